@@ -1 +1,139 @@
 #pragma once
+#include "Vector2.hpp"
+
+namespace stm
+{
+	// Closed box, points and boxes on the border count as inside and overlapping.
+	template<typename T>
+	class AABB2D
+	{
+	public:
+		AABB2D();
+		AABB2D(const AABB2D<T>& aAABB2D);
+		AABB2D(const Vector2<T>& aMin, const Vector2<T>& aMax);
+
+		AABB2D<T>& operator=(const AABB2D<T>& aAABB2D) = default;
+
+		void InitWithMinAndMax(const Vector2<T>& aMin, const Vector2<T>& aMax);
+
+		bool IsInside(const Vector2<T>& aPosition) const;
+		bool Contains(const AABB2D<T>& aAABB2D) const;
+		bool Overlaps(const AABB2D<T>& aAABB2D) const;
+
+		// Grows the box to also cover aAABB2D or aPosition.
+		void Merge(const AABB2D<T>& aAABB2D);
+		void Merge(const Vector2<T>& aPosition);
+		// Moves every side out by aMargin, negative margins shrink the box.
+		void Expand(T aMargin);
+
+		Vector2<T>& Min();
+		const Vector2<T>& Min() const;
+
+		Vector2<T>& Max();
+		const Vector2<T>& Max() const;
+
+	private:
+		Vector2<T> m_Min;
+		Vector2<T> m_Max;
+	};
+
+	template<typename T>
+	inline AABB2D<T>::AABB2D()
+	{
+
+	}
+
+	template<typename T>
+	inline AABB2D<T>::AABB2D(const AABB2D<T>& aAABB2D) :
+		m_Min(aAABB2D.m_Min),
+		m_Max(aAABB2D.m_Max)
+	{
+	}
+
+	template<typename T>
+	inline AABB2D<T>::AABB2D(const Vector2<T>& aMin, const Vector2<T>& aMax) :
+		m_Min(aMin),
+		m_Max(aMax)
+	{
+	}
+
+	template<typename T>
+	inline void AABB2D<T>::InitWithMinAndMax(const Vector2<T>& aMin, const Vector2<T>& aMax)
+	{
+		m_Min = aMin;
+		m_Max = aMax;
+	}
+
+	template<typename T>
+	inline Vector2<T>& AABB2D<T>::Min()
+	{
+		return m_Min;
+	}
+
+	template<typename T>
+	inline const Vector2<T>& AABB2D<T>::Min() const
+	{
+		return m_Min;
+	}
+
+	template<typename T>
+	inline Vector2<T>& AABB2D<T>::Max()
+	{
+		return m_Max;
+	}
+
+	template<typename T>
+	inline const Vector2<T>& AABB2D<T>::Max() const
+	{
+		return m_Max;
+	}
+
+	template<typename T>
+	inline bool AABB2D<T>::IsInside(const Vector2<T>& aPosition) const
+	{
+		return
+			aPosition.x >= m_Min.x && aPosition.x <= m_Max.x &&
+			aPosition.y >= m_Min.y && aPosition.y <= m_Max.y;
+	}
+
+	template<typename T>
+	inline bool AABB2D<T>::Contains(const AABB2D<T>& aAABB2D) const
+	{
+		return
+			aAABB2D.m_Min.x >= m_Min.x && aAABB2D.m_Max.x <= m_Max.x &&
+			aAABB2D.m_Min.y >= m_Min.y && aAABB2D.m_Max.y <= m_Max.y;
+	}
+
+	template<typename T>
+	inline bool AABB2D<T>::Overlaps(const AABB2D<T>& aAABB2D) const
+	{
+		// Bitwise and keeps the four compares free of branches.
+		return
+			(aAABB2D.m_Min.x <= m_Max.x) & (aAABB2D.m_Max.x >= m_Min.x) &
+			(aAABB2D.m_Min.y <= m_Max.y) & (aAABB2D.m_Max.y >= m_Min.y);
+	}
+
+	template<typename T>
+	inline void AABB2D<T>::Merge(const AABB2D<T>& aAABB2D)
+	{
+		m_Min.x = aAABB2D.m_Min.x < m_Min.x ? aAABB2D.m_Min.x : m_Min.x;
+		m_Min.y = aAABB2D.m_Min.y < m_Min.y ? aAABB2D.m_Min.y : m_Min.y;
+		m_Max.x = m_Max.x < aAABB2D.m_Max.x ? aAABB2D.m_Max.x : m_Max.x;
+		m_Max.y = m_Max.y < aAABB2D.m_Max.y ? aAABB2D.m_Max.y : m_Max.y;
+	}
+
+	template<typename T>
+	inline void AABB2D<T>::Merge(const Vector2<T>& aPosition)
+	{
+		Merge(AABB2D<T>(aPosition, aPosition));
+	}
+
+	template<typename T>
+	inline void AABB2D<T>::Expand(T aMargin)
+	{
+		m_Min.x -= aMargin;
+		m_Min.y -= aMargin;
+		m_Max.x += aMargin;
+		m_Max.y += aMargin;
+	}
+}
@@ -3,6 +3,7 @@
 
 namespace stm
 {
+	// Closed box, points and boxes on the border count as inside and overlapping.
 	template<typename T>
 	class AABB3D
 	{
@@ -11,9 +12,21 @@ namespace stm
 		AABB3D(const AABB3D<T>& aAABB3D);
 		AABB3D(const Vector3<T>& aMin, const Vector3<T>& aMax);
 
+		AABB3D<T>& operator=(const AABB3D<T>& aAABB3D) = default;
+
 		void InitWithMinAndMax(const Vector3<T>& aMin, const Vector3<T>& aMax);
 
 		bool IsInside(const Vector3<T>& aPosition) const;
+		bool Contains(const AABB3D<T>& aAABB3D) const;
+		bool Overlaps(const AABB3D<T>& aAABB3D) const;
+
+		// Grows the box to also cover aAABB3D or aPosition.
+		void Merge(const AABB3D<T>& aAABB3D);
+		void Merge(const Vector3<T>& aPosition);
+		// Moves every side out by aMargin, negative margins shrink the box.
+		void Expand(T aMargin);
+		// Meaningless for boxes with a min above their max.
+		T SurfaceArea() const;
 
 		Vector3<T>& Min();
 		const Vector3<T>& Min() const;
@@ -85,4 +98,60 @@ namespace stm
 			aPosition.y >= m_Min.y && aPosition.y <= m_Max.y &&
 			aPosition.z >= m_Min.z && aPosition.z <= m_Max.z;
 	}
+
+	template<typename T>
+	inline bool AABB3D<T>::Contains(const AABB3D<T>& aAABB3D) const
+	{
+		return
+			aAABB3D.m_Min.x >= m_Min.x && aAABB3D.m_Max.x <= m_Max.x &&
+			aAABB3D.m_Min.y >= m_Min.y && aAABB3D.m_Max.y <= m_Max.y &&
+			aAABB3D.m_Min.z >= m_Min.z && aAABB3D.m_Max.z <= m_Max.z;
+	}
+
+	template<typename T>
+	inline bool AABB3D<T>::Overlaps(const AABB3D<T>& aAABB3D) const
+	{
+		// Bitwise and keeps the six compares free of branches.
+		return
+			(aAABB3D.m_Min.x <= m_Max.x) & (aAABB3D.m_Max.x >= m_Min.x) &
+			(aAABB3D.m_Min.y <= m_Max.y) & (aAABB3D.m_Max.y >= m_Min.y) &
+			(aAABB3D.m_Min.z <= m_Max.z) & (aAABB3D.m_Max.z >= m_Min.z);
+	}
+
+	template<typename T>
+	inline void AABB3D<T>::Merge(const AABB3D<T>& aAABB3D)
+	{
+		m_Min.x = aAABB3D.m_Min.x < m_Min.x ? aAABB3D.m_Min.x : m_Min.x;
+		m_Min.y = aAABB3D.m_Min.y < m_Min.y ? aAABB3D.m_Min.y : m_Min.y;
+		m_Min.z = aAABB3D.m_Min.z < m_Min.z ? aAABB3D.m_Min.z : m_Min.z;
+		m_Max.x = m_Max.x < aAABB3D.m_Max.x ? aAABB3D.m_Max.x : m_Max.x;
+		m_Max.y = m_Max.y < aAABB3D.m_Max.y ? aAABB3D.m_Max.y : m_Max.y;
+		m_Max.z = m_Max.z < aAABB3D.m_Max.z ? aAABB3D.m_Max.z : m_Max.z;
+	}
+
+	template<typename T>
+	inline void AABB3D<T>::Merge(const Vector3<T>& aPosition)
+	{
+		Merge(AABB3D<T>(aPosition, aPosition));
+	}
+
+	template<typename T>
+	inline void AABB3D<T>::Expand(T aMargin)
+	{
+		m_Min.x -= aMargin;
+		m_Min.y -= aMargin;
+		m_Min.z -= aMargin;
+		m_Max.x += aMargin;
+		m_Max.y += aMargin;
+		m_Max.z += aMargin;
+	}
+
+	template<typename T>
+	inline T AABB3D<T>::SurfaceArea() const
+	{
+		const T x = m_Max.x - m_Min.x;
+		const T y = m_Max.y - m_Min.y;
+		const T z = m_Max.z - m_Min.z;
+		return T(2) * (x * y + y * z + z * x);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,165 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#include "CpuFeatures.hpp"
+#include "Precision.hpp"
+
+namespace stm
+{
+	template<typename T>
+	class Vector3Stream;
+
+	template<typename T>
+	class Vector3;
+
+	template<typename T>
+	class Vector4;
+
+	template<typename T>
+	class AABB2D;
+
+	template<typename T>
+	class AABB3D;
+
+	template<typename T>
+	class Sphere;
+
+	template<typename T>
+	class Ray;
+
+	template<typename T>
+	class Matrix3x3;
+
+	template<typename T>
+	class Matrix3x4;
+
+	template<typename T>
+	class Matrix4x4;
+
+	class Fixed32;
+	class Quaternion;
+	class QuaternionStream;
+	class Transform;
+	class Vector3h;
+	class OctahedralNormal;
+	class PackedVector1010102;
+	class PackedQuaternion;
+
+	// Entry points that run the SSE2, AVX2 or AVX-512 kernels, picked once from the running CPU.
+	namespace Batch
+	{
+		// Parallel splits large inputs across the hardware threads, small ones still run on the calling thread.
+		enum class Execution
+		{
+			Sequential,
+			Parallel
+		};
+
+		// All reports every hit. Any stops at the first hit it finds, which is enough for occlusion. Closest keeps
+		// the nearest hit, on ties the lowest index.
+		enum class HitMode
+		{
+			All,
+			Any,
+			Closest
+		};
+
+		// The index reported for rays that hit nothing.
+		constexpr std::uint32_t NoHit = std::numeric_limits<std::uint32_t>::max();
+
+		InstructionSet GetInstructionSet();
+
+		void Dot(const Vector3Stream<float>& aVectors0, const Vector3Stream<float>& aVectors1, std::span<float> aResult);
+		void DistanceSqr(const Vector3Stream<float>& aVectors0, const Vector3Stream<float>& aVectors1, std::span<float> aResult);
+		void Length(const Vector3Stream<float>& aVectors, std::span<float> aResult, Precision aPrecision = Precision::Exact);
+		void Normalize(Vector3Stream<float>& aVectors, Precision aPrecision = Precision::Exact);
+		void Cross(const Vector3Stream<float>& aVectors0, const Vector3Stream<float>& aVectors1, Vector3Stream<float>& aResult);
+		void Lerp(const Vector3Stream<float>& aFrom, const Vector3Stream<float>& aTo, float aDelta, Vector3Stream<float>& aResult);
+
+		// Math::Clamp, Lerp and Remap over whole arrays, aResult may be an input. Remap folds its ranges into one
+		// multiply-add, so it can differ from Math::Remap in the last bit.
+		void Clamp(std::span<const float> aValues, float aMin, float aMax, std::span<float> aResult, Execution aExecution = Execution::Sequential);
+		void Lerp(std::span<const float> aFrom, std::span<const float> aTo, float aDelta, std::span<float> aResult, Execution aExecution = Execution::Sequential);
+		void Remap(std::span<const float> aValues, float aFromMin, float aFromMax, float aToMin, float aToMax, std::span<float> aResult, Execution aExecution = Execution::Sequential);
+
+		// Fixed32 streams on the integer lanes, bit identical to the Vector3<Fixed32> operators on every instruction
+		// set. Multiply is component-wise, aResult may be either input.
+		void Add(const Vector3Stream<Fixed32>& aVectors0, const Vector3Stream<Fixed32>& aVectors1, Vector3Stream<Fixed32>& aResult, Execution aExecution = Execution::Sequential);
+		void Multiply(const Vector3Stream<Fixed32>& aVectors0, const Vector3Stream<Fixed32>& aVectors1, Vector3Stream<Fixed32>& aResult, Execution aExecution = Execution::Sequential);
+		void Dot(const Vector3Stream<Fixed32>& aVectors0, const Vector3Stream<Fixed32>& aVectors1, std::span<Fixed32> aResult, Execution aExecution = Execution::Sequential);
+		void Cross(const Vector3Stream<Fixed32>& aVectors0, const Vector3Stream<Fixed32>& aVectors1, Vector3Stream<Fixed32>& aResult, Execution aExecution = Execution::Sequential);
+
+		// Indices of the boxes in aBoxes that overlap aBox, in ascending order, returns how many there were.
+		// aResult must hold aBoxes.size() entries, the ones past the returned count are unspecified.
+		std::size_t Overlaps(const AABB2D<float>& aBox, std::span<const AABB2D<float>> aBoxes, std::span<std::uint32_t> aResult);
+
+		// Rays against spheres given as centers and radii, and against planes in Hessian normal form, given as unit
+		// normals and distances so that Dot(normal, point) + distance = 0. Distances along a ray are in multiples
+		// of its direction as in Ray::Intersects, a ray starting inside a sphere hits it at 0 and planes are hit
+		// from both sides. Only hits up to aMaxDistance count.
+		// One ray: writes the index and distance of the hits to aHitIndices and aHitDistances and returns how
+		// many there were. All lists every hit in ascending index order and needs room for one entry per
+		// primitive, Any and Closest report at most one hit and need room for one.
+		std::size_t IntersectSpheres(const Ray<float>& aRay, const Vector3Stream<float>& aCenters, std::span<const float> aRadii, HitMode aMode, std::span<std::uint32_t> aHitIndices, std::span<float> aHitDistances, float aMaxDistance = std::numeric_limits<float>::infinity());
+		std::size_t IntersectPlanes(const Ray<float>& aRay, const Vector3Stream<float>& aNormals, std::span<const float> aDistances, HitMode aMode, std::span<std::uint32_t> aHitIndices, std::span<float> aHitDistances, float aMaxDistance = std::numeric_limits<float>::infinity());
+		// Many rays with Any or Closest: aHitIndices[n] and aHitDistances[n] belong to ray n, NoHit and infinity
+		// when it hits nothing.
+		void IntersectSpheres(std::span<const Ray<float>> aRays, const Vector3Stream<float>& aCenters, std::span<const float> aRadii, HitMode aMode, std::span<std::uint32_t> aHitIndices, std::span<float> aHitDistances, float aMaxDistance = std::numeric_limits<float>::infinity(), Execution aExecution = Execution::Sequential);
+		void IntersectPlanes(std::span<const Ray<float>> aRays, const Vector3Stream<float>& aNormals, std::span<const float> aDistances, HitMode aMode, std::span<std::uint32_t> aHitIndices, std::span<float> aHitDistances, float aMaxDistance = std::numeric_limits<float>::infinity(), Execution aExecution = Execution::Sequential);
+
+		// Indices of the boxes or spheres that are not entirely in front of any of the planes, in ascending order,
+		// returns how many there were. The planes are in the Hessian normal form above with their normals pointing
+		// out of the volume. aResult must hold one entry per object, the ones past the returned count are unspecified.
+		std::size_t Cull(const Vector3Stream<float>& aNormals, std::span<const float> aDistances, std::span<const AABB3D<float>> aBoxes, std::span<std::uint32_t> aResult, Execution aExecution = Execution::Sequential);
+		std::size_t Cull(const Vector3Stream<float>& aNormals, std::span<const float> aDistances, std::span<const Sphere<float>> aSpheres, std::span<std::uint32_t> aResult, Execution aExecution = Execution::Sequential);
+
+		void Multiply(std::span<const Matrix4x4<float>> aLeft, const Matrix4x4<float>& aRight, std::span<Matrix4x4<float>> aResult);
+		// aResult[n] = aLeft[n] * aRight[n], aResult may alias either input.
+		void Multiply(std::span<const Matrix4x4<float>> aLeft, std::span<const Matrix4x4<float>> aRight, std::span<Matrix4x4<float>> aResult);
+
+		// Singular matrices keep their aResult entry untouched, the return value is how many there were.
+		std::size_t Inverse(std::span<const Matrix4x4<float>> aMatrices, std::span<Matrix4x4<float>> aResult);
+		std::size_t InverseAffine(std::span<const Matrix4x4<float>> aTransforms, std::span<Matrix4x4<float>> aResult);
+		std::size_t Inverse(std::span<const Matrix3x3<float>> aMatrices, std::span<Matrix3x3<float>> aResult);
+		void Determinant(std::span<const Matrix4x4<float>> aMatrices, std::span<float> aResult);
+		void Determinant(std::span<const Matrix3x3<float>> aMatrices, std::span<float> aResult);
+
+		// Row vectors times aMatrix. Points add the translation, directions do not, and both ignore the
+		// w column, use TransformHomogeneous for projections. aResult may be the input.
+		void TransformPoints(std::span<const Vector3<float>> aPoints, const Matrix4x4<float>& aMatrix, std::span<Vector3<float>> aResult, Execution aExecution = Execution::Sequential);
+		void TransformDirections(std::span<const Vector3<float>> aDirections, const Matrix4x4<float>& aMatrix, std::span<Vector3<float>> aResult, Execution aExecution = Execution::Sequential);
+		void TransformPoints(const Vector3Stream<float>& aPoints, const Matrix4x4<float>& aMatrix, Vector3Stream<float>& aResult, Execution aExecution = Execution::Sequential);
+		void TransformDirections(const Vector3Stream<float>& aDirections, const Matrix4x4<float>& aMatrix, Vector3Stream<float>& aResult, Execution aExecution = Execution::Sequential);
+		void TransformHomogeneous(std::span<const Vector4<float>> aVectors, const Matrix4x4<float>& aMatrix, std::span<Vector4<float>> aResult, Execution aExecution = Execution::Sequential);
+
+		void Normalize(std::span<Quaternion> aQuaternions, Precision aPrecision = Precision::Exact);
+
+		// Every vector rotated by aRotation, which is turned into a rotation matrix once. Vector4 keeps its w,
+		// aResult may be the input.
+		void Rotate(std::span<const Vector3<float>> aVectors, const Quaternion& aRotation, std::span<Vector3<float>> aResult, Execution aExecution = Execution::Sequential);
+		void Rotate(std::span<const Vector4<float>> aVectors, const Quaternion& aRotation, std::span<Vector4<float>> aResult, Execution aExecution = Execution::Sequential);
+		void Rotate(const Vector3Stream<float>& aVectors, const Quaternion& aRotation, Vector3Stream<float>& aResult, Execution aExecution = Execution::Sequential);
+		// aResult[n] = aVectors[n] rotated by unit quaternion aRotations[n].
+		void Rotate(const QuaternionStream& aRotations, const Vector3Stream<float>& aVectors, Vector3Stream<float>& aResult, Execution aExecution = Execution::Sequential);
+
+		// Euler angles in degrees to quaternions and back, the closed forms of Quaternion(x, y, z) and Quaternion::GetEuler.
+		void ToQuaternions(const Vector3Stream<float>& aEulerAngles, QuaternionStream& aResult, Execution aExecution = Execution::Sequential);
+		void ToEulerAngles(const QuaternionStream& aRotations, Vector3Stream<float>& aResult, Execution aExecution = Execution::Sequential);
+
+		// Transform::CreateMatrix and CreateAffineMatrix for a whole array, built straight from the quaternions.
+		void BuildMatrices(std::span<const Transform> aTransforms, std::span<Matrix4x4<float>> aResult, Execution aExecution = Execution::Sequential);
+		void BuildMatrices(std::span<const Transform> aTransforms, std::span<Matrix3x4<float>> aResult, Execution aExecution = Execution::Sequential);
+
+		// Bulk versions of the PackedVector.hpp constructors and Unpack, aResult must hold at least as many elements.
+		void Pack(std::span<const Vector3<float>> aVectors, std::span<Vector3h> aResult);
+		void Unpack(std::span<const Vector3h> aVectors, std::span<Vector3<float>> aResult);
+		void Pack(std::span<const Quaternion> aQuaternions, std::span<PackedQuaternion> aResult);
+		void Unpack(std::span<const PackedQuaternion> aQuaternions, std::span<Quaternion> aResult);
+		void Pack(std::span<const Vector3<float>> aNormals, std::span<OctahedralNormal> aResult);
+		void Unpack(std::span<const OctahedralNormal> aNormals, std::span<Vector3<float>> aResult);
+		void Pack(std::span<const Vector4<float>> aVectors, std::span<PackedVector1010102> aResult);
+		void Unpack(std::span<const PackedVector1010102> aVectors, std::span<Vector4<float>> aResult);
+	}
+}
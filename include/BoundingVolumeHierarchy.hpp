@@ -0,0 +1,73 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "AABB3D.hpp"
+#include "Batch.hpp"
+#include "Ray.hpp"
+#include "RayPacket.hpp"
+#include "Sphere.hpp"
+
+namespace stm
+{
+	// Binary tree of boxes built with the binned surface area heuristic. Nodes are 32 bytes in one array, two
+	// to a cache line with siblings side by side, and leaves point into a copy of the boxes sorted by leaf.
+	// Queries report the payload of every primitive box that passes the test, in no particular order.
+	class BoundingVolumeHierarchy
+	{
+	public:
+		BoundingVolumeHierarchy() = default;
+		~BoundingVolumeHierarchy() = default;
+
+		// aPayloads is either empty, which makes the payloads the indices into aBoxes, or holds one per box.
+		// Parallel builds the subtrees of large nodes on their own threads.
+		void Build(std::span<const AABB3D<float>> aBoxes, std::span<const std::uint32_t> aPayloads = {}, Batch::Execution aExecution = Batch::Execution::Sequential);
+		void Clear();
+
+		std::size_t Size() const;
+		std::size_t GetNodeCount() const;
+		// Of the whole tree, undefined when it is empty.
+		AABB3D<float> GetBounds() const;
+
+		// Each replaces the contents of aResult.
+		void QueryPoint(const Vector3f& aPoint, std::vector<std::uint32_t>& aResult) const;
+		void QueryOverlap(const AABB3D<float>& aBox, std::vector<std::uint32_t>& aResult) const;
+		void QueryOverlap(const Sphere<float>& aSphere, std::vector<std::uint32_t>& aResult) const;
+		// Boxes the ray enters or starts in between aMinDistance and aMaxDistance, in multiples of the ray's
+		// direction, so 1 is the second point of a Ray built from two points.
+		void QueryRay(const Ray<float>& aRay, std::vector<std::uint32_t>& aResult, float aMinDistance = 0.0f, float aMaxDistance = std::numeric_limits<float>::infinity()) const;
+
+		// The box whose entry point is closest along the ray, false when nothing is hit.
+		bool Raycast(const Ray<float>& aRay, std::uint32_t& aPayload, float& aDistance, float aMaxDistance = std::numeric_limits<float>::infinity()) const;
+		// Raycast for every lane of the packet in a single traversal, worth it for rays that stay close together
+		// such as the pixels of a screen tile. Returns the mask of lanes that hit, other lanes of aPayloads and
+		// aDistances are left untouched.
+		std::uint32_t Raycast(const RayPacket4& aPacket, std::span<std::uint32_t, 4> aPayloads, std::span<float, 4> aDistances, float aMaxDistance = std::numeric_limits<float>::infinity()) const;
+		std::uint32_t Raycast(const RayPacket8& aPacket, std::span<std::uint32_t, 8> aPayloads, std::span<float, 8> aDistances, float aMaxDistance = std::numeric_limits<float>::infinity()) const;
+
+	private:
+		// Interior nodes have a count of 0 and their children at index and index + 1, leaves hold the count
+		// boxes starting at index.
+		struct Node
+		{
+			float min[3];
+			std::uint32_t index;
+			float max[3];
+			std::uint32_t count;
+		};
+		static_assert(sizeof(Node) == 32, "Nodes must stay at half a cache line");
+
+		class Builder;
+
+		template<typename Test>
+		void Query(const Test& aTest, std::vector<std::uint32_t>& aResult) const;
+		template<std::size_t N>
+		std::uint32_t RaycastPacket(const RayPacket<N>& aPacket, std::span<std::uint32_t, N> aPayloads, std::span<float, N> aDistances, float aMaxDistance) const;
+
+		std::vector<Node> m_Nodes;
+		std::vector<AABB3D<float>> m_Boxes;
+		std::vector<std::uint32_t> m_Payloads;
+	};
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "AABB2D.hpp"
+
+namespace stm
+{
+	// Uniform grid over the bounds of the boxes. Every box is binned into the cells it touches and only boxes
+	// sharing a cell are tested, with Batch::Overlaps doing one box against the rest of its cell at a time.
+	// A pair is only reported by the cell holding the min corner of the two boxes' intersection, so every
+	// overlapping pair comes out exactly once. The buffers are kept between calls, so reuse one instance.
+	class Broadphase2D
+	{
+	public:
+		using Pair = std::pair<std::uint32_t, std::uint32_t>;
+
+		// Around the size of a typical box works best. Grows on its own when the bounds would need more than a
+		// few cells per box.
+		explicit Broadphase2D(float aCellSize);
+		~Broadphase2D() = default;
+
+		void SetCellSize(float aCellSize);
+		float GetCellSize() const;
+
+		// Replaces the contents of aPairs with the index pairs of every two overlapping boxes, the smaller index
+		// first. Pairs are ordered by cell, not sorted.
+		void FindPairs(std::span<const AABB2D<float>> aBoxes, std::vector<Pair>& aPairs);
+
+	private:
+		float m_CellSize;
+		// Boxes per cell as a counting sort, cell n holds m_CellBoxes[m_CellStart[n]] to m_CellBoxes[m_CellStart[n + 1]].
+		std::vector<std::uint32_t> m_CellStart;
+		std::vector<std::uint32_t> m_CellBoxes;
+		// One cell's boxes gathered for the batched test, and the test's output.
+		std::vector<AABB2D<float>> m_Gathered;
+		std::vector<std::uint32_t> m_Overlaps;
+	};
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+namespace stm
+{
+	enum class InstructionSet
+	{
+		Scalar,
+		SSE2,
+		AVX2,
+		AVX512
+	};
+
+	struct CpuFeatures
+	{
+		static const CpuFeatures& Get();
+		static const char* GetName(InstructionSet aInstructionSet);
+
+		bool hasSSE2 = false;
+		bool hasSSE41 = false;
+		bool hasAVX = false;
+		bool hasAVX2 = false;
+		bool hasFMA = false;
+		bool hasF16C = false;
+		bool hasAVX512F = false;
+		bool hasAVX512DQ = false;
+		bool hasAVX512VL = false;
+	};
+}
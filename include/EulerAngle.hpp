@@ -1,4 +1,4 @@
-
+#pragma once
 namespace stm
 {
 	template<typename T = float>
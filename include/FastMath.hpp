@@ -0,0 +1,203 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+#include "Precision.hpp"
+
+namespace stm
+{
+	// Polynomial sin, cos, atan2, acos and exp for float, written once against a Lanes type so that Math (one float),
+	// Simd (__m128) and the batch kernels (up to sixteen floats) share the same approximations. Exact is libm and left
+	// to the callers, the maximum error of the other two tiers is
+	//                Fast                          Fastest
+	//   SinCos       2 ULP                         1.5e-5 absolute        for |angle| < 8192 radians
+	//   Atan2        3 ULP                         2.3e-5 relative
+	//   Acos         2 ULP                         6.8e-5 absolute
+	//   Exp          2 ULP                         1.3e-4 relative        inputs clamped to [-104, 88.72], the relative
+	//                                                                     bound above -87.33 where results turn denormal
+	// Lanes provides Register, Splat, Add, Sub, Mul, Div, Sqrt, Min, Max, MultiplyAdd, Round (to nearest even),
+	// Less (a lane mask with every bit set or clear), Select(mask, a, b), And, Xor and, for Exp, Pow2 (2^n for
+	// integral n in [-126, 127]).
+	template<typename Lanes>
+	struct FastMath
+	{
+		using Register = typename Lanes::Register;
+
+		static Register Abs(Register aValue);
+		// Flips the sign of the lanes set in aMask.
+		static Register Negate(Register aValue, Register aMask);
+
+		template<Precision P>
+		static void SinCos(Register aAngle, Register& aSin, Register& aCos);
+		template<Precision P>
+		static Register Atan2(Register aY, Register aX);
+		template<Precision P>
+		static Register Acos(Register aValue);
+		template<Precision P>
+		static Register Exp(Register aValue);
+	};
+
+	template<typename Lanes>
+	inline typename FastMath<Lanes>::Register FastMath<Lanes>::Abs(Register aValue)
+	{
+		return Lanes::And(aValue, Lanes::Splat(std::bit_cast<float>(0x7fffffffu)));
+	}
+
+	template<typename Lanes>
+	inline typename FastMath<Lanes>::Register FastMath<Lanes>::Negate(Register aValue, Register aMask)
+	{
+		return Lanes::Xor(aValue, Lanes::And(aMask, Lanes::Splat(-0.0f)));
+	}
+
+	template<typename Lanes>
+	template<Precision P>
+	inline void FastMath<Lanes>::SinCos(Register aAngle, Register& aSin, Register& aCos)
+	{
+		static_assert(P != Precision::Exact, "Exact is left to libm");
+
+		// Cody-Waite reduction by pi / 2 in three parts of at most eleven significant bits, so that their products
+		// with quadrants below 8192 are exact with or without a fused multiply add. The rest of pi / 2 is too small
+		// to change the reduced angle by more than its rounding and is added to the sine's cubic term instead,
+		// which keeps the error in ULP also next to the zeros of sine and cosine.
+		const Register quadrant = Lanes::Round(Lanes::Mul(aAngle, Lanes::Splat(0.636619772f)));
+		Register reduced = Lanes::MultiplyAdd(quadrant, Lanes::Splat(-1.5703125f), aAngle);
+		reduced = Lanes::MultiplyAdd(quadrant, Lanes::Splat(-4.837512969970703125e-4f), reduced);
+		reduced = Lanes::MultiplyAdd(quadrant, Lanes::Splat(-7.54953362047672271728515625e-8f), reduced);
+		const Register correction = Lanes::Mul(quadrant, Lanes::Splat(-2.5633440682570896e-12f));
+
+		const Register squared = Lanes::Mul(reduced, reduced);
+		Register sine;
+		Register cosine;
+		if constexpr (P == Precision::Fast)
+		{
+			sine = Lanes::MultiplyAdd(squared, Lanes::Splat(-1.9515295891e-4f), Lanes::Splat(8.3321608736e-3f));
+			sine = Lanes::MultiplyAdd(squared, sine, Lanes::Splat(-1.6666654611e-1f));
+			cosine = Lanes::MultiplyAdd(squared, Lanes::Splat(2.443315711809948e-5f), Lanes::Splat(-1.388731625493765e-3f));
+			cosine = Lanes::MultiplyAdd(squared, cosine, Lanes::Splat(4.166664568298827e-2f));
+			cosine = Lanes::MultiplyAdd(Lanes::Mul(squared, squared), cosine, Lanes::MultiplyAdd(squared, Lanes::Splat(-0.5f), Lanes::Splat(1.0f)));
+		}
+		else
+		{
+			sine = Lanes::MultiplyAdd(squared, Lanes::Splat(8.16328115e-3f), Lanes::Splat(-1.66633903e-1f));
+			cosine = Lanes::MultiplyAdd(squared, Lanes::Splat(4.04584469e-2f), Lanes::Splat(-4.99760554e-1f));
+			cosine = Lanes::MultiplyAdd(squared, cosine, Lanes::Splat(1.0f));
+		}
+		sine = Lanes::Add(reduced, Lanes::MultiplyAdd(Lanes::Mul(reduced, squared), sine, correction));
+
+		// The quadrant q mod 4 from q - 4 * round(q / 4), which lies in [-2, 2].
+		const Register wrapped = Lanes::MultiplyAdd(Lanes::Round(Lanes::Mul(quadrant, Lanes::Splat(0.25f))), Lanes::Splat(-4.0f), quadrant);
+		const Register odd = Lanes::Less(Abs(Lanes::Sub(Abs(wrapped), Lanes::Splat(1.0f))), Lanes::Splat(0.5f));
+		const Register sineNegative = Lanes::Xor(Lanes::Less(wrapped, Lanes::Splat(-0.5f)), Lanes::Less(Lanes::Splat(1.5f), wrapped));
+		const Register cosineNegative = Lanes::Xor(Lanes::Less(wrapped, Lanes::Splat(-1.5f)), Lanes::Less(Lanes::Splat(0.5f), wrapped));
+		aSin = Negate(Lanes::Select(odd, cosine, sine), sineNegative);
+		aCos = Negate(Lanes::Select(odd, sine, cosine), cosineNegative);
+	}
+
+	template<typename Lanes>
+	template<Precision P>
+	inline typename FastMath<Lanes>::Register FastMath<Lanes>::Atan2(Register aY, Register aX)
+	{
+		static_assert(P != Precision::Exact, "Exact is left to libm");
+
+		// atan of a = min / max on [0, 1], above tan(pi / 8) shifted to atan((a - 1) / (a + 1)) + pi / 4.
+		const Register absY = Abs(aY);
+		const Register absX = Abs(aX);
+		const Register smaller = Lanes::Min(absX, absY);
+		const Register larger = Lanes::Max(absX, absY);
+		const Register shifted = Lanes::Less(Lanes::Mul(larger, Lanes::Splat(0.414213562f)), smaller);
+		const Register numerator = Lanes::Select(shifted, Lanes::Sub(smaller, larger), smaller);
+		const Register denominator = Lanes::Select(shifted, Lanes::Add(smaller, larger), larger);
+		// Zero over zero becomes zero over the smallest normal.
+		const Register ratio = Lanes::Div(numerator, Lanes::Max(denominator, Lanes::Splat(std::numeric_limits<float>::min())));
+
+		const Register squared = Lanes::Mul(ratio, ratio);
+		Register result;
+		if constexpr (P == Precision::Fast)
+		{
+			result = Lanes::MultiplyAdd(squared, Lanes::Splat(8.05374449538e-2f), Lanes::Splat(-1.38776856032e-1f));
+			result = Lanes::MultiplyAdd(squared, result, Lanes::Splat(1.99777106478e-1f));
+			result = Lanes::MultiplyAdd(squared, result, Lanes::Splat(-3.33329491539e-1f));
+		}
+		else
+		{
+			result = Lanes::MultiplyAdd(squared, Lanes::Splat(1.70341591e-1f), Lanes::Splat(-3.31833748e-1f));
+		}
+		result = Lanes::MultiplyAdd(Lanes::Mul(ratio, squared), result, ratio);
+		result = Lanes::Add(result, Lanes::And(shifted, Lanes::Splat(0.785398163f)));
+
+		result = Lanes::Select(Lanes::Less(absX, absY), Lanes::Sub(Lanes::Splat(1.57079633f), result), result);
+		result = Lanes::Select(Lanes::Less(aX, Lanes::Splat(0.0f)), Lanes::Sub(Lanes::Splat(3.14159265f), result), result);
+		return Lanes::Xor(result, Lanes::And(aY, Lanes::Splat(-0.0f)));
+	}
+
+	template<typename Lanes>
+	template<Precision P>
+	inline typename FastMath<Lanes>::Register FastMath<Lanes>::Acos(Register aValue)
+	{
+		static_assert(P != Precision::Exact, "Exact is left to libm");
+
+		const Register absValue = Abs(aValue);
+		const Register negative = Lanes::Less(aValue, Lanes::Splat(0.0f));
+		if constexpr (P == Precision::Fast)
+		{
+			// asin(s) on [0, 0.5], acos(x) = pi / 2 - asin(x) there and 2 * asin(sqrt((1 - x) / 2)) above.
+			const Register large = Lanes::Less(Lanes::Splat(0.5f), absValue);
+			const Register halfComplement = Lanes::Mul(Lanes::Sub(Lanes::Splat(1.0f), absValue), Lanes::Splat(0.5f));
+			const Register squared = Lanes::Select(large, halfComplement, Lanes::Mul(absValue, absValue));
+			const Register argument = Lanes::Select(large, Lanes::Sqrt(squared), absValue);
+
+			Register arcSine = Lanes::MultiplyAdd(squared, Lanes::Splat(4.2163199048e-2f), Lanes::Splat(2.4181311049e-2f));
+			arcSine = Lanes::MultiplyAdd(squared, arcSine, Lanes::Splat(4.5470025998e-2f));
+			arcSine = Lanes::MultiplyAdd(squared, arcSine, Lanes::Splat(7.4953002686e-2f));
+			arcSine = Lanes::MultiplyAdd(squared, arcSine, Lanes::Splat(1.6666752422e-1f));
+			arcSine = Lanes::MultiplyAdd(Lanes::Mul(argument, squared), arcSine, argument);
+
+			const Register doubled = Lanes::Add(arcSine, arcSine);
+			const Register largeResult = Lanes::Select(negative, Lanes::Sub(Lanes::Splat(3.14159265f), doubled), doubled);
+			const Register smallResult = Lanes::Sub(Lanes::Splat(1.57079633f), Negate(arcSine, negative));
+			return Lanes::Select(large, largeResult, smallResult);
+		}
+		else
+		{
+			// sqrt(1 - x) * cubic, Abramowitz and Stegun 4.4.45.
+			Register result = Lanes::MultiplyAdd(absValue, Lanes::Splat(-0.0187293f), Lanes::Splat(0.0742610f));
+			result = Lanes::MultiplyAdd(absValue, result, Lanes::Splat(-0.2121144f));
+			result = Lanes::MultiplyAdd(absValue, result, Lanes::Splat(1.5707288f));
+			result = Lanes::Mul(result, Lanes::Sqrt(Lanes::Sub(Lanes::Splat(1.0f), absValue)));
+			return Lanes::Select(negative, Lanes::Sub(Lanes::Splat(3.14159265f), result), result);
+		}
+	}
+
+	template<typename Lanes>
+	template<Precision P>
+	inline typename FastMath<Lanes>::Register FastMath<Lanes>::Exp(Register aValue)
+	{
+		static_assert(P != Precision::Exact, "Exact is left to libm");
+
+		// e^x = 2^n * e^r with n = round(x / ln 2), ln 2 split in two so that r stays exact.
+		const Register value = Lanes::Min(Lanes::Max(aValue, Lanes::Splat(-104.0f)), Lanes::Splat(88.7228394f));
+		const Register power = Lanes::Round(Lanes::Mul(value, Lanes::Splat(1.44269504f)));
+		Register reduced = Lanes::MultiplyAdd(power, Lanes::Splat(-0.693359375f), value);
+		reduced = Lanes::MultiplyAdd(power, Lanes::Splat(2.12194440e-4f), reduced);
+
+		Register result;
+		if constexpr (P == Precision::Fast)
+		{
+			result = Lanes::MultiplyAdd(reduced, Lanes::Splat(1.9875691500e-4f), Lanes::Splat(1.3981999507e-3f));
+			result = Lanes::MultiplyAdd(reduced, result, Lanes::Splat(8.3334519073e-3f));
+			result = Lanes::MultiplyAdd(reduced, result, Lanes::Splat(4.1665795894e-2f));
+			result = Lanes::MultiplyAdd(reduced, result, Lanes::Splat(1.6666665459e-1f));
+			result = Lanes::MultiplyAdd(reduced, result, Lanes::Splat(5.0000001201e-1f));
+		}
+		else
+		{
+			result = Lanes::MultiplyAdd(reduced, Lanes::Splat(1.66628169e-1f), Lanes::Splat(5.03941089e-1f));
+		}
+		result = Lanes::MultiplyAdd(Lanes::Mul(reduced, reduced), result, Lanes::Add(reduced, Lanes::Splat(1.0f)));
+
+		// 2^n as two factors, so that n from -150 to 128 never leaves the normal exponent range.
+		const Register halfPower = Lanes::Round(Lanes::Mul(power, Lanes::Splat(0.5f)));
+		return Lanes::Mul(Lanes::Mul(result, Lanes::Pow2(halfPower)), Lanes::Pow2(Lanes::Sub(power, halfPower)));
+	}
+}
@@ -0,0 +1,301 @@
+#pragma once
+#include <cassert>
+#include <compare>
+#include <cstdint>
+
+namespace stm
+{
+	// Signed 16.16 fixed point, range [-32768, 32768) in steps of 1 / 65536. Every operation is integer arithmetic,
+	// so results are bit identical on every machine and compiler, which float cannot promise for lockstep simulation.
+	// Products and quotients round toward negative infinity, overflow wraps. Converting a value outside the range
+	// asserts instead, as it is a bug at the call site rather than the result of a simulation step.
+	class Fixed32
+	{
+	public:
+		static constexpr int FractionBits = 16;
+		static constexpr std::int32_t One = 1 << FractionBits;
+
+		constexpr Fixed32() = default;
+		// aValue must lie in [-32768, 32767].
+		constexpr Fixed32(int aValue);
+		// Rounds to the nearest step, the only place floating point is involved. aValue must round into the range.
+		explicit constexpr Fixed32(float aValue);
+		explicit constexpr Fixed32(double aValue);
+
+		static constexpr Fixed32 FromRaw(std::int32_t aRaw);
+		constexpr std::int32_t GetRaw() const;
+
+		explicit constexpr operator float() const;
+		explicit constexpr operator double() const;
+		// Rounds toward negative infinity.
+		explicit constexpr operator int() const;
+
+		constexpr Fixed32 operator-() const;
+		constexpr Fixed32& operator+=(Fixed32 aOther);
+		constexpr Fixed32& operator-=(Fixed32 aOther);
+		constexpr Fixed32& operator*=(Fixed32 aOther);
+		constexpr Fixed32& operator/=(Fixed32 aOther);
+
+		friend constexpr Fixed32 operator+(Fixed32 aLeft, Fixed32 aRight) { return aLeft += aRight; }
+		friend constexpr Fixed32 operator-(Fixed32 aLeft, Fixed32 aRight) { return aLeft -= aRight; }
+		friend constexpr Fixed32 operator*(Fixed32 aLeft, Fixed32 aRight) { return aLeft *= aRight; }
+		friend constexpr Fixed32 operator/(Fixed32 aLeft, Fixed32 aRight) { return aLeft /= aRight; }
+		friend constexpr bool operator==(Fixed32 aLeft, Fixed32 aRight) = default;
+		friend constexpr std::strong_ordering operator<=>(Fixed32 aLeft, Fixed32 aRight) = default;
+
+		static constexpr Fixed32 Abs(Fixed32 aValue);
+		// Rounded to the nearest step, aValue must not be negative.
+		static constexpr Fixed32 Sqrt(Fixed32 aValue);
+		// Radians. Evaluated in 2.30 fixed point with the Math::SinCos<Precision::Fast> polynomials, the results are
+		// within one step of the exact values over the whole range.
+		static constexpr void SinCos(Fixed32 aAngle, Fixed32& aSin, Fixed32& aCos);
+		static constexpr Fixed32 Sin(Fixed32 aAngle);
+		static constexpr Fixed32 Cos(Fixed32 aAngle);
+		// Radians in [-pi, pi], 0 for Atan2(0, 0).
+		static constexpr Fixed32 Atan2(Fixed32 aY, Fixed32 aX);
+		static constexpr Fixed32 DegreeToRad(Fixed32 aDegrees);
+
+		static constexpr Fixed32 Pi();
+
+	private:
+		// Q30 values back to 16.16, rounded to nearest.
+		static constexpr std::int32_t FromQ30(std::int64_t aValue);
+		static constexpr std::int32_t FromDouble(double aValue);
+
+		std::int32_t m_Value = 0;
+	};
+
+	constexpr Fixed32::Fixed32(int aValue) : m_Value(static_cast<std::int32_t>(static_cast<std::uint32_t>(aValue) << FractionBits))
+	{
+		assert(aValue >= -32768 && aValue <= 32767 && "Value out of Fixed32 range");
+	}
+
+	constexpr Fixed32::Fixed32(float aValue) : Fixed32(static_cast<double>(aValue))
+	{
+
+	}
+
+	constexpr Fixed32::Fixed32(double aValue) : m_Value(FromDouble(aValue))
+	{
+
+	}
+
+	constexpr Fixed32 Fixed32::FromRaw(std::int32_t aRaw)
+	{
+		Fixed32 result;
+		result.m_Value = aRaw;
+		return result;
+	}
+
+	constexpr std::int32_t Fixed32::GetRaw() const
+	{
+		return m_Value;
+	}
+
+	constexpr Fixed32::operator float() const
+	{
+		return static_cast<float>(m_Value) / One;
+	}
+
+	constexpr Fixed32::operator double() const
+	{
+		return static_cast<double>(m_Value) / One;
+	}
+
+	constexpr Fixed32::operator int() const
+	{
+		return m_Value >> FractionBits;
+	}
+
+	constexpr Fixed32 Fixed32::operator-() const
+	{
+		return FromRaw(static_cast<std::int32_t>(0u - static_cast<std::uint32_t>(m_Value)));
+	}
+
+	constexpr Fixed32& Fixed32::operator+=(Fixed32 aOther)
+	{
+		m_Value = static_cast<std::int32_t>(static_cast<std::uint32_t>(m_Value) + static_cast<std::uint32_t>(aOther.m_Value));
+		return *this;
+	}
+
+	constexpr Fixed32& Fixed32::operator-=(Fixed32 aOther)
+	{
+		m_Value = static_cast<std::int32_t>(static_cast<std::uint32_t>(m_Value) - static_cast<std::uint32_t>(aOther.m_Value));
+		return *this;
+	}
+
+	constexpr Fixed32& Fixed32::operator*=(Fixed32 aOther)
+	{
+		m_Value = static_cast<std::int32_t>((static_cast<std::int64_t>(m_Value) * aOther.m_Value) >> FractionBits);
+		return *this;
+	}
+
+	constexpr Fixed32& Fixed32::operator/=(Fixed32 aOther)
+	{
+		assert(aOther.m_Value != 0 && "Division by 0");
+
+		const std::int64_t numerator = static_cast<std::int64_t>(m_Value) * One;
+		std::int64_t quotient = numerator / aOther.m_Value;
+		if ((numerator % aOther.m_Value != 0) && ((numerator < 0) != (aOther.m_Value < 0)))
+		{
+			quotient--;
+		}
+		m_Value = static_cast<std::int32_t>(quotient);
+		return *this;
+	}
+
+	constexpr Fixed32 Fixed32::Abs(Fixed32 aValue)
+	{
+		return aValue.m_Value < 0 ? -aValue : aValue;
+	}
+
+	constexpr Fixed32 Fixed32::Sqrt(Fixed32 aValue)
+	{
+		assert(aValue.m_Value >= 0 && "Square root of a negative value");
+
+		// Digit by digit on raw * 2^16, whose root is the raw result.
+		std::uint64_t remainder = static_cast<std::uint64_t>(aValue.m_Value) << FractionBits;
+		std::uint64_t result = 0;
+		std::uint64_t bit = std::uint64_t(1) << 62;
+		while (bit > remainder)
+		{
+			bit >>= 2;
+		}
+		while (bit != 0)
+		{
+			if (remainder >= result + bit)
+			{
+				remainder -= result + bit;
+				result = (result >> 1) + bit;
+			}
+			else
+			{
+				result >>= 1;
+			}
+			bit >>= 2;
+		}
+		if (remainder > result)
+		{
+			result++;
+		}
+		return FromRaw(static_cast<std::int32_t>(result));
+	}
+
+	constexpr std::int32_t Fixed32::FromDouble(double aValue)
+	{
+		// Halves round away from zero. The range is checked before the cast, which is undefined outside it.
+		const double scaled = aValue * One + (aValue < 0 ? -0.5 : 0.5);
+		assert(scaled > -2147483649.0 && scaled < 2147483648.0 && "Value out of Fixed32 range");
+
+		return static_cast<std::int32_t>(scaled);
+	}
+
+	constexpr std::int32_t Fixed32::FromQ30(std::int64_t aValue)
+	{
+		return static_cast<std::int32_t>((aValue + (std::int64_t(1) << 13)) >> 14);
+	}
+
+	constexpr void Fixed32::SinCos(Fixed32 aAngle, Fixed32& aSin, Fixed32& aCos)
+	{
+		constexpr std::int64_t halfPi = 1686629713;
+
+		// Reduction by pi / 2 to [-pi / 4, pi / 4), quadrant rounded toward negative infinity.
+		const std::int64_t angle = static_cast<std::int64_t>(aAngle.m_Value) << 14;
+		const std::int64_t shifted = angle + halfPi / 2;
+		std::int64_t quadrant = shifted / halfPi;
+		if (shifted % halfPi < 0)
+		{
+			quadrant--;
+		}
+		const std::int64_t reduced = angle - quadrant * halfPi;
+
+		const std::int64_t squared = (reduced * reduced) >> 30;
+		std::int64_t sine = -209544;
+		sine = 8946590 + ((squared * sine) >> 30);
+		sine = -178956841 + ((squared * sine) >> 30);
+		sine = reduced + ((((reduced * squared) >> 30) * sine) >> 30);
+		std::int64_t cosine = 26235;
+		cosine = -1491139 + ((squared * cosine) >> 30);
+		cosine = 44739220 + ((squared * cosine) >> 30);
+		cosine = (std::int64_t(1) << 30) - (squared >> 1) + ((((squared * squared) >> 30) * cosine) >> 30);
+
+		switch (quadrant & 3)
+		{
+		case 0:
+			aSin = FromRaw(FromQ30(sine));
+			aCos = FromRaw(FromQ30(cosine));
+			break;
+		case 1:
+			aSin = FromRaw(FromQ30(cosine));
+			aCos = FromRaw(FromQ30(-sine));
+			break;
+		case 2:
+			aSin = FromRaw(FromQ30(-sine));
+			aCos = FromRaw(FromQ30(-cosine));
+			break;
+		default:
+			aSin = FromRaw(FromQ30(-cosine));
+			aCos = FromRaw(FromQ30(sine));
+			break;
+		}
+	}
+
+	constexpr Fixed32 Fixed32::Sin(Fixed32 aAngle)
+	{
+		Fixed32 sine;
+		Fixed32 cosine;
+		SinCos(aAngle, sine, cosine);
+		return sine;
+	}
+
+	constexpr Fixed32 Fixed32::Cos(Fixed32 aAngle)
+	{
+		Fixed32 sine;
+		Fixed32 cosine;
+		SinCos(aAngle, sine, cosine);
+		return cosine;
+	}
+
+	constexpr Fixed32 Fixed32::Atan2(Fixed32 aY, Fixed32 aX)
+	{
+		const std::int64_t absY = aY.m_Value < 0 ? -static_cast<std::int64_t>(aY.m_Value) : aY.m_Value;
+		const std::int64_t absX = aX.m_Value < 0 ? -static_cast<std::int64_t>(aX.m_Value) : aX.m_Value;
+		const std::int64_t smaller = absX < absY ? absX : absY;
+		const std::int64_t larger = absX < absY ? absY : absX;
+		if (larger == 0)
+		{
+			return Fixed32();
+		}
+
+		// atan of a = min / max, above tan(pi / 8) shifted to atan((a - 1) / (a + 1)) + pi / 4.
+		const bool shift = (smaller << 30) > larger * 444758426;
+		const std::int64_t ratio = shift ? ((smaller - larger) << 30) / (smaller + larger) : (smaller << 30) / larger;
+		const std::int64_t squared = (ratio * ratio) >> 30;
+		std::int64_t result = 86476423;
+		result = -149010515 + ((squared * result) >> 30);
+		result = 214509035 + ((squared * result) >> 30);
+		result = -357909816 + ((squared * result) >> 30);
+		result = ratio + ((((ratio * squared) >> 30) * result) >> 30) + (shift ? 843314857 : 0);
+
+		if (absY > absX)
+		{
+			result = 1686629713 - result;
+		}
+		if (aX.m_Value < 0)
+		{
+			result = 3373259426 - result;
+		}
+		return FromRaw(FromQ30(aY.m_Value < 0 ? -result : result));
+	}
+
+	constexpr Fixed32 Fixed32::DegreeToRad(Fixed32 aDegrees)
+	{
+		// pi / 180 in 0.32 fixed point.
+		return FromRaw(static_cast<std::int32_t>((static_cast<std::int64_t>(aDegrees.m_Value) * 74961321 + (std::int64_t(1) << 31)) >> 32));
+	}
+
+	constexpr Fixed32 Fixed32::Pi()
+	{
+		return FromRaw(205887);
+	}
+}
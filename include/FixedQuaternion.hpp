@@ -0,0 +1,104 @@
+#pragma once
+#include "Fixed32.hpp"
+#include "Quaternion.hpp"
+#include "Vector3.hpp"
+
+namespace stm
+{
+	// Quaternion on Fixed32, for rotations that must come out bit identical on every machine. Same conventions as
+	// Quaternion, without the float conversions everything is integer arithmetic.
+	class FixedQuaternion
+	{
+	public:
+		constexpr FixedQuaternion();
+		~FixedQuaternion() = default;
+		constexpr FixedQuaternion(Fixed32 aR, Fixed32 aI, Fixed32 aJ, Fixed32 aK);
+		constexpr FixedQuaternion(Fixed32 aDegreeAngle, const Vector3x& aRotationAxis);
+		// Rounds every component to the nearest Fixed32.
+		explicit constexpr FixedQuaternion(const Quaternion& aQuaternion);
+		constexpr FixedQuaternion(const FixedQuaternion& aQuaternion) = default;
+
+		constexpr FixedQuaternion& operator=(const FixedQuaternion& aQuaternion) = default;
+
+		constexpr Quaternion ToQuaternion() const;
+
+		constexpr const FixedQuaternion operator*(const FixedQuaternion& aOther) const;
+		constexpr void operator*=(const FixedQuaternion& aOther);
+
+		constexpr const Vector3x Rotate(const Vector3x& aVector) const;
+
+		constexpr void Normalize();
+
+		Fixed32 r;
+		Fixed32 i;
+		Fixed32 j;
+		Fixed32 k;
+	};
+
+	constexpr bool operator==(const FixedQuaternion& aQuaternion0, const FixedQuaternion& aQuaternion1)
+	{
+		return aQuaternion0.r == aQuaternion1.r && aQuaternion0.i == aQuaternion1.i && aQuaternion0.j == aQuaternion1.j && aQuaternion0.k == aQuaternion1.k;
+	}
+
+	constexpr FixedQuaternion::FixedQuaternion() : r(1), i(0), j(0), k(0)
+	{
+
+	}
+
+	constexpr FixedQuaternion::FixedQuaternion(Fixed32 aR, Fixed32 aI, Fixed32 aJ, Fixed32 aK) : r(aR), i(aI), j(aJ), k(aK)
+	{
+
+	}
+
+	constexpr FixedQuaternion::FixedQuaternion(Fixed32 aDegreeAngle, const Vector3x& aRotationAxis)
+	{
+		Fixed32 sinus;
+		Fixed32::SinCos(Fixed32::DegreeToRad(aDegreeAngle) / Fixed32(2), sinus, r);
+		i = aRotationAxis.x * sinus;
+		j = aRotationAxis.y * sinus;
+		k = aRotationAxis.z * sinus;
+	}
+
+	constexpr FixedQuaternion::FixedQuaternion(const Quaternion& aQuaternion)
+		: r(aQuaternion.r), i(aQuaternion.i), j(aQuaternion.j), k(aQuaternion.k)
+	{
+
+	}
+
+	constexpr Quaternion FixedQuaternion::ToQuaternion() const
+	{
+		return Quaternion(static_cast<float>(r), static_cast<float>(i), static_cast<float>(j), static_cast<float>(k));
+	}
+
+	constexpr const FixedQuaternion FixedQuaternion::operator*(const FixedQuaternion& aOther) const
+	{
+		return FixedQuaternion(r * aOther.r - i * aOther.i - j * aOther.j - k * aOther.k,
+			r * aOther.i + i * aOther.r + j * aOther.k - k * aOther.j,
+			r * aOther.j - i * aOther.k + j * aOther.r + k * aOther.i,
+			r * aOther.k + i * aOther.j - j * aOther.i + k * aOther.r);
+	}
+
+	constexpr void FixedQuaternion::operator*=(const FixedQuaternion& aOther)
+	{
+		*this = *this * aOther;
+	}
+
+	constexpr const Vector3x FixedQuaternion::Rotate(const Vector3x& aVector) const
+	{
+		// v + r * t + q x t with t = 2 * q x v, fewer products than the expanded form and so less rounding.
+		const Vector3x vectorPart(i, j, k);
+		const Vector3x twiceCross = Fixed32(2) * vectorPart.Cross(aVector);
+		return aVector + r * twiceCross + vectorPart.Cross(twiceCross);
+	}
+
+	constexpr void FixedQuaternion::Normalize()
+	{
+		const Fixed32 length = Fixed32::Sqrt(r * r + i * i + j * j + k * k);
+		assert(length != 0 && "Division by 0");
+
+		r /= length;
+		i /= length;
+		j /= length;
+		k /= length;
+	}
+}
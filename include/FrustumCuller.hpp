@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "AABB3D.hpp"
+#include "Batch.hpp"
+#include "PlaneSet.hpp"
+#include "PlaneVolume.hpp"
+#include "Sphere.hpp"
+
+namespace stm
+{
+	// Culls arrays of boxes and spheres against the planes of a PlaneVolume, normals pointing out of the volume as
+	// CreateFrustum makes them. The planes are kept transposed, so Batch::Cull tests each one against 4, 8 or 16
+	// objects at once. Boxes use the corner furthest against the plane's normal and spheres their signed distance,
+	// an object is only culled when it is entirely in front of one plane. Objects just outside a corner of the
+	// frustum can therefore survive, which is fine for visibility.
+	class FrustumCuller
+	{
+	public:
+		FrustumCuller() = default;
+		explicit FrustumCuller(const PlaneVolume<float>& aVolume);
+		explicit FrustumCuller(const PlaneSet<float>& aPlanes);
+		~FrustumCuller() = default;
+
+		void SetVolume(const PlaneVolume<float>& aVolume);
+		void SetVolume(const PlaneSet<float>& aPlanes);
+		std::size_t GetPlaneCount() const;
+		// Transformed in place this moves the volume without building a new one.
+		PlaneSet<float>& GetPlanes();
+		const PlaneSet<float>& GetPlanes() const;
+
+		// Replaces the contents of aVisible with the indices of the objects that survive, in ascending order.
+		// Parallel splits the objects over threads once there are enough of them.
+		void Cull(std::span<const AABB3D<float>> aBoxes, std::vector<std::uint32_t>& aVisible, Batch::Execution aExecution = Batch::Execution::Sequential) const;
+		void Cull(std::span<const Sphere<float>> aSpheres, std::vector<std::uint32_t>& aVisible, Batch::Execution aExecution = Batch::Execution::Sequential) const;
+
+	private:
+		PlaneSet<float> m_Planes;
+	};
+}
@@ -125,11 +125,11 @@ namespace stm
 	template<>
 	inline bool Line<double>::PointIsOnLine(Vector2<double>& aPoint) const
 	{
-		float result = std::abs(Vector2<double>(-m_Direction.y, m_Direction.x).Dot(aPoint - m_Point));
+		double result = std::abs(Vector2<double>(-m_Direction.y, m_Direction.x).Dot(aPoint - m_Point));
 
 		bool isOnLine = result <= Math::ELIPSON_D && result >= -Math::ELIPSON_D;
 
-		return isOnLine,
+		return isOnLine;
 	}
 
 	template<typename T>
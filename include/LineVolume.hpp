@@ -31,7 +31,7 @@ namespace stm
 	template<typename T>
 	inline void LineVolume<T>::AddLine(const Line<T>& aLine)
 	{
-		m_Data.push_back(aLine);
+		m_Data.Add(aLine);
 	}
 
 	template<typename T>
@@ -1,22 +1,269 @@
 #pragma once
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <type_traits>
 
+#include "FastMath.hpp"
+#include "Fixed32.hpp"
+#include "Precision.hpp"
+#include "Simd.hpp"
 
 namespace stm
 {
 	struct Math
 	{
-		static constexpr float PI = 3.141592f;
+		static constexpr float PI = std::numbers::pi_v<float>;
+		static constexpr double PI_D = std::numbers::pi;
 		static constexpr float ELIPSON = 0.0001f;
 		static constexpr double ELIPSON_D = 0.0001;
 
-		static float RadToDegree(float rad);
-		static float DegreeToRad(float degree);
+		template<typename T>
+		static constexpr T RadToDegree(T aRadians);
+		template<typename T>
+		static constexpr T DegreeToRad(T aDegrees);
 
-		static float Sign(float value);
+		// -1 for negative values, 1 otherwise.
+		template<typename T>
+		static constexpr T Sign(T aValue);
 
-		static float Clamp(float value, float min, float max);
-		static float Clamp01(float value);
+		// T follows the first argument, the others convert to it so that Clamp(value, 0, 1) keeps a double a double.
+		template<typename T>
+		static constexpr T Clamp(T aValue, std::type_identity_t<T> aMin, std::type_identity_t<T> aMax);
+		template<typename T>
+		static constexpr T Clamp01(T aValue);
 
-		static float Lerp(float a, float b, float t);
+		template<typename T>
+		static constexpr T Lerp(T aFrom, std::type_identity_t<T> aTo, std::type_identity_t<T> aDelta);
+		// aValue moved from [aFromMin, aFromMax] to the same place in [aToMin, aToMax], without clamping.
+		template<typename T>
+		static constexpr T Remap(T aValue, std::type_identity_t<T> aFromMin, std::type_identity_t<T> aFromMax, std::type_identity_t<T> aToMin, std::type_identity_t<T> aToMax);
+
+		// False for zero, denormal and NaN determinants, whose reciprocal would not be a usable scale.
+		template<typename T>
+		static constexpr bool IsInvertible(T aDeterminant);
+
+		template<Precision P = Precision::Exact, typename T>
+		static T Sqrt(T value);
+		template<Precision P = Precision::Exact, typename T>
+		static T ReciprocalSqrt(T value);
+
+		// Exact calls libm, Fast and Fastest use the FastMath polynomials for float, see there for their error.
+		// Fixed32 always takes its own integer versions, whatever the precision, so the results stay deterministic.
+		template<Precision P = Precision::Exact, typename T>
+		static T Sin(T aAngle);
+		template<Precision P = Precision::Exact, typename T>
+		static T Cos(T aAngle);
+		template<Precision P = Precision::Exact, typename T>
+		static void SinCos(T aAngle, T& aSin, T& aCos);
+		template<Precision P = Precision::Exact, typename T>
+		static T Atan2(T aY, T aX);
+		template<Precision P = Precision::Exact, typename T>
+		static T Acos(T aValue);
+		template<Precision P = Precision::Exact, typename T>
+		static T Exp(T aValue);
+
+	private:
+		// One float as FastMath lanes, masks are floats with every bit set or clear.
+		struct Lanes
+		{
+			using Register = float;
+
+			static float Splat(float aValue) { return aValue; }
+			static float Add(float aA, float aB) { return aA + aB; }
+			static float Sub(float aA, float aB) { return aA - aB; }
+			static float Mul(float aA, float aB) { return aA * aB; }
+			static float Div(float aA, float aB) { return aA / aB; }
+			static float Sqrt(float aA) { return std::sqrt(aA); }
+			static float Min(float aA, float aB) { return aB < aA ? aB : aA; }
+			static float Max(float aA, float aB) { return aA < aB ? aB : aA; }
+			static float MultiplyAdd(float aA, float aB, float aC) { return aA * aB + aC; }
+			static float Round(float aA) { return std::nearbyint(aA); }
+			static float Less(float aA, float aB) { return std::bit_cast<float>(aA < aB ? ~std::uint32_t(0) : std::uint32_t(0)); }
+			static float Select(float aMask, float aA, float aB) { return std::bit_cast<std::uint32_t>(aMask) ? aA : aB; }
+			static float And(float aA, float aB) { return std::bit_cast<float>(std::bit_cast<std::uint32_t>(aA) & std::bit_cast<std::uint32_t>(aB)); }
+			static float Xor(float aA, float aB) { return std::bit_cast<float>(std::bit_cast<std::uint32_t>(aA) ^ std::bit_cast<std::uint32_t>(aB)); }
+			static float Pow2(float aA) { return std::bit_cast<float>(static_cast<std::uint32_t>(static_cast<std::int32_t>(aA) + 127) << 23); }
+		};
 	};
+
+	template<typename T>
+	constexpr bool Math::IsInvertible(T aDeterminant)
+	{
+		return aDeterminant >= std::numeric_limits<T>::min() || aDeterminant <= -std::numeric_limits<T>::min();
+	}
+
+	template<typename T>
+	constexpr T Math::RadToDegree(T aRadians)
+	{
+		static_assert(std::is_floating_point_v<T>, "Angles must be floating point");
+
+		return aRadians * (T(180) / std::numbers::pi_v<T>);
+	}
+
+	template<typename T>
+	constexpr T Math::DegreeToRad(T aDegrees)
+	{
+		if constexpr (std::is_same_v<T, Fixed32>)
+		{
+			return Fixed32::DegreeToRad(aDegrees);
+		}
+		else
+		{
+			static_assert(std::is_floating_point_v<T>, "Angles must be floating point");
+
+			return aDegrees * (std::numbers::pi_v<T> / T(180));
+		}
+	}
+
+	template<typename T>
+	constexpr T Math::Sign(T aValue)
+	{
+		return T(1) - T(2) * static_cast<T>(aValue < T(0));
+	}
+
+	template<typename T>
+	constexpr T Math::Clamp(T aValue, std::type_identity_t<T> aMin, std::type_identity_t<T> aMax)
+	{
+		// Both selects compile to min and max instructions.
+		const T lower = aValue < aMin ? aMin : aValue;
+		return aMax < lower ? aMax : lower;
+	}
+
+	template<typename T>
+	constexpr T Math::Clamp01(T aValue)
+	{
+		return Clamp(aValue, T(0), T(1));
+	}
+
+	template<typename T>
+	constexpr T Math::Lerp(T aFrom, std::type_identity_t<T> aTo, std::type_identity_t<T> aDelta)
+	{
+		return aFrom + (aTo - aFrom) * aDelta;
+	}
+
+	template<typename T>
+	constexpr T Math::Remap(T aValue, std::type_identity_t<T> aFromMin, std::type_identity_t<T> aFromMax, std::type_identity_t<T> aToMin, std::type_identity_t<T> aToMax)
+	{
+		return Lerp(aToMin, aToMax, (aValue - aFromMin) / (aFromMax - aFromMin));
+	}
+
+	template<Precision P, typename T>
+	inline T Math::Sqrt(T aValue)
+	{
+		if constexpr (std::is_same_v<T, Fixed32>)
+		{
+			return Fixed32::Sqrt(aValue);
+		}
+#ifdef STM_SIMD_SSE
+		else if constexpr (P != Precision::Exact && std::is_same_v<T, float>)
+		{
+			return Simd::GetX(Simd::Sqrt<P>(_mm_set_ss(aValue)));
+		}
+#endif
+		else
+		{
+			return std::sqrt(aValue);
+		}
+	}
+
+	template<Precision P, typename T>
+	inline T Math::ReciprocalSqrt(T aValue)
+	{
+		if constexpr (std::is_same_v<T, Fixed32>)
+		{
+			return Fixed32(1) / Fixed32::Sqrt(aValue);
+		}
+#ifdef STM_SIMD_SSE
+		else if constexpr (P != Precision::Exact && std::is_same_v<T, float>)
+		{
+			return Simd::GetX(Simd::ReciprocalSqrt<P>(_mm_set_ss(aValue)));
+		}
+#endif
+		else
+		{
+			return T(1) / std::sqrt(aValue);
+		}
+	}
+
+	template<Precision P, typename T>
+	inline T Math::Sin(T aAngle)
+	{
+		T sine;
+		T cosine;
+		SinCos<P>(aAngle, sine, cosine);
+		return sine;
+	}
+
+	template<Precision P, typename T>
+	inline T Math::Cos(T aAngle)
+	{
+		T sine;
+		T cosine;
+		SinCos<P>(aAngle, sine, cosine);
+		return cosine;
+	}
+
+	template<Precision P, typename T>
+	inline void Math::SinCos(T aAngle, T& aSin, T& aCos)
+	{
+		if constexpr (std::is_same_v<T, Fixed32>)
+		{
+			Fixed32::SinCos(aAngle, aSin, aCos);
+		}
+		else if constexpr (P != Precision::Exact && std::is_same_v<T, float>)
+		{
+			FastMath<Lanes>::template SinCos<P>(aAngle, aSin, aCos);
+		}
+		else
+		{
+			aSin = std::sin(aAngle);
+			aCos = std::cos(aAngle);
+		}
+	}
+
+	template<Precision P, typename T>
+	inline T Math::Atan2(T aY, T aX)
+	{
+		if constexpr (std::is_same_v<T, Fixed32>)
+		{
+			return Fixed32::Atan2(aY, aX);
+		}
+		else if constexpr (P != Precision::Exact && std::is_same_v<T, float>)
+		{
+			return FastMath<Lanes>::template Atan2<P>(aY, aX);
+		}
+		else
+		{
+			return std::atan2(aY, aX);
+		}
+	}
+
+	template<Precision P, typename T>
+	inline T Math::Acos(T aValue)
+	{
+		if constexpr (P != Precision::Exact && std::is_same_v<T, float>)
+		{
+			return FastMath<Lanes>::template Acos<P>(aValue);
+		}
+		else
+		{
+			return std::acos(aValue);
+		}
+	}
+
+	template<Precision P, typename T>
+	inline T Math::Exp(T aValue)
+	{
+		if constexpr (P != Precision::Exact && std::is_same_v<T, float>)
+		{
+			return FastMath<Lanes>::template Exp<P>(aValue);
+		}
+		else
+		{
+			return std::exp(aValue);
+		}
+	}
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #pragma once
+#include "Math.hpp"
 #include "Vector3.hpp"
 
 namespace stm
@@ -9,37 +10,46 @@ namespace stm
 	template<typename T>
 	class Matrix3x3
 	{
-		friend inline Vector3<T> operator*(const Vector3<T>& aVector, const Matrix3x3<T>& aMatrix);
+		template<typename U>
+		friend constexpr Vector3<U> operator*(const Vector3<U>& aVector, const Matrix3x3<U>& aMatrix);
 
 	public:
-		Matrix3x3<T>();
-		Matrix3x3<T>(const Matrix3x3<T>& aMatrix);
-		Matrix3x3<T>(const Matrix4x4<T>& aMatrix);
-
-		inline T& operator()(const int row, const int column);
-		inline const T& operator()(const int row, const int column) const;
-		inline Matrix3x3<T>& operator+=(const Matrix3x3& aOther);
-		inline Matrix3x3<T>& operator-=(const Matrix3x3& aOther);
-		inline Matrix3x3<T>& operator*=(const Matrix3x3& aOther);
-		inline bool operator==(const Matrix3x3& aOther) const;
-		inline Matrix3x3<T>& operator=(const Matrix3x3& aOther);
+		constexpr Matrix3x3();
+		constexpr Matrix3x3(const Matrix3x3<T>& aMatrix);
+		constexpr Matrix3x3(const Matrix4x4<T>& aMatrix);
 
+		constexpr T& operator()(const int row, const int column);
+		constexpr const T& operator()(const int row, const int column) const;
+		constexpr Matrix3x3<T>& operator+=(const Matrix3x3& aOther);
+		constexpr Matrix3x3<T>& operator-=(const Matrix3x3& aOther);
+		constexpr Matrix3x3<T>& operator*=(const Matrix3x3& aOther);
+		constexpr bool operator==(const Matrix3x3& aOther) const;
+		constexpr Matrix3x3<T>& operator=(const Matrix3x3& aOther);
+
+		// P picks libm or the FastMath polynomials for the one sine and cosine.
+		template<Precision P = Precision::Exact>
 		static inline Matrix3x3<T> CreateRotationAroundX(T aAngleInRadians);
+		template<Precision P = Precision::Exact>
 		static inline Matrix3x3<T> CreateRotationAroundY(T aAngleInRadians);
+		template<Precision P = Precision::Exact>
 		static inline Matrix3x3<T> CreateRotationAroundZ(T aAngleInRadians);
-		static inline Matrix3x3<T> Transpose(const Matrix3x3<T>& aMatrixToTranspose);
+		static constexpr Matrix3x3<T> Transpose(const Matrix3x3<T>& aMatrixToTranspose);
+
+		static constexpr T GetDeterminant(const Matrix3x3<T>& aMatrix);
+		// Returns false and leaves aResult untouched when aMatrix is singular.
+		static constexpr bool GetInverse(const Matrix3x3<T>& aMatrix, Matrix3x3<T>& aResult);
 	private:
 		T m_Data[9];
 	};
 
 	template<typename T>
-	Matrix3x3<T>::Matrix3x3() 
+	constexpr Matrix3x3<T>::Matrix3x3() 
 		: m_Data{ 1, 0, 0, 0, 1, 0, 0, 0, 1 }
 	{
 	}
 
 	template<typename T>
-	Matrix3x3<T>::Matrix3x3(const Matrix3x3<T>& aMatrix) 
+	constexpr Matrix3x3<T>::Matrix3x3(const Matrix3x3<T>& aMatrix) 
 		: m_Data{
 			aMatrix.m_Data[0], aMatrix.m_Data[1], aMatrix.m_Data[2],
 			aMatrix.m_Data[3], aMatrix.m_Data[4], aMatrix.m_Data[5],
@@ -50,7 +60,7 @@ namespace stm
 	}
 
 	template<typename T>
-	Matrix3x3<T>::Matrix3x3(const Matrix4x4<T>& aMatrix) 
+	constexpr Matrix3x3<T>::Matrix3x3(const Matrix4x4<T>& aMatrix) 
 		: m_Data{
 			aMatrix.m_Data[0], aMatrix.m_Data[1], aMatrix.m_Data[2],
 			aMatrix.m_Data[4], aMatrix.m_Data[5], aMatrix.m_Data[6],
@@ -61,7 +71,7 @@ namespace stm
 	}
 
 	template<typename T>
-	inline T& Matrix3x3<T>::operator()(const int aRow, const int aColumn)
+	constexpr T& Matrix3x3<T>::operator()(const int aRow, const int aColumn)
 	{
 		assert(aRow >= 0 && aRow <= 3 && "Row out of bounds");
 		assert(aColumn >= 0 && aColumn <= 3 && "Column out of bounds");
@@ -70,7 +80,7 @@ namespace stm
 	}
 
 	template<typename T>
-	inline const T& Matrix3x3<T>::operator()(const int aRow, const int aColumn) const
+	constexpr const T& Matrix3x3<T>::operator()(const int aRow, const int aColumn) const
 	{
 		assert(aRow >= 0 && aRow <= 3 && "Row out of bounds");
 		assert(aColumn >= 0 && aColumn <= 3 && "Column out of bounds");
@@ -79,7 +89,7 @@ namespace stm
 	}
 
 	template<typename T>
-	inline Matrix3x3<T>& Matrix3x3<T>::operator+=(const Matrix3x3<T>& aOther)
+	constexpr Matrix3x3<T>& Matrix3x3<T>::operator+=(const Matrix3x3<T>& aOther)
 	{
 		this->m_Data[0] += aOther.m_Data[0];
 		this->m_Data[1] += aOther.m_Data[1];
@@ -94,7 +104,7 @@ namespace stm
 	}
 
 	template<typename T>
-	inline Matrix3x3<T> operator+(const Matrix3x3<T>& aLeft, const Matrix3x3<T>& aRight)
+	constexpr Matrix3x3<T> operator+(const Matrix3x3<T>& aLeft, const Matrix3x3<T>& aRight)
 	{
 		Matrix3x3<T> matrix(aLeft);
 		matrix += aRight;
@@ -102,7 +112,7 @@ namespace stm
 	}
 
 	template<typename T>
-	inline Matrix3x3<T>& Matrix3x3<T>::operator-=(const Matrix3x3<T>& aOther)
+	constexpr Matrix3x3<T>& Matrix3x3<T>::operator-=(const Matrix3x3<T>& aOther)
 	{
 		this->m_Data[0] -= aOther.m_Data[0];
 		this->m_Data[1] -= aOther.m_Data[1];
@@ -117,7 +127,7 @@ namespace stm
 	}
 
 	template<typename T>
-	inline Matrix3x3<T> operator-(const Matrix3x3<T>& aLeft, const Matrix3x3<T>& aRight)
+	constexpr Matrix3x3<T> operator-(const Matrix3x3<T>& aLeft, const Matrix3x3<T>& aRight)
 	{
 		Matrix3x3<T> matrix(aLeft);
 		matrix -= aRight;
@@ -125,7 +135,7 @@ namespace stm
 	}
 
 	template<typename T>
-	inline Matrix3x3<T>& Matrix3x3<T>::operator*=(const Matrix3x3<T>& aOther)
+	constexpr Matrix3x3<T>& Matrix3x3<T>::operator*=(const Matrix3x3<T>& aOther)
 	{
 		T data[9];
 		data[0] = this->m_Data[0] * aOther.m_Data[0] + this->m_Data[1] * aOther.m_Data[3] + this->m_Data[2] * aOther.m_Data[6];
@@ -150,7 +160,7 @@ namespace stm
 	}
 
 	template<typename T>
-	inline Matrix3x3<T> operator*(const Matrix3x3<T>& aLeft, const Matrix3x3<T>& aRight)
+	constexpr Matrix3x3<T> operator*(const Matrix3x3<T>& aLeft, const Matrix3x3<T>& aRight)
 	{
 		Matrix3x3<T> matrix(aLeft);
 		matrix *= aRight;
@@ -158,7 +168,7 @@ namespace stm
 	}
 
 	template<typename T>
-	inline bool Matrix3x3<T>::operator==(const Matrix3x3& aOther) const
+	constexpr bool Matrix3x3<T>::operator==(const Matrix3x3& aOther) const
 	{
 		return
 			this->m_Data[0] == aOther.m_Data[0] && this->m_Data[1] == aOther.m_Data[1] && this->m_Data[2] == aOther.m_Data[2] &&
@@ -167,7 +177,7 @@ namespace stm
 	}
 
 	template<typename T>
-	inline Matrix3x3<T>& Matrix3x3<T>::operator=(const Matrix3x3& aOther)
+	constexpr Matrix3x3<T>& Matrix3x3<T>::operator=(const Matrix3x3& aOther)
 	{
 		m_Data[0] = aOther.m_Data[0];
 		m_Data[1] = aOther.m_Data[1];
@@ -182,7 +192,7 @@ namespace stm
 	}
 
 	template<typename T>
-	inline Vector3<T> operator*(const Vector3<T>& aVector, const Matrix3x3<T>& aMatrix)
+	constexpr Vector3<T> operator*(const Vector3<T>& aVector, const Matrix3x3<T>& aMatrix)
 	{
 		return Vector3<T>(
 			aVector.x * aMatrix.m_Data[0] + aVector.y * aMatrix.m_Data[3] + aVector.z * aMatrix.m_Data[6],
@@ -192,7 +202,7 @@ namespace stm
 	}
 
 	template<typename T>
-	inline Matrix3x3<T> Matrix3x3<T>::Transpose(const Matrix3x3<T>& aMatrixToTranspose)
+	constexpr Matrix3x3<T> Matrix3x3<T>::Transpose(const Matrix3x3<T>& aMatrixToTranspose)
 	{
 		Matrix3x3<T> matrix;
 		matrix(1, 1) = aMatrixToTranspose(1, 1);
@@ -210,40 +220,87 @@ namespace stm
 	}
 
 	template<typename T>
+	template<Precision P>
 	inline Matrix3x3<T> Matrix3x3<T>::CreateRotationAroundX(T aAngleInRadians)
 	{
+		T sine;
+		T cosine;
+		Math::SinCos<P>(aAngleInRadians, sine, cosine);
 		Matrix3x3<T> matrix;
 		matrix(1, 1) = 1;
-		matrix(2, 2) = std::cos(aAngleInRadians);
-		matrix(2, 3) = std::sin(aAngleInRadians);
-		matrix(3, 2) = -std::sin(aAngleInRadians);
-		matrix(3, 3) = std::cos(aAngleInRadians);
+		matrix(2, 2) = cosine;
+		matrix(2, 3) = sine;
+		matrix(3, 2) = -sine;
+		matrix(3, 3) = cosine;
 		return matrix;
 	}
 
 	template<typename T>
+	template<Precision P>
 	inline Matrix3x3<T> Matrix3x3<T>::CreateRotationAroundY(T aAngleInRadians)
 	{
+		T sine;
+		T cosine;
+		Math::SinCos<P>(aAngleInRadians, sine, cosine);
 		Matrix3x3<T> matrix;
-		matrix(1, 1) = std::cos(aAngleInRadians);
+		matrix(1, 1) = cosine;
 		matrix(2, 2) = 1;
-		matrix(3, 1) = std::sin(aAngleInRadians);
-		matrix(1, 3) = -std::sin(aAngleInRadians);
-		matrix(3, 3) = std::cos(aAngleInRadians);
+		matrix(3, 1) = sine;
+		matrix(1, 3) = -sine;
+		matrix(3, 3) = cosine;
 		return matrix;
 	}
 
 	template<typename T>
+	template<Precision P>
 	inline Matrix3x3<T> Matrix3x3<T>::CreateRotationAroundZ(T aAngleInRadians)
 	{
+		T sine;
+		T cosine;
+		Math::SinCos<P>(aAngleInRadians, sine, cosine);
 		Matrix3x3<T> matrix;
-		matrix(1, 1) = std::cos(aAngleInRadians);
-		matrix(1, 2) = std::sin(aAngleInRadians);
-		matrix(2, 1) = -std::sin(aAngleInRadians);
-		matrix(2, 2) = std::cos(aAngleInRadians);
+		matrix(1, 1) = cosine;
+		matrix(1, 2) = sine;
+		matrix(2, 1) = -sine;
+		matrix(2, 2) = cosine;
 		matrix(3, 3) = 1;
 		return matrix;
 	}
 
+	template<typename T>
+	constexpr T Matrix3x3<T>::GetDeterminant(const Matrix3x3<T>& aMatrix)
+	{
+		const T* m = aMatrix.m_Data;
+		return m[0] * (m[4] * m[8] - m[5] * m[7]) - m[1] * (m[3] * m[8] - m[5] * m[6]) + m[2] * (m[3] * m[7] - m[4] * m[6]);
+	}
+
+	template<typename T>
+	constexpr bool Matrix3x3<T>::GetInverse(const Matrix3x3<T>& aMatrix, Matrix3x3<T>& aResult)
+	{
+		const T* m = aMatrix.m_Data;
+		const T cofactor0 = m[4] * m[8] - m[5] * m[7];
+		const T cofactor1 = m[5] * m[6] - m[3] * m[8];
+		const T cofactor2 = m[3] * m[7] - m[4] * m[6];
+
+		const T determinant = m[0] * cofactor0 + m[1] * cofactor1 + m[2] * cofactor2;
+		if (!Math::IsInvertible(determinant))
+		{
+			return false;
+		}
+
+		// Every element is computed before aResult is written, so aResult may be aMatrix.
+		const T scale = 1 / determinant;
+		const T inverse[9] = {
+			cofactor0 * scale, (m[2] * m[7] - m[1] * m[8]) * scale, (m[1] * m[5] - m[2] * m[4]) * scale,
+			cofactor1 * scale, (m[0] * m[8] - m[2] * m[6]) * scale, (m[2] * m[3] - m[0] * m[5]) * scale,
+			cofactor2 * scale, (m[1] * m[6] - m[0] * m[7]) * scale, (m[0] * m[4] - m[1] * m[3]) * scale
+		};
+		for (int index = 0; index < 9; index++)
+		{
+			aResult.m_Data[index] = inverse[index];
+		}
+		return true;
+	}
+
 	using Matrix3x3f = Matrix3x3<float>;
 }
\ No newline at end of file
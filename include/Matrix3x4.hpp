@@ -0,0 +1,305 @@
+#pragma once
+#include <cassert>
+#include <type_traits>
+
+#include "Math.hpp"
+#include "Vector3.hpp"
+#include "Matrix3x3.hpp"
+#include "Matrix4x4.hpp"
+#include "Simd.hpp"
+
+namespace stm
+{
+	// Affine Matrix4x4 without its constant (0, 0, 0, 1) column, 12 elements instead of 16.
+	// Stored transposed so every row produces one output axis: row 1 is (m11, m21, m31, m41) of the Matrix4x4,
+	// row 4 of which holds the translation. Products keep the Matrix4x4 order, aLeft * aRight applies aLeft first.
+	template<typename T>
+	class Matrix3x4
+	{
+		template<typename U>
+		friend constexpr Matrix3x4<U> operator*(const Matrix3x4<U>& aLeft, const Matrix3x4<U>& aRight);
+
+	public:
+		constexpr Vector3<T> GetRight() const;
+		constexpr Vector3<T> GetUp() const;
+		constexpr Vector3<T> GetForward() const;
+		constexpr Vector3<T> GetTranslation() const;
+
+	public:
+		constexpr Matrix3x4();
+		constexpr Matrix3x4(const Matrix3x4<T>& aMatrix) = default;
+		constexpr Matrix3x4(T a11, T a12, T a13, T a14, T a21, T a22, T a23, T a24, T a31, T a32, T a33, T a34);
+		// Drops the last column, which is assumed to be (0, 0, 0, 1).
+		explicit constexpr Matrix3x4(const Matrix4x4<T>& aMatrix);
+
+		constexpr Matrix4x4<T> ToMatrix4x4() const;
+
+		constexpr T& operator()(const int row, const int column);
+		constexpr const T& operator()(const int row, const int column) const;
+		constexpr T* GetData();
+		constexpr const T* GetData() const;
+		constexpr Matrix3x4<T>& operator*=(const Matrix3x4& aOther);
+		constexpr bool operator==(const Matrix3x4& aOther) const;
+		constexpr Matrix3x4<T>& operator=(const Matrix3x4& aOther) = default;
+
+		constexpr Vector3<T> TransformPoint(const Vector3<T>& aPoint) const;
+		constexpr Vector3<T> TransformDirection(const Vector3<T>& aDirection) const;
+
+		static constexpr T GetDeterminant(const Matrix3x4<T>& aMatrix);
+		// Returns false and leaves aResult untouched when the matrix is singular, aResult may be the input.
+		static constexpr bool GetInverse(const Matrix3x4<T>& aMatrix, Matrix3x4<T>& aResult);
+		static constexpr Matrix3x4<T> GetIdentity();
+
+	private:
+		alignas(4 * sizeof(T)) T m_Data[12];
+	};
+
+	template<typename T>
+	constexpr Matrix3x4<T>::Matrix3x4()
+		: m_Data
+	{
+		1,0,0,0,
+		0,1,0,0,
+		0,0,1,0
+	}
+	{
+	}
+
+	template<typename T>
+	constexpr Matrix3x4<T>::Matrix3x4(T a11, T a12, T a13, T a14, T a21, T a22, T a23, T a24, T a31, T a32, T a33, T a34)
+		: m_Data{
+		a11, a12, a13, a14,
+		a21, a22, a23, a24,
+		a31, a32, a33, a34
+	}
+	{
+	}
+
+	template<typename T>
+	constexpr Matrix3x4<T>::Matrix3x4(const Matrix4x4<T>& aMatrix)
+		: m_Data{
+		aMatrix(1, 1), aMatrix(2, 1), aMatrix(3, 1), aMatrix(4, 1),
+		aMatrix(1, 2), aMatrix(2, 2), aMatrix(3, 2), aMatrix(4, 2),
+		aMatrix(1, 3), aMatrix(2, 3), aMatrix(3, 3), aMatrix(4, 3)
+	}
+	{
+	}
+
+	template<typename T>
+	constexpr Matrix4x4<T> Matrix3x4<T>::ToMatrix4x4() const
+	{
+		return Matrix4x4<T>(
+			m_Data[0], m_Data[4], m_Data[8], 0,
+			m_Data[1], m_Data[5], m_Data[9], 0,
+			m_Data[2], m_Data[6], m_Data[10], 0,
+			m_Data[3], m_Data[7], m_Data[11], 1
+		);
+	}
+
+	template<typename T>
+	constexpr T& Matrix3x4<T>::operator()(const int aRow, const int aColumn)
+	{
+		assert(aRow >= 1 && aRow <= 3 && "Row out of bounds");
+		assert(aColumn >= 1 && aColumn <= 4 && "Column out of bounds");
+
+		return m_Data[(aRow - 1) * 4 + (aColumn - 1)];
+	}
+
+	template<typename T>
+	constexpr const T& Matrix3x4<T>::operator()(const int aRow, const int aColumn) const
+	{
+		assert(aRow >= 1 && aRow <= 3 && "Row out of bounds");
+		assert(aColumn >= 1 && aColumn <= 4 && "Column out of bounds");
+
+		return m_Data[(aRow - 1) * 4 + (aColumn - 1)];
+	}
+
+	template<typename T>
+	constexpr T* Matrix3x4<T>::GetData()
+	{
+		return m_Data;
+	}
+
+	template<typename T>
+	constexpr const T* Matrix3x4<T>::GetData() const
+	{
+		return m_Data;
+	}
+
+	// Each result row is the left rows weighted by the right row, the right translation lands in the w lane.
+	template<typename T>
+	constexpr Matrix3x4<T> operator*(const Matrix3x4<T>& aLeft, const Matrix3x4<T>& aRight)
+	{
+		Matrix3x4<T> result;
+#ifdef STM_SIMD_SSE
+		if (!std::is_constant_evaluated())
+		{
+			if constexpr (std::is_same_v<T, float>)
+			{
+				const __m128 left0 = _mm_load_ps(aLeft.m_Data);
+				const __m128 left1 = _mm_load_ps(aLeft.m_Data + 4);
+				const __m128 left2 = _mm_load_ps(aLeft.m_Data + 8);
+				const __m128 translationMask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+				for (int row = 0; row < 12; row += 4)
+				{
+					const __m128 right = _mm_load_ps(aRight.m_Data + row);
+					__m128 sum = _mm_and_ps(right, translationMask);
+					sum = Simd::MultiplyAdd(_mm_shuffle_ps(right, right, _MM_SHUFFLE(0, 0, 0, 0)), left0, sum);
+					sum = Simd::MultiplyAdd(_mm_shuffle_ps(right, right, _MM_SHUFFLE(1, 1, 1, 1)), left1, sum);
+					sum = Simd::MultiplyAdd(_mm_shuffle_ps(right, right, _MM_SHUFFLE(2, 2, 2, 2)), left2, sum);
+					_mm_store_ps(result.m_Data + row, sum);
+				}
+				return result;
+			}
+		}
+#endif
+		for (int row = 0; row < 12; row += 4)
+		{
+			for (int column = 0; column < 4; column++)
+			{
+				result.m_Data[row + column] =
+					aRight.m_Data[row] * aLeft.m_Data[column] +
+					aRight.m_Data[row + 1] * aLeft.m_Data[4 + column] +
+					aRight.m_Data[row + 2] * aLeft.m_Data[8 + column];
+			}
+			result.m_Data[row + 3] += aRight.m_Data[row + 3];
+		}
+		return result;
+	}
+
+	template<typename T>
+	constexpr Matrix3x4<T>& Matrix3x4<T>::operator*=(const Matrix3x4<T>& aOther)
+	{
+		return (*this) = (*this) * aOther;
+	}
+
+	template<typename T>
+	constexpr bool Matrix3x4<T>::operator==(const Matrix3x4& aOther) const
+	{
+		return
+			this->m_Data[0] == aOther.m_Data[0] && this->m_Data[1] == aOther.m_Data[1] && this->m_Data[2] == aOther.m_Data[2] && this->m_Data[3] == aOther.m_Data[3] &&
+			this->m_Data[4] == aOther.m_Data[4] && this->m_Data[5] == aOther.m_Data[5] && this->m_Data[6] == aOther.m_Data[6] && this->m_Data[7] == aOther.m_Data[7] &&
+			this->m_Data[8] == aOther.m_Data[8] && this->m_Data[9] == aOther.m_Data[9] && this->m_Data[10] == aOther.m_Data[10] && this->m_Data[11] == aOther.m_Data[11];
+	}
+
+	template<typename T>
+	constexpr Vector3<T> Matrix3x4<T>::TransformPoint(const Vector3<T>& aPoint) const
+	{
+#ifdef STM_SIMD_SSE
+		if (!std::is_constant_evaluated())
+		{
+			if constexpr (std::is_same_v<T, float>)
+			{
+				// The three row products are transposed so summing the registers gives (x, y, z, 0).
+				const __m128 point = _mm_or_ps(
+					_mm_and_ps(aPoint.Load(), _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0))),
+					_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+				__m128 x = _mm_mul_ps(_mm_load_ps(m_Data), point);
+				__m128 y = _mm_mul_ps(_mm_load_ps(m_Data + 4), point);
+				__m128 z = _mm_mul_ps(_mm_load_ps(m_Data + 8), point);
+				__m128 w = _mm_setzero_ps();
+				_MM_TRANSPOSE4_PS(x, y, z, w);
+				return Vector3<T>(_mm_add_ps(_mm_add_ps(x, y), _mm_add_ps(z, w)));
+			}
+		}
+#endif
+		return Vector3<T>(
+			aPoint.x * m_Data[0] + aPoint.y * m_Data[1] + aPoint.z * m_Data[2] + m_Data[3],
+			aPoint.x * m_Data[4] + aPoint.y * m_Data[5] + aPoint.z * m_Data[6] + m_Data[7],
+			aPoint.x * m_Data[8] + aPoint.y * m_Data[9] + aPoint.z * m_Data[10] + m_Data[11]
+		);
+	}
+
+	template<typename T>
+	constexpr Vector3<T> Matrix3x4<T>::TransformDirection(const Vector3<T>& aDirection) const
+	{
+		return Vector3<T>(
+			aDirection.x * m_Data[0] + aDirection.y * m_Data[1] + aDirection.z * m_Data[2],
+			aDirection.x * m_Data[4] + aDirection.y * m_Data[5] + aDirection.z * m_Data[6],
+			aDirection.x * m_Data[8] + aDirection.y * m_Data[9] + aDirection.z * m_Data[10]
+		);
+	}
+
+	// Points get the translation, like Vector3 * Transform.
+	template<typename T>
+	constexpr Vector3<T> operator*(const Vector3<T>& aPoint, const Matrix3x4<T>& aMatrix)
+	{
+		return aMatrix.TransformPoint(aPoint);
+	}
+
+	template<typename T>
+	constexpr T Matrix3x4<T>::GetDeterminant(const Matrix3x4<T>& aMatrix)
+	{
+		const T* m = aMatrix.m_Data;
+		return m[0] * (m[5] * m[10] - m[6] * m[9])
+			- m[1] * (m[4] * m[10] - m[6] * m[8])
+			+ m[2] * (m[4] * m[9] - m[5] * m[8]);
+	}
+
+	template<typename T>
+	constexpr bool Matrix3x4<T>::GetInverse(const Matrix3x4<T>& aMatrix, Matrix3x4<T>& aResult)
+	{
+		const T* m = aMatrix.m_Data;
+		Matrix3x3<T> rotationScale;
+		rotationScale(1, 1) = m[0];
+		rotationScale(1, 2) = m[1];
+		rotationScale(1, 3) = m[2];
+		rotationScale(2, 1) = m[4];
+		rotationScale(2, 2) = m[5];
+		rotationScale(2, 3) = m[6];
+		rotationScale(3, 1) = m[8];
+		rotationScale(3, 2) = m[9];
+		rotationScale(3, 3) = m[10];
+		if (!Matrix3x3<T>::GetInverse(rotationScale, rotationScale))
+		{
+			return false;
+		}
+
+		// The inverse translation is -(R^-1 t), one dot product per row in this layout.
+		const T x = m[3];
+		const T y = m[7];
+		const T z = m[11];
+		aResult = Matrix3x4<T>(
+			rotationScale(1, 1), rotationScale(1, 2), rotationScale(1, 3), -(rotationScale(1, 1) * x + rotationScale(1, 2) * y + rotationScale(1, 3) * z),
+			rotationScale(2, 1), rotationScale(2, 2), rotationScale(2, 3), -(rotationScale(2, 1) * x + rotationScale(2, 2) * y + rotationScale(2, 3) * z),
+			rotationScale(3, 1), rotationScale(3, 2), rotationScale(3, 3), -(rotationScale(3, 1) * x + rotationScale(3, 2) * y + rotationScale(3, 3) * z)
+		);
+		return true;
+	}
+
+	template<typename T>
+	constexpr Matrix3x4<T> Matrix3x4<T>::GetIdentity()
+	{
+		return Matrix3x4<T>(
+			1, 0, 0, 0,
+			0, 1, 0, 0,
+			0, 0, 1, 0
+		);
+	}
+
+	template<typename T>
+	constexpr Vector3<T> Matrix3x4<T>::GetRight() const
+	{
+		return Vector3<T>(m_Data[0], m_Data[4], m_Data[8]);
+	}
+
+	template<typename T>
+	constexpr Vector3<T> Matrix3x4<T>::GetUp() const
+	{
+		return Vector3<T>(m_Data[1], m_Data[5], m_Data[9]);
+	}
+
+	template<typename T>
+	constexpr Vector3<T> Matrix3x4<T>::GetForward() const
+	{
+		return Vector3<T>(m_Data[2], m_Data[6], m_Data[10]);
+	}
+
+	template<typename T>
+	constexpr Vector3<T> Matrix3x4<T>::GetTranslation() const
+	{
+		return Vector3<T>(m_Data[3], m_Data[7], m_Data[11]);
+	}
+
+	using Matrix3x4f = Matrix3x4<float>;
+}
@@ -1,54 +1,83 @@
 #pragma once
 #include <cassert>
+#include <type_traits>
 
+#include "Math.hpp"
 #include "Vector4.hpp"
 #include "Vector3.hpp"
 #include "Matrix3x3.hpp"
+#include "Simd.hpp"
 
 namespace stm
 {
 	template<typename T>
 	class Matrix4x4
 	{
-		friend Matrix3x3<T>::Matrix3x3(const Matrix4x4<T>& aMatrix);
-		friend inline Vector4<T> operator*(const Vector4<T>& aVector, const Matrix4x4<T>& aMatrix);
-		friend inline Matrix4x4<T> operator*(const Matrix4x4<T>& aLeft, const Matrix4x4<T>& aRight);
+		friend constexpr Matrix3x3<T>::Matrix3x3(const Matrix4x4<T>& aMatrix);
+		template<typename U>
+		friend constexpr Vector4<U> operator*(const Vector4<U>& aVector, const Matrix4x4<U>& aMatrix);
+		template<typename U>
+		friend constexpr Matrix4x4<U> operator*(const Matrix4x4<U>& aLeft, const Matrix4x4<U>& aRight);
 
 	public:
-		const Vector3<T> GetRight() const;
-		const Vector3<T> GetUp() const;
-		const Vector3<T> GetForward() const;
-		const Vector3<T> GetTranslation() const;
+		constexpr Vector3<T> GetRight() const;
+		constexpr Vector3<T> GetUp() const;
+		constexpr Vector3<T> GetForward() const;
+		constexpr Vector3<T> GetTranslation() const;
 
 	public:
-		Matrix4x4<T>();
-		Matrix4x4<T>(const Matrix4x4<T>& aMatrix);
-		Matrix4x4<T>(T a11, T a12, T a13, T a14, T a21, T a22, T a23, T a24, T a31, T a32, T a33, T a34, T a41, T a42, T a43, T a44);
-
-		inline T& operator()(const int row, const int column);
-		inline const T& operator()(const int row, const int column) const;
-		inline Matrix4x4<T>& operator+=(const Matrix4x4& aOther);
-		inline Matrix4x4<T>& operator-=(const Matrix4x4& aOther);
-		inline Matrix4x4<T>& operator*=(const Matrix4x4& aOther);
-		inline bool operator==(const Matrix4x4& aOther) const;
-		inline Matrix4x4<T>& operator=(const Matrix4x4& aOther);
+		constexpr Matrix4x4();
+		constexpr Matrix4x4(const Matrix4x4<T>& aMatrix) = default;
+		constexpr Matrix4x4(T a11, T a12, T a13, T a14, T a21, T a22, T a23, T a24, T a31, T a32, T a33, T a34, T a41, T a42, T a43, T a44);
+
+		constexpr T& operator()(const int row, const int column);
+		constexpr const T& operator()(const int row, const int column) const;
+		constexpr T* GetData();
+		constexpr const T* GetData() const;
+		constexpr Matrix4x4<T>& operator+=(const Matrix4x4& aOther);
+		constexpr Matrix4x4<T>& operator-=(const Matrix4x4& aOther);
+		constexpr Matrix4x4<T>& operator*=(const Matrix4x4& aOther);
+		constexpr bool operator==(const Matrix4x4& aOther) const;
+		constexpr Matrix4x4<T>& operator=(const Matrix4x4& aOther) = default;
 
 		void ConstructOrientation(const Vector4<T>& aBasise0, const Vector4<T>& aBasise1, const Vector4<T>& aBasise2);
+		// P picks libm or the FastMath polynomials for the one sine and cosine.
+		template<Precision P = Precision::Exact>
 		static inline Matrix4x4<T> CreateRotationAroundX(T aAngleInRadians);
+		template<Precision P = Precision::Exact>
 		static inline Matrix4x4<T> CreateRotationAroundY(T aAngleInRadians);
+		template<Precision P = Precision::Exact>
 		static inline Matrix4x4<T> CreateRotationAroundZ(T aAngleInRadians);
-		static inline Matrix4x4<T> Transpose(const Matrix4x4<T>& aMatrixToTranspose);
 
-		static Matrix4x4<T> GetFastInverse(const Matrix4x4<T>& aTransform);
-		static Matrix4x4<T> GetIdentity();
+		// Left handed like Transform (+z forward) with depth in [0, 1], the ReversedZ variants map near to 1 and far to 0
+		// which spreads float depth precision evenly. Infinite variants put the far plane at infinity.
+		static inline Matrix4x4<T> CreatePerspective(T aFieldOfViewInRadians, T aAspectRatio, T aNear, T aFar);
+		static inline Matrix4x4<T> CreatePerspectiveReversedZ(T aFieldOfViewInRadians, T aAspectRatio, T aNear, T aFar);
+		static inline Matrix4x4<T> CreatePerspectiveInfinite(T aFieldOfViewInRadians, T aAspectRatio, T aNear);
+		static inline Matrix4x4<T> CreatePerspectiveInfiniteReversedZ(T aFieldOfViewInRadians, T aAspectRatio, T aNear);
+		static constexpr Matrix4x4<T> CreateOrthographic(T aWidth, T aHeight, T aNear, T aFar);
+		static constexpr Matrix4x4<T> CreateOrthographicReversedZ(T aWidth, T aHeight, T aNear, T aFar);
+		// View matrix of a camera at aEye looking at aTarget, the inverse of its world transform.
+		static inline Matrix4x4<T> CreateLookAt(const Vector3<T>& aEye, const Vector3<T>& aTarget, const Vector3<T>& aUp);
+
+		static constexpr Matrix4x4<T> Transpose(const Matrix4x4<T>& aMatrixToTranspose);
+
+		static constexpr Matrix4x4<T> GetFastInverse(const Matrix4x4<T>& aTransform);
+		static constexpr T GetDeterminant(const Matrix4x4<T>& aMatrix);
+		// Both return false and leave aResult untouched when the matrix is singular, aResult may be the input.
+		static constexpr bool GetInverse(const Matrix4x4<T>& aMatrix, Matrix4x4<T>& aResult);
+		// For matrices whose last column is (0, 0, 0, 1), unlike GetFastInverse it handles scale and shear.
+		static constexpr bool GetInverseAffine(const Matrix4x4<T>& aTransform, Matrix4x4<T>& aResult);
+		static constexpr Matrix4x4<T> GetIdentity();
 
 		void RotateAroundX(T anAmount);
 	private:
-		T m_Data[16];
+		// One row per SSE register for float, per AVX register for double.
+		alignas(4 * sizeof(T)) T m_Data[16];
 	};
 
 	template<typename T>
-	Matrix4x4<T>::Matrix4x4() 
+	constexpr Matrix4x4<T>::Matrix4x4() 
 		: m_Data
 	{
 		1,0,0,0,
@@ -60,30 +89,7 @@ namespace stm
 	}
 
 	template<typename T>
-	Matrix4x4<T>::Matrix4x4(const Matrix4x4<T>& aMatrix) 
-		: m_Data {
-		aMatrix.m_Data[0],
-		aMatrix.m_Data[1],
-		aMatrix.m_Data[2],
-		aMatrix.m_Data[3],
-		aMatrix.m_Data[4],
-		aMatrix.m_Data[5],
-		aMatrix.m_Data[6],
-		aMatrix.m_Data[7],
-		aMatrix.m_Data[8],
-		aMatrix.m_Data[9],
-		aMatrix.m_Data[10],
-		aMatrix.m_Data[11],
-		aMatrix.m_Data[12],
-		aMatrix.m_Data[13],
-		aMatrix.m_Data[14],
-		aMatrix.m_Data[15]
-	}
-	{
-	}
-
-	template<typename T>
-	Matrix4x4<T>::Matrix4x4(T a11, T a12, T a13, T a14, T a21, T a22, T a23, T a24, T a31, T a32, T a33, T a34, T a41, T a42, T a43, T a44) 
+	constexpr Matrix4x4<T>::Matrix4x4(T a11, T a12, T a13, T a14, T a21, T a22, T a23, T a24, T a31, T a32, T a33, T a34, T a41, T a42, T a43, T a44) 
 		: m_Data{
 		a11,
 		a12,
@@ -106,7 +112,7 @@ namespace stm
 	}
 
 	template<typename T>
-	inline T& Matrix4x4<T>::operator()(const int aRow, const int aColumn)
+	constexpr T& Matrix4x4<T>::operator()(const int aRow, const int aColumn)
 	{
 		assert(aRow >= 0 && aRow <= 4 && "Row out of bounds");
 		assert(aColumn >= 0 && aColumn <= 4 && "Column out of bounds");
@@ -115,7 +121,7 @@ namespace stm
 	}
 
 	template<typename T>
-	inline const T& Matrix4x4<T>::operator()(const int aRow, const int aColumn) const
+	constexpr const T& Matrix4x4<T>::operator()(const int aRow, const int aColumn) const
 	{
 		assert(aRow >= 0 && aRow <= 4 && "Row out of bounds");
 		assert(aColumn >= 0 && aColumn <= 4 && "Column out of bounds");
@@ -124,29 +130,50 @@ namespace stm
 	}
 
 	template<typename T>
-	inline Matrix4x4<T>& Matrix4x4<T>::operator+=(const Matrix4x4<T>& aOther)
-	{
-		this->m_Data[0] += aOther.m_Data[0];
-		this->m_Data[1] += aOther.m_Data[1];
-		this->m_Data[2] += aOther.m_Data[2];
-		this->m_Data[3] += aOther.m_Data[3];
-		this->m_Data[4] += aOther.m_Data[4];
-		this->m_Data[5] += aOther.m_Data[5];
-		this->m_Data[6] += aOther.m_Data[6];
-		this->m_Data[7] += aOther.m_Data[7];
-		this->m_Data[8] += aOther.m_Data[8];
-		this->m_Data[9] += aOther.m_Data[9];
-		this->m_Data[10] += aOther.m_Data[10];
-		this->m_Data[11] += aOther.m_Data[11];
-		this->m_Data[12] += aOther.m_Data[12];
-		this->m_Data[13] += aOther.m_Data[13];
-		this->m_Data[14] += aOther.m_Data[14];
-		this->m_Data[15] += aOther.m_Data[15];
+	constexpr T* Matrix4x4<T>::GetData()
+	{
+		return m_Data;
+	}
+
+	template<typename T>
+	constexpr const T* Matrix4x4<T>::GetData() const
+	{
+		return m_Data;
+	}
+
+	template<typename T>
+	constexpr Matrix4x4<T>& Matrix4x4<T>::operator+=(const Matrix4x4<T>& aOther)
+	{
+#ifdef STM_SIMD_SSE
+		if (!std::is_constant_evaluated())
+		{
+			if constexpr (std::is_same_v<T, float>)
+			{
+				for (int index = 0; index < 16; index += 4)
+				{
+					_mm_store_ps(m_Data + index, _mm_add_ps(_mm_load_ps(m_Data + index), _mm_load_ps(aOther.m_Data + index)));
+				}
+				return *this;
+			}
+			else if constexpr (std::is_same_v<T, double>)
+			{
+				for (int index = 0; index < 16; index += 2)
+				{
+					_mm_store_pd(m_Data + index, _mm_add_pd(_mm_load_pd(m_Data + index), _mm_load_pd(aOther.m_Data + index)));
+				}
+				return *this;
+			}
+		}
+#endif
+		for (int index = 0; index < 16; index++)
+		{
+			m_Data[index] += aOther.m_Data[index];
+		}
 		return *this;
 	}
 
 	template<typename T>
-	inline Matrix4x4<T> operator+(const Matrix4x4<T>& aLeft, const Matrix4x4<T>& aRight)
+	constexpr Matrix4x4<T> operator+(const Matrix4x4<T>& aLeft, const Matrix4x4<T>& aRight)
 	{
 		Matrix4x4<T> matrix(aLeft);
 		matrix += aRight;
@@ -154,75 +181,113 @@ namespace stm
 	}
 
 	template<typename T>
-	inline Matrix4x4<T>& Matrix4x4<T>::operator-=(const Matrix4x4<T>& aOther)
-	{
-		this->m_Data[0] -= aOther.m_Data[0];
-		this->m_Data[1] -= aOther.m_Data[1];
-		this->m_Data[2] -= aOther.m_Data[2];
-		this->m_Data[3] -= aOther.m_Data[3];
-		this->m_Data[4] -= aOther.m_Data[4];
-		this->m_Data[5] -= aOther.m_Data[5];
-		this->m_Data[6] -= aOther.m_Data[6];
-		this->m_Data[7] -= aOther.m_Data[7];
-		this->m_Data[8] -= aOther.m_Data[8];
-		this->m_Data[9] -= aOther.m_Data[9];
-		this->m_Data[10] -= aOther.m_Data[10];
-		this->m_Data[11] -= aOther.m_Data[11];
-		this->m_Data[12] -= aOther.m_Data[12];
-		this->m_Data[13] -= aOther.m_Data[13];
-		this->m_Data[14] -= aOther.m_Data[14];
-		this->m_Data[15] -= aOther.m_Data[15];
+	constexpr Matrix4x4<T>& Matrix4x4<T>::operator-=(const Matrix4x4<T>& aOther)
+	{
+#ifdef STM_SIMD_SSE
+		if (!std::is_constant_evaluated())
+		{
+			if constexpr (std::is_same_v<T, float>)
+			{
+				for (int index = 0; index < 16; index += 4)
+				{
+					_mm_store_ps(m_Data + index, _mm_sub_ps(_mm_load_ps(m_Data + index), _mm_load_ps(aOther.m_Data + index)));
+				}
+				return *this;
+			}
+			else if constexpr (std::is_same_v<T, double>)
+			{
+				for (int index = 0; index < 16; index += 2)
+				{
+					_mm_store_pd(m_Data + index, _mm_sub_pd(_mm_load_pd(m_Data + index), _mm_load_pd(aOther.m_Data + index)));
+				}
+				return *this;
+			}
+		}
+#endif
+		for (int index = 0; index < 16; index++)
+		{
+			m_Data[index] -= aOther.m_Data[index];
+		}
 		return *this;
 	}
 
 	template<typename T>
-	inline Matrix4x4<T> operator-(const Matrix4x4<T>& aLeft, const Matrix4x4<T>& aRight)
+	constexpr Matrix4x4<T> operator-(const Matrix4x4<T>& aLeft, const Matrix4x4<T>& aRight)
 	{
 		Matrix4x4<T> matrix(aLeft);
 		matrix -= aRight;
 		return matrix;
 	}
 
+	// Each result row is the sum of the right rows scaled by the broadcast elements of the left row.
 	template<typename T>
-	inline Matrix4x4<T> operator*(const Matrix4x4<T>& aLeft, const Matrix4x4<T>& aRight)
+	constexpr Matrix4x4<T> operator*(const Matrix4x4<T>& aLeft, const Matrix4x4<T>& aRight)
 	{
-#define LEFT aLeft.m_Data
-#define RIGHT aRight.m_Data
-
-		return Matrix4x4<T>(
-			LEFT[0] * RIGHT[0] + LEFT[1] * RIGHT[4] + LEFT[2] * RIGHT[8] + LEFT[3] * RIGHT[12],
-			LEFT[0] * RIGHT[1] + LEFT[1] * RIGHT[5] + LEFT[2] * RIGHT[9] + LEFT[3] * RIGHT[13],
-			LEFT[0] * RIGHT[2] + LEFT[1] * RIGHT[6] + LEFT[2] * RIGHT[10] + LEFT[3] * RIGHT[14],
-			LEFT[0] * RIGHT[3] + LEFT[1] * RIGHT[7] + LEFT[2] * RIGHT[11] + LEFT[3] * RIGHT[15],
-
-			LEFT[4] * RIGHT[0] + LEFT[5] * RIGHT[4] + LEFT[6] * RIGHT[8] + LEFT[7] * RIGHT[12],
-			LEFT[4] * RIGHT[1] + LEFT[5] * RIGHT[5] + LEFT[6] * RIGHT[9] + LEFT[7] * RIGHT[13],
-			LEFT[4] * RIGHT[2] + LEFT[5] * RIGHT[6] + LEFT[6] * RIGHT[10] + LEFT[7] * RIGHT[14],
-			LEFT[4] * RIGHT[3] + LEFT[5] * RIGHT[7] + LEFT[6] * RIGHT[11] + LEFT[7] * RIGHT[15],
-
-			LEFT[8] * RIGHT[0] + LEFT[9] * RIGHT[4] + LEFT[10] * RIGHT[8] + LEFT[11] * RIGHT[12],
-			LEFT[8] * RIGHT[1] + LEFT[9] * RIGHT[5] + LEFT[10] * RIGHT[9] + LEFT[11] * RIGHT[13],
-			LEFT[8] * RIGHT[2] + LEFT[9] * RIGHT[6] + LEFT[10] * RIGHT[10] + LEFT[11] * RIGHT[14],
-			LEFT[8] * RIGHT[3] + LEFT[9] * RIGHT[7] + LEFT[10] * RIGHT[11] + LEFT[11] * RIGHT[15],
-
-			LEFT[12] * RIGHT[0] + LEFT[13] * RIGHT[4] + LEFT[14] * RIGHT[8] + LEFT[15] * RIGHT[12],
-			LEFT[12] * RIGHT[1] + LEFT[13] * RIGHT[5] + LEFT[14] * RIGHT[9] + LEFT[15] * RIGHT[13],
-			LEFT[12] * RIGHT[2] + LEFT[13] * RIGHT[6] + LEFT[14] * RIGHT[10] + LEFT[15] * RIGHT[14],
-			LEFT[12] * RIGHT[3] + LEFT[13] * RIGHT[7] + LEFT[14] * RIGHT[11] + LEFT[15] * RIGHT[15]
-		);
-#undef LEFT
-#undef RIGHT
+		Matrix4x4<T> result;
+#ifdef STM_SIMD_SSE
+		if (!std::is_constant_evaluated())
+		{
+			if constexpr (std::is_same_v<T, float>)
+			{
+				const __m128 right0 = _mm_load_ps(aRight.m_Data);
+				const __m128 right1 = _mm_load_ps(aRight.m_Data + 4);
+				const __m128 right2 = _mm_load_ps(aRight.m_Data + 8);
+				const __m128 right3 = _mm_load_ps(aRight.m_Data + 12);
+				for (int row = 0; row < 16; row += 4)
+				{
+					__m128 sum = _mm_mul_ps(Simd::Splat(aLeft.m_Data[row]), right0);
+					sum = Simd::MultiplyAdd(Simd::Splat(aLeft.m_Data[row + 1]), right1, sum);
+					sum = Simd::MultiplyAdd(Simd::Splat(aLeft.m_Data[row + 2]), right2, sum);
+					sum = Simd::MultiplyAdd(Simd::Splat(aLeft.m_Data[row + 3]), right3, sum);
+					_mm_store_ps(result.m_Data + row, sum);
+				}
+				return result;
+			}
+			else if constexpr (std::is_same_v<T, double>)
+			{
+				// Every row in two halves of two doubles, the same code whatever instruction set the including translation unit enables.
+				for (int half = 0; half < 4; half += 2)
+				{
+					const __m128d right0 = _mm_load_pd(aRight.m_Data + half);
+					const __m128d right1 = _mm_load_pd(aRight.m_Data + 4 + half);
+					const __m128d right2 = _mm_load_pd(aRight.m_Data + 8 + half);
+					const __m128d right3 = _mm_load_pd(aRight.m_Data + 12 + half);
+					for (int row = 0; row < 16; row += 4)
+					{
+						__m128d sum = _mm_mul_pd(_mm_set1_pd(aLeft.m_Data[row]), right0);
+						sum = _mm_add_pd(_mm_mul_pd(_mm_set1_pd(aLeft.m_Data[row + 1]), right1), sum);
+						sum = _mm_add_pd(_mm_mul_pd(_mm_set1_pd(aLeft.m_Data[row + 2]), right2), sum);
+						sum = _mm_add_pd(_mm_mul_pd(_mm_set1_pd(aLeft.m_Data[row + 3]), right3), sum);
+						_mm_store_pd(result.m_Data + row + half, sum);
+					}
+				}
+				return result;
+			}
+		}
+#endif
+		for (int row = 0; row < 16; row += 4)
+		{
+			for (int column = 0; column < 4; column++)
+			{
+				result.m_Data[row + column] =
+					aLeft.m_Data[row] * aRight.m_Data[column] +
+					aLeft.m_Data[row + 1] * aRight.m_Data[4 + column] +
+					aLeft.m_Data[row + 2] * aRight.m_Data[8 + column] +
+					aLeft.m_Data[row + 3] * aRight.m_Data[12 + column];
+			}
+		}
+		return result;
 	}
 
 	template<typename T>
-	inline Matrix4x4<T>& Matrix4x4<T>::operator*=(const Matrix4x4<T>& aOther)
+	constexpr Matrix4x4<T>& Matrix4x4<T>::operator*=(const Matrix4x4<T>& aOther)
 	{
 		return (*this) = (*this) * aOther;
 	}
 
 
 	template<typename T>
-	inline bool Matrix4x4<T>::operator==(const Matrix4x4& aOther) const
+	constexpr bool Matrix4x4<T>::operator==(const Matrix4x4& aOther) const
 	{
 		return
 			this->m_Data[0] == aOther.m_Data[0] && this->m_Data[1] == aOther.m_Data[1] && this->m_Data[2] == aOther.m_Data[2] && this->m_Data[3] == aOther.m_Data[3] &&
@@ -232,29 +297,7 @@ namespace stm
 	}
 
 	template<typename T>
-	inline Matrix4x4<T>& Matrix4x4<T>::operator=(const Matrix4x4& aOther)
-	{
-		m_Data[0] = aOther.m_Data[0];
-		m_Data[1] = aOther.m_Data[1];
-		m_Data[2] = aOther.m_Data[2];
-		m_Data[3] = aOther.m_Data[3];
-		m_Data[4] = aOther.m_Data[4];
-		m_Data[5] = aOther.m_Data[5];
-		m_Data[6] = aOther.m_Data[6];
-		m_Data[7] = aOther.m_Data[7];
-		m_Data[8] = aOther.m_Data[8];
-		m_Data[9] = aOther.m_Data[9];
-		m_Data[10] = aOther.m_Data[10];
-		m_Data[11] = aOther.m_Data[11];
-		m_Data[12] = aOther.m_Data[12];
-		m_Data[13] = aOther.m_Data[13];
-		m_Data[14] = aOther.m_Data[14];
-		m_Data[15] = aOther.m_Data[15];
-		return *this;
-	}
-
-	template<typename T>
-	inline Vector4<T> operator*(const Vector4<T>& aVector, const Matrix4x4<T>& aMatrix)
+	constexpr Vector4<T> operator*(const Vector4<T>& aVector, const Matrix4x4<T>& aMatrix)
 	{
 		return Vector4<T>(
 			aVector.x * aMatrix.m_Data[0] + aVector.y * aMatrix.m_Data[4] + aVector.z * aMatrix.m_Data[8] + aVector.w * aMatrix.m_Data[12],
@@ -265,7 +308,7 @@ namespace stm
 	}
 
 	template<typename T>
-	inline Matrix4x4<T> Matrix4x4<T>::Transpose(const Matrix4x4<T>& aMatrixToTranspose)
+	constexpr Matrix4x4<T> Matrix4x4<T>::Transpose(const Matrix4x4<T>& aMatrixToTranspose)
 	{
 		return Matrix4x4<T>(
 			aMatrixToTranspose.m_Data[0],
@@ -310,40 +353,152 @@ namespace stm
 	}
 
 	template<typename T>
+	template<Precision P>
 	inline Matrix4x4<T> Matrix4x4<T>::CreateRotationAroundX(T aAngleInRadians)
 	{
+		T sine;
+		T cosine;
+		Math::SinCos<P>(aAngleInRadians, sine, cosine);
 		return Matrix4x4<T>(
 			1, 0, 0, 0,
-			0, std::cos(aAngleInRadians), std::sin(aAngleInRadians), 0,
-			0, -std::sin(aAngleInRadians), std::cos(aAngleInRadians), 0,
+			0, cosine, sine, 0,
+			0, -sine, cosine, 0,
 			0, 0, 0, 1
 		);
 	}
 
 	template<typename T>
+	template<Precision P>
 	inline Matrix4x4<T> Matrix4x4<T>::CreateRotationAroundY(T aAngleInRadians)
 	{
+		T sine;
+		T cosine;
+		Math::SinCos<P>(aAngleInRadians, sine, cosine);
 		return Matrix4x4<T>(
-			std::cos(aAngleInRadians), 0, -std::sin(aAngleInRadians), 0,
+			cosine, 0, -sine, 0,
 			0, 1, 0, 0,
-			std::sin(aAngleInRadians), 0, std::cos(aAngleInRadians), 0,
+			sine, 0, cosine, 0,
 			0, 0, 0, 1
 		);
 	}
 
 	template<typename T>
+	template<Precision P>
 	inline Matrix4x4<T> Matrix4x4<T>::CreateRotationAroundZ(T aAngleInRadians)
 	{
+		T sine;
+		T cosine;
+		Math::SinCos<P>(aAngleInRadians, sine, cosine);
 		return Matrix4x4<T>(
-			std::cos(aAngleInRadians), std::sin(aAngleInRadians), 0, 0,
-			-std::sin(aAngleInRadians), std::cos(aAngleInRadians), 0, 0,
+			cosine, sine, 0, 0,
+			-sine, cosine, 0, 0,
 			0, 0, 1, 0,
 			0, 0, 0, 1
 		);
 	}
 
 	template<typename T>
-	Matrix4x4<T> Matrix4x4<T>::GetFastInverse(const Matrix4x4<T>& aTransform)
+	inline Matrix4x4<T> Matrix4x4<T>::CreatePerspective(T aFieldOfViewInRadians, T aAspectRatio, T aNear, T aFar)
+	{
+		assert(aAspectRatio != 0 && aNear != aFar && "Division by 0");
+
+		const T scaleY = 1 / std::tan(aFieldOfViewInRadians / 2);
+		const T depthScale = aFar / (aFar - aNear);
+		return Matrix4x4<T>(
+			scaleY / aAspectRatio, 0, 0, 0,
+			0, scaleY, 0, 0,
+			0, 0, depthScale, 1,
+			0, 0, -aNear * depthScale, 0
+		);
+	}
+
+	template<typename T>
+	inline Matrix4x4<T> Matrix4x4<T>::CreatePerspectiveReversedZ(T aFieldOfViewInRadians, T aAspectRatio, T aNear, T aFar)
+	{
+		assert(aAspectRatio != 0 && aNear != aFar && "Division by 0");
+
+		const T scaleY = 1 / std::tan(aFieldOfViewInRadians / 2);
+		const T depthScale = aNear / (aNear - aFar);
+		return Matrix4x4<T>(
+			scaleY / aAspectRatio, 0, 0, 0,
+			0, scaleY, 0, 0,
+			0, 0, depthScale, 1,
+			0, 0, -aFar * depthScale, 0
+		);
+	}
+
+	template<typename T>
+	inline Matrix4x4<T> Matrix4x4<T>::CreatePerspectiveInfinite(T aFieldOfViewInRadians, T aAspectRatio, T aNear)
+	{
+		assert(aAspectRatio != 0 && "Division by 0");
+
+		const T scaleY = 1 / std::tan(aFieldOfViewInRadians / 2);
+		return Matrix4x4<T>(
+			scaleY / aAspectRatio, 0, 0, 0,
+			0, scaleY, 0, 0,
+			0, 0, 1, 1,
+			0, 0, -aNear, 0
+		);
+	}
+
+	template<typename T>
+	inline Matrix4x4<T> Matrix4x4<T>::CreatePerspectiveInfiniteReversedZ(T aFieldOfViewInRadians, T aAspectRatio, T aNear)
+	{
+		assert(aAspectRatio != 0 && "Division by 0");
+
+		const T scaleY = 1 / std::tan(aFieldOfViewInRadians / 2);
+		return Matrix4x4<T>(
+			scaleY / aAspectRatio, 0, 0, 0,
+			0, scaleY, 0, 0,
+			0, 0, 0, 1,
+			0, 0, aNear, 0
+		);
+	}
+
+	template<typename T>
+	constexpr Matrix4x4<T> Matrix4x4<T>::CreateOrthographic(T aWidth, T aHeight, T aNear, T aFar)
+	{
+		assert(aWidth != 0 && aHeight != 0 && aNear != aFar && "Division by 0");
+
+		const T depthScale = 1 / (aFar - aNear);
+		return Matrix4x4<T>(
+			2 / aWidth, 0, 0, 0,
+			0, 2 / aHeight, 0, 0,
+			0, 0, depthScale, 0,
+			0, 0, -aNear * depthScale, 1
+		);
+	}
+
+	template<typename T>
+	constexpr Matrix4x4<T> Matrix4x4<T>::CreateOrthographicReversedZ(T aWidth, T aHeight, T aNear, T aFar)
+	{
+		assert(aWidth != 0 && aHeight != 0 && aNear != aFar && "Division by 0");
+
+		const T depthScale = 1 / (aNear - aFar);
+		return Matrix4x4<T>(
+			2 / aWidth, 0, 0, 0,
+			0, 2 / aHeight, 0, 0,
+			0, 0, depthScale, 0,
+			0, 0, -aFar * depthScale, 1
+		);
+	}
+
+	template<typename T>
+	inline Matrix4x4<T> Matrix4x4<T>::CreateLookAt(const Vector3<T>& aEye, const Vector3<T>& aTarget, const Vector3<T>& aUp)
+	{
+		const Vector3<T> forward = (aTarget - aEye).GetNormalized();
+		const Vector3<T> right = aUp.Cross(forward).GetNormalized();
+		const Vector3<T> up = forward.Cross(right);
+		return Matrix4x4<T>(
+			right.x, up.x, forward.x, 0,
+			right.y, up.y, forward.y, 0,
+			right.z, up.z, forward.z, 0,
+			-right.Dot(aEye), -up.Dot(aEye), -forward.Dot(aEye), 1
+		);
+	}
+
+	template<typename T>
+	constexpr Matrix4x4<T> Matrix4x4<T>::GetFastInverse(const Matrix4x4<T>& aTransform)
 	{
 		return Matrix4x4<T>(
 			aTransform.m_Data[0], aTransform.m_Data[4], aTransform.m_Data[8], 0,
@@ -358,7 +513,149 @@ namespace stm
 	}
 
 	template<typename T>
-	Matrix4x4<T> Matrix4x4<T>::GetIdentity()
+	constexpr T Matrix4x4<T>::GetDeterminant(const Matrix4x4<T>& aMatrix)
+	{
+		const T* m = aMatrix.m_Data;
+		// 2x2 determinants of the top two and the bottom two rows.
+		const T top0 = m[0] * m[5] - m[1] * m[4];
+		const T top1 = m[0] * m[6] - m[2] * m[4];
+		const T top2 = m[0] * m[7] - m[3] * m[4];
+		const T top3 = m[1] * m[6] - m[2] * m[5];
+		const T top4 = m[1] * m[7] - m[3] * m[5];
+		const T top5 = m[2] * m[7] - m[3] * m[6];
+		const T bottom0 = m[8] * m[13] - m[9] * m[12];
+		const T bottom1 = m[8] * m[14] - m[10] * m[12];
+		const T bottom2 = m[8] * m[15] - m[11] * m[12];
+		const T bottom3 = m[9] * m[14] - m[10] * m[13];
+		const T bottom4 = m[9] * m[15] - m[11] * m[13];
+		const T bottom5 = m[10] * m[15] - m[11] * m[14];
+		return top0 * bottom5 - top1 * bottom4 + top2 * bottom3 + top3 * bottom2 - top4 * bottom1 + top5 * bottom0;
+	}
+
+	template<typename T>
+	constexpr bool Matrix4x4<T>::GetInverse(const Matrix4x4<T>& aMatrix, Matrix4x4<T>& aResult)
+	{
+#ifdef STM_SIMD_SSE
+		if (!std::is_constant_evaluated())
+		{
+			if constexpr (std::is_same_v<T, float>)
+			{
+				// Block inversion with the 2x2 sub matrices A B / C D, every adjugate is scaled by 1 / |M| at the end.
+				const __m128 row0 = _mm_load_ps(aMatrix.m_Data);
+				const __m128 row1 = _mm_load_ps(aMatrix.m_Data + 4);
+				const __m128 row2 = _mm_load_ps(aMatrix.m_Data + 8);
+				const __m128 row3 = _mm_load_ps(aMatrix.m_Data + 12);
+
+				const __m128 a = _mm_movelh_ps(row0, row1);
+				const __m128 b = _mm_movehl_ps(row1, row0);
+				const __m128 c = _mm_movelh_ps(row2, row3);
+				const __m128 d = _mm_movehl_ps(row3, row2);
+
+				// (|A|, |B|, |C|, |D|)
+				const __m128 determinants = _mm_sub_ps(
+					_mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(3, 1, 3, 1))),
+					_mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(2, 0, 2, 0))));
+				const __m128 determinantA = _mm_shuffle_ps(determinants, determinants, _MM_SHUFFLE(0, 0, 0, 0));
+				const __m128 determinantB = _mm_shuffle_ps(determinants, determinants, _MM_SHUFFLE(1, 1, 1, 1));
+				const __m128 determinantC = _mm_shuffle_ps(determinants, determinants, _MM_SHUFFLE(2, 2, 2, 2));
+				const __m128 determinantD = _mm_shuffle_ps(determinants, determinants, _MM_SHUFFLE(3, 3, 3, 3));
+
+				const __m128 adjugateDC = Simd::Matrix2AdjugateMultiply(d, c);
+				const __m128 adjugateAB = Simd::Matrix2AdjugateMultiply(a, b);
+				__m128 x = _mm_sub_ps(_mm_mul_ps(determinantD, a), Simd::Matrix2Multiply(b, adjugateDC));
+				__m128 w = _mm_sub_ps(_mm_mul_ps(determinantA, d), Simd::Matrix2Multiply(c, adjugateAB));
+				__m128 y = _mm_sub_ps(_mm_mul_ps(determinantB, c), Simd::Matrix2MultiplyAdjugate(d, adjugateAB));
+				__m128 z = _mm_sub_ps(_mm_mul_ps(determinantC, b), Simd::Matrix2MultiplyAdjugate(a, adjugateDC));
+
+				// |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+				const __m128 trace = Simd::HorizontalSum(_mm_mul_ps(adjugateAB, _mm_shuffle_ps(adjugateDC, adjugateDC, _MM_SHUFFLE(3, 1, 2, 0))));
+				const __m128 determinant = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(determinantA, determinantD), _mm_mul_ps(determinantB, determinantC)), trace);
+				if (!Math::IsInvertible(Simd::GetX(determinant)))
+				{
+					return false;
+				}
+
+				const __m128 scale = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+				x = _mm_mul_ps(x, scale);
+				y = _mm_mul_ps(y, scale);
+				z = _mm_mul_ps(z, scale);
+				w = _mm_mul_ps(w, scale);
+
+				// The shuffles apply the final adjugate of every block while putting the rows back together.
+				_mm_store_ps(aResult.m_Data, _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+				_mm_store_ps(aResult.m_Data + 4, _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+				_mm_store_ps(aResult.m_Data + 8, _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+				_mm_store_ps(aResult.m_Data + 12, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+				return true;
+			}
+		}
+#endif
+		const T* m = aMatrix.m_Data;
+		const T top0 = m[0] * m[5] - m[1] * m[4];
+		const T top1 = m[0] * m[6] - m[2] * m[4];
+		const T top2 = m[0] * m[7] - m[3] * m[4];
+		const T top3 = m[1] * m[6] - m[2] * m[5];
+		const T top4 = m[1] * m[7] - m[3] * m[5];
+		const T top5 = m[2] * m[7] - m[3] * m[6];
+		const T bottom0 = m[8] * m[13] - m[9] * m[12];
+		const T bottom1 = m[8] * m[14] - m[10] * m[12];
+		const T bottom2 = m[8] * m[15] - m[11] * m[12];
+		const T bottom3 = m[9] * m[14] - m[10] * m[13];
+		const T bottom4 = m[9] * m[15] - m[11] * m[13];
+		const T bottom5 = m[10] * m[15] - m[11] * m[14];
+
+		const T determinant = top0 * bottom5 - top1 * bottom4 + top2 * bottom3 + top3 * bottom2 - top4 * bottom1 + top5 * bottom0;
+		if (!Math::IsInvertible(determinant))
+		{
+			return false;
+		}
+
+		const T scale = 1 / determinant;
+		aResult = Matrix4x4<T>(
+			(m[5] * bottom5 - m[6] * bottom4 + m[7] * bottom3) * scale,
+			(-m[1] * bottom5 + m[2] * bottom4 - m[3] * bottom3) * scale,
+			(m[13] * top5 - m[14] * top4 + m[15] * top3) * scale,
+			(-m[9] * top5 + m[10] * top4 - m[11] * top3) * scale,
+
+			(-m[4] * bottom5 + m[6] * bottom2 - m[7] * bottom1) * scale,
+			(m[0] * bottom5 - m[2] * bottom2 + m[3] * bottom1) * scale,
+			(-m[12] * top5 + m[14] * top2 - m[15] * top1) * scale,
+			(m[8] * top5 - m[10] * top2 + m[11] * top1) * scale,
+
+			(m[4] * bottom4 - m[5] * bottom2 + m[7] * bottom0) * scale,
+			(-m[0] * bottom4 + m[1] * bottom2 - m[3] * bottom0) * scale,
+			(m[12] * top4 - m[13] * top2 + m[15] * top0) * scale,
+			(-m[8] * top4 + m[9] * top2 - m[11] * top0) * scale,
+
+			(-m[4] * bottom3 + m[5] * bottom1 - m[6] * bottom0) * scale,
+			(m[0] * bottom3 - m[1] * bottom1 + m[2] * bottom0) * scale,
+			(-m[12] * top3 + m[13] * top1 - m[14] * top0) * scale,
+			(m[8] * top3 - m[9] * top1 + m[10] * top0) * scale
+		);
+		return true;
+	}
+
+	template<typename T>
+	constexpr bool Matrix4x4<T>::GetInverseAffine(const Matrix4x4<T>& aTransform, Matrix4x4<T>& aResult)
+	{
+		Matrix3x3<T> rotationScale(aTransform);
+		if (!Matrix3x3<T>::GetInverse(rotationScale, rotationScale))
+		{
+			return false;
+		}
+
+		const Vector3<T> translation = -(aTransform.GetTranslation() * rotationScale);
+		aResult = Matrix4x4<T>(
+			rotationScale(1, 1), rotationScale(1, 2), rotationScale(1, 3), 0,
+			rotationScale(2, 1), rotationScale(2, 2), rotationScale(2, 3), 0,
+			rotationScale(3, 1), rotationScale(3, 2), rotationScale(3, 3), 0,
+			translation.x, translation.y, translation.z, 1
+		);
+		return true;
+	}
+
+	template<typename T>
+	constexpr Matrix4x4<T> Matrix4x4<T>::GetIdentity()
 	{
 		return Matrix4x4<T>(
 			1, 0, 0, 0,
@@ -368,22 +665,22 @@ namespace stm
 		);
 	}
 	template<typename T>
-	const Vector3<T> Matrix4x4<T>::GetRight() const
+	constexpr Vector3<T> Matrix4x4<T>::GetRight() const
 	{
 		return Vector3<T>(m_Data[0], m_Data[1], m_Data[2]);
 	}
 	template<typename T>
-	const Vector3<T> Matrix4x4<T>::GetUp() const
+	constexpr Vector3<T> Matrix4x4<T>::GetUp() const
 	{
 		return Vector3<T>(m_Data[4], m_Data[5], m_Data[6]);
 	}
 	template<typename T>
-	const Vector3<T> Matrix4x4<T>::GetForward() const
+	constexpr Vector3<T> Matrix4x4<T>::GetForward() const
 	{
 		return Vector3<T>(m_Data[8], m_Data[9], m_Data[10]);
 	}
 	template<typename T>
-	const Vector3<T> Matrix4x4<T>::GetTranslation() const
+	constexpr Vector3<T> Matrix4x4<T>::GetTranslation() const
 	{
 		return Vector3<T>(m_Data[12], m_Data[13], m_Data[14]);
 	}
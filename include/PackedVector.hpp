@@ -0,0 +1,269 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+#include "Quaternion.hpp"
+#include "Vector3.hpp"
+#include "Vector4.hpp"
+
+namespace stm
+{
+	// Scalar conversions behind the packed formats, Batch::Pack and Batch::Unpack do the same for whole arrays.
+	namespace Packing
+	{
+		// IEEE half precision, rounded to nearest even like F16C.
+		constexpr std::uint16_t FloatToHalf(float aValue);
+		constexpr float HalfToFloat(std::uint16_t aValue);
+
+		// [-1, 1] mapped to [-32767, 32767] rounded to nearest even like the SIMD conversions, values outside are clamped.
+		constexpr std::int16_t FloatToSnorm16(float aValue);
+		constexpr float Snorm16ToFloat(std::int16_t aValue);
+	}
+
+	// Half precision Vector3, padded like Vector3<float> so a packed array is exactly half the size.
+	class Vector3h
+	{
+	public:
+		constexpr Vector3h();
+		explicit constexpr Vector3h(const Vector3f& aVector);
+
+		constexpr Vector3f Unpack() const;
+
+		std::uint16_t x;
+		std::uint16_t y;
+		std::uint16_t z;
+#ifdef STM_SIMD_SSE
+		std::uint16_t m_Padding;
+#endif
+	};
+
+	// Unit vector folded onto an octahedron and stored as two snorm16, 4 bytes. Angular error stays below 0.005 degrees.
+	class OctahedralNormal
+	{
+	public:
+		constexpr OctahedralNormal();
+		explicit OctahedralNormal(const Vector3f& aNormal);
+
+		Vector3f Unpack() const;
+
+		std::int16_t u;
+		std::int16_t v;
+	};
+
+	// xyz as snorm10 and w as snorm2 (-1, 0 or 1, e.g. a tangent's handedness) in 32 bits.
+	class PackedVector1010102
+	{
+	public:
+		constexpr PackedVector1010102();
+		explicit constexpr PackedVector1010102(const Vector4f& aVector);
+
+		constexpr Vector4f Unpack() const;
+
+		std::uint32_t bits;
+	};
+
+	// Quaternion as four snorm16, 8 bytes. Unpack does not renormalize.
+	class PackedQuaternion
+	{
+	public:
+		constexpr PackedQuaternion();
+		explicit constexpr PackedQuaternion(const Quaternion& aQuaternion);
+
+		constexpr Quaternion Unpack() const;
+
+		std::int16_t r;
+		std::int16_t i;
+		std::int16_t j;
+		std::int16_t k;
+	};
+
+	constexpr std::uint16_t Packing::FloatToHalf(float aValue)
+	{
+		constexpr std::uint32_t infinity = 255u << 23;
+		constexpr std::uint32_t halfOverflow = (127u + 16u) << 23;
+		constexpr std::uint32_t smallestNormal = 113u << 23;
+		constexpr std::uint32_t denormalMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+		std::uint32_t bits = std::bit_cast<std::uint32_t>(aValue);
+		const std::uint32_t sign = bits & 0x80000000u;
+		bits ^= sign;
+
+		std::uint32_t result = 0;
+		if (bits >= halfOverflow)
+		{
+			result = bits > infinity ? 0x7E00u : 0x7C00u;
+		}
+		else if (bits < smallestNormal)
+		{
+			// Adding the magic number lets the FPU round the denormal mantissa into place.
+			const float shifted = std::bit_cast<float>(bits) + std::bit_cast<float>(denormalMagic);
+			result = std::bit_cast<std::uint32_t>(shifted) - denormalMagic;
+		}
+		else
+		{
+			const std::uint32_t mantissaOdd = (bits >> 13) & 1u;
+			bits += ((15u - 127u) << 23) + 0xFFFu;
+			bits += mantissaOdd;
+			result = bits >> 13;
+		}
+		return static_cast<std::uint16_t>(result | (sign >> 16));
+	}
+
+	constexpr float Packing::HalfToFloat(std::uint16_t aValue)
+	{
+		constexpr std::uint32_t shiftedExponent = 0x7C00u << 13;
+		constexpr std::uint32_t magic = 113u << 23;
+
+		std::uint32_t bits = (aValue & 0x7FFFu) << 13;
+		const std::uint32_t exponent = shiftedExponent & bits;
+		bits += (127u - 15u) << 23;
+
+		if (exponent == shiftedExponent)
+		{
+			bits += (128u - 16u) << 23;
+		}
+		else if (exponent == 0)
+		{
+			bits += 1u << 23;
+			bits = std::bit_cast<std::uint32_t>(std::bit_cast<float>(bits) - std::bit_cast<float>(magic));
+		}
+		return std::bit_cast<float>(bits | (static_cast<std::uint32_t>(aValue & 0x8000u) << 16));
+	}
+
+	constexpr std::int16_t Packing::FloatToSnorm16(float aValue)
+	{
+		// Adding 1.5 * 2^23 leaves no fraction bits, so the FPU rounds to the nearest even integer.
+		constexpr float roundingMagic = 12582912.0f;
+
+		const float scaled = std::clamp(aValue, -1.0f, 1.0f) * 32767.0f;
+		return static_cast<std::int16_t>((scaled + roundingMagic) - roundingMagic);
+	}
+
+	constexpr float Packing::Snorm16ToFloat(std::int16_t aValue)
+	{
+		return std::max(aValue * (1.0f / 32767.0f), -1.0f);
+	}
+
+	constexpr Vector3h::Vector3h() :
+		x(0),
+		y(0),
+		z(0)
+#ifdef STM_SIMD_SSE
+		, m_Padding(0)
+#endif
+	{
+
+	}
+
+	constexpr Vector3h::Vector3h(const Vector3f& aVector) :
+		x(Packing::FloatToHalf(aVector.x)),
+		y(Packing::FloatToHalf(aVector.y)),
+		z(Packing::FloatToHalf(aVector.z))
+#ifdef STM_SIMD_SSE
+		, m_Padding(0)
+#endif
+	{
+
+	}
+
+	constexpr Vector3f Vector3h::Unpack() const
+	{
+		return Vector3f(Packing::HalfToFloat(x), Packing::HalfToFloat(y), Packing::HalfToFloat(z));
+	}
+
+	constexpr OctahedralNormal::OctahedralNormal() :
+		u(0),
+		v(0)
+	{
+
+	}
+
+	inline OctahedralNormal::OctahedralNormal(const Vector3f& aNormal)
+	{
+		const float length = std::abs(aNormal.x) + std::abs(aNormal.y) + std::abs(aNormal.z);
+		assert(length != 0 && "Division by 0");
+
+		float octahedralU = aNormal.x / length;
+		float octahedralV = aNormal.y / length;
+		if (aNormal.z < 0.0f)
+		{
+			const float foldedU = (1.0f - std::abs(octahedralV)) * std::copysign(1.0f, octahedralU);
+			const float foldedV = (1.0f - std::abs(octahedralU)) * std::copysign(1.0f, octahedralV);
+			octahedralU = foldedU;
+			octahedralV = foldedV;
+		}
+		u = Packing::FloatToSnorm16(octahedralU);
+		v = Packing::FloatToSnorm16(octahedralV);
+	}
+
+	inline Vector3f OctahedralNormal::Unpack() const
+	{
+		float x = Packing::Snorm16ToFloat(u);
+		float y = Packing::Snorm16ToFloat(v);
+		const float z = 1.0f - std::abs(x) - std::abs(y);
+		if (z < 0.0f)
+		{
+			const float foldedX = (1.0f - std::abs(y)) * std::copysign(1.0f, x);
+			const float foldedY = (1.0f - std::abs(x)) * std::copysign(1.0f, y);
+			x = foldedX;
+			y = foldedY;
+		}
+		return Vector3f(x, y, z).GetNormalized();
+	}
+
+	constexpr PackedVector1010102::PackedVector1010102() :
+		bits(0)
+	{
+
+	}
+
+	constexpr PackedVector1010102::PackedVector1010102(const Vector4f& aVector) :
+		bits(0)
+	{
+		auto pack = [](float aValue, float aScale) constexpr
+		{
+			const float scaled = std::clamp(aValue, -1.0f, 1.0f) * aScale;
+			return static_cast<std::uint32_t>(static_cast<std::int32_t>(scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f));
+		};
+		bits = (pack(aVector.x, 511.0f) & 0x3FFu)
+			| ((pack(aVector.y, 511.0f) & 0x3FFu) << 10)
+			| ((pack(aVector.z, 511.0f) & 0x3FFu) << 20)
+			| ((pack(aVector.w, 1.0f) & 0x3u) << 30);
+	}
+
+	constexpr Vector4f PackedVector1010102::Unpack() const
+	{
+		// Shifting the field to the top and back sign extends it.
+		auto unpack = [this](int aShift, int aWidth, float aScale) constexpr
+		{
+			const std::int32_t value = static_cast<std::int32_t>(bits << (32 - aShift - aWidth)) >> (32 - aWidth);
+			return std::max(value / aScale, -1.0f);
+		};
+		return Vector4f(unpack(0, 10, 511.0f), unpack(10, 10, 511.0f), unpack(20, 10, 511.0f), unpack(30, 2, 1.0f));
+	}
+
+	constexpr PackedQuaternion::PackedQuaternion() :
+		r(Packing::FloatToSnorm16(1.0f)),
+		i(0),
+		j(0),
+		k(0)
+	{
+
+	}
+
+	constexpr PackedQuaternion::PackedQuaternion(const Quaternion& aQuaternion) :
+		r(Packing::FloatToSnorm16(aQuaternion.r)),
+		i(Packing::FloatToSnorm16(aQuaternion.i)),
+		j(Packing::FloatToSnorm16(aQuaternion.j)),
+		k(Packing::FloatToSnorm16(aQuaternion.k))
+	{
+
+	}
+
+	constexpr Quaternion PackedQuaternion::Unpack() const
+	{
+		return Quaternion(Packing::Snorm16ToFloat(r), Packing::Snorm16ToFloat(i), Packing::Snorm16ToFloat(j), Packing::Snorm16ToFloat(k));
+	}
+}
\ No newline at end of file
@@ -4,6 +4,8 @@
 
 namespace stm
 {
+	// Hessian normal form, Dot(Normal(), point) + Distance() is how far point is in front of the plane and 0 on
+	// it. Points in front of the plane, on the side the normal points to, are outside.
 	template<typename T>
 	class Plane
 	{
@@ -11,25 +13,30 @@ namespace stm
 		Plane();
 		Plane(const Vector3<T>& aPoint0, const Vector3<T>& aPoint1, const Vector3<T>& aPoint2);
 		Plane(const Vector3<T>& aPoint0, const Vector3<T>& aNormal);
+		// aNormal must already be of unit length.
+		Plane(const Vector3<T>& aNormal, T aDistance);
 		~Plane() = default;
 
 		void InitWith3Points(const Vector3<T>& aPoint0, const Vector3<T>& aPoint1, const Vector3<T>& aPoint2);
 		void InitWithPointAndNormal(const Vector3<T>& aPoint, const Vector3<T>& aNormal);
 
 		bool Inside(const Vector3<T>& aPosition) const;
+		T SignedDistance(const Vector3<T>& aPosition) const;
 
-		const Vector3<T>& Point() const;
+		// The point of the plane closest to the origin.
+		Vector3<T> Point() const;
 		const Vector3<T>& Normal() const;
+		T Distance() const;
 
 	private:
-		Vector3<T> m_Point;
 		Vector3<T> m_Normal;
+		T m_Distance;
 	};
 
 	template<typename T>
 	inline Plane<T>::Plane() 
-		: m_Point(0, 0, 0),
-	 	  m_Normal(0, 0, 0)
+		: m_Normal(0, 0, 0),
+		  m_Distance(0)
 	{
 	}
 
@@ -45,40 +52,55 @@ namespace stm
 		InitWithPointAndNormal(aPoint0, aNormal);
 	}
 
+	template<typename T>
+	inline Plane<T>::Plane(const Vector3<T>& aNormal, T aDistance)
+		: m_Normal(aNormal),
+		  m_Distance(aDistance)
+	{
+	}
+
 	template<typename T>
 	inline void Plane<T>::InitWith3Points(const Vector3<T>& aPoint0, const Vector3<T>& aPoint1, const Vector3<T>& aPoint2)
 	{
-		m_Point = aPoint0;
 		m_Normal = Vector3<T>(aPoint1 - aPoint0).Cross(Vector3<T>(aPoint2 - aPoint0)).GetNormalized();
+		m_Distance = -m_Normal.Dot(aPoint0);
 	}
 
 	template<typename T>
 	inline void Plane<T>::InitWithPointAndNormal(const Vector3<T>& aPoint, const Vector3<T>& aNormal)
 	{
-		m_Point = aPoint;
 		m_Normal = aNormal.GetNormalized();
+		m_Distance = -m_Normal.Dot(aPoint);
 	}
 
 	template<typename T>
 	inline bool Plane<T>::Inside(const Vector3<T>& aPosition) const
 	{
-		return m_Normal.Dot(aPosition - m_Point) <= 0;
+		return SignedDistance(aPosition) <= 0;
 	}
 
+	template<>
 	inline bool Plane<float>::Inside(const Vector3<float>& aPosition) const
 	{
-		return m_Normal.Dot(aPosition - m_Point) <= Math::ELIPSON;
+		return SignedDistance(aPosition) <= Math::ELIPSON;
 	}
 
+	template<>
 	inline bool Plane<double>::Inside(const Vector3<double>& aPosition) const
 	{
-		return m_Normal.Dot(aPosition - m_Point) <= Math::ELIPSON_D;
+		return SignedDistance(aPosition) <= Math::ELIPSON_D;
+	}
+
+	template<typename T>
+	inline T Plane<T>::SignedDistance(const Vector3<T>& aPosition) const
+	{
+		return m_Normal.Dot(aPosition) + m_Distance;
 	}
 
 	template<typename T>
-	const Vector3<T>& Plane<T>::Point() const
+	Vector3<T> Plane<T>::Point() const
 	{
-		return m_Point;
+		return m_Normal * -m_Distance;
 	}
 
 	template<typename T>
@@ -86,4 +108,10 @@ namespace stm
 	{
 		return m_Normal;
 	}
+
+	template<typename T>
+	T Plane<T>::Distance() const
+	{
+		return m_Distance;
+	}
 }
\ No newline at end of file
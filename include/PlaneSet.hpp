@@ -0,0 +1,177 @@
+#pragma once
+#include <cassert>
+#include <cmath>
+#include <span>
+#include <vector>
+
+#include "Matrix4x4.hpp"
+#include "Plane.hpp"
+#include "PlaneVolume.hpp"
+#include "Vector3Stream.hpp"
+
+namespace stm
+{
+	// Planes in Hessian normal form stored as structure of arrays, the normals in a Vector3Stream next to an array
+	// of distances, which is the layout Batch::Cull and Batch::IntersectPlanes take. Transforms work in place
+	// without allocating, so a set built once can follow its camera or object every frame.
+	template<typename T>
+	class PlaneSet
+	{
+	public:
+		PlaneSet() = default;
+		explicit PlaneSet(const PlaneVolume<T>& aVolume);
+		~PlaneSet() = default;
+
+		// Keeps the storage, so it only allocates when the set grows past its largest size so far.
+		void Assign(const PlaneVolume<T>& aVolume);
+		void Add(const Plane<T>& aPlane);
+		void Clear();
+
+		std::size_t Size() const;
+
+		Plane<T> Get(std::size_t aIndex) const;
+		void Set(std::size_t aIndex, const Plane<T>& aPlane);
+
+		bool Inside(const Vector3<T>& aPosition) const;
+
+		// Moves the planes along with the points aMatrix transforms, returns false and leaves them untouched when
+		// aMatrix is singular.
+		bool Transform(const Matrix4x4<T>& aMatrix);
+		// The same with the transpose of the inverse already at hand, for a matrix that transforms many sets. The
+		// normals are renormalized, so scaled matrices keep the distances in world units.
+		void TransformInverseTranspose(const Matrix4x4<T>& aInverseTranspose);
+
+		const Vector3Stream<T>& GetNormals() const;
+		std::span<const T> GetDistances() const;
+
+	private:
+		Vector3Stream<T> m_Normals;
+		std::vector<T> m_Distances;
+	};
+
+	template<typename T>
+	inline PlaneSet<T>::PlaneSet(const PlaneVolume<T>& aVolume)
+	{
+		Assign(aVolume);
+	}
+
+	template<typename T>
+	inline void PlaneSet<T>::Assign(const PlaneVolume<T>& aVolume)
+	{
+		const SimpleList<Plane<T>>& planes = aVolume.GetPlanes();
+		m_Normals.Resize(planes.Size());
+		m_Distances.resize(planes.Size());
+		for (std::size_t index = 0; index < planes.Size(); index++)
+		{
+			Set(index, planes[index]);
+		}
+	}
+
+	template<typename T>
+	inline void PlaneSet<T>::Add(const Plane<T>& aPlane)
+	{
+		const std::size_t index = Size();
+		m_Normals.Resize(index + 1);
+		m_Distances.resize(index + 1);
+		Set(index, aPlane);
+	}
+
+	template<typename T>
+	inline void PlaneSet<T>::Clear()
+	{
+		m_Normals.Resize(0);
+		m_Distances.clear();
+	}
+
+	template<typename T>
+	inline std::size_t PlaneSet<T>::Size() const
+	{
+		return m_Distances.size();
+	}
+
+	template<typename T>
+	inline Plane<T> PlaneSet<T>::Get(std::size_t aIndex) const
+	{
+		assert(aIndex < Size() && "Index out of range");
+
+		return Plane<T>(m_Normals.Get(aIndex), m_Distances[aIndex]);
+	}
+
+	template<typename T>
+	inline void PlaneSet<T>::Set(std::size_t aIndex, const Plane<T>& aPlane)
+	{
+		assert(aIndex < Size() && "Index out of range");
+
+		m_Normals.Set(aIndex, aPlane.Normal());
+		m_Distances[aIndex] = aPlane.Distance();
+	}
+
+	template<typename T>
+	inline bool PlaneSet<T>::Inside(const Vector3<T>& aPosition) const
+	{
+		for (std::size_t index = 0; index < Size(); index++)
+		{
+			if (!Get(index).Inside(aPosition))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename T>
+	inline bool PlaneSet<T>::Transform(const Matrix4x4<T>& aMatrix)
+	{
+		// With row vectors a point p moves to p * M, and (normal, distance) * transpose(inverse(M)) keeps its
+		// product with the moved point the same.
+		Matrix4x4<T> inverse;
+		if (!Matrix4x4<T>::GetInverse(aMatrix, inverse))
+		{
+			return false;
+		}
+		TransformInverseTranspose(Matrix4x4<T>::Transpose(inverse));
+		return true;
+	}
+
+	template<typename T>
+	inline void PlaneSet<T>::TransformInverseTranspose(const Matrix4x4<T>& aInverseTranspose)
+	{
+		T matrix[4][4];
+		for (int row = 0; row < 4; row++)
+		{
+			for (int column = 0; column < 4; column++)
+			{
+				matrix[row][column] = aInverseTranspose(row + 1, column + 1);
+			}
+		}
+
+		T* x = m_Normals.X();
+		T* y = m_Normals.Y();
+		T* z = m_Normals.Z();
+		T* distances = m_Distances.data();
+		for (std::size_t index = 0; index < Size(); index++)
+		{
+			const T resultX = x[index] * matrix[0][0] + y[index] * matrix[1][0] + z[index] * matrix[2][0] + distances[index] * matrix[3][0];
+			const T resultY = x[index] * matrix[0][1] + y[index] * matrix[1][1] + z[index] * matrix[2][1] + distances[index] * matrix[3][1];
+			const T resultZ = x[index] * matrix[0][2] + y[index] * matrix[1][2] + z[index] * matrix[2][2] + distances[index] * matrix[3][2];
+			const T resultDistance = x[index] * matrix[0][3] + y[index] * matrix[1][3] + z[index] * matrix[2][3] + distances[index] * matrix[3][3];
+			const T inverseLength = T(1) / std::sqrt(resultX * resultX + resultY * resultY + resultZ * resultZ);
+			x[index] = resultX * inverseLength;
+			y[index] = resultY * inverseLength;
+			z[index] = resultZ * inverseLength;
+			distances[index] = resultDistance * inverseLength;
+		}
+	}
+
+	template<typename T>
+	inline const Vector3Stream<T>& PlaneSet<T>::GetNormals() const
+	{
+		return m_Normals;
+	}
+
+	template<typename T>
+	inline std::span<const T> PlaneSet<T>::GetDistances() const
+	{
+		return m_Distances;
+	}
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cmath>
+#include <limits>
+
 #include "Plane.hpp"
 #include "SimpleList.hpp"
 #include "Matrix4x4.hpp"
@@ -13,17 +16,21 @@ namespace stm
 		PlaneVolume() = default;
 		PlaneVolume(const SimpleList<Plane<T>>& aPlaneList);
 
+		// The six clip planes of a view projection matrix with normals pointing out of the frustum, world space when
+		// aViewProjection is view * projection. The far plane of an infinite projection is skipped, leaving five.
+		static PlaneVolume<T> CreateFrustum(const Matrix4x4<T>& aViewProjection);
+
 		void AddPlane(const Plane<T>& aPlane);
 
-		bool Inside(const Vector3<T>& aPosition);
+		bool Inside(const Vector3<T>& aPosition) const;
 
 		const std::size_t Size() const;
 
-		const SimpleList<Plane<T>>& GetPlanes();
+		const SimpleList<Plane<T>>& GetPlanes() const;
 
 	private:
-		template<typename T>
-		friend inline PlaneVolume<T> operator*(const PlaneVolume<T>& aPlaneVolume, const Matrix4x4<T>& aMatrix);
+		template<typename U>
+		friend inline PlaneVolume<U> operator*(const PlaneVolume<U>& aPlaneVolume, const Matrix4x4<U>& aMatrix);
 
 		SimpleList<Plane<T>> m_Data;
 	};
@@ -34,16 +41,66 @@ namespace stm
 		m_Data = aPlaneList;
 	}
 
+	template<typename T>
+	inline PlaneVolume<T> PlaneVolume<T>::CreateFrustum(const Matrix4x4<T>& aViewProjection)
+	{
+		// With clip = v * M every clip test is a dot product with a column of M, -w <= x becomes 0 <= v . (column4 + column1).
+		Vector4<T> columns[4];
+		T lengths[4];
+		for (int column = 0; column < 4; column++)
+		{
+			columns[column] = Vector4<T>(aViewProjection(1, column + 1), aViewProjection(2, column + 1), aViewProjection(3, column + 1), aViewProjection(4, column + 1));
+			lengths[column] = Vector3<T>(columns[column].x, columns[column].y, columns[column].z).Length();
+		}
+		const Vector4<T> planes[6] =
+		{
+			columns[3] + columns[0],
+			columns[3] - columns[0],
+			columns[3] + columns[1],
+			columns[3] - columns[1],
+			columns[2],
+			columns[3] - columns[2]
+		};
+		// The size of the columns each normal was summed from, what is left of it after cancelling is rounding.
+		const T scales[6] =
+		{
+			lengths[3] + lengths[0],
+			lengths[3] + lengths[0],
+			lengths[3] + lengths[1],
+			lengths[3] + lengths[1],
+			lengths[2],
+			lengths[3] + lengths[2]
+		};
+
+		// Only a normal that is gone, like the far plane of an infinite projection, drops its plane. The w
+		// component grows with the camera's distance from the origin and plays no part in that.
+		PlaneVolume<T> frustum;
+		for (int index = 0; index < 6; index++)
+		{
+			const Vector4<T>& plane = planes[index];
+			const Vector3<T> normal(-plane.x, -plane.y, -plane.z);
+			const T lengthSqr = normal.LengthSqr();
+			const T tolerance = 16 * std::numeric_limits<T>::epsilon() * scales[index];
+			if (lengthSqr < std::numeric_limits<T>::min() || lengthSqr <= tolerance * tolerance)
+			{
+				continue;
+			}
+			const T inverseLength = T(1) / std::sqrt(lengthSqr);
+			frustum.AddPlane(Plane<T>(normal * inverseLength, -plane.w * inverseLength));
+		}
+		return frustum;
+	}
+
 	template<typename T>
 	inline void PlaneVolume<T>::AddPlane(const Plane<T>& aPlane)
 	{
-		m_Data.push_back(aPlane);
+		m_Data.Add(aPlane);
 	}
 	
 	template<typename T>
-	inline bool PlaneVolume<T>::Inside(const Vector3<T>& aPosition)
+	inline bool PlaneVolume<T>::Inside(const Vector3<T>& aPosition) const
 	{
-		for (auto& iterator : m_Data)
+		for (const auto& iterator : m_Data)
 		{
 			if (!iterator.Inside(aPosition))
 			{
@@ -61,23 +118,32 @@ namespace stm
 	}
 
 	template<typename T>
-	inline const SimpleList<Plane<T>>& PlaneVolume<T>::GetPlanes()
+	inline const SimpleList<Plane<T>>& PlaneVolume<T>::GetPlanes() const
 	{
 		return m_Data;
 	}
 
+	// The volume around the points of aPlaneVolume transformed by aMatrix, a singular matrix leaves it as is.
+	// PlaneSet::Transform does the same in place.
 	template<typename T>
-	PlaneVolume<T> operator*(const PlaneVolume<T>& aPlaneVolume, const Matrix4x4<T>& aMatrix)
+	inline PlaneVolume<T> operator*(const PlaneVolume<T>& aPlaneVolume, const Matrix4x4<T>& aMatrix)
 	{
+		Matrix4x4<T> inverse;
+		if (!Matrix4x4<T>::GetInverse(aMatrix, inverse))
+		{
+			return aPlaneVolume;
+		}
+		const Matrix4x4<T> inverseTranspose = Matrix4x4<T>::Transpose(inverse);
+
 		PlaneVolume<T> returnValue;
-		for (int i = 0; i < aPlaneVolume.m_Data.Size(); i++)
+		for (const Plane<T>& plane : aPlaneVolume.m_Data)
 		{
-			Vector4<T> point4 = *(Vector4<T>*) & aPlaneVolume.m_Data[i].Point();
-			point4.w = 1.f;
-			Vector4<T> normal4 = *(Vector4<T>*) & aPlaneVolume.m_Data[i].Normal();
-			normal4.w = 0.f;
+			const Vector3<T>& normal = plane.Normal();
+			const Vector4<T> plane4 = Vector4<T>(normal.x, normal.y, normal.z, plane.Distance()) * inverseTranspose;
+			const Vector3<T> normal3(plane4.x, plane4.y, plane4.z);
+			const T inverseLength = T(1) / normal3.Length();
 
-			returnValue.AddPlane(Plane<T>(*(Vector3<T>*) & (point4 * aMatrix), *(Vector3<T>*) & (normal4 * aMatrix)));
+			returnValue.AddPlane(Plane<T>(normal3 * inverseLength, plane4.w * inverseLength));
 		}
 		return returnValue;
 	}
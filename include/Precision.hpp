@@ -0,0 +1,19 @@
+#pragma once
+
+namespace stm
+{
+	// Selects how Length, Normalize and GetNormalized compute 1 / sqrt(x) for float.
+	// Relative error of that reciprocal square root:
+	//   Exact   - sqrt and divide, correctly rounded.
+	//   Fast    - hardware estimate refined by one Newton-Raphson step, below 2.5e-7 (about 2 ULP).
+	//   Fastest - the hardware estimate alone, below 3.7e-4 (1.5 * 2^-12, about 12 bits).
+	// Double precision, STM_NO_SIMD builds and constant evaluation always use Exact.
+	// Math and Simd transcendentals use the same tiers with Exact being libm. Their polynomials are plain float
+	// arithmetic, so unlike the above they also apply in STM_NO_SIMD builds, see FastMath.hpp for their error.
+	enum class Precision
+	{
+		Exact,
+		Fast,
+		Fastest
+	};
+}
\ No newline at end of file
@@ -1,4 +1,8 @@
 #pragma once
+#include "EulerAngle.hpp"
+#include "Math.hpp"
+#include "Matrix3x3.hpp"
+#include "Precision.hpp"
 #include "Vector3.hpp"
 #include "Vector4.hpp"
 
@@ -7,26 +11,128 @@ namespace stm
 	class Quaternion
 	{
 	public:
-		Quaternion();
+		constexpr Quaternion();
 		~Quaternion() = default;
-		Quaternion(float aR, float aI, float aJ, float aK);
+		constexpr Quaternion(float aR, float aI, float aJ, float aK);
+		// Euler angles in degrees, the rotation of Quaternion(aY, up) * Quaternion(aX, right) * Quaternion(aZ, forward).
 		Quaternion(float aX, float aY, float aZ);
-		Quaternion(const Quaternion& aQuaternion);
+		template<typename T>
+		explicit Quaternion(const EulerAngle<T>& aEulerAngle);
+		constexpr Quaternion(const Quaternion& aQuaternion) = default;
 		Quaternion(const float aDegreeAngle, const Vector3f& aRotationAxis);
+		// From a pure rotation whose rows are the rotated x, y and z axes, as in Transform::CreateMatrix.
+		explicit Quaternion(const Matrix3x3<float>& aRotation);
 
+		constexpr Quaternion& operator=(const Quaternion& aQuaternion) = default;
+
+		// Inverse of the Euler angle constructor, x in [-90, 90] and y, z in [-180, 180]. At x = +-90 z is 0 and y
+		// holds the whole turn about the vertical.
 		const Vector3f GetEuler() const;
+		template<typename T = float>
+		EulerAngle<T> GetEulerAngle() const;
 
-		const Quaternion operator*(const Quaternion& aOther) const;
-		void operator*=(const Quaternion& aOther);
+		constexpr const Quaternion operator*(const Quaternion& aOther) const;
+		constexpr void operator*=(const Quaternion& aOther);
 
-		const Vector3f Rotate(const Vector3f& aVector) const;
-		const Vector4f Rotate(const Vector4f& aVector) const;
+		constexpr const Vector3f Rotate(const Vector3f& aVector) const;
+		constexpr const Vector4f Rotate(const Vector4f& aVector) const;
+		// Rows are the rotated x, y and z axes, so v * matrix equals Rotate(v). Worth it from a handful of vectors on.
+		constexpr const Matrix3x3f CreateRotationMatrix() const;
 
+		template<Precision P = Precision::Exact>
 		void Normalize();
 
+		// GetEuler treats the rotation as looking straight up or down when the squared length of the rotated
+		// forward axis in the xz plane drops below this, about 0.02 degrees from either pole.
+		static constexpr float GimbalLockThreshold = 1e-7f;
+
 		float r;
 		float i;
 		float j;
 		float k;
 	};
+
+	constexpr Quaternion::Quaternion() : r(1), i(0), j(0), k(0)
+	{
+
+	}
+
+	constexpr Quaternion::Quaternion(float aR, float aI, float aJ, float aK) : r(aR), i(aI), j(aJ), k(aK)
+	{
+
+	}
+
+	template<typename T>
+	inline Quaternion::Quaternion(const EulerAngle<T>& aEulerAngle)
+		: Quaternion(static_cast<float>(aEulerAngle.x), static_cast<float>(aEulerAngle.y), static_cast<float>(aEulerAngle.z))
+	{
+
+	}
+
+	template<typename T>
+	inline EulerAngle<T> Quaternion::GetEulerAngle() const
+	{
+		const Vector3f euler = GetEuler();
+		return { static_cast<T>(euler.x), static_cast<T>(euler.y), static_cast<T>(euler.z) };
+	}
+
+	constexpr const Quaternion Quaternion::operator*(const Quaternion& aOther) const
+	{
+		return Quaternion(r * aOther.r - i * aOther.i - j * aOther.j - k * aOther.k,
+			r * aOther.i + i * aOther.r + j * aOther.k - k * aOther.j,
+			r * aOther.j - i * aOther.k + j * aOther.r + k * aOther.i,
+			r * aOther.k + i * aOther.j - j * aOther.i + k * aOther.r);
+	}
+
+	constexpr void Quaternion::operator*=(const Quaternion& aOther)
+	{
+		*this = *this * aOther;
+	}
+
+	constexpr const Vector3f Quaternion::Rotate(const Vector3f& aVector) const
+	{
+		Vector3f vectorPart(i, j, k);
+
+		return 2.0f * vectorPart.Dot(aVector) * vectorPart
+			+ (r * r - vectorPart.Dot(vectorPart)) * aVector
+			+ 2.0f * r * vectorPart.Cross(aVector);
+	}
+
+	constexpr const Vector4f Quaternion::Rotate(const Vector4f& aVector) const
+	{
+		return Vector4f(Rotate(Vector3f(aVector.x, aVector.y, aVector.z)), aVector.w);
+	}
+
+	constexpr const Matrix3x3f Quaternion::CreateRotationMatrix() const
+	{
+		const float rr = r * r;
+		const float ii = i * i;
+		const float jj = j * j;
+		const float kk = k * k;
+
+		Matrix3x3f matrix;
+		matrix(1, 1) = rr + ii - jj - kk;
+		matrix(1, 2) = 2.0f * (i * j + r * k);
+		matrix(1, 3) = 2.0f * (i * k - r * j);
+		matrix(2, 1) = 2.0f * (i * j - r * k);
+		matrix(2, 2) = rr - ii + jj - kk;
+		matrix(2, 3) = 2.0f * (j * k + r * i);
+		matrix(3, 1) = 2.0f * (i * k + r * j);
+		matrix(3, 2) = 2.0f * (j * k - r * i);
+		matrix(3, 3) = rr - ii - jj + kk;
+		return matrix;
+	}
+
+	template<Precision P>
+	inline void Quaternion::Normalize()
+	{
+		float lengthSqr = r * r + i * i + j * j + k * k;
+		assert(lengthSqr != 0 && "Division by 0");
+
+		float result = Math::ReciprocalSqrt<P>(lengthSqr);
+		r *= result;
+		i *= result;
+		j *= result;
+		k *= result;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+#include <span>
+#include <vector>
+
+#include "Batch.hpp"
+#include "Quaternion.hpp"
+#include "Vector3Stream.hpp"
+
+namespace stm
+{
+	// Structure of arrays storage for Quaternion, so N vectors can be rotated by N quaternions lane by lane.
+	class QuaternionStream
+	{
+	public:
+		QuaternionStream() = default;
+		explicit QuaternionStream(std::size_t aSize);
+		explicit QuaternionStream(std::span<const Quaternion> aQuaternions);
+		~QuaternionStream() = default;
+
+		void Resize(std::size_t aSize);
+		std::size_t Size() const;
+
+		void Load(std::span<const Quaternion> aQuaternions);
+		void Store(std::span<Quaternion> aQuaternions) const;
+
+		Quaternion Get(std::size_t aIndex) const;
+		void Set(std::size_t aIndex, const Quaternion& aQuaternion);
+
+		float* R();
+		float* I();
+		float* J();
+		float* K();
+		const float* R() const;
+		const float* I() const;
+		const float* J() const;
+		const float* K() const;
+
+		// aResult[n] = element n rotating aVectors[n], every quaternion must be of unit length.
+		void Rotate(const Vector3Stream<float>& aVectors, Vector3Stream<float>& aResult, Batch::Execution aExecution = Batch::Execution::Sequential) const;
+
+	private:
+		std::vector<float> m_R;
+		std::vector<float> m_I;
+		std::vector<float> m_J;
+		std::vector<float> m_K;
+	};
+}
@@ -1,8 +1,14 @@
 #pragma once
+#include <limits>
+#include <type_traits>
+#include "AABB3D.hpp"
 #include "Vector3.hpp"
 
 namespace stm
 {
+	// Distances along the ray are in multiples of its direction, so a ray built from two points reaches the second
+	// at 1. The inverse direction is kept for the slab test and only exists for floating point rays, axis aligned
+	// directions give infinite components there.
 	template<typename T>
 	class Ray
 	{
@@ -16,10 +22,18 @@ namespace stm
 
 		const Vector3<T>& GetPosition() const;
 		const Vector3<T>& GetDirection() const;
+		const Vector3<T>& GetInverseDirection() const;
+
+		// Branch free slab test. True when the ray enters or starts in aAABB3D between 0 and aMaxDistance, aEntry
+		// is then the larger of 0 and where the ray enters it.
+		bool Intersects(const AABB3D<T>& aAABB3D, T& aEntry, T aMaxDistance = std::numeric_limits<T>::infinity()) const;
+		bool Intersects(const AABB3D<T>& aAABB3D) const;
 	private:
+		void UpdateInverseDirection();
 
 		Vector3<T> m_Position;
 		Vector3<T> m_Direction;
+		Vector3<T> m_InverseDirection;
 	};
 
 	template<typename T>
@@ -27,12 +41,14 @@ namespace stm
 	{
 		m_Direction = Vector3f(0, 0, 1);
 		m_Position = Vector3f();
+		UpdateInverseDirection();
 	}
 
 	template<typename T>
 	inline Ray<T>::Ray(const Ray<T>& aRay) :
 		m_Position(aRay.m_Position),
-		m_Direction(aRay.m_Direction)
+		m_Direction(aRay.m_Direction),
+		m_InverseDirection(aRay.m_InverseDirection)
 	{
 	}
 
@@ -41,6 +57,7 @@ namespace stm
 		m_Position(aOrigin),
 		m_Direction(aPoint - aOrigin)
 	{
+		UpdateInverseDirection();
 	}
 
 	template<typename T>
@@ -48,6 +65,7 @@ namespace stm
 	{
 		m_Position = aOrigin;
 		m_Direction = aPoint - aOrigin;
+		UpdateInverseDirection();
 	}
 	
 	template<typename T>
@@ -55,6 +73,7 @@ namespace stm
 	{
 		m_Position = aOrigin;
 		m_Direction = aDirection;
+		UpdateInverseDirection();
 	}
 
 	template<typename T>
@@ -68,4 +87,50 @@ namespace stm
 	{
 		return m_Direction;
 	}
+
+	template<typename T>
+	inline const Vector3<T>& Ray<T>::GetInverseDirection() const
+	{
+		return m_InverseDirection;
+	}
+
+	template<typename T>
+	inline bool Ray<T>::Intersects(const AABB3D<T>& aAABB3D, T& aEntry, T aMaxDistance) const
+	{
+		static_assert(std::is_floating_point_v<T>, "The slab test needs a floating point ray");
+
+		// An axis whose products are NaN, a ray lying in one of its slab planes, fails every compare and is skipped.
+		T entry = 0;
+		T exit = aMaxDistance;
+		auto slab = [&entry, &exit](T aMin, T aMax, T aPosition, T aInverse)
+		{
+			const T near = (aMin - aPosition) * aInverse;
+			const T far = (aMax - aPosition) * aInverse;
+			const T axisEntry = far < near ? far : near;
+			const T axisExit = far < near ? near : far;
+			entry = axisEntry > entry ? axisEntry : entry;
+			exit = axisExit < exit ? axisExit : exit;
+		};
+		slab(aAABB3D.Min().x, aAABB3D.Max().x, m_Position.x, m_InverseDirection.x);
+		slab(aAABB3D.Min().y, aAABB3D.Max().y, m_Position.y, m_InverseDirection.y);
+		slab(aAABB3D.Min().z, aAABB3D.Max().z, m_Position.z, m_InverseDirection.z);
+		aEntry = entry;
+		return entry <= exit;
+	}
+
+	template<typename T>
+	inline bool Ray<T>::Intersects(const AABB3D<T>& aAABB3D) const
+	{
+		T entry;
+		return Intersects(aAABB3D, entry);
+	}
+
+	template<typename T>
+	inline void Ray<T>::UpdateInverseDirection()
+	{
+		if constexpr (std::is_floating_point_v<T>)
+		{
+			m_InverseDirection = Vector3<T>(T(1) / m_Direction.x, T(1) / m_Direction.y, T(1) / m_Direction.z);
+		}
+	}
 }
\ No newline at end of file
@@ -0,0 +1,123 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#include "AABB3D.hpp"
+#include "Ray.hpp"
+#include "Simd.hpp"
+
+namespace stm
+{
+	// N float rays stored axis by axis, so one box is tested against all of them at once. Every four lanes go
+	// through one SSE register whatever the including code is built with, so all translation units share one
+	// definition. Lanes that were never set hold the default Ray.
+	template<std::size_t N>
+	class RayPacket
+	{
+		static_assert(N == 4 || N == 8, "Packets hold 4 or 8 rays");
+
+	public:
+		RayPacket();
+
+		void Set(std::size_t aLane, const Ray<float>& aRay);
+
+		// Bit n is set when ray n enters or starts in aAABB3D between 0 and aMaxDistances[n], aEntries[n] is then
+		// the same entry distance Ray::Intersects gives. The entries of lanes that miss are unspecified.
+		std::uint32_t Intersect(const AABB3D<float>& aAABB3D, std::span<const float, N> aMaxDistances, std::span<float, N> aEntries) const;
+		std::uint32_t Intersect(const AABB3D<float>& aAABB3D, float aMaxDistance = std::numeric_limits<float>::infinity()) const;
+
+	private:
+		alignas(N * sizeof(float)) float m_Position[3][N];
+		alignas(N * sizeof(float)) float m_InverseDirection[3][N];
+	};
+
+	using RayPacket4 = RayPacket<4>;
+	using RayPacket8 = RayPacket<8>;
+
+	template<std::size_t N>
+	inline RayPacket<N>::RayPacket()
+	{
+		const Ray<float> ray;
+		for (std::size_t lane = 0; lane < N; lane++)
+		{
+			Set(lane, ray);
+		}
+	}
+
+	template<std::size_t N>
+	inline void RayPacket<N>::Set(std::size_t aLane, const Ray<float>& aRay)
+	{
+		assert(aLane < N && "Lane out of range");
+
+		m_Position[0][aLane] = aRay.GetPosition().x;
+		m_Position[1][aLane] = aRay.GetPosition().y;
+		m_Position[2][aLane] = aRay.GetPosition().z;
+		m_InverseDirection[0][aLane] = aRay.GetInverseDirection().x;
+		m_InverseDirection[1][aLane] = aRay.GetInverseDirection().y;
+		m_InverseDirection[2][aLane] = aRay.GetInverseDirection().z;
+	}
+
+	template<std::size_t N>
+	inline std::uint32_t RayPacket<N>::Intersect(const AABB3D<float>& aAABB3D, std::span<const float, N> aMaxDistances, std::span<float, N> aEntries) const
+	{
+		const float min[3] = { aAABB3D.Min().x, aAABB3D.Min().y, aAABB3D.Min().z };
+		const float max[3] = { aAABB3D.Max().x, aAABB3D.Max().y, aAABB3D.Max().z };
+
+		// The min and max operands are ordered like the compares in Ray::Intersects, so NaN products skip the
+		// same axes and every lane gives the same answer as its ray would alone.
+#ifdef STM_SIMD_SSE
+		std::uint32_t mask = 0;
+		for (std::size_t half = 0; half < N; half += 4)
+		{
+			__m128 entry = _mm_setzero_ps();
+			__m128 exit = _mm_loadu_ps(aMaxDistances.data() + half);
+			for (int axis = 0; axis < 3; axis++)
+			{
+				const __m128 position = _mm_load_ps(m_Position[axis] + half);
+				const __m128 inverse = _mm_load_ps(m_InverseDirection[axis] + half);
+				const __m128 near = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(min[axis]), position), inverse);
+				const __m128 far = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(max[axis]), position), inverse);
+				entry = _mm_max_ps(_mm_min_ps(far, near), entry);
+				exit = _mm_min_ps(_mm_max_ps(near, far), exit);
+			}
+			_mm_storeu_ps(aEntries.data() + half, entry);
+			mask |= static_cast<std::uint32_t>(_mm_movemask_ps(_mm_cmple_ps(entry, exit))) << half;
+		}
+		return mask;
+#else
+		std::uint32_t mask = 0;
+		for (std::size_t lane = 0; lane < N; lane++)
+		{
+			float entry = 0.0f;
+			float exit = aMaxDistances[lane];
+			for (int axis = 0; axis < 3; axis++)
+			{
+				const float near = (min[axis] - m_Position[axis][lane]) * m_InverseDirection[axis][lane];
+				const float far = (max[axis] - m_Position[axis][lane]) * m_InverseDirection[axis][lane];
+				const float axisEntry = far < near ? far : near;
+				const float axisExit = near > far ? near : far;
+				entry = axisEntry > entry ? axisEntry : entry;
+				exit = axisExit < exit ? axisExit : exit;
+			}
+			aEntries[lane] = entry;
+			mask |= static_cast<std::uint32_t>(entry <= exit) << lane;
+		}
+		return mask;
+#endif
+	}
+
+	template<std::size_t N>
+	inline std::uint32_t RayPacket<N>::Intersect(const AABB3D<float>& aAABB3D, float aMaxDistance) const
+	{
+		float maxDistances[N];
+		float entries[N];
+		for (std::size_t lane = 0; lane < N; lane++)
+		{
+			maxDistances[lane] = aMaxDistance;
+		}
+		return Intersect(aAABB3D, maxDistances, entries);
+	}
+}
@@ -0,0 +1,269 @@
+#pragma once
+#include "FastMath.hpp"
+#include "Precision.hpp"
+
+// Define STM_NO_SIMD to force the scalar templates everywhere.
+#if !defined(STM_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define STM_SIMD_SSE 1
+#endif
+
+#if defined(STM_SIMD_SSE) && (defined(__SSE4_1__) || defined(__AVX__))
+#define STM_SIMD_SSE41 1
+#endif
+
+#if defined(STM_SIMD_SSE) && (defined(__FMA__) || defined(__AVX2__))
+#define STM_SIMD_FMA 1
+#endif
+
+#ifdef STM_SIMD_SSE
+#include <cmath>
+#include <immintrin.h>
+
+namespace stm
+{
+	namespace Simd
+	{
+		inline __m128 Splat(float aValue)
+		{
+			return _mm_set1_ps(aValue);
+		}
+
+		inline __m128 MultiplyAdd(__m128 aA, __m128 aB, __m128 aC)
+		{
+#ifdef STM_SIMD_FMA
+			return _mm_fmadd_ps(aA, aB, aC);
+#else
+			return _mm_add_ps(_mm_mul_ps(aA, aB), aC);
+#endif
+		}
+
+		// Sum of all four lanes, broadcast to every lane.
+		inline __m128 HorizontalSum(__m128 aValue)
+		{
+			__m128 shuffled = _mm_shuffle_ps(aValue, aValue, _MM_SHUFFLE(2, 3, 0, 1));
+			__m128 sums = _mm_add_ps(aValue, shuffled);
+			shuffled = _mm_shuffle_ps(sums, sums, _MM_SHUFFLE(1, 0, 3, 2));
+			return _mm_add_ps(sums, shuffled);
+		}
+
+		inline __m128 Dot4(__m128 aA, __m128 aB)
+		{
+#ifdef STM_SIMD_SSE41
+			return _mm_dp_ps(aA, aB, 0xFF);
+#else
+			return HorizontalSum(_mm_mul_ps(aA, aB));
+#endif
+		}
+
+		// Dot product of the xyz lanes; the w lane of both inputs is ignored.
+		inline __m128 Dot3(__m128 aA, __m128 aB)
+		{
+#ifdef STM_SIMD_SSE41
+			return _mm_dp_ps(aA, aB, 0x7F);
+#else
+			__m128 product = _mm_mul_ps(aA, aB);
+			__m128 y = _mm_shuffle_ps(product, product, _MM_SHUFFLE(1, 1, 1, 1));
+			__m128 z = _mm_shuffle_ps(product, product, _MM_SHUFFLE(2, 2, 2, 2));
+			__m128 sum = _mm_add_ss(_mm_add_ss(product, y), z);
+			return _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(0, 0, 0, 0));
+#endif
+		}
+
+		// xyz cross product, the w lane of the result is 0 when both w lanes are 0.
+		inline __m128 Cross3(__m128 aA, __m128 aB)
+		{
+			__m128 aYZX = _mm_shuffle_ps(aA, aA, _MM_SHUFFLE(3, 0, 2, 1));
+			__m128 bYZX = _mm_shuffle_ps(aB, aB, _MM_SHUFFLE(3, 0, 2, 1));
+			__m128 result = _mm_sub_ps(_mm_mul_ps(aA, bYZX), _mm_mul_ps(aYZX, aB));
+			return _mm_shuffle_ps(result, result, _MM_SHUFFLE(3, 0, 2, 1));
+		}
+
+		// 1 / sqrt in every lane, see Precision for the error of each mode.
+		template<Precision P>
+		inline __m128 ReciprocalSqrt(__m128 aValue)
+		{
+			if constexpr (P == Precision::Exact)
+			{
+				return _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(aValue));
+			}
+			else
+			{
+				__m128 estimate = _mm_rsqrt_ps(aValue);
+				if constexpr (P == Precision::Fast)
+				{
+					__m128 halfValue = _mm_mul_ps(_mm_set1_ps(0.5f), aValue);
+					estimate = _mm_mul_ps(estimate, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(halfValue, _mm_mul_ps(estimate, estimate))));
+				}
+				return estimate;
+			}
+		}
+
+		// Outside Exact this is x * (1 / sqrt(x)), lanes holding 0 stay 0.
+		template<Precision P>
+		inline __m128 Sqrt(__m128 aValue)
+		{
+			if constexpr (P == Precision::Exact)
+			{
+				return _mm_sqrt_ps(aValue);
+			}
+			else
+			{
+				return _mm_and_ps(_mm_cmpgt_ps(aValue, _mm_setzero_ps()), _mm_mul_ps(aValue, ReciprocalSqrt<P>(aValue)));
+			}
+		}
+
+		// 2x2 row major matrices packed as (m11, m12, m21, m22), Adjugate marks the operand whose adjugate is used.
+		inline __m128 Matrix2Multiply(__m128 aA, __m128 aB)
+		{
+			return _mm_add_ps(
+				_mm_mul_ps(aA, _mm_shuffle_ps(aB, aB, _MM_SHUFFLE(3, 0, 3, 0))),
+				_mm_mul_ps(_mm_shuffle_ps(aA, aA, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(aB, aB, _MM_SHUFFLE(1, 2, 1, 2))));
+		}
+
+		inline __m128 Matrix2AdjugateMultiply(__m128 aA, __m128 aB)
+		{
+			return _mm_sub_ps(
+				_mm_mul_ps(_mm_shuffle_ps(aA, aA, _MM_SHUFFLE(0, 0, 3, 3)), aB),
+				_mm_mul_ps(_mm_shuffle_ps(aA, aA, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(aB, aB, _MM_SHUFFLE(1, 0, 3, 2))));
+		}
+
+		inline __m128 Matrix2MultiplyAdjugate(__m128 aA, __m128 aB)
+		{
+			return _mm_sub_ps(
+				_mm_mul_ps(aA, _mm_shuffle_ps(aB, aB, _MM_SHUFFLE(0, 3, 0, 3))),
+				_mm_mul_ps(_mm_shuffle_ps(aA, aA, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(aB, aB, _MM_SHUFFLE(1, 2, 1, 2))));
+		}
+
+		inline float GetX(__m128 aValue)
+		{
+			return _mm_cvtss_f32(aValue);
+		}
+
+		// __m128 as FastMath lanes.
+		struct Lanes
+		{
+			using Register = __m128;
+
+			static __m128 Splat(float aValue) { return _mm_set1_ps(aValue); }
+			static __m128 Add(__m128 aA, __m128 aB) { return _mm_add_ps(aA, aB); }
+			static __m128 Sub(__m128 aA, __m128 aB) { return _mm_sub_ps(aA, aB); }
+			static __m128 Mul(__m128 aA, __m128 aB) { return _mm_mul_ps(aA, aB); }
+			static __m128 Div(__m128 aA, __m128 aB) { return _mm_div_ps(aA, aB); }
+			static __m128 Sqrt(__m128 aA) { return _mm_sqrt_ps(aA); }
+			static __m128 Min(__m128 aA, __m128 aB) { return _mm_min_ps(aA, aB); }
+			static __m128 Max(__m128 aA, __m128 aB) { return _mm_max_ps(aA, aB); }
+			static __m128 MultiplyAdd(__m128 aA, __m128 aB, __m128 aC) { return Simd::MultiplyAdd(aA, aB, aC); }
+			static __m128 Less(__m128 aA, __m128 aB) { return _mm_cmplt_ps(aA, aB); }
+			static __m128 And(__m128 aA, __m128 aB) { return _mm_and_ps(aA, aB); }
+			static __m128 Xor(__m128 aA, __m128 aB) { return _mm_xor_ps(aA, aB); }
+
+			static __m128 Round(__m128 aA)
+			{
+#ifdef STM_SIMD_SSE41
+				return _mm_round_ps(aA, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+#else
+				return _mm_cvtepi32_ps(_mm_cvtps_epi32(aA));
+#endif
+			}
+
+			static __m128 Select(__m128 aMask, __m128 aA, __m128 aB)
+			{
+#ifdef STM_SIMD_SSE41
+				return _mm_blendv_ps(aB, aA, aMask);
+#else
+				return _mm_or_ps(_mm_and_ps(aMask, aA), _mm_andnot_ps(aMask, aB));
+#endif
+			}
+
+			static __m128 Pow2(__m128 aA)
+			{
+				return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(aA), _mm_set1_epi32(127)), 23));
+			}
+		};
+
+		// Exact runs libm lane by lane, the other tiers are the FastMath polynomials.
+		template<typename Function>
+		inline __m128 PerLane(__m128 aValue, const Function& aFunction)
+		{
+			alignas(16) float lanes[4];
+			_mm_store_ps(lanes, aValue);
+			return _mm_setr_ps(aFunction(lanes[0]), aFunction(lanes[1]), aFunction(lanes[2]), aFunction(lanes[3]));
+		}
+
+		template<Precision P>
+		inline void SinCos(__m128 aAngle, __m128& aSin, __m128& aCos)
+		{
+			if constexpr (P == Precision::Exact)
+			{
+				aSin = PerLane(aAngle, [](float aLane) { return std::sin(aLane); });
+				aCos = PerLane(aAngle, [](float aLane) { return std::cos(aLane); });
+			}
+			else
+			{
+				FastMath<Lanes>::SinCos<P>(aAngle, aSin, aCos);
+			}
+		}
+
+		template<Precision P>
+		inline __m128 Sin(__m128 aAngle)
+		{
+			__m128 sine;
+			__m128 cosine;
+			SinCos<P>(aAngle, sine, cosine);
+			return sine;
+		}
+
+		template<Precision P>
+		inline __m128 Cos(__m128 aAngle)
+		{
+			__m128 sine;
+			__m128 cosine;
+			SinCos<P>(aAngle, sine, cosine);
+			return cosine;
+		}
+
+		template<Precision P>
+		inline __m128 Atan2(__m128 aY, __m128 aX)
+		{
+			if constexpr (P == Precision::Exact)
+			{
+				alignas(16) float y[4];
+				alignas(16) float x[4];
+				_mm_store_ps(y, aY);
+				_mm_store_ps(x, aX);
+				return _mm_setr_ps(std::atan2(y[0], x[0]), std::atan2(y[1], x[1]), std::atan2(y[2], x[2]), std::atan2(y[3], x[3]));
+			}
+			else
+			{
+				return FastMath<Lanes>::Atan2<P>(aY, aX);
+			}
+		}
+
+		template<Precision P>
+		inline __m128 Acos(__m128 aValue)
+		{
+			if constexpr (P == Precision::Exact)
+			{
+				return PerLane(aValue, [](float aLane) { return std::acos(aLane); });
+			}
+			else
+			{
+				return FastMath<Lanes>::Acos<P>(aValue);
+			}
+		}
+
+		template<Precision P>
+		inline __m128 Exp(__m128 aValue)
+		{
+			if constexpr (P == Precision::Exact)
+			{
+				return PerLane(aValue, [](float aLane) { return std::exp(aLane); });
+			}
+			else
+			{
+				return FastMath<Lanes>::Exp<P>(aValue);
+			}
+		}
+	}
+}
+#endif
@@ -1,6 +1,7 @@
 #pragma once
 #include <cassert>
 #include <memory>
+#include <utility>
 
 namespace stm
 {
@@ -9,9 +10,14 @@ namespace stm
 	{
 	public:
 		SimpleList();
+		SimpleList(const SimpleList<T>& aList);
+		SimpleList(SimpleList<T>&& aList) noexcept;
 		~SimpleList();
 
-		void Add(const T aData);
+		SimpleList<T>& operator=(const SimpleList<T>& aList);
+		SimpleList<T>& operator=(SimpleList<T>&& aList) noexcept;
+
+		void Add(const T& aData);
 		void Add(T&& aData);
 
 		void Remove(const T aData);
@@ -25,6 +31,11 @@ namespace stm
 		const std::size_t Size() const;
 		const std::size_t Capacity() const;
 
+		T* begin();
+		T* end();
+		const T* begin() const;
+		const T* end() const;
+
 	private:
 		T* m_Data;
 		std::size_t m_Size;
@@ -39,6 +50,29 @@ namespace stm
 		m_Capacity = 4;
 	}
 
+	template<typename T>
+	inline SimpleList<T>::SimpleList(const SimpleList<T>& aList)
+	{
+		m_Data = new T[aList.m_Capacity];
+		m_Size = aList.m_Size;
+		m_Capacity = aList.m_Capacity;
+		for (size_t i = 0; i < m_Size; i++)
+		{
+			m_Data[i] = aList.m_Data[i];
+		}
+	}
+
+	template<typename T>
+	inline SimpleList<T>::SimpleList(SimpleList<T>&& aList) noexcept
+	{
+		m_Data = aList.m_Data;
+		m_Size = aList.m_Size;
+		m_Capacity = aList.m_Capacity;
+		aList.m_Data = nullptr;
+		aList.m_Size = 0;
+		aList.m_Capacity = 0;
+	}
+
 	template<typename T>
 	inline SimpleList<T>::~SimpleList()
 	{
@@ -46,11 +80,38 @@ namespace stm
 	}
 
 	template<typename T>
-	inline void SimpleList<T>::Add(const T aData)
+	inline SimpleList<T>& SimpleList<T>::operator=(const SimpleList<T>& aList)
+	{
+		if (this != &aList)
+		{
+			SimpleList<T> copy(aList);
+			*this = std::move(copy);
+		}
+		return *this;
+	}
+
+	template<typename T>
+	inline SimpleList<T>& SimpleList<T>::operator=(SimpleList<T>&& aList) noexcept
+	{
+		if (this != &aList)
+		{
+			delete[] m_Data;
+			m_Data = aList.m_Data;
+			m_Size = aList.m_Size;
+			m_Capacity = aList.m_Capacity;
+			aList.m_Data = nullptr;
+			aList.m_Size = 0;
+			aList.m_Capacity = 0;
+		}
+		return *this;
+	}
+
+	template<typename T>
+	inline void SimpleList<T>::Add(const T& aData)
 	{
 		if (m_Size == m_Capacity)
 		{
-			m_Capacity *= 2;
+			m_Capacity = m_Capacity == 0 ? 4 : m_Capacity * 2;
 			T* newData = new T[m_Capacity];
 			for (size_t i = 0; i < m_Size; i++)
 			{
@@ -68,7 +129,7 @@ namespace stm
 	{
 		if (m_Size == m_Capacity)
 		{
-			m_Capacity *= 2;
+			m_Capacity = m_Capacity == 0 ? 4 : m_Capacity * 2;
 			T* newData = new T[m_Capacity];
 			for (size_t i = 0; i < m_Size; i++)
 			{
@@ -77,18 +138,23 @@ namespace stm
 			delete[] m_Data;
 			m_Data = newData;
 		}
-		m_Data[(int)m_Size] = aData;
+		m_Data[(int)m_Size] = std::move(aData);
 		m_Size++;
 	}
 
 	template<typename T>
 	inline void SimpleList<T>::Remove(const T aData)
 	{
-		if (aIndex >= m_Size)
+		size_t index = 0;
+		while (index < m_Size && !(m_Data[index] == aData))
+		{
+			index++;
+		}
+		if (index >= m_Size)
 		{
 			return;
 		}
-		for (size_t i = aIndex; i < m_Size - 1; i++)
+		for (size_t i = index; i < m_Size - 1; i++)
 		{
 			m_Data[i] = m_Data[i + 1];
 		}
@@ -140,6 +206,30 @@ namespace stm
 	template<typename T>
 	inline const std::size_t SimpleList<T>::Capacity() const
 	{
-		return m_Capacity
+		return m_Capacity;
+	}
+
+	template<typename T>
+	inline T* SimpleList<T>::begin()
+	{
+		return m_Data;
+	}
+
+	template<typename T>
+	inline T* SimpleList<T>::end()
+	{
+		return m_Data + m_Size;
+	}
+
+	template<typename T>
+	inline const T* SimpleList<T>::begin() const
+	{
+		return m_Data;
+	}
+
+	template<typename T>
+	inline const T* SimpleList<T>::end() const
+	{
+		return m_Data + m_Size;
 	}
 }
\ No newline at end of file
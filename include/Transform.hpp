@@ -2,6 +2,7 @@
 #include "Vector3.hpp"
 #include "Quaternion.hpp"
 #include "Matrix4x4.hpp"
+#include "Matrix3x4.hpp"
 
 namespace stm
 {
@@ -11,6 +12,9 @@ namespace stm
 		Transform();
 		~Transform() = default;
 		Transform(const Transform& aTransform);
+		Transform& operator=(const Transform& aTransform) = default;
+		// Decomposes a scale, rotation and translation matrix, shear is lost.
+		explicit Transform(const Matrix3x4f& aMatrix);
 
 		void SetPosition(const Vector3f& aPosition);
 		
@@ -38,6 +42,7 @@ namespace stm
 		const Vector3f& GetScale() const;
 
 		const Matrix4x4f CreateMatrix() const;
+		const Matrix3x4f CreateAffineMatrix() const;
 
 		friend const Vector3f operator*(const Vector3f& aVector, const Transform& aTransform);
 		friend void operator*=(Vector3f& aVector, const Transform& aTransform);
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Batch.hpp"
+#include "Matrix3x4.hpp"
+#include "Transform.hpp"
+
+namespace stm
+{
+	// Transforms with parents, stored parent before child so one pass in index order sees every parent first.
+	// Changed nodes are queued by depth and Update only rebuilds their subtrees, one depth level at a time so
+	// that every queued node of a level can be computed in parallel.
+	class TransformHierarchy
+	{
+	public:
+		using Handle = std::uint32_t;
+		static constexpr Handle InvalidHandle = ~Handle(0);
+
+		TransformHierarchy() = default;
+		~TransformHierarchy() = default;
+
+		void Reserve(std::size_t aCapacity);
+		void Clear();
+		std::size_t Size() const;
+
+		// aParent must already be in the hierarchy, which is what keeps the parent before child order.
+		Handle Add(const Transform& aLocal, Handle aParent = InvalidHandle);
+
+		Handle GetParent(Handle aHandle) const;
+		std::uint32_t GetDepth(Handle aHandle) const;
+
+		const Transform& GetLocal(Handle aHandle) const;
+		void SetLocal(Handle aHandle, const Transform& aLocal);
+		bool IsDirty(Handle aHandle) const;
+
+		// Cached by Update, stale between a SetLocal and the next Update.
+		const Matrix3x4f& GetLocalMatrix(Handle aHandle) const;
+		const Matrix3x4f& GetWorldMatrix(Handle aHandle) const;
+		std::span<const Matrix3x4f> GetWorldMatrices() const;
+
+		void Update(Batch::Execution aExecution = Batch::Execution::Sequential);
+
+	private:
+		enum Flags : std::uint8_t
+		{
+			LocalDirty = 1,
+			WorldDirty = 2
+		};
+
+		void UpdateNode(Handle aHandle);
+
+		std::vector<Transform> m_Local;
+		std::vector<Handle> m_Parent;
+		std::vector<Handle> m_FirstChild;
+		std::vector<Handle> m_NextSibling;
+		std::vector<std::uint32_t> m_Depth;
+		std::vector<std::uint8_t> m_Flags;
+		std::vector<Matrix3x4f> m_LocalMatrix;
+		std::vector<Matrix3x4f> m_WorldMatrix;
+		// Dirty handles grouped by depth, Update queues the children of each level on the next one.
+		std::vector<std::vector<Handle>> m_DirtyLevels;
+	};
+}
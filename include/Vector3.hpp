@@ -2,6 +2,10 @@
 #include <initializer_list>
 #include <assert.h>
 #include <cmath>
+#include <type_traits>
+#include "Math.hpp"
+#include "Precision.hpp"
+#include "Simd.hpp"
 
 namespace stm
 {
@@ -9,59 +13,128 @@ namespace stm
 	class Vector3
 	{
 	public:
-		static Vector3<T> Up()
+		static constexpr Vector3<T> Up()
 		{
 			return Vector3<T>(0, 1, 0);
 		}
-		static Vector3<T> Down()
+		static constexpr Vector3<T> Down()
 		{
 			return Vector3<T>(0, -1, 0);
 		}
-		static Vector3<T> Right()
+		static constexpr Vector3<T> Right()
 		{
 			return Vector3<T>(1, 0, 0);
 		}
-		static Vector3<T> Left()
+		static constexpr Vector3<T> Left()
 		{
 			return Vector3<T>(-1, 0, 0);
 		}
-		static Vector3<T> Forward()
+		static constexpr Vector3<T> Forward()
 		{
 			return Vector3<T>(0, 0, 1);
 		}
-		static Vector3<T> Back()
+		static constexpr Vector3<T> Back()
 		{
 			return Vector3<T>(0, 0, -1);
 		}
 
 	public:
-		Vector3<T>();
-		Vector3<T>(const T& aX, const T& aY, const T& aZ);
-		Vector3<T>(const Vector3<T>& aVector) = default;
+		constexpr Vector3();
+		constexpr Vector3(const T& aX, const T& aY, const T& aZ);
+		constexpr Vector3(const Vector3<T>& aVector) = default;
 
-		~Vector3<T>() = default;
+		~Vector3() = default;
 
-		inline Vector3<T>& operator=(const Vector3<T>& aVector3) = default;
-		inline Vector3<T> operator-(void);
+		constexpr Vector3<T>& operator=(const Vector3<T>& aVector3) = default;
+		constexpr Vector3<T> operator-(void);
 
-		inline T LengthSqr() const;
+		constexpr T LengthSqr() const;
+		template<Precision P = Precision::Exact>
 		inline T Length() const;
 		inline T Distance(const Vector3<T>& aVector) const;
-		inline T DistanceSqr(const Vector3<T>& aVector) const;
+		constexpr T DistanceSqr(const Vector3<T>& aVector) const;
+		template<Precision P = Precision::Exact>
 		inline Vector3<T> GetNormalized() const;
+		template<Precision P = Precision::Exact>
 		inline void Normalize();
 		inline void Truncate(T aUpperBound);
-		inline T Dot(const Vector3<T>& aVector) const;
-		inline Vector3<T> Cross(const Vector3<T>& aVector) const;
-		static Vector3<T> Lerp(const Vector3<T>& A, const Vector3<T>& B, float aDelta);
+		constexpr T Dot(const Vector3<T>& aVector) const;
+		constexpr Vector3<T> Cross(const Vector3<T>& aVector) const;
+		// The delta is a T, so Fixed32 vectors interpolate without going through float.
+		static constexpr Vector3<T> Lerp(const Vector3<T>& A, const Vector3<T>& B, T aDelta);
 
 		T x;
 		T y;
 		T z;
 	};
 
+#ifdef STM_SIMD_SSE
+	template <>
+	class alignas(16) Vector3<float>
+	{
+	public:
+		static constexpr Vector3<float> Up()
+		{
+			return Vector3<float>(0, 1, 0);
+		}
+		static constexpr Vector3<float> Down()
+		{
+			return Vector3<float>(0, -1, 0);
+		}
+		static constexpr Vector3<float> Right()
+		{
+			return Vector3<float>(1, 0, 0);
+		}
+		static constexpr Vector3<float> Left()
+		{
+			return Vector3<float>(-1, 0, 0);
+		}
+		static constexpr Vector3<float> Forward()
+		{
+			return Vector3<float>(0, 0, 1);
+		}
+		static constexpr Vector3<float> Back()
+		{
+			return Vector3<float>(0, 0, -1);
+		}
+
+	public:
+		constexpr Vector3();
+		constexpr Vector3(const float& aX, const float& aY, const float& aZ);
+		constexpr Vector3(const Vector3<float>& aVector) = default;
+		explicit Vector3(__m128 aRegister);
+
+		~Vector3() = default;
+
+		constexpr Vector3<float>& operator=(const Vector3<float>& aVector3) = default;
+		constexpr Vector3<float> operator-(void);
+
+		inline __m128 Load() const;
+
+		constexpr float LengthSqr() const;
+		template<Precision P = Precision::Exact>
+		inline float Length() const;
+		inline float Distance(const Vector3<float>& aVector) const;
+		constexpr float DistanceSqr(const Vector3<float>& aVector) const;
+		template<Precision P = Precision::Exact>
+		inline Vector3<float> GetNormalized() const;
+		template<Precision P = Precision::Exact>
+		inline void Normalize();
+		inline void Truncate(float aUpperBound);
+		constexpr float Dot(const Vector3<float>& aVector) const;
+		constexpr Vector3<float> Cross(const Vector3<float>& aVector) const;
+		static constexpr Vector3<float> Lerp(const Vector3<float>& A, const Vector3<float>& B, float aDelta);
+
+		float x;
+		float y;
+		float z;
+		// Pads the vector to one 16 byte register, not part of the value.
+		float m_Padding;
+	};
+#endif
+
 	template <typename T>
-	Vector3<T>::Vector3() :
+	constexpr Vector3<T>::Vector3() :
 		x(T()),
 		y(T()),
 		z(T())
@@ -70,7 +143,7 @@ namespace stm
 	}
 
 	template <typename T>
-	Vector3<T>::Vector3(const T& aX, const T& aY, const T& aZ) :
+	constexpr Vector3<T>::Vector3(const T& aX, const T& aY, const T& aZ) :
 		x(aX),
 		y(aY),
 		z(aZ)
@@ -79,49 +152,49 @@ namespace stm
 	}
 
 	template <typename T>
-	inline bool operator==(const Vector3<T>& aVector0, const Vector3<T>& aVector1)
+	constexpr bool operator==(const Vector3<T>& aVector0, const Vector3<T>& aVector1)
 	{
 		return aVector0.x == aVector1.x && aVector0.y == aVector1.y && aVector0.z == aVector1.z;
 	}
 
 	template <typename T>
-	inline bool operator!=(const Vector3<T>& aVector0, const Vector3<T>& aVector1)
+	constexpr bool operator!=(const Vector3<T>& aVector0, const Vector3<T>& aVector1)
 	{
 		return aVector0.x != aVector1.x && aVector0.y != aVector1.y && aVector0.z != aVector1.z;
 	}
 
 	template <typename T>
-	inline Vector3<T> operator+(const Vector3<T>& aVector0, const Vector3<T>& aVector1)
+	constexpr Vector3<T> operator+(const Vector3<T>& aVector0, const Vector3<T>& aVector1)
 	{
 		return Vector3<T>(aVector0.x + aVector1.x, aVector0.y + aVector1.y, aVector0.z + aVector1.z);
 	}
 
 	template <typename T>
-	inline Vector3<T> operator-(const Vector3<T>& aVector0, const Vector3<T>& aVector1)
+	constexpr Vector3<T> operator-(const Vector3<T>& aVector0, const Vector3<T>& aVector1)
 	{
 		return Vector3<T>(aVector0.x - aVector1.x, aVector0.y - aVector1.y, aVector0.z - aVector1.z);
 	}
 
 	template <typename T>
-	inline Vector3<T> Vector3<T>::operator-(void)
+	constexpr Vector3<T> Vector3<T>::operator-(void)
 	{
 		return Vector3<T>(-x, -y, -z);
 	}
 
 	template <typename T>
-	inline Vector3<T> operator*(const Vector3<T>& aVector, const T& aScalar)
+	constexpr Vector3<T> operator*(const Vector3<T>& aVector, const T& aScalar)
 	{
 		return Vector3<T>(aVector.x * aScalar, aVector.y * aScalar, aVector.z * aScalar);
 	}
 
 	template <typename T>
-	inline Vector3<T> operator*(const T& aScalar, const Vector3<T>& aVector)
+	constexpr Vector3<T> operator*(const T& aScalar, const Vector3<T>& aVector)
 	{
 		return Vector3<T>(aVector.x * aScalar, aVector.y * aScalar, aVector.z * aScalar);
 	}
 
 	template <typename T>
-	Vector3<T> operator/(const Vector3<T>& aVector, const T& aScalar)
+	constexpr Vector3<T> operator/(const Vector3<T>& aVector, const T& aScalar)
 	{
 		assert(aScalar != 0 && "Division by 0");
 
@@ -144,19 +217,23 @@ namespace stm
 	}
 
 	template <typename T>
-	inline void operator+=(Vector3<T>& aVector0, const Vector3<T>& aVector1)
+	constexpr void operator+=(Vector3<T>& aVector0, const Vector3<T>& aVector1)
 	{
-		aVector0 = aVector0 + aVector1;
+		aVector0.x += aVector1.x;
+		aVector0.y += aVector1.y;
+		aVector0.z += aVector1.z;
 	}
 
 	template <typename T>
-	inline void operator-=(Vector3<T>& aVector0, const Vector3<T>& aVector1)
+	constexpr void operator-=(Vector3<T>& aVector0, const Vector3<T>& aVector1)
 	{
-		aVector0 = aVector0 - aVector1;
+		aVector0.x -= aVector1.x;
+		aVector0.y -= aVector1.y;
+		aVector0.z -= aVector1.z;
 	}
 
 	template <typename T>
-	inline void operator*=(Vector3<T>& aVector, const T& aScalar)
+	constexpr void operator*=(Vector3<T>& aVector, const T& aScalar)
 	{
 		aVector.x *= aScalar;
 		aVector.y *= aScalar;
@@ -164,7 +241,7 @@ namespace stm
 	}
 
 	template <typename T>
-	inline void operator/=(Vector3<T>& aVector, const T& aScalar)
+	constexpr void operator/=(Vector3<T>& aVector, const T& aScalar)
 	{
 		assert(aScalar != 0 && "Division by 0");
 
@@ -194,15 +271,16 @@ namespace stm
 	}
 
 	template<typename T>
-	inline T Vector3<T>::LengthSqr() const
+	constexpr T Vector3<T>::LengthSqr() const
 	{
 		return x * x + y * y + z * z;
 	}
 
 	template<typename T>
+	template<Precision P>
 	inline T Vector3<T>::Length() const
 	{
-		return std::sqrt(x * x + y * y + z * z);
+		return Math::Sqrt<P>(x * x + y * y + z * z);
 	}
 
 	template<typename T>
@@ -211,11 +289,11 @@ namespace stm
 		T arg1 = x - aVector.x;
 		T arg2 = y - aVector.y;
 		T arg3 = z - aVector.z;
-		return std::sqrt(arg1 * arg1 + arg2 * arg2 + arg3 * arg3);
+		return Math::Sqrt(arg1 * arg1 + arg2 * arg2 + arg3 * arg3);
 	}
 
 	template<typename T>
-	inline T Vector3<T>::DistanceSqr(const Vector3<T>& aVector) const
+	constexpr T Vector3<T>::DistanceSqr(const Vector3<T>& aVector) const
 	{
 		T arg1 = x - aVector.x;
 		T arg2 = y - aVector.y;
@@ -224,20 +302,22 @@ namespace stm
 	}
 
 	template<typename T>
+	template<Precision P>
 	inline Vector3<T> Vector3<T>::GetNormalized() const
 	{
 		assert(x * x + y * y + z * z != 0 && "Division by 0");
 
-		double result = 1 / std::sqrt(x * x + y * y + z * z);
+		T result = Math::ReciprocalSqrt<P>(x * x + y * y + z * z);
 		return Vector3(x * result, y * result, z * result);
 	}
 
 	template<typename T>
+	template<Precision P>
 	inline void Vector3<T>::Normalize()
 	{
-		assert(std::sqrt(x * x + y * y + z * z) != 0 && "Division by 0");
+		assert(x * x + y * y + z * z != 0 && "Division by 0");
 
-		double result = 1 / std::sqrt(x * x + y * y + z * z);
+		T result = Math::ReciprocalSqrt<P>(x * x + y * y + z * z);
 		x *= result;
 		y *= result;
 		z *= result;
@@ -249,28 +329,255 @@ namespace stm
 		T sqrLen = LengthSqr();
 		if (sqrLen > aUpperBound * aUpperBound)
 		{
-			double multiplier = aUpperBound / std::sqrt(sqrLen);
-			x *= multiplier; y *= multiplier;
+			T multiplier = aUpperBound / Math::Sqrt(sqrLen);
+			x *= multiplier; y *= multiplier; z *= multiplier;
 		}
 	}
 
 	template<typename T>
-	inline T Vector3<T>::Dot(const Vector3<T>& aVector) const
+	constexpr T Vector3<T>::Dot(const Vector3<T>& aVector) const
 	{
 		return x * aVector.x + y * aVector.y + z * aVector.z;
 	}
 
 	template<typename T>
-	inline Vector3<T> Vector3<T>::Cross(const Vector3<T>& aVector) const
+	constexpr Vector3<T> Vector3<T>::Cross(const Vector3<T>& aVector) const
 	{
 		return Vector3(y * aVector.z - z * aVector.y, z * aVector.x - x * aVector.z, x * aVector.y - y * aVector.x);
 	}
 
 	template <typename T>
-	Vector3<T> Vector3<T>::Lerp(const  Vector3<T>& a, const  Vector3<T>& b, float aDelta)
+	constexpr Vector3<T> Vector3<T>::Lerp(const  Vector3<T>& a, const  Vector3<T>& b, T aDelta)
 	{
 		return a + aDelta * (b - a);
 	}
 
+#ifdef STM_SIMD_SSE
+	constexpr Vector3<float>::Vector3() :
+		x(0),
+		y(0),
+		z(0),
+		m_Padding(0)
+	{
+
+	}
+
+	constexpr Vector3<float>::Vector3(const float& aX, const float& aY, const float& aZ) :
+		x(aX),
+		y(aY),
+		z(aZ),
+		m_Padding(0)
+	{
+
+	}
+
+	inline Vector3<float>::Vector3(__m128 aRegister)
+	{
+		_mm_store_ps(&x, aRegister);
+	}
+
+	inline __m128 Vector3<float>::Load() const
+	{
+		return _mm_load_ps(&x);
+	}
+
+	constexpr Vector3<float> operator+(const Vector3<float>& aVector0, const Vector3<float>& aVector1)
+	{
+		if (std::is_constant_evaluated())
+		{
+			return Vector3<float>(aVector0.x + aVector1.x, aVector0.y + aVector1.y, aVector0.z + aVector1.z);
+		}
+		return Vector3<float>(_mm_add_ps(aVector0.Load(), aVector1.Load()));
+	}
+
+	constexpr Vector3<float> operator-(const Vector3<float>& aVector0, const Vector3<float>& aVector1)
+	{
+		if (std::is_constant_evaluated())
+		{
+			return Vector3<float>(aVector0.x - aVector1.x, aVector0.y - aVector1.y, aVector0.z - aVector1.z);
+		}
+		return Vector3<float>(_mm_sub_ps(aVector0.Load(), aVector1.Load()));
+	}
+
+	constexpr Vector3<float> Vector3<float>::operator-(void)
+	{
+		if (std::is_constant_evaluated())
+		{
+			return Vector3<float>(-x, -y, -z);
+		}
+		return Vector3<float>(_mm_sub_ps(_mm_setzero_ps(), Load()));
+	}
+
+	constexpr Vector3<float> operator*(const Vector3<float>& aVector, const float& aScalar)
+	{
+		if (std::is_constant_evaluated())
+		{
+			return Vector3<float>(aVector.x * aScalar, aVector.y * aScalar, aVector.z * aScalar);
+		}
+		return Vector3<float>(_mm_mul_ps(aVector.Load(), Simd::Splat(aScalar)));
+	}
+
+	constexpr Vector3<float> operator*(const float& aScalar, const Vector3<float>& aVector)
+	{
+		if (std::is_constant_evaluated())
+		{
+			return aVector * aScalar;
+		}
+		return Vector3<float>(_mm_mul_ps(aVector.Load(), Simd::Splat(aScalar)));
+	}
+
+	constexpr Vector3<float> operator/(const Vector3<float>& aVector, const float& aScalar)
+	{
+		assert(aScalar != 0 && "Division by 0");
+
+		if (std::is_constant_evaluated())
+		{
+			return aVector * (1 / aScalar);
+		}
+		return Vector3<float>(_mm_mul_ps(aVector.Load(), Simd::Splat(1 / aScalar)));
+	}
+
+	constexpr void operator+=(Vector3<float>& aVector0, const Vector3<float>& aVector1)
+	{
+		if (std::is_constant_evaluated())
+		{
+			aVector0.x += aVector1.x;
+			aVector0.y += aVector1.y;
+			aVector0.z += aVector1.z;
+			return;
+		}
+		_mm_store_ps(&aVector0.x, _mm_add_ps(aVector0.Load(), aVector1.Load()));
+	}
+
+	constexpr void operator-=(Vector3<float>& aVector0, const Vector3<float>& aVector1)
+	{
+		if (std::is_constant_evaluated())
+		{
+			aVector0.x -= aVector1.x;
+			aVector0.y -= aVector1.y;
+			aVector0.z -= aVector1.z;
+			return;
+		}
+		_mm_store_ps(&aVector0.x, _mm_sub_ps(aVector0.Load(), aVector1.Load()));
+	}
+
+	constexpr void operator*=(Vector3<float>& aVector, const float& aScalar)
+	{
+		if (std::is_constant_evaluated())
+		{
+			aVector = aVector * aScalar;
+			return;
+		}
+		_mm_store_ps(&aVector.x, _mm_mul_ps(aVector.Load(), Simd::Splat(aScalar)));
+	}
+
+	constexpr void operator/=(Vector3<float>& aVector, const float& aScalar)
+	{
+		assert(aScalar != 0 && "Division by 0");
+
+		if (std::is_constant_evaluated())
+		{
+			aVector = aVector * (1 / aScalar);
+			return;
+		}
+		_mm_store_ps(&aVector.x, _mm_mul_ps(aVector.Load(), Simd::Splat(1 / aScalar)));
+	}
+
+	constexpr float Vector3<float>::LengthSqr() const
+	{
+		if (std::is_constant_evaluated())
+		{
+			return Dot(*this);
+		}
+		__m128 vector = Load();
+		return Simd::GetX(Simd::Dot3(vector, vector));
+	}
+
+	template<Precision P>
+	inline float Vector3<float>::Length() const
+	{
+		__m128 vector = Load();
+		return Simd::GetX(Simd::Sqrt<P>(Simd::Dot3(vector, vector)));
+	}
+
+	inline float Vector3<float>::Distance(const Vector3<float>& aVector) const
+	{
+		__m128 delta = _mm_sub_ps(Load(), aVector.Load());
+		return Simd::GetX(_mm_sqrt_ss(Simd::Dot3(delta, delta)));
+	}
+
+	constexpr float Vector3<float>::DistanceSqr(const Vector3<float>& aVector) const
+	{
+		if (std::is_constant_evaluated())
+		{
+			const Vector3<float> delta = *this - aVector;
+			return delta.Dot(delta);
+		}
+		__m128 delta = _mm_sub_ps(Load(), aVector.Load());
+		return Simd::GetX(Simd::Dot3(delta, delta));
+	}
+
+	template<Precision P>
+	inline Vector3<float> Vector3<float>::GetNormalized() const
+	{
+		__m128 vector = Load();
+		__m128 lengthSqr = Simd::Dot3(vector, vector);
+		assert(Simd::GetX(lengthSqr) != 0 && "Division by 0");
+
+		if constexpr (P == Precision::Exact)
+		{
+			return Vector3<float>(_mm_div_ps(vector, _mm_sqrt_ps(lengthSqr)));
+		}
+		else
+		{
+			return Vector3<float>(_mm_mul_ps(vector, Simd::ReciprocalSqrt<P>(lengthSqr)));
+		}
+	}
+
+	template<Precision P>
+	inline void Vector3<float>::Normalize()
+	{
+		*this = GetNormalized<P>();
+	}
+
+	inline void Vector3<float>::Truncate(float aUpperBound)
+	{
+		float sqrLen = LengthSqr();
+		if (sqrLen > aUpperBound * aUpperBound)
+		{
+			*this *= aUpperBound / std::sqrt(sqrLen);
+		}
+	}
+
+	constexpr float Vector3<float>::Dot(const Vector3<float>& aVector) const
+	{
+		if (std::is_constant_evaluated())
+		{
+			return x * aVector.x + y * aVector.y + z * aVector.z;
+		}
+		return Simd::GetX(Simd::Dot3(Load(), aVector.Load()));
+	}
+
+	constexpr Vector3<float> Vector3<float>::Cross(const Vector3<float>& aVector) const
+	{
+		if (std::is_constant_evaluated())
+		{
+			return Vector3<float>(y * aVector.z - z * aVector.y, z * aVector.x - x * aVector.z, x * aVector.y - y * aVector.x);
+		}
+		return Vector3<float>(Simd::Cross3(Load(), aVector.Load()));
+	}
+
+	constexpr Vector3<float> Vector3<float>::Lerp(const Vector3<float>& a, const Vector3<float>& b, float aDelta)
+	{
+		if (std::is_constant_evaluated())
+		{
+			return a + aDelta * (b - a);
+		}
+		__m128 from = a.Load();
+		return Vector3<float>(Simd::MultiplyAdd(Simd::Splat(aDelta), _mm_sub_ps(b.Load(), from), from));
+	}
+#endif
+
 	using Vector3f = Vector3<float>;
+	using Vector3x = Vector3<Fixed32>;
 }
\ No newline at end of file
@@ -0,0 +1,349 @@
+#pragma once
+#include <cassert>
+#include <cmath>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "Batch.hpp"
+#include "Math.hpp"
+#include "Precision.hpp"
+#include "Vector3.hpp"
+
+namespace stm
+{
+	// Structure of arrays storage for Vector3, every batch function works on all elements at once.
+	template<typename T>
+	class Vector3Stream
+	{
+	public:
+		Vector3Stream() = default;
+		explicit Vector3Stream(std::size_t aSize);
+		explicit Vector3Stream(std::span<const Vector3<T>> aVectors);
+		~Vector3Stream() = default;
+
+		void Resize(std::size_t aSize);
+		std::size_t Size() const;
+
+		void Load(std::span<const Vector3<T>> aVectors);
+		void Store(std::span<Vector3<T>> aVectors) const;
+
+		Vector3<T> Get(std::size_t aIndex) const;
+		void Set(std::size_t aIndex, const Vector3<T>& aVector);
+
+		T* X();
+		T* Y();
+		T* Z();
+		const T* X() const;
+		const T* Y() const;
+		const T* Z() const;
+
+		void LengthSqr(std::span<T> aResult) const;
+		template<Precision P = Precision::Exact>
+		void Length(std::span<T> aResult) const;
+		void DistanceSqr(const Vector3Stream<T>& aOther, std::span<T> aResult) const;
+		template<Precision P = Precision::Exact>
+		void GetNormalized(Vector3Stream<T>& aResult) const;
+		template<Precision P = Precision::Exact>
+		void Normalize();
+		void Dot(const Vector3Stream<T>& aOther, std::span<T> aResult) const;
+		void Cross(const Vector3Stream<T>& aOther, Vector3Stream<T>& aResult) const;
+		static void Lerp(const Vector3Stream<T>& aFrom, const Vector3Stream<T>& aTo, float aDelta, Vector3Stream<T>& aResult);
+
+	private:
+		std::vector<T> m_X;
+		std::vector<T> m_Y;
+		std::vector<T> m_Z;
+	};
+
+	template<typename T>
+	inline Vector3Stream<T>::Vector3Stream(std::size_t aSize) :
+		m_X(aSize),
+		m_Y(aSize),
+		m_Z(aSize)
+	{
+	}
+
+	template<typename T>
+	inline Vector3Stream<T>::Vector3Stream(std::span<const Vector3<T>> aVectors)
+	{
+		Load(aVectors);
+	}
+
+	template<typename T>
+	inline void Vector3Stream<T>::Resize(std::size_t aSize)
+	{
+		m_X.resize(aSize);
+		m_Y.resize(aSize);
+		m_Z.resize(aSize);
+	}
+
+	template<typename T>
+	inline std::size_t Vector3Stream<T>::Size() const
+	{
+		return m_X.size();
+	}
+
+	template<typename T>
+	inline void Vector3Stream<T>::Load(std::span<const Vector3<T>> aVectors)
+	{
+		Resize(aVectors.size());
+
+		std::size_t index = 0;
+#ifdef STM_SIMD_SSE
+		if constexpr (std::is_same_v<T, float>)
+		{
+			// Vector3<float> is padded to 16 bytes, four of them transpose into one register per axis.
+			for (; index + 4 <= aVectors.size(); index += 4)
+			{
+				__m128 row0 = aVectors[index].Load();
+				__m128 row1 = aVectors[index + 1].Load();
+				__m128 row2 = aVectors[index + 2].Load();
+				__m128 row3 = aVectors[index + 3].Load();
+				_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+				_mm_storeu_ps(&m_X[index], row0);
+				_mm_storeu_ps(&m_Y[index], row1);
+				_mm_storeu_ps(&m_Z[index], row2);
+			}
+		}
+#endif
+		for (; index < aVectors.size(); index++)
+		{
+			m_X[index] = aVectors[index].x;
+			m_Y[index] = aVectors[index].y;
+			m_Z[index] = aVectors[index].z;
+		}
+	}
+
+	template<typename T>
+	inline void Vector3Stream<T>::Store(std::span<Vector3<T>> aVectors) const
+	{
+		assert(aVectors.size() >= Size() && "Output span too small");
+
+		std::size_t index = 0;
+#ifdef STM_SIMD_SSE
+		if constexpr (std::is_same_v<T, float>)
+		{
+			for (; index + 4 <= Size(); index += 4)
+			{
+				__m128 row0 = _mm_loadu_ps(&m_X[index]);
+				__m128 row1 = _mm_loadu_ps(&m_Y[index]);
+				__m128 row2 = _mm_loadu_ps(&m_Z[index]);
+				__m128 row3 = _mm_setzero_ps();
+				_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+				aVectors[index] = Vector3<float>(row0);
+				aVectors[index + 1] = Vector3<float>(row1);
+				aVectors[index + 2] = Vector3<float>(row2);
+				aVectors[index + 3] = Vector3<float>(row3);
+			}
+		}
+#endif
+		for (; index < Size(); index++)
+		{
+			aVectors[index] = Vector3<T>(m_X[index], m_Y[index], m_Z[index]);
+		}
+	}
+
+	template<typename T>
+	inline Vector3<T> Vector3Stream<T>::Get(std::size_t aIndex) const
+	{
+		assert(aIndex < Size() && "Index out of bounds");
+
+		return Vector3<T>(m_X[aIndex], m_Y[aIndex], m_Z[aIndex]);
+	}
+
+	template<typename T>
+	inline void Vector3Stream<T>::Set(std::size_t aIndex, const Vector3<T>& aVector)
+	{
+		assert(aIndex < Size() && "Index out of bounds");
+
+		m_X[aIndex] = aVector.x;
+		m_Y[aIndex] = aVector.y;
+		m_Z[aIndex] = aVector.z;
+	}
+
+	template<typename T>
+	inline T* Vector3Stream<T>::X()
+	{
+		return m_X.data();
+	}
+
+	template<typename T>
+	inline T* Vector3Stream<T>::Y()
+	{
+		return m_Y.data();
+	}
+
+	template<typename T>
+	inline T* Vector3Stream<T>::Z()
+	{
+		return m_Z.data();
+	}
+
+	template<typename T>
+	inline const T* Vector3Stream<T>::X() const
+	{
+		return m_X.data();
+	}
+
+	template<typename T>
+	inline const T* Vector3Stream<T>::Y() const
+	{
+		return m_Y.data();
+	}
+
+	template<typename T>
+	inline const T* Vector3Stream<T>::Z() const
+	{
+		return m_Z.data();
+	}
+
+	template<typename T>
+	inline void Vector3Stream<T>::LengthSqr(std::span<T> aResult) const
+	{
+		Dot(*this, aResult);
+	}
+
+	template<typename T>
+	template<Precision P>
+	inline void Vector3Stream<T>::Length(std::span<T> aResult) const
+	{
+		assert(aResult.size() >= Size() && "Output span too small");
+
+		if constexpr (std::is_same_v<T, float>)
+		{
+			Batch::Length(*this, aResult, P);
+		}
+		else
+		{
+			for (std::size_t index = 0; index < Size(); index++)
+			{
+				aResult[index] = Math::Sqrt<P>(m_X[index] * m_X[index] + m_Y[index] * m_Y[index] + m_Z[index] * m_Z[index]);
+			}
+		}
+	}
+
+	template<typename T>
+	inline void Vector3Stream<T>::DistanceSqr(const Vector3Stream<T>& aOther, std::span<T> aResult) const
+	{
+		assert(aOther.Size() == Size() && "Stream size mismatch");
+		assert(aResult.size() >= Size() && "Output span too small");
+
+		if constexpr (std::is_same_v<T, float>)
+		{
+			Batch::DistanceSqr(*this, aOther, aResult);
+		}
+		else
+		{
+			for (std::size_t index = 0; index < Size(); index++)
+			{
+				T x = m_X[index] - aOther.m_X[index];
+				T y = m_Y[index] - aOther.m_Y[index];
+				T z = m_Z[index] - aOther.m_Z[index];
+				aResult[index] = x * x + y * y + z * z;
+			}
+		}
+	}
+
+	template<typename T>
+	template<Precision P>
+	inline void Vector3Stream<T>::GetNormalized(Vector3Stream<T>& aResult) const
+	{
+		if (&aResult != this)
+		{
+			aResult = *this;
+		}
+		aResult.template Normalize<P>();
+	}
+
+	template<typename T>
+	template<Precision P>
+	inline void Vector3Stream<T>::Normalize()
+	{
+		if constexpr (std::is_same_v<T, float>)
+		{
+			Batch::Normalize(*this, P);
+		}
+		else
+		{
+			for (std::size_t index = 0; index < Size(); index++)
+			{
+				T lengthSqr = m_X[index] * m_X[index] + m_Y[index] * m_Y[index] + m_Z[index] * m_Z[index];
+				assert(lengthSqr != 0 && "Division by 0");
+
+				T scale = Math::ReciprocalSqrt<P>(lengthSqr);
+				m_X[index] *= scale;
+				m_Y[index] *= scale;
+				m_Z[index] *= scale;
+			}
+		}
+	}
+
+	template<typename T>
+	inline void Vector3Stream<T>::Dot(const Vector3Stream<T>& aOther, std::span<T> aResult) const
+	{
+		assert(aOther.Size() == Size() && "Stream size mismatch");
+		assert(aResult.size() >= Size() && "Output span too small");
+
+		if constexpr (std::is_same_v<T, float> || std::is_same_v<T, Fixed32>)
+		{
+			Batch::Dot(*this, aOther, aResult);
+		}
+		else
+		{
+			for (std::size_t index = 0; index < Size(); index++)
+			{
+				aResult[index] = m_X[index] * aOther.m_X[index] + m_Y[index] * aOther.m_Y[index] + m_Z[index] * aOther.m_Z[index];
+			}
+		}
+	}
+
+	template<typename T>
+	inline void Vector3Stream<T>::Cross(const Vector3Stream<T>& aOther, Vector3Stream<T>& aResult) const
+	{
+		assert(aOther.Size() == Size() && "Stream size mismatch");
+
+		aResult.Resize(Size());
+
+		if constexpr (std::is_same_v<T, float> || std::is_same_v<T, Fixed32>)
+		{
+			Batch::Cross(*this, aOther, aResult);
+		}
+		else
+		{
+			for (std::size_t index = 0; index < Size(); index++)
+			{
+				T x = m_Y[index] * aOther.m_Z[index] - m_Z[index] * aOther.m_Y[index];
+				T y = m_Z[index] * aOther.m_X[index] - m_X[index] * aOther.m_Z[index];
+				T z = m_X[index] * aOther.m_Y[index] - m_Y[index] * aOther.m_X[index];
+				aResult.m_X[index] = x;
+				aResult.m_Y[index] = y;
+				aResult.m_Z[index] = z;
+			}
+		}
+	}
+
+	template<typename T>
+	inline void Vector3Stream<T>::Lerp(const Vector3Stream<T>& aFrom, const Vector3Stream<T>& aTo, float aDelta, Vector3Stream<T>& aResult)
+	{
+		assert(aFrom.Size() == aTo.Size() && "Stream size mismatch");
+
+		aResult.Resize(aFrom.Size());
+
+		if constexpr (std::is_same_v<T, float>)
+		{
+			Batch::Lerp(aFrom, aTo, aDelta, aResult);
+		}
+		else
+		{
+			for (std::size_t index = 0; index < aFrom.Size(); index++)
+			{
+				aResult.m_X[index] = aFrom.m_X[index] + aDelta * (aTo.m_X[index] - aFrom.m_X[index]);
+				aResult.m_Y[index] = aFrom.m_Y[index] + aDelta * (aTo.m_Y[index] - aFrom.m_Y[index]);
+				aResult.m_Z[index] = aFrom.m_Z[index] + aDelta * (aTo.m_Z[index] - aFrom.m_Z[index]);
+			}
+		}
+	}
+
+	using Vector3Streamf = Vector3Stream<float>;
+}
@@ -7,25 +7,28 @@ namespace stm
 	class Vector4
 	{
 	public:
-		Vector4<T>();
-		Vector4<T>(const T& aVariable);
-		Vector4<T>(const T& aX, const T& aY, const T& aZ, const T& aW);
-		Vector4<T>(const Vector3<T>& aVector3, const T& aW);
-		Vector4<T>(const Vector4<T>& aVector) = default;
-		~Vector4<T>() = default;
-
-		inline Vector4<T>& operator=(const Vector4<T>& aVector4) = default;
-		inline Vector4<T>& operator-(void);
-
-		inline T LengthSqr() const;
+		constexpr Vector4();
+		constexpr Vector4(const T& aVariable);
+		constexpr Vector4(const T& aX, const T& aY, const T& aZ, const T& aW);
+		constexpr Vector4(const Vector3<T>& aVector3, const T& aW);
+		constexpr Vector4(const Vector4<T>& aVector) = default;
+		~Vector4() = default;
+
+		constexpr Vector4<T>& operator=(const Vector4<T>& aVector4) = default;
+		constexpr Vector4<T>& operator-(void);
+
+		constexpr T LengthSqr() const;
+		template<Precision P = Precision::Exact>
 		inline T Length() const;
 		inline T Distance(const Vector4<T>& aVector) const;
-		inline T DistanceSqr(const Vector4<T>& aVector) const;
+		constexpr T DistanceSqr(const Vector4<T>& aVector) const;
+		template<Precision P = Precision::Exact>
 		inline Vector4<T> GetNormalized() const;
+		template<Precision P = Precision::Exact>
 		inline void Normalize();
 		inline void Truncate(T aUpperBound);
-		inline T Dot(const Vector4<T>& aVector) const;
-		static Vector4<T> Lerp(const Vector4<T>& aFrom, const Vector4<T>& aTo, float aDelta);
+		constexpr T Dot(const Vector4<T>& aVector) const;
+		static constexpr Vector4<T> Lerp(const Vector4<T>& aFrom, const Vector4<T>& aTo, T aDelta);
 
 		T x;
 		T y;
@@ -33,8 +36,46 @@ namespace stm
 		T w;
 	};
 
+#ifdef STM_SIMD_SSE
+	template <>
+	class alignas(16) Vector4<float>
+	{
+	public:
+		constexpr Vector4();
+		constexpr Vector4(const float& aVariable);
+		constexpr Vector4(const float& aX, const float& aY, const float& aZ, const float& aW);
+		constexpr Vector4(const Vector3<float>& aVector3, const float& aW);
+		constexpr Vector4(const Vector4<float>& aVector) = default;
+		explicit Vector4(__m128 aRegister);
+		~Vector4() = default;
+
+		constexpr Vector4<float>& operator=(const Vector4<float>& aVector4) = default;
+		constexpr Vector4<float>& operator-(void);
+
+		inline __m128 Load() const;
+
+		constexpr float LengthSqr() const;
+		template<Precision P = Precision::Exact>
+		inline float Length() const;
+		inline float Distance(const Vector4<float>& aVector) const;
+		constexpr float DistanceSqr(const Vector4<float>& aVector) const;
+		template<Precision P = Precision::Exact>
+		inline Vector4<float> GetNormalized() const;
+		template<Precision P = Precision::Exact>
+		inline void Normalize();
+		inline void Truncate(float aUpperBound);
+		constexpr float Dot(const Vector4<float>& aVector) const;
+		static constexpr Vector4<float> Lerp(const Vector4<float>& aFrom, const Vector4<float>& aTo, float aDelta);
+
+		float x;
+		float y;
+		float z;
+		float w;
+	};
+#endif
+
 	template <typename T>
-	Vector4<T>::Vector4() :
+	constexpr Vector4<T>::Vector4() :
 		x(T()),
 		y(T()),
 		z(T()),
@@ -44,7 +85,7 @@ namespace stm
 	}
 
 	template <typename T>
-	Vector4<T>::Vector4(const T& aVariable) :
+	constexpr Vector4<T>::Vector4(const T& aVariable) :
 		x(aVariable),
 		y(aVariable),
 		z(aVariable),
@@ -54,7 +95,7 @@ namespace stm
 	}
 
 	template <typename T>
-	Vector4<T>::Vector4(const T& aX, const T& aY, const T& aZ, const T& aW) :
+	constexpr Vector4<T>::Vector4(const T& aX, const T& aY, const T& aZ, const T& aW) :
 		x(aX),
 		y(aY),
 		z(aZ),
@@ -64,7 +105,7 @@ namespace stm
 	}
 
 	template <typename T>
-	Vector4<T>::Vector4(const Vector3<T>& aVector3, const T& aW) :
+	constexpr Vector4<T>::Vector4(const Vector3<T>& aVector3, const T& aW) :
 		x(aVector3.x),
 		y(aVector3.y),
 		z(aVector3.z),
@@ -74,30 +115,30 @@ namespace stm
 	}
 
 	template <typename T>
-	inline bool operator==(const Vector4<T>& aVector0, const Vector4<T>& aVector1)
+	constexpr bool operator==(const Vector4<T>& aVector0, const Vector4<T>& aVector1)
 	{
 		return aVector0.x == aVector1.x && aVector0.y == aVector1.y && aVector0.z == aVector1.z && aVector0.w == aVector1.w;
 	}
 	template <typename T>
-	inline bool operator!=(const Vector4<T>& aVector0, const Vector4<T>& aVector1)
+	constexpr bool operator!=(const Vector4<T>& aVector0, const Vector4<T>& aVector1)
 	{
 		return aVector0.x != aVector1.x && aVector0.y != aVector1.y && aVector0.z != aVector1.z && aVector0.w != aVector1.w;
 	}
 
 	template <typename T>
-	inline Vector4<T> operator+(const Vector4<T>& aVector0, const Vector4<T>& aVector1)
+	constexpr Vector4<T> operator+(const Vector4<T>& aVector0, const Vector4<T>& aVector1)
 	{
 		return Vector4<T>(aVector0.x + aVector1.x, aVector0.y + aVector1.y, aVector0.z + aVector1.z, aVector0.w + aVector1.w);
 	}
 
 	template <typename T>
-	inline Vector4<T> operator-(const Vector4<T>& aVector0, const Vector4<T>& aVector1)
+	constexpr Vector4<T> operator-(const Vector4<T>& aVector0, const Vector4<T>& aVector1)
 	{
 		return Vector4<T>(aVector0.x - aVector1.x, aVector0.y - aVector1.y, aVector0.z - aVector1.z, aVector0.w - aVector1.w);
 	}
 
 	template <typename T>
-	inline Vector4<T>& Vector4<T>::operator-(void)
+	constexpr Vector4<T>& Vector4<T>::operator-(void)
 	{
 		x = -x;
 		y = -y;
@@ -107,19 +148,19 @@ namespace stm
 	}
 
 	template <typename T>
-	inline Vector4<T> operator*(const Vector4<T>& aVector, const T& aScalar)
+	constexpr Vector4<T> operator*(const Vector4<T>& aVector, const T& aScalar)
 	{
 		return Vector4<T>(aVector.x * aScalar, aVector.y * aScalar, aVector.z * aScalar, aVector.w * aScalar);
 	}
 
 	template <typename T>
-	inline Vector4<T> operator*(const T& aScalar, const Vector4<T>& aVector)
+	constexpr Vector4<T> operator*(const T& aScalar, const Vector4<T>& aVector)
 	{
 		return Vector4<T>(aVector.x * aScalar, aVector.y * aScalar, aVector.z * aScalar, aVector.w * aScalar);
 	}
 
 	template <typename T>
-	Vector4<T> operator/(const Vector4<T>& aVector, const T& aScalar)
+	constexpr Vector4<T> operator/(const Vector4<T>& aVector, const T& aScalar)
 	{
 		assert(aScalar != 0 && "Division by 0");
 		return Vector4<T>(aVector.x / aScalar, aVector.y / aScalar, aVector.z / aScalar, aVector.w / aScalar);
@@ -142,19 +183,25 @@ namespace stm
 	}
 
 	template <typename T>
-	inline void operator+=(Vector4<T>& aVector0, const Vector4<T>& aVector1)
+	constexpr void operator+=(Vector4<T>& aVector0, const Vector4<T>& aVector1)
 	{
-		aVector0 = aVector0 + aVector1;
+		aVector0.x += aVector1.x;
+		aVector0.y += aVector1.y;
+		aVector0.z += aVector1.z;
+		aVector0.w += aVector1.w;
 	}
 
 	template <typename T>
-	inline void operator-=(Vector4<T>& aVector0, const Vector4<T>& aVector1)
+	constexpr void operator-=(Vector4<T>& aVector0, const Vector4<T>& aVector1)
 	{
-		aVector0 = aVector0 - aVector1;
+		aVector0.x -= aVector1.x;
+		aVector0.y -= aVector1.y;
+		aVector0.z -= aVector1.z;
+		aVector0.w -= aVector1.w;
 	}
 
 	template <typename T>
-	inline void operator*=(Vector4<T>& aVector, const T& aScalar)
+	constexpr void operator*=(Vector4<T>& aVector, const T& aScalar)
 	{
 		aVector.x *= aScalar;
 		aVector.y *= aScalar;
@@ -163,7 +210,7 @@ namespace stm
 	}
 
 	template <typename T>
-	inline void operator/=(Vector4<T>& aVector, const T& aScalar)
+	constexpr void operator/=(Vector4<T>& aVector, const T& aScalar)
 	{
 		assert(aScalar != 0 && "Division by 0");
 		aVector.x /= aScalar;
@@ -195,15 +242,16 @@ namespace stm
 	}
 
 	template<typename T>
-	inline T Vector4<T>::LengthSqr() const
+	constexpr T Vector4<T>::LengthSqr() const
 	{
 		return x * x + y * y + z * z + w * w;
 	}
 
 	template<typename T>
+	template<Precision P>
 	inline T Vector4<T>::Length() const
 	{
-		return std::sqrt(x * x + y * y + z * z + w * w);
+		return Math::Sqrt<P>(x * x + y * y + z * z + w * w);
 	}
 
 	template<typename T>
@@ -213,11 +261,11 @@ namespace stm
 		T arg2 = y - aVector.y;
 		T arg3 = z - aVector.z;
 		T arg4 = w - aVector.w;
-		return std::sqrt(arg1 * arg1 + arg2 * arg2 + arg3 * arg3 + arg4 * arg4);
+		return Math::Sqrt(arg1 * arg1 + arg2 * arg2 + arg3 * arg3 + arg4 * arg4);
 	}
 
 	template<typename T>
-	inline T Vector4<T>::DistanceSqr(const Vector4<T>& aVector) const
+	constexpr T Vector4<T>::DistanceSqr(const Vector4<T>& aVector) const
 	{
 		T arg1 = x - aVector.x;
 		T arg2 = y - aVector.y;
@@ -227,18 +275,22 @@ namespace stm
 	}
 
 	template<typename T>
+	template<Precision P>
 	inline Vector4<T> Vector4<T>::GetNormalized() const
 	{
-		assert(std::sqrt(x * x + y * y + z * z + w * w) != 0 && "Division by 0");
-		double result = 1 / std::sqrt(x * x + y * y + z * z + w * w);
+		assert(x * x + y * y + z * z + w * w != 0 && "Division by 0");
+
+		T result = Math::ReciprocalSqrt<P>(x * x + y * y + z * z + w * w);
 		return Vector4(x * result, y * result, z * result, w * result);
 	}
 
 	template<typename T>
+	template<Precision P>
 	inline void Vector4<T>::Normalize()
 	{
-		assert(std::sqrt(x * x + y * y + z * z + w * w) != 0 && "Division by 0");
-		double result = 1 / std::sqrt(x * x + y * y + z * z + w * w);
+		assert(x * x + y * y + z * z + w * w != 0 && "Division by 0");
+
+		T result = Math::ReciprocalSqrt<P>(x * x + y * y + z * z + w * w);
 		x *= result;
 		y *= result;
 		z *= result;
@@ -251,22 +303,263 @@ namespace stm
 		T sqrLen = LengthSqr();
 		if (sqrLen > aUpperBound * aUpperBound)
 		{
-			double multiplier = aUpperBound / std::sqrt(sqrLen);
-			x *= multiplier; y *= multiplier;
+			T multiplier = aUpperBound / Math::Sqrt(sqrLen);
+			x *= multiplier; y *= multiplier; z *= multiplier; w *= multiplier;
 		}
 	}
 
 	template<typename T>
-	inline T Vector4<T>::Dot(const Vector4<T>& aVector) const
+	constexpr T Vector4<T>::Dot(const Vector4<T>& aVector) const
 	{
 		return x * aVector.x + y * aVector.y + z * aVector.z + w * aVector.w;
 	}
 
 	template <typename T>
-	Vector4<T> Vector4<T>::Lerp(const  Vector4<T>& aFrom, const  Vector4<T>& aTO, float aDelta)
+	constexpr Vector4<T> Vector4<T>::Lerp(const  Vector4<T>& aFrom, const  Vector4<T>& aTO, T aDelta)
 	{
 		return aFrom + aDelta * (aTO - aFrom);
 	}
 
+#ifdef STM_SIMD_SSE
+	constexpr Vector4<float>::Vector4() :
+		x(0),
+		y(0),
+		z(0),
+		w(0)
+	{
+
+	}
+
+	constexpr Vector4<float>::Vector4(const float& aVariable) :
+		x(aVariable),
+		y(aVariable),
+		z(aVariable),
+		w(aVariable)
+	{
+
+	}
+
+	constexpr Vector4<float>::Vector4(const float& aX, const float& aY, const float& aZ, const float& aW) :
+		x(aX),
+		y(aY),
+		z(aZ),
+		w(aW)
+	{
+
+	}
+
+	constexpr Vector4<float>::Vector4(const Vector3<float>& aVector3, const float& aW) :
+		x(aVector3.x),
+		y(aVector3.y),
+		z(aVector3.z),
+		w(aW)
+	{
+
+	}
+
+	inline Vector4<float>::Vector4(__m128 aRegister)
+	{
+		_mm_store_ps(&x, aRegister);
+	}
+
+	inline __m128 Vector4<float>::Load() const
+	{
+		return _mm_load_ps(&x);
+	}
+
+	constexpr Vector4<float> operator+(const Vector4<float>& aVector0, const Vector4<float>& aVector1)
+	{
+		if (std::is_constant_evaluated())
+		{
+			return Vector4<float>(aVector0.x + aVector1.x, aVector0.y + aVector1.y, aVector0.z + aVector1.z, aVector0.w + aVector1.w);
+		}
+		return Vector4<float>(_mm_add_ps(aVector0.Load(), aVector1.Load()));
+	}
+
+	constexpr Vector4<float> operator-(const Vector4<float>& aVector0, const Vector4<float>& aVector1)
+	{
+		if (std::is_constant_evaluated())
+		{
+			return Vector4<float>(aVector0.x - aVector1.x, aVector0.y - aVector1.y, aVector0.z - aVector1.z, aVector0.w - aVector1.w);
+		}
+		return Vector4<float>(_mm_sub_ps(aVector0.Load(), aVector1.Load()));
+	}
+
+	constexpr Vector4<float>& Vector4<float>::operator-(void)
+	{
+		if (std::is_constant_evaluated())
+		{
+			x = -x;
+			y = -y;
+			z = -z;
+			w = -w;
+			return *this;
+		}
+		_mm_store_ps(&x, _mm_sub_ps(_mm_setzero_ps(), Load()));
+		return *this;
+	}
+
+	constexpr Vector4<float> operator*(const Vector4<float>& aVector, const float& aScalar)
+	{
+		if (std::is_constant_evaluated())
+		{
+			return Vector4<float>(aVector.x * aScalar, aVector.y * aScalar, aVector.z * aScalar, aVector.w * aScalar);
+		}
+		return Vector4<float>(_mm_mul_ps(aVector.Load(), Simd::Splat(aScalar)));
+	}
+
+	constexpr Vector4<float> operator*(const float& aScalar, const Vector4<float>& aVector)
+	{
+		if (std::is_constant_evaluated())
+		{
+			return aVector * aScalar;
+		}
+		return Vector4<float>(_mm_mul_ps(aVector.Load(), Simd::Splat(aScalar)));
+	}
+
+	constexpr Vector4<float> operator/(const Vector4<float>& aVector, const float& aScalar)
+	{
+		assert(aScalar != 0 && "Division by 0");
+		if (std::is_constant_evaluated())
+		{
+			return aVector * (1 / aScalar);
+		}
+		return Vector4<float>(_mm_mul_ps(aVector.Load(), Simd::Splat(1 / aScalar)));
+	}
+
+	constexpr void operator+=(Vector4<float>& aVector0, const Vector4<float>& aVector1)
+	{
+		if (std::is_constant_evaluated())
+		{
+			aVector0.x += aVector1.x;
+			aVector0.y += aVector1.y;
+			aVector0.z += aVector1.z;
+			aVector0.w += aVector1.w;
+			return;
+		}
+		_mm_store_ps(&aVector0.x, _mm_add_ps(aVector0.Load(), aVector1.Load()));
+	}
+
+	constexpr void operator-=(Vector4<float>& aVector0, const Vector4<float>& aVector1)
+	{
+		if (std::is_constant_evaluated())
+		{
+			aVector0.x -= aVector1.x;
+			aVector0.y -= aVector1.y;
+			aVector0.z -= aVector1.z;
+			aVector0.w -= aVector1.w;
+			return;
+		}
+		_mm_store_ps(&aVector0.x, _mm_sub_ps(aVector0.Load(), aVector1.Load()));
+	}
+
+	constexpr void operator*=(Vector4<float>& aVector, const float& aScalar)
+	{
+		if (std::is_constant_evaluated())
+		{
+			aVector = aVector * aScalar;
+			return;
+		}
+		_mm_store_ps(&aVector.x, _mm_mul_ps(aVector.Load(), Simd::Splat(aScalar)));
+	}
+
+	constexpr void operator/=(Vector4<float>& aVector, const float& aScalar)
+	{
+		assert(aScalar != 0 && "Division by 0");
+		if (std::is_constant_evaluated())
+		{
+			aVector = aVector * (1 / aScalar);
+			return;
+		}
+		_mm_store_ps(&aVector.x, _mm_mul_ps(aVector.Load(), Simd::Splat(1 / aScalar)));
+	}
+
+	constexpr float Vector4<float>::LengthSqr() const
+	{
+		if (std::is_constant_evaluated())
+		{
+			return Dot(*this);
+		}
+		__m128 vector = Load();
+		return Simd::GetX(Simd::Dot4(vector, vector));
+	}
+
+	template<Precision P>
+	inline float Vector4<float>::Length() const
+	{
+		__m128 vector = Load();
+		return Simd::GetX(Simd::Sqrt<P>(Simd::Dot4(vector, vector)));
+	}
+
+	inline float Vector4<float>::Distance(const Vector4<float>& aVector) const
+	{
+		__m128 delta = _mm_sub_ps(Load(), aVector.Load());
+		return Simd::GetX(_mm_sqrt_ss(Simd::Dot4(delta, delta)));
+	}
+
+	constexpr float Vector4<float>::DistanceSqr(const Vector4<float>& aVector) const
+	{
+		if (std::is_constant_evaluated())
+		{
+			const Vector4<float> delta = *this - aVector;
+			return delta.Dot(delta);
+		}
+		__m128 delta = _mm_sub_ps(Load(), aVector.Load());
+		return Simd::GetX(Simd::Dot4(delta, delta));
+	}
+
+	template<Precision P>
+	inline Vector4<float> Vector4<float>::GetNormalized() const
+	{
+		__m128 vector = Load();
+		__m128 lengthSqr = Simd::Dot4(vector, vector);
+		assert(Simd::GetX(lengthSqr) != 0 && "Division by 0");
+
+		if constexpr (P == Precision::Exact)
+		{
+			return Vector4<float>(_mm_div_ps(vector, _mm_sqrt_ps(lengthSqr)));
+		}
+		else
+		{
+			return Vector4<float>(_mm_mul_ps(vector, Simd::ReciprocalSqrt<P>(lengthSqr)));
+		}
+	}
+
+	template<Precision P>
+	inline void Vector4<float>::Normalize()
+	{
+		*this = GetNormalized<P>();
+	}
+
+	inline void Vector4<float>::Truncate(float aUpperBound)
+	{
+		float sqrLen = LengthSqr();
+		if (sqrLen > aUpperBound * aUpperBound)
+		{
+			*this *= aUpperBound / std::sqrt(sqrLen);
+		}
+	}
+
+	constexpr float Vector4<float>::Dot(const Vector4<float>& aVector) const
+	{
+		if (std::is_constant_evaluated())
+		{
+			return x * aVector.x + y * aVector.y + z * aVector.z + w * aVector.w;
+		}
+		return Simd::GetX(Simd::Dot4(Load(), aVector.Load()));
+	}
+
+	constexpr Vector4<float> Vector4<float>::Lerp(const Vector4<float>& aFrom, const Vector4<float>& aTo, float aDelta)
+	{
+		if (std::is_constant_evaluated())
+		{
+			return aFrom + aDelta * (aTo - aFrom);
+		}
+		__m128 from = aFrom.Load();
+		return Vector4<float>(Simd::MultiplyAdd(Simd::Splat(aDelta), _mm_sub_ps(aTo.Load(), from), from));
+	}
+#endif
+
 	using Vector4f = Vector4<float>;
+	using Vector4x = Vector4<Fixed32>;
 }
\ No newline at end of file
@@ -0,0 +1,543 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+#include "Vector2.hpp"
+#include "Vector3.hpp"
+#include "Vector3Stream.hpp"
+#include "Vector4.hpp"
+
+namespace stm
+{
+	// Opt-in lazy arithmetic for Vector2, Vector3, Vector4 and Vector3Stream. Wrapping one operand in
+	// Expression::Lazy turns the rest of the expression into a tree that is evaluated in a single pass,
+	// component by component, when it is converted to a vector or passed to Expression::Assign.
+	// Only component-wise operations exist, so assigning into one of the operands is safe.
+	// Expressions hold references to their operands, evaluate them before those go out of scope.
+	//
+	//   Vector3f result = Expression::Lazy(a) * 2.0f + b - c / length;
+	//   Expression::Assign(positions, Expression::Lazy(positions) + velocities * deltaTime);
+	namespace Expression
+	{
+		template<typename V>
+		struct VectorTraits
+		{
+			static constexpr std::size_t Dimension = 0;
+		};
+
+		template<typename T>
+		struct VectorTraits<Vector2<T>>
+		{
+			using Scalar = T;
+			static constexpr std::size_t Dimension = 2;
+		};
+
+		template<typename T>
+		struct VectorTraits<Vector3<T>>
+		{
+			using Scalar = T;
+			static constexpr std::size_t Dimension = 3;
+		};
+
+		template<typename T>
+		struct VectorTraits<Vector4<T>>
+		{
+			using Scalar = T;
+			static constexpr std::size_t Dimension = 4;
+		};
+
+		template<typename T, std::size_t Dimension>
+		struct VectorOf;
+
+		template<typename T>
+		struct VectorOf<T, 2>
+		{
+			using Type = Vector2<T>;
+		};
+
+		template<typename T>
+		struct VectorOf<T, 3>
+		{
+			using Type = Vector3<T>;
+		};
+
+		template<typename T>
+		struct VectorOf<T, 4>
+		{
+			using Type = Vector4<T>;
+		};
+
+		template<std::size_t Axis, typename V>
+		constexpr auto& Component(V& aVector)
+		{
+			if constexpr (Axis == 0)
+			{
+				return aVector.x;
+			}
+			else if constexpr (Axis == 1)
+			{
+				return aVector.y;
+			}
+			else if constexpr (Axis == 2)
+			{
+				return aVector.z;
+			}
+			else
+			{
+				return aVector.w;
+			}
+		}
+
+		// Every node provides Scalar, Dimension (0 for scalars, which broadcast), HasStream, Size()
+		// (the element count when HasStream is set) and At<Axis>(aElement).
+		template<typename Derived>
+		class VectorExpression
+		{
+		public:
+			constexpr const Derived& GetDerived() const;
+
+			constexpr auto Evaluate() const;
+
+			template<typename V>
+				requires (VectorTraits<V>::Dimension == Derived::Dimension && !Derived::HasStream)
+			constexpr operator V() const;
+		};
+
+		template<typename T>
+		concept IsExpression = std::is_base_of_v<VectorExpression<T>, T>;
+
+		template<typename T>
+		constexpr bool IsStream = false;
+
+		template<typename T>
+		constexpr bool IsStream<Vector3Stream<T>> = true;
+
+		template<typename T>
+		concept IsOperand = IsExpression<T> || IsStream<T> || VectorTraits<T>::Dimension != 0 || std::is_arithmetic_v<T>;
+
+		template<typename V>
+		class VectorReference : public VectorExpression<VectorReference<V>>
+		{
+		public:
+			using Scalar = typename VectorTraits<V>::Scalar;
+			static constexpr std::size_t Dimension = VectorTraits<V>::Dimension;
+			static constexpr bool HasStream = false;
+
+			explicit constexpr VectorReference(const V& aVector);
+
+			constexpr std::size_t Size() const;
+			template<std::size_t Axis>
+			constexpr Scalar At(std::size_t aElement) const;
+
+		private:
+			const V& m_Vector;
+		};
+
+		template<typename T>
+		class StreamReference : public VectorExpression<StreamReference<T>>
+		{
+		public:
+			using Scalar = T;
+			static constexpr std::size_t Dimension = 3;
+			static constexpr bool HasStream = true;
+
+			explicit StreamReference(const Vector3Stream<T>& aStream);
+
+			std::size_t Size() const;
+			template<std::size_t Axis>
+			Scalar At(std::size_t aElement) const;
+
+		private:
+			const T* m_X;
+			const T* m_Y;
+			const T* m_Z;
+			std::size_t m_Size;
+		};
+
+		template<typename T>
+		class ScalarValue : public VectorExpression<ScalarValue<T>>
+		{
+		public:
+			using Scalar = T;
+			static constexpr std::size_t Dimension = 0;
+			static constexpr bool HasStream = false;
+
+			explicit constexpr ScalarValue(const T& aValue);
+
+			constexpr std::size_t Size() const;
+			template<std::size_t Axis>
+			constexpr Scalar At(std::size_t aElement) const;
+
+		private:
+			T m_Value;
+		};
+
+		struct Add
+		{
+			template<typename T>
+			static constexpr T Apply(T aLeft, T aRight) { return aLeft + aRight; }
+		};
+
+		struct Subtract
+		{
+			template<typename T>
+			static constexpr T Apply(T aLeft, T aRight) { return aLeft - aRight; }
+		};
+
+		struct Multiply
+		{
+			template<typename T>
+			static constexpr T Apply(T aLeft, T aRight) { return aLeft * aRight; }
+		};
+
+		struct Divide
+		{
+			template<typename T>
+			static constexpr T Apply(T aLeft, T aRight) { return aLeft / aRight; }
+		};
+
+		// Scalars are converted to the scalar type of the vector side, as Vector3f * 2.0 would be.
+		template<typename Operation, typename Left, typename Right>
+		class BinaryExpression : public VectorExpression<BinaryExpression<Operation, Left, Right>>
+		{
+		public:
+			using Scalar = std::conditional_t<Left::Dimension != 0, typename Left::Scalar, typename Right::Scalar>;
+			static constexpr std::size_t Dimension = Left::Dimension != 0 ? Left::Dimension : Right::Dimension;
+			static constexpr bool HasStream = Left::HasStream || Right::HasStream;
+
+			static_assert(Left::Dimension == 0 || Right::Dimension == 0 || Left::Dimension == Right::Dimension, "Vector dimension mismatch");
+
+			constexpr BinaryExpression(const Left& aLeft, const Right& aRight);
+
+			constexpr std::size_t Size() const;
+			template<std::size_t Axis>
+			constexpr Scalar At(std::size_t aElement) const;
+
+		private:
+			Left m_Left;
+			Right m_Right;
+		};
+
+		template<typename Operand>
+		class NegateExpression : public VectorExpression<NegateExpression<Operand>>
+		{
+		public:
+			using Scalar = typename Operand::Scalar;
+			static constexpr std::size_t Dimension = Operand::Dimension;
+			static constexpr bool HasStream = Operand::HasStream;
+
+			explicit constexpr NegateExpression(const Operand& aOperand);
+
+			constexpr std::size_t Size() const;
+			template<std::size_t Axis>
+			constexpr Scalar At(std::size_t aElement) const;
+
+		private:
+			Operand m_Operand;
+		};
+
+		template<typename V>
+			requires (VectorTraits<V>::Dimension != 0)
+		constexpr VectorReference<V> Lazy(const V& aVector);
+		template<typename T>
+		StreamReference<T> Lazy(const Vector3Stream<T>& aStream);
+
+		template<typename V, typename E>
+			requires (VectorTraits<V>::Dimension != 0)
+		constexpr void Assign(V& aTarget, const VectorExpression<E>& aExpression);
+		// Resizes aTarget to the expression's streams, or keeps its size when only single vectors are involved.
+		template<typename T, typename E>
+		void Assign(Vector3Stream<T>& aTarget, const VectorExpression<E>& aExpression);
+
+		template<typename L, typename R>
+			requires ((IsExpression<L> || IsExpression<R>) && IsOperand<L> && IsOperand<R>)
+		constexpr auto operator+(const L& aLeft, const R& aRight);
+		template<typename L, typename R>
+			requires ((IsExpression<L> || IsExpression<R>) && IsOperand<L> && IsOperand<R>)
+		constexpr auto operator-(const L& aLeft, const R& aRight);
+		template<typename L, typename R>
+			requires ((IsExpression<L> || IsExpression<R>) && IsOperand<L> && IsOperand<R>)
+		constexpr auto operator*(const L& aLeft, const R& aRight);
+		template<typename L, typename R>
+			requires ((IsExpression<L> || IsExpression<R>) && IsOperand<L> && IsOperand<R>)
+		constexpr auto operator/(const L& aLeft, const R& aRight);
+		template<typename E>
+		constexpr NegateExpression<E> operator-(const VectorExpression<E>& aExpression);
+	}
+
+	template<typename Derived>
+	constexpr const Derived& Expression::VectorExpression<Derived>::GetDerived() const
+	{
+		return static_cast<const Derived&>(*this);
+	}
+
+	template<typename Derived>
+	constexpr auto Expression::VectorExpression<Derived>::Evaluate() const
+	{
+		static_assert(!Derived::HasStream, "Stream expressions are evaluated with Assign");
+
+		typename VectorOf<typename Derived::Scalar, Derived::Dimension>::Type result;
+		Assign(result, *this);
+		return result;
+	}
+
+	template<typename Derived>
+	template<typename V>
+		requires (Expression::VectorTraits<V>::Dimension == Derived::Dimension && !Derived::HasStream)
+	constexpr Expression::VectorExpression<Derived>::operator V() const
+	{
+		V result;
+		Assign(result, *this);
+		return result;
+	}
+
+	template<typename V>
+	constexpr Expression::VectorReference<V>::VectorReference(const V& aVector) :
+		m_Vector(aVector)
+	{
+
+	}
+
+	template<typename V>
+	constexpr std::size_t Expression::VectorReference<V>::Size() const
+	{
+		return 0;
+	}
+
+	template<typename V>
+	template<std::size_t Axis>
+	constexpr typename Expression::VectorReference<V>::Scalar Expression::VectorReference<V>::At(std::size_t) const
+	{
+		return Component<Axis>(m_Vector);
+	}
+
+	template<typename T>
+	inline Expression::StreamReference<T>::StreamReference(const Vector3Stream<T>& aStream) :
+		m_X(aStream.X()),
+		m_Y(aStream.Y()),
+		m_Z(aStream.Z()),
+		m_Size(aStream.Size())
+	{
+
+	}
+
+	template<typename T>
+	inline std::size_t Expression::StreamReference<T>::Size() const
+	{
+		return m_Size;
+	}
+
+	template<typename T>
+	template<std::size_t Axis>
+	inline T Expression::StreamReference<T>::At(std::size_t aElement) const
+	{
+		if constexpr (Axis == 0)
+		{
+			return m_X[aElement];
+		}
+		else if constexpr (Axis == 1)
+		{
+			return m_Y[aElement];
+		}
+		else
+		{
+			return m_Z[aElement];
+		}
+	}
+
+	template<typename T>
+	constexpr Expression::ScalarValue<T>::ScalarValue(const T& aValue) :
+		m_Value(aValue)
+	{
+
+	}
+
+	template<typename T>
+	constexpr std::size_t Expression::ScalarValue<T>::Size() const
+	{
+		return 0;
+	}
+
+	template<typename T>
+	template<std::size_t Axis>
+	constexpr T Expression::ScalarValue<T>::At(std::size_t) const
+	{
+		return m_Value;
+	}
+
+	template<typename Operation, typename Left, typename Right>
+	constexpr Expression::BinaryExpression<Operation, Left, Right>::BinaryExpression(const Left& aLeft, const Right& aRight) :
+		m_Left(aLeft),
+		m_Right(aRight)
+	{
+
+	}
+
+	template<typename Operation, typename Left, typename Right>
+	constexpr std::size_t Expression::BinaryExpression<Operation, Left, Right>::Size() const
+	{
+		const std::size_t left = m_Left.Size();
+		const std::size_t right = m_Right.Size();
+		assert((!Left::HasStream || !Right::HasStream || left == right) && "Stream size mismatch");
+
+		return Left::HasStream ? left : right;
+	}
+
+	template<typename Operation, typename Left, typename Right>
+	template<std::size_t Axis>
+	constexpr typename Expression::BinaryExpression<Operation, Left, Right>::Scalar Expression::BinaryExpression<Operation, Left, Right>::At(std::size_t aElement) const
+	{
+		return Operation::Apply(static_cast<Scalar>(m_Left.template At<Axis>(aElement)), static_cast<Scalar>(m_Right.template At<Axis>(aElement)));
+	}
+
+	template<typename Operand>
+	constexpr Expression::NegateExpression<Operand>::NegateExpression(const Operand& aOperand) :
+		m_Operand(aOperand)
+	{
+
+	}
+
+	template<typename Operand>
+	constexpr std::size_t Expression::NegateExpression<Operand>::Size() const
+	{
+		return m_Operand.Size();
+	}
+
+	template<typename Operand>
+	template<std::size_t Axis>
+	constexpr typename Expression::NegateExpression<Operand>::Scalar Expression::NegateExpression<Operand>::At(std::size_t aElement) const
+	{
+		return -m_Operand.template At<Axis>(aElement);
+	}
+
+	template<typename V>
+		requires (Expression::VectorTraits<V>::Dimension != 0)
+	constexpr Expression::VectorReference<V> Expression::Lazy(const V& aVector)
+	{
+		return VectorReference<V>(aVector);
+	}
+
+	template<typename T>
+	inline Expression::StreamReference<T> Expression::Lazy(const Vector3Stream<T>& aStream)
+	{
+		return StreamReference<T>(aStream);
+	}
+
+	template<typename V, typename E>
+		requires (Expression::VectorTraits<V>::Dimension != 0)
+	constexpr void Expression::Assign(V& aTarget, const VectorExpression<E>& aExpression)
+	{
+		static_assert(VectorTraits<V>::Dimension == E::Dimension, "Vector dimension mismatch");
+		static_assert(!E::HasStream, "Stream expressions can only be assigned to a Vector3Stream");
+
+		const E& expression = aExpression.GetDerived();
+		Component<0>(aTarget) = expression.template At<0>(0);
+		Component<1>(aTarget) = expression.template At<1>(0);
+		if constexpr (E::Dimension > 2)
+		{
+			Component<2>(aTarget) = expression.template At<2>(0);
+		}
+		if constexpr (E::Dimension > 3)
+		{
+			Component<3>(aTarget) = expression.template At<3>(0);
+		}
+	}
+
+	template<typename T, typename E>
+	inline void Expression::Assign(Vector3Stream<T>& aTarget, const VectorExpression<E>& aExpression)
+	{
+		static_assert(E::Dimension == 3, "Vector dimension mismatch");
+
+		const E& expression = aExpression.GetDerived();
+		const std::size_t size = E::HasStream ? expression.Size() : aTarget.Size();
+		aTarget.Resize(size);
+
+		// One pass per axis keeps every loop on contiguous arrays the compiler can vectorize.
+		T* x = aTarget.X();
+		for (std::size_t index = 0; index < size; index++)
+		{
+			x[index] = expression.template At<0>(index);
+		}
+		T* y = aTarget.Y();
+		for (std::size_t index = 0; index < size; index++)
+		{
+			y[index] = expression.template At<1>(index);
+		}
+		T* z = aTarget.Z();
+		for (std::size_t index = 0; index < size; index++)
+		{
+			z[index] = expression.template At<2>(index);
+		}
+	}
+
+	namespace Expression
+	{
+		template<typename T>
+		constexpr auto Wrap(const T& aOperand)
+		{
+			if constexpr (IsExpression<T>)
+			{
+				return aOperand;
+			}
+			else if constexpr (std::is_arithmetic_v<T>)
+			{
+				return ScalarValue<T>(aOperand);
+			}
+			else
+			{
+				return Lazy(aOperand);
+			}
+		}
+
+		template<typename Operation, typename L, typename R>
+		constexpr auto MakeBinary(const L& aLeft, const R& aRight)
+		{
+			using Left = decltype(Wrap(aLeft));
+			using Right = decltype(Wrap(aRight));
+			return BinaryExpression<Operation, Left, Right>(Wrap(aLeft), Wrap(aRight));
+		}
+	}
+
+	template<typename L, typename R>
+		requires ((Expression::IsExpression<L> || Expression::IsExpression<R>) && Expression::IsOperand<L> && Expression::IsOperand<R>)
+	constexpr auto Expression::operator+(const L& aLeft, const R& aRight)
+	{
+		static_assert(!std::is_arithmetic_v<L> && !std::is_arithmetic_v<R>, "Vectors can only be added to vectors");
+
+		return MakeBinary<Add>(aLeft, aRight);
+	}
+
+	template<typename L, typename R>
+		requires ((Expression::IsExpression<L> || Expression::IsExpression<R>) && Expression::IsOperand<L> && Expression::IsOperand<R>)
+	constexpr auto Expression::operator-(const L& aLeft, const R& aRight)
+	{
+		static_assert(!std::is_arithmetic_v<L> && !std::is_arithmetic_v<R>, "Vectors can only be subtracted from vectors");
+
+		return MakeBinary<Subtract>(aLeft, aRight);
+	}
+
+	template<typename L, typename R>
+		requires ((Expression::IsExpression<L> || Expression::IsExpression<R>) && Expression::IsOperand<L> && Expression::IsOperand<R>)
+	constexpr auto Expression::operator*(const L& aLeft, const R& aRight)
+	{
+		static_assert(decltype(Wrap(aLeft))::Dimension == 0 || decltype(Wrap(aRight))::Dimension == 0, "Vectors can only be multiplied by scalars");
+
+		return MakeBinary<Multiply>(aLeft, aRight);
+	}
+
+	template<typename L, typename R>
+		requires ((Expression::IsExpression<L> || Expression::IsExpression<R>) && Expression::IsOperand<L> && Expression::IsOperand<R>)
+	constexpr auto Expression::operator/(const L& aLeft, const R& aRight)
+	{
+		static_assert(decltype(Wrap(aRight))::Dimension == 0, "Vectors can only be divided by scalars");
+
+		return MakeBinary<Divide>(aLeft, aRight);
+	}
+
+	template<typename E>
+	constexpr Expression::NegateExpression<E> Expression::operator-(const VectorExpression<E>& aExpression)
+	{
+		return NegateExpression<E>(aExpression.GetDerived());
+	}
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include "Matrix4x4.hpp"
+#include "PlaneVolume.hpp"
+
+namespace stm
+{
+	// Keeps view * projection and its frustum planes up to date whenever either matrix changes,
+	// so per frame readers get them without another multiply or plane extraction.
+	template<typename T>
+	class ViewProjection
+	{
+	public:
+		ViewProjection();
+		ViewProjection(const Matrix4x4<T>& aView, const Matrix4x4<T>& aProjection);
+
+		void SetView(const Matrix4x4<T>& aView);
+		void SetProjection(const Matrix4x4<T>& aProjection);
+		void Set(const Matrix4x4<T>& aView, const Matrix4x4<T>& aProjection);
+
+		const Matrix4x4<T>& GetView() const;
+		const Matrix4x4<T>& GetProjection() const;
+		const Matrix4x4<T>& GetViewProjection() const;
+		// World space, normals pointing out of the frustum.
+		const PlaneVolume<T>& GetFrustum() const;
+
+	private:
+		void Update();
+
+		Matrix4x4<T> m_View;
+		Matrix4x4<T> m_Projection;
+		Matrix4x4<T> m_ViewProjection;
+		PlaneVolume<T> m_Frustum;
+	};
+
+	template<typename T>
+	inline ViewProjection<T>::ViewProjection()
+	{
+		Update();
+	}
+
+	template<typename T>
+	inline ViewProjection<T>::ViewProjection(const Matrix4x4<T>& aView, const Matrix4x4<T>& aProjection)
+		: m_View(aView),
+		  m_Projection(aProjection)
+	{
+		Update();
+	}
+
+	template<typename T>
+	inline void ViewProjection<T>::SetView(const Matrix4x4<T>& aView)
+	{
+		m_View = aView;
+		Update();
+	}
+
+	template<typename T>
+	inline void ViewProjection<T>::SetProjection(const Matrix4x4<T>& aProjection)
+	{
+		m_Projection = aProjection;
+		Update();
+	}
+
+	template<typename T>
+	inline void ViewProjection<T>::Set(const Matrix4x4<T>& aView, const Matrix4x4<T>& aProjection)
+	{
+		m_View = aView;
+		m_Projection = aProjection;
+		Update();
+	}
+
+	template<typename T>
+	inline const Matrix4x4<T>& ViewProjection<T>::GetView() const
+	{
+		return m_View;
+	}
+
+	template<typename T>
+	inline const Matrix4x4<T>& ViewProjection<T>::GetProjection() const
+	{
+		return m_Projection;
+	}
+
+	template<typename T>
+	inline const Matrix4x4<T>& ViewProjection<T>::GetViewProjection() const
+	{
+		return m_ViewProjection;
+	}
+
+	template<typename T>
+	inline const PlaneVolume<T>& ViewProjection<T>::GetFrustum() const
+	{
+		return m_Frustum;
+	}
+
+	template<typename T>
+	inline void ViewProjection<T>::Update()
+	{
+		m_ViewProjection = m_View * m_Projection;
+		m_Frustum = PlaneVolume<T>::CreateFrustum(m_ViewProjection);
+	}
+
+	using ViewProjectionf = ViewProjection<float>;
+}
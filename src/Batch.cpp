@@ -0,0 +1,802 @@
+#include "Batch.hpp"
+#include "AABB2D.hpp"
+#include "AABB3D.hpp"
+#include "BatchKernels.hpp"
+#include "Matrix3x4.hpp"
+#include "Matrix4x4.hpp"
+#include "PackedVector.hpp"
+#include "Parallel.hpp"
+#include "Quaternion.hpp"
+#include "QuaternionStream.hpp"
+#include "Ray.hpp"
+#include "Sphere.hpp"
+#include "Transform.hpp"
+#include "Vector3Stream.hpp"
+#include <algorithm>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace stm
+{
+	static_assert(sizeof(Matrix4x4<float>) == 16 * sizeof(float), "Batch kernels expect tightly packed matrices");
+	static_assert(sizeof(Quaternion) == 4 * sizeof(float), "Batch kernels expect tightly packed quaternions");
+	static_assert(sizeof(Vector4f) == 4 * sizeof(float), "Batch kernels expect tightly packed vectors");
+	static_assert(2 * sizeof(Vector3h) == sizeof(Vector3f), "Vector3h must mirror the layout of Vector3f");
+	static_assert(sizeof(OctahedralNormal) == 2 * sizeof(std::int16_t), "Batch kernels expect tightly packed normals");
+	static_assert(sizeof(PackedQuaternion) == 4 * sizeof(std::int16_t), "Batch kernels expect tightly packed quaternions");
+	static_assert(sizeof(Fixed32) == sizeof(std::int32_t), "Batch kernels expect Fixed32 to be its raw value");
+	static_assert(sizeof(AABB2D<float>) == 4 * sizeof(float), "Batch kernels expect tightly packed boxes");
+	static_assert(GimbalLockThreshold == Quaternion::GimbalLockThreshold, "Batch Euler angles must match Quaternion::GetEuler");
+	static_assert(RadiansToDegrees == Math::RadToDegree(1.0f), "Batch Euler angles must match Quaternion::GetEuler");
+	static_assert(sizeof(AABB3D<float>) == 2 * sizeof(Vector3f), "Batch kernels expect boxes of two vectors");
+	static_assert(sizeof(Sphere<float>) % sizeof(float) == 0 && sizeof(Sphere<float>) > sizeof(Vector3f), "Batch kernels expect spheres of a center followed by the radius");
+
+	namespace
+	{
+		struct Dispatch
+		{
+			InstructionSet instructionSet;
+			const BatchKernels* kernels;
+		};
+
+		Dispatch Select()
+		{
+			const CpuFeatures& features = CpuFeatures::Get();
+
+			if (features.hasAVX512F && features.hasAVX512DQ && features.hasAVX512VL && features.hasFMA && features.hasF16C)
+			{
+				if (const BatchKernels* kernels = GetAVX512Kernels())
+				{
+					return { InstructionSet::AVX512, kernels };
+				}
+			}
+			if (features.hasAVX2 && features.hasFMA && features.hasF16C)
+			{
+				if (const BatchKernels* kernels = GetAVX2Kernels())
+				{
+					return { InstructionSet::AVX2, kernels };
+				}
+			}
+			if (features.hasSSE2)
+			{
+				if (const BatchKernels* kernels = GetSSE2Kernels())
+				{
+					return { InstructionSet::SSE2, kernels };
+				}
+			}
+			return { InstructionSet::Scalar, GetScalarKernels() };
+		}
+
+		const Dispatch& GetDispatch()
+		{
+			static const Dispatch dispatch = Select();
+			return dispatch;
+		}
+
+		const BatchKernels& Kernels()
+		{
+			return *GetDispatch().kernels;
+		}
+
+		// Below this many vectors per thread, starting the thread costs more than it saves.
+		constexpr std::size_t MinimumParallelCount = 16384;
+		// Sixteen floats, one cache line of a stream's axis.
+		constexpr std::size_t ParallelAlignment = 16;
+
+		template<typename Function>
+		void Run(Batch::Execution aExecution, std::size_t aCount, const Function& aFunction)
+		{
+			if (aCount == 0)
+			{
+				return;
+			}
+			if (aExecution == Batch::Execution::Parallel)
+			{
+				ParallelFor(aCount, MinimumParallelCount, ParallelAlignment, aFunction);
+				return;
+			}
+			aFunction(std::size_t(0), aCount);
+		}
+
+		const std::int32_t* Raw(const Fixed32* aValues)
+		{
+			return reinterpret_cast<const std::int32_t*>(aValues);
+		}
+
+		std::int32_t* Raw(Fixed32* aValues)
+		{
+			return reinterpret_cast<std::int32_t*>(aValues);
+		}
+
+		using RayKernel = std::size_t (*)(const float*, const float*, const float*, const float*, const float*, std::size_t, float, std::uint32_t*, float*);
+
+		std::size_t IntersectRay(const RayKernel* aKernels, const Ray<float>& aRay, const Vector3Stream<float>& aPrimitives, std::span<const float> aValues, Batch::HitMode aMode, std::span<std::uint32_t> aHitIndices, std::span<float> aHitDistances, float aMaxDistance)
+		{
+			assert(aPrimitives.Size() == aValues.size() && "Stream size mismatch");
+			assert(aHitIndices.size() >= (aMode == Batch::HitMode::All ? aValues.size() : 1) && "Output span too small");
+			assert(aHitDistances.size() >= (aMode == Batch::HitMode::All ? aValues.size() : 1) && "Output span too small");
+
+			if (aValues.empty())
+			{
+				return 0;
+			}
+			const Vector3f& position = aRay.GetPosition();
+			const Vector3f& direction = aRay.GetDirection();
+			const float ray[6] = { position.x, position.y, position.z, direction.x, direction.y, direction.z };
+			return aKernels[static_cast<int>(aMode)](ray, aPrimitives.X(), aPrimitives.Y(), aPrimitives.Z(), aValues.data(), aValues.size(), aMaxDistance, aHitIndices.data(), aHitDistances.data());
+		}
+
+		void IntersectRays(const RayKernel* aKernels, std::span<const Ray<float>> aRays, const Vector3Stream<float>& aPrimitives, std::span<const float> aValues, Batch::HitMode aMode, std::span<std::uint32_t> aHitIndices, std::span<float> aHitDistances, float aMaxDistance, Batch::Execution aExecution)
+		{
+			assert(aMode != Batch::HitMode::All && "Many rays report Any or Closest hits");
+			assert(aHitIndices.size() >= aRays.size() && aHitDistances.size() >= aRays.size() && "Output span too small");
+
+			auto intersect = [&](std::size_t aBegin, std::size_t aEnd)
+			{
+				for (std::size_t ray = aBegin; ray < aEnd; ray++)
+				{
+					if (IntersectRay(aKernels, aRays[ray], aPrimitives, aValues, aMode, aHitIndices.subspan(ray, 1), aHitDistances.subspan(ray, 1), aMaxDistance) == 0)
+					{
+						aHitIndices[ray] = Batch::NoHit;
+						aHitDistances[ray] = std::numeric_limits<float>::infinity();
+					}
+				}
+			};
+			// Every ray goes through all the primitives, so far fewer of them fill a thread.
+			if (aExecution == Batch::Execution::Parallel && !aRays.empty())
+			{
+				ParallelFor(aRays.size(), std::max<std::size_t>(1, MinimumParallelCount / std::max<std::size_t>(1, aValues.size())), 1, intersect);
+				return;
+			}
+			intersect(0, aRays.size());
+		}
+
+		using CullKernel = std::size_t (*)(const float*, const float*, const float*, const float*, std::size_t, const float*, std::size_t, std::size_t, std::size_t, std::uint32_t*);
+
+		template<typename Object>
+		std::size_t CullObjects(CullKernel aKernel, const Vector3Stream<float>& aNormals, std::span<const float> aDistances, std::span<const Object> aObjects, std::span<std::uint32_t> aResult, Batch::Execution aExecution)
+		{
+			assert(aNormals.Size() == aDistances.size() && "Stream size mismatch");
+			assert(aResult.size() >= aObjects.size() && "Output span too small");
+
+			// The max corner of a box and the radius of a sphere both start right after the first Vector3f.
+			const std::size_t stride = sizeof(Object) / sizeof(float);
+			const std::size_t offset = sizeof(Vector3f) / sizeof(float);
+			const float* objects = reinterpret_cast<const float*>(aObjects.data());
+			auto cull = [&](std::size_t aBegin, std::size_t aEnd)
+			{
+				const std::size_t count = aKernel(aNormals.X(), aNormals.Y(), aNormals.Z(), aDistances.data(), aDistances.size(), objects + stride * aBegin, stride, offset, aEnd - aBegin, aResult.data() + aBegin);
+				for (std::size_t result = aBegin; result < aBegin + count; result++)
+				{
+					aResult[result] += static_cast<std::uint32_t>(aBegin);
+				}
+				return count;
+			};
+			if (aObjects.empty())
+			{
+				return 0;
+			}
+			if (aExecution == Batch::Execution::Sequential)
+			{
+				return cull(0, aObjects.size());
+			}
+
+			// Every range writes its survivors to the start of its own part of aResult, moving them together in
+			// range order afterwards keeps the indices ascending.
+			std::vector<std::pair<std::size_t, std::size_t>> ranges;
+			std::mutex rangesMutex;
+			ParallelFor(aObjects.size(), MinimumParallelCount, ParallelAlignment, [&](std::size_t aBegin, std::size_t aEnd)
+			{
+				const std::size_t count = cull(aBegin, aEnd);
+				const std::lock_guard lock(rangesMutex);
+				ranges.emplace_back(aBegin, count);
+			});
+			std::sort(ranges.begin(), ranges.end());
+
+			std::size_t resultCount = 0;
+			for (const auto& [begin, count] : ranges)
+			{
+				std::copy(aResult.begin() + begin, aResult.begin() + begin + count, aResult.begin() + resultCount);
+				resultCount += count;
+			}
+			return resultCount;
+		}
+
+		void TransformVector3s(std::span<const Vector3f> aVectors, const Matrix4x4<float>& aMatrix, std::span<Vector3f> aResult, TransformKind aKind, Batch::Execution aExecution)
+		{
+			assert(aResult.size() >= aVectors.size() && "Output span too small");
+
+			if constexpr (sizeof(Vector3f) == 4 * sizeof(float))
+			{
+				// Zeroing the w column keeps the padding lane of every result at 0.
+				float matrix[16];
+				std::copy(aMatrix.GetData(), aMatrix.GetData() + 16, matrix);
+				matrix[3] = matrix[7] = matrix[11] = matrix[15] = 0.0f;
+
+				const auto transform = Kernels().TransformVectors[static_cast<int>(aKind)];
+				Run(aExecution, aVectors.size(), [&](std::size_t aBegin, std::size_t aEnd)
+				{
+					transform(&aVectors[aBegin].x, matrix, &aResult[aBegin].x, aEnd - aBegin);
+				});
+			}
+			else
+			{
+				const float w = aKind == TransformKind::Point ? 1.0f : 0.0f;
+				for (std::size_t index = 0; index < aVectors.size(); index++)
+				{
+					const Vector4f result = Vector4f(aVectors[index].x, aVectors[index].y, aVectors[index].z, w) * aMatrix;
+					aResult[index] = Vector3f(result.x, result.y, result.z);
+				}
+			}
+		}
+
+		// The w row is (0, 0, 0, 1) so homogeneous vectors keep their w.
+		Matrix4x4<float> CreateRotationMatrix(const Quaternion& aRotation)
+		{
+			const Matrix3x3f rotation = aRotation.CreateRotationMatrix();
+			return Matrix4x4<float>(
+				rotation(1, 1), rotation(1, 2), rotation(1, 3), 0,
+				rotation(2, 1), rotation(2, 2), rotation(2, 3), 0,
+				rotation(3, 1), rotation(3, 2), rotation(3, 3), 0,
+				0, 0, 0, 1
+			);
+		}
+
+#ifdef STM_SIMD_SSE
+		// Rows of Transform::CreateMatrix. Row n is 2 * (q_n * (i, j, k) + r * d_n) - e_n * |q|^2, where the |q|^2
+		// term keeps the diagonal equal to Quaternion::Rotate for quaternions that are not of unit length.
+		void BuildRows(const Vector3f& aScale, const Quaternion& aRotation, const Vector3f& aPosition, __m128 aRows[4])
+		{
+			const __m128 xyzMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+			const __m128 quaternion = _mm_loadu_ps(&aRotation.r);
+			const __m128 r = _mm_shuffle_ps(quaternion, quaternion, _MM_SHUFFLE(0, 0, 0, 0));
+			const __m128 ijk = _mm_shuffle_ps(quaternion, quaternion, _MM_SHUFFLE(3, 3, 2, 1));
+			const __m128 lengthSqr = Simd::Dot4(quaternion, quaternion);
+			const __m128 scale = aScale.Load();
+
+			// (r, k, -j), (-k, r, i) and (j, -i, r)
+			const __m128 d0 = _mm_mul_ps(_mm_shuffle_ps(quaternion, quaternion, _MM_SHUFFLE(0, 2, 3, 0)), _mm_setr_ps(1.0f, 1.0f, -1.0f, 0.0f));
+			const __m128 d1 = _mm_mul_ps(_mm_shuffle_ps(quaternion, quaternion, _MM_SHUFFLE(0, 1, 0, 3)), _mm_setr_ps(-1.0f, 1.0f, 1.0f, 0.0f));
+			const __m128 d2 = _mm_mul_ps(_mm_shuffle_ps(quaternion, quaternion, _MM_SHUFFLE(0, 0, 1, 2)), _mm_setr_ps(1.0f, -1.0f, 1.0f, 0.0f));
+
+			auto row = [&](__m128 aComponent, __m128 aD, __m128 aAxis, __m128 aScale)
+			{
+				__m128 result = Simd::MultiplyAdd(aComponent, ijk, _mm_mul_ps(r, aD));
+				result = _mm_sub_ps(_mm_add_ps(result, result), _mm_mul_ps(aAxis, lengthSqr));
+				return _mm_mul_ps(_mm_and_ps(result, xyzMask), aScale);
+			};
+			aRows[0] = row(_mm_shuffle_ps(quaternion, quaternion, _MM_SHUFFLE(1, 1, 1, 1)), d0, _mm_setr_ps(1.0f, 0.0f, 0.0f, 0.0f), _mm_shuffle_ps(scale, scale, _MM_SHUFFLE(0, 0, 0, 0)));
+			aRows[1] = row(_mm_shuffle_ps(quaternion, quaternion, _MM_SHUFFLE(2, 2, 2, 2)), d1, _mm_setr_ps(0.0f, 1.0f, 0.0f, 0.0f), _mm_shuffle_ps(scale, scale, _MM_SHUFFLE(1, 1, 1, 1)));
+			aRows[2] = row(_mm_shuffle_ps(quaternion, quaternion, _MM_SHUFFLE(3, 3, 3, 3)), d2, _mm_setr_ps(0.0f, 0.0f, 1.0f, 0.0f), _mm_shuffle_ps(scale, scale, _MM_SHUFFLE(2, 2, 2, 2)));
+			aRows[3] = _mm_or_ps(_mm_and_ps(aPosition.Load(), xyzMask), _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+		}
+#endif
+
+		void TransformStream(const Vector3Stream<float>& aVectors, const Matrix4x4<float>& aMatrix, Vector3Stream<float>& aResult, TransformKind aKind, Batch::Execution aExecution)
+		{
+			aResult.Resize(aVectors.Size());
+
+			const auto transform = Kernels().TransformStream[static_cast<int>(aKind)];
+			Run(aExecution, aVectors.Size(), [&](std::size_t aBegin, std::size_t aEnd)
+			{
+				transform(aVectors.X() + aBegin, aVectors.Y() + aBegin, aVectors.Z() + aBegin, aMatrix.GetData(), aResult.X() + aBegin, aResult.Y() + aBegin, aResult.Z() + aBegin, aEnd - aBegin);
+			});
+		}
+	}
+
+	InstructionSet Batch::GetInstructionSet()
+	{
+		return GetDispatch().instructionSet;
+	}
+
+	void Batch::Dot(const Vector3Stream<float>& aVectors0, const Vector3Stream<float>& aVectors1, std::span<float> aResult)
+	{
+		assert(aVectors0.Size() == aVectors1.Size() && "Stream size mismatch");
+		assert(aResult.size() >= aVectors0.Size() && "Output span too small");
+
+		Kernels().Dot(aVectors0.X(), aVectors0.Y(), aVectors0.Z(), aVectors1.X(), aVectors1.Y(), aVectors1.Z(), aResult.data(), aVectors0.Size());
+	}
+
+	void Batch::DistanceSqr(const Vector3Stream<float>& aVectors0, const Vector3Stream<float>& aVectors1, std::span<float> aResult)
+	{
+		assert(aVectors0.Size() == aVectors1.Size() && "Stream size mismatch");
+		assert(aResult.size() >= aVectors0.Size() && "Output span too small");
+
+		Kernels().DistanceSqr(aVectors0.X(), aVectors0.Y(), aVectors0.Z(), aVectors1.X(), aVectors1.Y(), aVectors1.Z(), aResult.data(), aVectors0.Size());
+	}
+
+	void Batch::Length(const Vector3Stream<float>& aVectors, std::span<float> aResult, Precision aPrecision)
+	{
+		assert(aResult.size() >= aVectors.Size() && "Output span too small");
+
+		Kernels().Length[static_cast<int>(aPrecision)](aVectors.X(), aVectors.Y(), aVectors.Z(), aResult.data(), aVectors.Size());
+	}
+
+	void Batch::Normalize(Vector3Stream<float>& aVectors, Precision aPrecision)
+	{
+		Kernels().Normalize[static_cast<int>(aPrecision)](aVectors.X(), aVectors.Y(), aVectors.Z(), aVectors.Size());
+	}
+
+	void Batch::Cross(const Vector3Stream<float>& aVectors0, const Vector3Stream<float>& aVectors1, Vector3Stream<float>& aResult)
+	{
+		assert(aVectors0.Size() == aVectors1.Size() && "Stream size mismatch");
+
+		aResult.Resize(aVectors0.Size());
+		Kernels().Cross(aVectors0.X(), aVectors0.Y(), aVectors0.Z(), aVectors1.X(), aVectors1.Y(), aVectors1.Z(), aResult.X(), aResult.Y(), aResult.Z(), aVectors0.Size());
+	}
+
+	void Batch::Lerp(const Vector3Stream<float>& aFrom, const Vector3Stream<float>& aTo, float aDelta, Vector3Stream<float>& aResult)
+	{
+		assert(aFrom.Size() == aTo.Size() && "Stream size mismatch");
+
+		aResult.Resize(aFrom.Size());
+		Kernels().Lerp(aFrom.X(), aFrom.Y(), aFrom.Z(), aTo.X(), aTo.Y(), aTo.Z(), aDelta, aResult.X(), aResult.Y(), aResult.Z(), aFrom.Size());
+	}
+
+	void Batch::Clamp(std::span<const float> aValues, float aMin, float aMax, std::span<float> aResult, Execution aExecution)
+	{
+		assert(aResult.size() >= aValues.size() && "Output span too small");
+
+		const auto clamp = Kernels().ClampFloats;
+		Run(aExecution, aValues.size(), [&](std::size_t aBegin, std::size_t aEnd)
+		{
+			clamp(aValues.data() + aBegin, aMin, aMax, aResult.data() + aBegin, aEnd - aBegin);
+		});
+	}
+
+	void Batch::Lerp(std::span<const float> aFrom, std::span<const float> aTo, float aDelta, std::span<float> aResult, Execution aExecution)
+	{
+		assert(aFrom.size() == aTo.size() && "Span size mismatch");
+		assert(aResult.size() >= aFrom.size() && "Output span too small");
+
+		const auto lerp = Kernels().LerpFloats;
+		Run(aExecution, aFrom.size(), [&](std::size_t aBegin, std::size_t aEnd)
+		{
+			lerp(aFrom.data() + aBegin, aTo.data() + aBegin, aDelta, aResult.data() + aBegin, aEnd - aBegin);
+		});
+	}
+
+	void Batch::Remap(std::span<const float> aValues, float aFromMin, float aFromMax, float aToMin, float aToMax, std::span<float> aResult, Execution aExecution)
+	{
+		assert(aResult.size() >= aValues.size() && "Output span too small");
+		assert(aFromMin != aFromMax && "Division by 0");
+
+		const float scale = (aToMax - aToMin) / (aFromMax - aFromMin);
+		const float offset = aToMin - aFromMin * scale;
+		const auto scaleOffset = Kernels().ScaleOffsetFloats;
+		Run(aExecution, aValues.size(), [&](std::size_t aBegin, std::size_t aEnd)
+		{
+			scaleOffset(aValues.data() + aBegin, scale, offset, aResult.data() + aBegin, aEnd - aBegin);
+		});
+	}
+
+	void Batch::Add(const Vector3Stream<Fixed32>& aVectors0, const Vector3Stream<Fixed32>& aVectors1, Vector3Stream<Fixed32>& aResult, Execution aExecution)
+	{
+		assert(aVectors0.Size() == aVectors1.Size() && "Stream size mismatch");
+
+		aResult.Resize(aVectors0.Size());
+		const auto add = Kernels().FixedAdd;
+		Run(aExecution, aVectors0.Size(), [&](std::size_t aBegin, std::size_t aEnd)
+		{
+			add(Raw(aVectors0.X() + aBegin), Raw(aVectors1.X() + aBegin), Raw(aResult.X() + aBegin), aEnd - aBegin);
+			add(Raw(aVectors0.Y() + aBegin), Raw(aVectors1.Y() + aBegin), Raw(aResult.Y() + aBegin), aEnd - aBegin);
+			add(Raw(aVectors0.Z() + aBegin), Raw(aVectors1.Z() + aBegin), Raw(aResult.Z() + aBegin), aEnd - aBegin);
+		});
+	}
+
+	void Batch::Multiply(const Vector3Stream<Fixed32>& aVectors0, const Vector3Stream<Fixed32>& aVectors1, Vector3Stream<Fixed32>& aResult, Execution aExecution)
+	{
+		assert(aVectors0.Size() == aVectors1.Size() && "Stream size mismatch");
+
+		aResult.Resize(aVectors0.Size());
+		const auto multiply = Kernels().FixedMultiply;
+		Run(aExecution, aVectors0.Size(), [&](std::size_t aBegin, std::size_t aEnd)
+		{
+			multiply(Raw(aVectors0.X() + aBegin), Raw(aVectors1.X() + aBegin), Raw(aResult.X() + aBegin), aEnd - aBegin);
+			multiply(Raw(aVectors0.Y() + aBegin), Raw(aVectors1.Y() + aBegin), Raw(aResult.Y() + aBegin), aEnd - aBegin);
+			multiply(Raw(aVectors0.Z() + aBegin), Raw(aVectors1.Z() + aBegin), Raw(aResult.Z() + aBegin), aEnd - aBegin);
+		});
+	}
+
+	void Batch::Dot(const Vector3Stream<Fixed32>& aVectors0, const Vector3Stream<Fixed32>& aVectors1, std::span<Fixed32> aResult, Execution aExecution)
+	{
+		assert(aVectors0.Size() == aVectors1.Size() && "Stream size mismatch");
+		assert(aResult.size() >= aVectors0.Size() && "Output span too small");
+
+		const auto dot = Kernels().FixedDot;
+		Run(aExecution, aVectors0.Size(), [&](std::size_t aBegin, std::size_t aEnd)
+		{
+			dot(Raw(aVectors0.X() + aBegin), Raw(aVectors0.Y() + aBegin), Raw(aVectors0.Z() + aBegin),
+				Raw(aVectors1.X() + aBegin), Raw(aVectors1.Y() + aBegin), Raw(aVectors1.Z() + aBegin),
+				Raw(aResult.data() + aBegin), aEnd - aBegin);
+		});
+	}
+
+	void Batch::Cross(const Vector3Stream<Fixed32>& aVectors0, const Vector3Stream<Fixed32>& aVectors1, Vector3Stream<Fixed32>& aResult, Execution aExecution)
+	{
+		assert(aVectors0.Size() == aVectors1.Size() && "Stream size mismatch");
+
+		aResult.Resize(aVectors0.Size());
+		const auto cross = Kernels().FixedCross;
+		Run(aExecution, aVectors0.Size(), [&](std::size_t aBegin, std::size_t aEnd)
+		{
+			cross(Raw(aVectors0.X() + aBegin), Raw(aVectors0.Y() + aBegin), Raw(aVectors0.Z() + aBegin),
+				Raw(aVectors1.X() + aBegin), Raw(aVectors1.Y() + aBegin), Raw(aVectors1.Z() + aBegin),
+				Raw(aResult.X() + aBegin), Raw(aResult.Y() + aBegin), Raw(aResult.Z() + aBegin), aEnd - aBegin);
+		});
+	}
+
+	std::size_t Batch::Overlaps(const AABB2D<float>& aBox, std::span<const AABB2D<float>> aBoxes, std::span<std::uint32_t> aResult)
+	{
+		assert(aResult.size() >= aBoxes.size() && "Output span too small");
+
+		if (aBoxes.empty())
+		{
+			return 0;
+		}
+		return Kernels().OverlapBoxes2D(&aBox.Min().x, &aBoxes[0].Min().x, aBoxes.size(), 0, aResult.data());
+	}
+
+	std::size_t Batch::IntersectSpheres(const Ray<float>& aRay, const Vector3Stream<float>& aCenters, std::span<const float> aRadii, HitMode aMode, std::span<std::uint32_t> aHitIndices, std::span<float> aHitDistances, float aMaxDistance)
+	{
+		return IntersectRay(Kernels().RaySpheres, aRay, aCenters, aRadii, aMode, aHitIndices, aHitDistances, aMaxDistance);
+	}
+
+	std::size_t Batch::IntersectPlanes(const Ray<float>& aRay, const Vector3Stream<float>& aNormals, std::span<const float> aDistances, HitMode aMode, std::span<std::uint32_t> aHitIndices, std::span<float> aHitDistances, float aMaxDistance)
+	{
+		return IntersectRay(Kernels().RayPlanes, aRay, aNormals, aDistances, aMode, aHitIndices, aHitDistances, aMaxDistance);
+	}
+
+	void Batch::IntersectSpheres(std::span<const Ray<float>> aRays, const Vector3Stream<float>& aCenters, std::span<const float> aRadii, HitMode aMode, std::span<std::uint32_t> aHitIndices, std::span<float> aHitDistances, float aMaxDistance, Execution aExecution)
+	{
+		IntersectRays(Kernels().RaySpheres, aRays, aCenters, aRadii, aMode, aHitIndices, aHitDistances, aMaxDistance, aExecution);
+	}
+
+	void Batch::IntersectPlanes(std::span<const Ray<float>> aRays, const Vector3Stream<float>& aNormals, std::span<const float> aDistances, HitMode aMode, std::span<std::uint32_t> aHitIndices, std::span<float> aHitDistances, float aMaxDistance, Execution aExecution)
+	{
+		IntersectRays(Kernels().RayPlanes, aRays, aNormals, aDistances, aMode, aHitIndices, aHitDistances, aMaxDistance, aExecution);
+	}
+
+	std::size_t Batch::Cull(const Vector3Stream<float>& aNormals, std::span<const float> aDistances, std::span<const AABB3D<float>> aBoxes, std::span<std::uint32_t> aResult, Execution aExecution)
+	{
+		return CullObjects(Kernels().CullBoxes, aNormals, aDistances, aBoxes, aResult, aExecution);
+	}
+
+	std::size_t Batch::Cull(const Vector3Stream<float>& aNormals, std::span<const float> aDistances, std::span<const Sphere<float>> aSpheres, std::span<std::uint32_t> aResult, Execution aExecution)
+	{
+		return CullObjects(Kernels().CullSpheres, aNormals, aDistances, aSpheres, aResult, aExecution);
+	}
+
+	void Batch::Multiply(std::span<const Matrix4x4<float>> aLeft, const Matrix4x4<float>& aRight, std::span<Matrix4x4<float>> aResult)
+	{
+		assert(aResult.size() >= aLeft.size() && "Output span too small");
+
+		if (aLeft.empty())
+		{
+			return;
+		}
+		Kernels().MultiplyMatrices(aLeft.front().GetData(), aRight.GetData(), aResult.front().GetData(), aLeft.size());
+	}
+
+	void Batch::Multiply(std::span<const Matrix4x4<float>> aLeft, std::span<const Matrix4x4<float>> aRight, std::span<Matrix4x4<float>> aResult)
+	{
+		assert(aLeft.size() == aRight.size() && "Span size mismatch");
+		assert(aResult.size() >= aLeft.size() && "Output span too small");
+
+		if (aLeft.empty())
+		{
+			return;
+		}
+		Kernels().MultiplyMatricesPairwise(aLeft.front().GetData(), aRight.front().GetData(), aResult.front().GetData(), aLeft.size());
+	}
+
+	// Every inverse is a branchy computation of its own, these loop over the SSE single matrix versions.
+	std::size_t Batch::Inverse(std::span<const Matrix4x4<float>> aMatrices, std::span<Matrix4x4<float>> aResult)
+	{
+		assert(aResult.size() >= aMatrices.size() && "Output span too small");
+
+		std::size_t singularCount = 0;
+		for (std::size_t index = 0; index < aMatrices.size(); index++)
+		{
+			singularCount += !Matrix4x4<float>::GetInverse(aMatrices[index], aResult[index]);
+		}
+		return singularCount;
+	}
+
+	std::size_t Batch::InverseAffine(std::span<const Matrix4x4<float>> aTransforms, std::span<Matrix4x4<float>> aResult)
+	{
+		assert(aResult.size() >= aTransforms.size() && "Output span too small");
+
+		std::size_t singularCount = 0;
+		for (std::size_t index = 0; index < aTransforms.size(); index++)
+		{
+			singularCount += !Matrix4x4<float>::GetInverseAffine(aTransforms[index], aResult[index]);
+		}
+		return singularCount;
+	}
+
+	std::size_t Batch::Inverse(std::span<const Matrix3x3<float>> aMatrices, std::span<Matrix3x3<float>> aResult)
+	{
+		assert(aResult.size() >= aMatrices.size() && "Output span too small");
+
+		std::size_t singularCount = 0;
+		for (std::size_t index = 0; index < aMatrices.size(); index++)
+		{
+			singularCount += !Matrix3x3<float>::GetInverse(aMatrices[index], aResult[index]);
+		}
+		return singularCount;
+	}
+
+	void Batch::Determinant(std::span<const Matrix4x4<float>> aMatrices, std::span<float> aResult)
+	{
+		assert(aResult.size() >= aMatrices.size() && "Output span too small");
+
+		for (std::size_t index = 0; index < aMatrices.size(); index++)
+		{
+			aResult[index] = Matrix4x4<float>::GetDeterminant(aMatrices[index]);
+		}
+	}
+
+	void Batch::Determinant(std::span<const Matrix3x3<float>> aMatrices, std::span<float> aResult)
+	{
+		assert(aResult.size() >= aMatrices.size() && "Output span too small");
+
+		for (std::size_t index = 0; index < aMatrices.size(); index++)
+		{
+			aResult[index] = Matrix3x3<float>::GetDeterminant(aMatrices[index]);
+		}
+	}
+
+	void Batch::TransformPoints(std::span<const Vector3f> aPoints, const Matrix4x4<float>& aMatrix, std::span<Vector3f> aResult, Execution aExecution)
+	{
+		TransformVector3s(aPoints, aMatrix, aResult, TransformKind::Point, aExecution);
+	}
+
+	void Batch::TransformDirections(std::span<const Vector3f> aDirections, const Matrix4x4<float>& aMatrix, std::span<Vector3f> aResult, Execution aExecution)
+	{
+		TransformVector3s(aDirections, aMatrix, aResult, TransformKind::Direction, aExecution);
+	}
+
+	void Batch::TransformPoints(const Vector3Stream<float>& aPoints, const Matrix4x4<float>& aMatrix, Vector3Stream<float>& aResult, Execution aExecution)
+	{
+		TransformStream(aPoints, aMatrix, aResult, TransformKind::Point, aExecution);
+	}
+
+	void Batch::TransformDirections(const Vector3Stream<float>& aDirections, const Matrix4x4<float>& aMatrix, Vector3Stream<float>& aResult, Execution aExecution)
+	{
+		TransformStream(aDirections, aMatrix, aResult, TransformKind::Direction, aExecution);
+	}
+
+	void Batch::TransformHomogeneous(std::span<const Vector4f> aVectors, const Matrix4x4<float>& aMatrix, std::span<Vector4f> aResult, Execution aExecution)
+	{
+		assert(aResult.size() >= aVectors.size() && "Output span too small");
+
+		const auto transform = Kernels().TransformVectors[static_cast<int>(TransformKind::Homogeneous)];
+		Run(aExecution, aVectors.size(), [&](std::size_t aBegin, std::size_t aEnd)
+		{
+			transform(&aVectors[aBegin].x, aMatrix.GetData(), &aResult[aBegin].x, aEnd - aBegin);
+		});
+	}
+
+	void Batch::Normalize(std::span<Quaternion> aQuaternions, Precision aPrecision)
+	{
+		if (aQuaternions.empty())
+		{
+			return;
+		}
+		Kernels().NormalizeQuaternions[static_cast<int>(aPrecision)](&aQuaternions.front().r, aQuaternions.size());
+	}
+
+	void Batch::Rotate(std::span<const Vector3f> aVectors, const Quaternion& aRotation, std::span<Vector3f> aResult, Execution aExecution)
+	{
+		TransformVector3s(aVectors, CreateRotationMatrix(aRotation), aResult, TransformKind::Direction, aExecution);
+	}
+
+	void Batch::Rotate(std::span<const Vector4f> aVectors, const Quaternion& aRotation, std::span<Vector4f> aResult, Execution aExecution)
+	{
+		TransformHomogeneous(aVectors, CreateRotationMatrix(aRotation), aResult, aExecution);
+	}
+
+	void Batch::Rotate(const Vector3Stream<float>& aVectors, const Quaternion& aRotation, Vector3Stream<float>& aResult, Execution aExecution)
+	{
+		TransformStream(aVectors, CreateRotationMatrix(aRotation), aResult, TransformKind::Direction, aExecution);
+	}
+
+	void Batch::Rotate(const QuaternionStream& aRotations, const Vector3Stream<float>& aVectors, Vector3Stream<float>& aResult, Execution aExecution)
+	{
+		assert(aRotations.Size() == aVectors.Size() && "Stream size mismatch");
+
+		aResult.Resize(aVectors.Size());
+
+		const auto rotate = Kernels().RotateStream;
+		Run(aExecution, aVectors.Size(), [&](std::size_t aBegin, std::size_t aEnd)
+		{
+			rotate(aRotations.R() + aBegin, aRotations.I() + aBegin, aRotations.J() + aBegin, aRotations.K() + aBegin,
+				aVectors.X() + aBegin, aVectors.Y() + aBegin, aVectors.Z() + aBegin,
+				aResult.X() + aBegin, aResult.Y() + aBegin, aResult.Z() + aBegin, aEnd - aBegin);
+		});
+	}
+
+	void Batch::ToQuaternions(const Vector3Stream<float>& aEulerAngles, QuaternionStream& aResult, Execution aExecution)
+	{
+		aResult.Resize(aEulerAngles.Size());
+
+		const auto convert = Kernels().EulerToQuaternionStream;
+		Run(aExecution, aEulerAngles.Size(), [&](std::size_t aBegin, std::size_t aEnd)
+		{
+			convert(aEulerAngles.X() + aBegin, aEulerAngles.Y() + aBegin, aEulerAngles.Z() + aBegin,
+				aResult.R() + aBegin, aResult.I() + aBegin, aResult.J() + aBegin, aResult.K() + aBegin, aEnd - aBegin);
+		});
+	}
+
+	void Batch::ToEulerAngles(const QuaternionStream& aRotations, Vector3Stream<float>& aResult, Execution aExecution)
+	{
+		aResult.Resize(aRotations.Size());
+
+		const auto convert = Kernels().QuaternionToEulerStream;
+		Run(aExecution, aRotations.Size(), [&](std::size_t aBegin, std::size_t aEnd)
+		{
+			convert(aRotations.R() + aBegin, aRotations.I() + aBegin, aRotations.J() + aBegin, aRotations.K() + aBegin,
+				aResult.X() + aBegin, aResult.Y() + aBegin, aResult.Z() + aBegin, aEnd - aBegin);
+		});
+	}
+
+	void Batch::BuildMatrices(std::span<const Transform> aTransforms, std::span<Matrix4x4f> aResult, Execution aExecution)
+	{
+		assert(aResult.size() >= aTransforms.size() && "Output span too small");
+
+		Run(aExecution, aTransforms.size(), [&](std::size_t aBegin, std::size_t aEnd)
+		{
+			for (std::size_t index = aBegin; index < aEnd; index++)
+			{
+				const Transform& transform = aTransforms[index];
+#ifdef STM_SIMD_SSE
+				__m128 rows[4];
+				BuildRows(transform.GetScale(), transform.GetRotationQuaternion(), transform.GetPosition(), rows);
+				float* matrix = aResult[index].GetData();
+				_mm_store_ps(matrix, rows[0]);
+				_mm_store_ps(matrix + 4, rows[1]);
+				_mm_store_ps(matrix + 8, rows[2]);
+				_mm_store_ps(matrix + 12, rows[3]);
+#else
+				aResult[index] = transform.CreateMatrix();
+#endif
+			}
+		});
+	}
+
+	void Batch::BuildMatrices(std::span<const Transform> aTransforms, std::span<Matrix3x4f> aResult, Execution aExecution)
+	{
+		assert(aResult.size() >= aTransforms.size() && "Output span too small");
+
+		Run(aExecution, aTransforms.size(), [&](std::size_t aBegin, std::size_t aEnd)
+		{
+			for (std::size_t index = aBegin; index < aEnd; index++)
+			{
+				const Transform& transform = aTransforms[index];
+#ifdef STM_SIMD_SSE
+				__m128 rows[4];
+				BuildRows(transform.GetScale(), transform.GetRotationQuaternion(), transform.GetPosition(), rows);
+				_MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+				float* matrix = aResult[index].GetData();
+				_mm_store_ps(matrix, rows[0]);
+				_mm_store_ps(matrix + 4, rows[1]);
+				_mm_store_ps(matrix + 8, rows[2]);
+#else
+				aResult[index] = transform.CreateAffineMatrix();
+#endif
+			}
+		});
+	}
+
+	void Batch::Pack(std::span<const Vector3f> aVectors, std::span<Vector3h> aResult)
+	{
+		assert(aResult.size() >= aVectors.size() && "Output span too small");
+
+		if (aVectors.empty())
+		{
+			return;
+		}
+		// Padding lanes are converted along with the rest, which keeps the whole array one flat run.
+		const std::size_t floatCount = aVectors.size() * (sizeof(Vector3f) / sizeof(float));
+		Kernels().FloatsToHalves(&aVectors.front().x, &aResult.front().x, floatCount);
+	}
+
+	void Batch::Unpack(std::span<const Vector3h> aVectors, std::span<Vector3f> aResult)
+	{
+		assert(aResult.size() >= aVectors.size() && "Output span too small");
+
+		if (aVectors.empty())
+		{
+			return;
+		}
+		const std::size_t floatCount = aVectors.size() * (sizeof(Vector3f) / sizeof(float));
+		Kernels().HalvesToFloats(&aVectors.front().x, &aResult.front().x, floatCount);
+	}
+
+	void Batch::Pack(std::span<const Quaternion> aQuaternions, std::span<PackedQuaternion> aResult)
+	{
+		assert(aResult.size() >= aQuaternions.size() && "Output span too small");
+
+		if (aQuaternions.empty())
+		{
+			return;
+		}
+		Kernels().FloatsToSnorm16(&aQuaternions.front().r, &aResult.front().r, aQuaternions.size() * 4);
+	}
+
+	void Batch::Unpack(std::span<const PackedQuaternion> aQuaternions, std::span<Quaternion> aResult)
+	{
+		assert(aResult.size() >= aQuaternions.size() && "Output span too small");
+
+		if (aQuaternions.empty())
+		{
+			return;
+		}
+		Kernels().Snorm16ToFloats(&aQuaternions.front().r, &aResult.front().r, aQuaternions.size() * 4);
+	}
+
+	void Batch::Pack(std::span<const Vector3f> aNormals, std::span<OctahedralNormal> aResult)
+	{
+		assert(aResult.size() >= aNormals.size() && "Output span too small");
+
+		if (aNormals.empty())
+		{
+			return;
+		}
+		if constexpr (sizeof(Vector3f) == 4 * sizeof(float))
+		{
+			Kernels().NormalsToOctahedral(&aNormals.front().x, &aResult.front().u, aNormals.size());
+		}
+		else
+		{
+			for (std::size_t index = 0; index < aNormals.size(); index++)
+			{
+				aResult[index] = OctahedralNormal(aNormals[index]);
+			}
+		}
+	}
+
+	void Batch::Unpack(std::span<const OctahedralNormal> aNormals, std::span<Vector3f> aResult)
+	{
+		assert(aResult.size() >= aNormals.size() && "Output span too small");
+
+		if (aNormals.empty())
+		{
+			return;
+		}
+		if constexpr (sizeof(Vector3f) == 4 * sizeof(float))
+		{
+			Kernels().OctahedralToNormals(&aNormals.front().u, &aResult.front().x, aNormals.size());
+		}
+		else
+		{
+			for (std::size_t index = 0; index < aNormals.size(); index++)
+			{
+				aResult[index] = aNormals[index].Unpack();
+			}
+		}
+	}
+
+	// Ten bit fields need per lane integer shifts, which the kernels' lanes do not have, so these loops stay scalar.
+	void Batch::Pack(std::span<const Vector4f> aVectors, std::span<PackedVector1010102> aResult)
+	{
+		assert(aResult.size() >= aVectors.size() && "Output span too small");
+
+		for (std::size_t index = 0; index < aVectors.size(); index++)
+		{
+			aResult[index] = PackedVector1010102(aVectors[index]);
+		}
+	}
+
+	void Batch::Unpack(std::span<const PackedVector1010102> aVectors, std::span<Vector4f> aResult)
+	{
+		assert(aResult.size() >= aVectors.size() && "Output span too small");
+
+		for (std::size_t index = 0; index < aVectors.size(); index++)
+		{
+			aResult[index] = aVectors[index].Unpack();
+		}
+	}
+}
@@ -0,0 +1,212 @@
+// Everything but the kernels is included before the instruction set is enabled, so inline std and library
+// functions emitted here stay plain x86-64 and the linker can pick any copy of them.
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+
+#include "Batch.hpp"
+#include "Precision.hpp"
+
+#if !defined(STM_NO_SIMD) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+
+// MSVC accepts every intrinsic without flags.
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2,fma,f16c"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2,fma,f16c")
+#endif
+
+#include "FastMath.hpp"
+#include "BatchKernels.hpp"
+
+namespace stm
+{
+	namespace
+	{
+		struct AVX2Lanes
+		{
+			using Register = __m256;
+
+			static constexpr std::size_t Width = 8;
+
+			static __m256i Mask(std::size_t aCount)
+			{
+				return _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(aCount)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+			}
+
+			static Register Load(const float* aData, std::size_t aCount)
+			{
+				if (aCount == Width)
+				{
+					return _mm256_loadu_ps(aData);
+				}
+				return _mm256_maskload_ps(aData, Mask(aCount));
+			}
+
+			static void Store(float* aData, Register aValue, std::size_t aCount)
+			{
+				if (aCount == Width)
+				{
+					_mm256_storeu_ps(aData, aValue);
+					return;
+				}
+				_mm256_maskstore_ps(aData, Mask(aCount), aValue);
+			}
+
+			static Register LoadHalves(const std::uint16_t* aData, std::size_t aCount)
+			{
+				if (aCount == Width)
+				{
+					return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(aData)));
+				}
+
+				std::uint16_t buffer[Width] = {};
+				for (std::size_t index = 0; index < aCount; index++)
+				{
+					buffer[index] = aData[index];
+				}
+				return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer)));
+			}
+
+			static void StoreHalves(std::uint16_t* aData, Register aValue, std::size_t aCount)
+			{
+				StoreShorts(aData, _mm256_cvtps_ph(aValue, _MM_FROUND_TO_NEAREST_INT), aCount);
+			}
+
+			static Register LoadInt16(const std::int16_t* aData, std::size_t aCount)
+			{
+				if (aCount == Width)
+				{
+					return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(aData))));
+				}
+
+				std::int16_t buffer[Width] = {};
+				for (std::size_t index = 0; index < aCount; index++)
+				{
+					buffer[index] = aData[index];
+				}
+				return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer))));
+			}
+
+			static void StoreInt16(std::int16_t* aData, Register aValue, std::size_t aCount)
+			{
+				const __m256i values = _mm256_cvtps_epi32(aValue);
+				StoreShorts(aData, _mm_packs_epi32(_mm256_castsi256_si128(values), _mm256_extracti128_si256(values, 1)), aCount);
+			}
+
+			template<typename Short>
+			static void StoreShorts(Short* aData, __m128i aValue, std::size_t aCount)
+			{
+				if (aCount == Width)
+				{
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(aData), aValue);
+					return;
+				}
+
+				Short buffer[Width];
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(buffer), aValue);
+				for (std::size_t index = 0; index < aCount; index++)
+				{
+					aData[index] = buffer[index];
+				}
+			}
+
+			using FixedRegister = __m256i;
+
+			static FixedRegister LoadFixed(const std::int32_t* aData, std::size_t aCount)
+			{
+				if (aCount == Width)
+				{
+					return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(aData));
+				}
+				return _mm256_maskload_epi32(reinterpret_cast<const int*>(aData), Mask(aCount));
+			}
+
+			static void StoreFixed(std::int32_t* aData, FixedRegister aValue, std::size_t aCount)
+			{
+				if (aCount == Width)
+				{
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(aData), aValue);
+					return;
+				}
+				_mm256_maskstore_epi32(reinterpret_cast<int*>(aData), Mask(aCount), aValue);
+			}
+
+			static FixedRegister AddFixed(FixedRegister aA, FixedRegister aB) { return _mm256_add_epi32(aA, aB); }
+			static FixedRegister SubFixed(FixedRegister aA, FixedRegister aB) { return _mm256_sub_epi32(aA, aB); }
+
+			// Signed 64 bit products of the even and odd lanes, bits 16 to 47 blended back together.
+			static FixedRegister MultiplyFixed(FixedRegister aA, FixedRegister aB)
+			{
+				const __m256i even = _mm256_srli_epi64(_mm256_mul_epi32(aA, aB), 16);
+				const __m256i odd = _mm256_slli_epi64(_mm256_mul_epi32(_mm256_srli_epi64(aA, 32), _mm256_srli_epi64(aB, 32)), 16);
+				return _mm256_blend_epi32(even, odd, 0xAA);
+			}
+
+			static Register Splat(float aValue) { return _mm256_set1_ps(aValue); }
+			static Register Add(Register aA, Register aB) { return _mm256_add_ps(aA, aB); }
+			static Register Sub(Register aA, Register aB) { return _mm256_sub_ps(aA, aB); }
+			static Register Mul(Register aA, Register aB) { return _mm256_mul_ps(aA, aB); }
+			static Register Div(Register aA, Register aB) { return _mm256_div_ps(aA, aB); }
+			static Register Sqrt(Register aA) { return _mm256_sqrt_ps(aA); }
+			static Register ReciprocalSqrt(Register aA) { return _mm256_rsqrt_ps(aA); }
+			static Register Min(Register aA, Register aB) { return _mm256_min_ps(aA, aB); }
+			static Register Max(Register aA, Register aB) { return _mm256_max_ps(aA, aB); }
+			static Register MultiplyAdd(Register aA, Register aB, Register aC) { return _mm256_fmadd_ps(aA, aB, aC); }
+			static Register Round(Register aA) { return _mm256_round_ps(aA, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+			static Register Less(Register aA, Register aB) { return _mm256_cmp_ps(aA, aB, _CMP_LT_OQ); }
+			static Register Select(Register aMask, Register aA, Register aB) { return _mm256_blendv_ps(aB, aA, aMask); }
+			static Register And(Register aA, Register aB) { return _mm256_and_ps(aA, aB); }
+			static Register Xor(Register aA, Register aB) { return _mm256_xor_ps(aA, aB); }
+			static std::uint32_t MaskBits(Register aMask) { return static_cast<std::uint32_t>(_mm256_movemask_ps(aMask)); }
+
+			static Register Sum4(Register aA)
+			{
+				Register sums = _mm256_add_ps(aA, _mm256_permute_ps(aA, _MM_SHUFFLE(2, 3, 0, 1)));
+				return _mm256_add_ps(sums, _mm256_permute_ps(sums, _MM_SHUFFLE(1, 0, 3, 2)));
+			}
+
+			template<int Lane>
+			static Register Broadcast4(Register aA)
+			{
+				return _mm256_permute_ps(aA, _MM_SHUFFLE(Lane, Lane, Lane, Lane));
+			}
+
+			static Register Replicate4(const float* aData)
+			{
+				return _mm256_broadcast_ps(reinterpret_cast<const __m128*>(aData));
+			}
+		};
+	}
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+namespace stm
+{
+	const BatchKernels* GetAVX2Kernels()
+	{
+		static const BatchKernels kernels = BatchKernelsFor<AVX2Lanes>::Create();
+		return &kernels;
+	}
+}
+#else
+#include "BatchKernels.hpp"
+
+namespace stm
+{
+	const BatchKernels* GetAVX2Kernels()
+	{
+		return nullptr;
+	}
+}
+#endif
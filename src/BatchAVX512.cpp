@@ -0,0 +1,213 @@
+// Everything but the kernels is included before the instruction set is enabled, so inline std and library
+// functions emitted here stay plain x86-64 and the linker can pick any copy of them.
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+
+#include "Batch.hpp"
+#include "Precision.hpp"
+
+#if !defined(STM_NO_SIMD) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+
+// MSVC accepts every intrinsic without flags.
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx512f,avx512dq,avx512vl,avx2,fma,f16c"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512dq,avx512vl,avx2,fma,f16c")
+#endif
+
+#include "FastMath.hpp"
+#include "BatchKernels.hpp"
+
+namespace stm
+{
+	namespace
+	{
+		struct AVX512Lanes
+		{
+			using Register = __m512;
+
+			static constexpr std::size_t Width = 16;
+
+			static __mmask16 Mask(std::size_t aCount)
+			{
+				return static_cast<__mmask16>((1u << aCount) - 1u);
+			}
+
+			static Register Load(const float* aData, std::size_t aCount)
+			{
+				if (aCount == Width)
+				{
+					return _mm512_loadu_ps(aData);
+				}
+				return _mm512_maskz_loadu_ps(Mask(aCount), aData);
+			}
+
+			static void Store(float* aData, Register aValue, std::size_t aCount)
+			{
+				if (aCount == Width)
+				{
+					_mm512_storeu_ps(aData, aValue);
+					return;
+				}
+				_mm512_mask_storeu_ps(aData, Mask(aCount), aValue);
+			}
+
+			// Masked 16 bit loads need AVX-512BW, so partial loads go through a buffer.
+			template<typename Short>
+			static __m256i LoadShorts(const Short* aData, std::size_t aCount)
+			{
+				if (aCount == Width)
+				{
+					return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(aData));
+				}
+
+				Short buffer[Width] = {};
+				for (std::size_t index = 0; index < aCount; index++)
+				{
+					buffer[index] = aData[index];
+				}
+				return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(buffer));
+			}
+
+			static Register LoadHalves(const std::uint16_t* aData, std::size_t aCount)
+			{
+				return _mm512_cvtph_ps(LoadShorts(aData, aCount));
+			}
+
+			static void StoreHalves(std::uint16_t* aData, Register aValue, std::size_t aCount)
+			{
+				const __m256i halves = _mm512_cvtps_ph(aValue, _MM_FROUND_TO_NEAREST_INT);
+				if (aCount == Width)
+				{
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(aData), halves);
+					return;
+				}
+
+				std::uint16_t buffer[Width];
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(buffer), halves);
+				for (std::size_t index = 0; index < aCount; index++)
+				{
+					aData[index] = buffer[index];
+				}
+			}
+
+			static Register LoadInt16(const std::int16_t* aData, std::size_t aCount)
+			{
+				return _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(LoadShorts(aData, aCount)));
+			}
+
+			static void StoreInt16(std::int16_t* aData, Register aValue, std::size_t aCount)
+			{
+				_mm512_mask_cvtsepi32_storeu_epi16(aData, Mask(aCount), _mm512_cvtps_epi32(aValue));
+			}
+
+			using FixedRegister = __m512i;
+
+			static FixedRegister LoadFixed(const std::int32_t* aData, std::size_t aCount)
+			{
+				if (aCount == Width)
+				{
+					return _mm512_loadu_si512(aData);
+				}
+				return _mm512_maskz_loadu_epi32(Mask(aCount), aData);
+			}
+
+			static void StoreFixed(std::int32_t* aData, FixedRegister aValue, std::size_t aCount)
+			{
+				if (aCount == Width)
+				{
+					_mm512_storeu_si512(aData, aValue);
+					return;
+				}
+				_mm512_mask_storeu_epi32(aData, Mask(aCount), aValue);
+			}
+
+			static FixedRegister AddFixed(FixedRegister aA, FixedRegister aB) { return _mm512_add_epi32(aA, aB); }
+			static FixedRegister SubFixed(FixedRegister aA, FixedRegister aB) { return _mm512_sub_epi32(aA, aB); }
+
+			// Signed 64 bit products of the even and odd lanes, bits 16 to 47 blended back together.
+			static FixedRegister MultiplyFixed(FixedRegister aA, FixedRegister aB)
+			{
+				const __m512i even = _mm512_srli_epi64(_mm512_mul_epi32(aA, aB), 16);
+				const __m512i odd = _mm512_slli_epi64(_mm512_mul_epi32(_mm512_srli_epi64(aA, 32), _mm512_srli_epi64(aB, 32)), 16);
+				return _mm512_mask_blend_epi32(0xAAAA, even, odd);
+			}
+
+			static Register Splat(float aValue) { return _mm512_set1_ps(aValue); }
+			static Register Add(Register aA, Register aB) { return _mm512_add_ps(aA, aB); }
+			static Register Sub(Register aA, Register aB) { return _mm512_sub_ps(aA, aB); }
+			static Register Mul(Register aA, Register aB) { return _mm512_mul_ps(aA, aB); }
+			static Register Div(Register aA, Register aB) { return _mm512_div_ps(aA, aB); }
+			static Register Sqrt(Register aA) { return _mm512_sqrt_ps(aA); }
+			static Register ReciprocalSqrt(Register aA) { return _mm512_rsqrt14_ps(aA); }
+			static Register Min(Register aA, Register aB) { return _mm512_min_ps(aA, aB); }
+			static Register Max(Register aA, Register aB) { return _mm512_max_ps(aA, aB); }
+			static Register MultiplyAdd(Register aA, Register aB, Register aC) { return _mm512_fmadd_ps(aA, aB, aC); }
+			static Register Round(Register aA) { return _mm512_roundscale_ps(aA, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+			// Comparisons produce a k mask, widened to a register so the kernels can treat every variant alike.
+			static Register Less(Register aA, Register aB)
+			{
+				return _mm512_castsi512_ps(_mm512_movm_epi32(_mm512_cmp_ps_mask(aA, aB, _CMP_LT_OQ)));
+			}
+
+			static Register Select(Register aMask, Register aA, Register aB)
+			{
+				return _mm512_mask_blend_ps(_mm512_movepi32_mask(_mm512_castps_si512(aMask)), aB, aA);
+			}
+
+			static Register And(Register aA, Register aB) { return _mm512_and_ps(aA, aB); }
+			static Register Xor(Register aA, Register aB) { return _mm512_xor_ps(aA, aB); }
+			static std::uint32_t MaskBits(Register aMask) { return _mm512_movepi32_mask(_mm512_castps_si512(aMask)); }
+
+			static Register Sum4(Register aA)
+			{
+				Register sums = _mm512_add_ps(aA, _mm512_permute_ps(aA, _MM_SHUFFLE(2, 3, 0, 1)));
+				return _mm512_add_ps(sums, _mm512_permute_ps(sums, _MM_SHUFFLE(1, 0, 3, 2)));
+			}
+
+			template<int Lane>
+			static Register Broadcast4(Register aA)
+			{
+				return _mm512_permute_ps(aA, _MM_SHUFFLE(Lane, Lane, Lane, Lane));
+			}
+
+			static Register Replicate4(const float* aData)
+			{
+				return _mm512_broadcast_f32x4(_mm_loadu_ps(aData));
+			}
+		};
+	}
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+namespace stm
+{
+	const BatchKernels* GetAVX512Kernels()
+	{
+		static const BatchKernels kernels = BatchKernelsFor<AVX512Lanes>::Create();
+		return &kernels;
+	}
+}
+#else
+#include "BatchKernels.hpp"
+
+namespace stm
+{
+	const BatchKernels* GetAVX512Kernels()
+	{
+		return nullptr;
+	}
+}
+#endif
@@ -0,0 +1,935 @@
+#pragma once
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+
+#include "Batch.hpp"
+#include "FastMath.hpp"
+#include "Precision.hpp"
+
+// Kernels behind the Batch entry points. Every instruction set variant lives in its own
+// translation unit, the AVX ones include this header and FastMath.hpp last with their
+// instruction set enabled by pragma, so this header must stay free of inline non-template
+// code and must not include anything else from the library; the templates below are only
+// instantiated with lane types that have internal linkage in those translation units.
+
+namespace stm
+{
+	// Points get the translation row added, directions do not, homogeneous vectors use their own w.
+	enum class TransformKind
+	{
+		Point,
+		Direction,
+		Homogeneous
+	};
+
+	struct BatchKernels
+	{
+		void (*Dot)(const float* aX0, const float* aY0, const float* aZ0, const float* aX1, const float* aY1, const float* aZ1, float* aResult, std::size_t aCount);
+		void (*DistanceSqr)(const float* aX0, const float* aY0, const float* aZ0, const float* aX1, const float* aY1, const float* aZ1, float* aResult, std::size_t aCount);
+		// Indexed by Precision.
+		void (*Length[3])(const float* aX, const float* aY, const float* aZ, float* aResult, std::size_t aCount);
+		void (*Normalize[3])(float* aX, float* aY, float* aZ, std::size_t aCount);
+		void (*Cross)(const float* aX0, const float* aY0, const float* aZ0, const float* aX1, const float* aY1, const float* aZ1, float* aResultX, float* aResultY, float* aResultZ, std::size_t aCount);
+		void (*Lerp)(const float* aX0, const float* aY0, const float* aZ0, const float* aX1, const float* aY1, const float* aZ1, float aDelta, float* aResultX, float* aResultY, float* aResultZ, std::size_t aCount);
+
+		// Flat float arrays, ScaleOffsetFloats computes aValues * aScale + aOffset.
+		void (*ClampFloats)(const float* aValues, float aMin, float aMax, float* aResult, std::size_t aCount);
+		void (*LerpFloats)(const float* aFrom, const float* aTo, float aDelta, float* aResult, std::size_t aCount);
+		void (*ScaleOffsetFloats)(const float* aValues, float aScale, float aOffset, float* aResult, std::size_t aCount);
+
+		// Row major 4x4 matrices, aResult[n] = aLeft[n] * aRight.
+		void (*MultiplyMatrices)(const float* aLeft, const float* aRight, float* aResult, std::size_t aCount);
+		// aResult[n] = aLeft[n] * aRight[n].
+		void (*MultiplyMatricesPairwise)(const float* aLeft, const float* aRight, float* aResult, std::size_t aCount);
+
+		// Groups of four floats (Vector4f or padded Vector3f) times a row major 4x4 matrix, indexed by TransformKind.
+		void (*TransformVectors[3])(const float* aVectors, const float* aMatrix, float* aResult, std::size_t aCount);
+		// Structure of arrays version, indexed by TransformKind::Point or TransformKind::Direction.
+		void (*TransformStream[2])(const float* aX, const float* aY, const float* aZ, const float* aMatrix, float* aResultX, float* aResultY, float* aResultZ, std::size_t aCount);
+
+		// Quaternions stored as r, i, j, k, indexed by Precision.
+		void (*NormalizeQuaternions[3])(float* aQuaternions, std::size_t aCount);
+		// Vector n rotated by unit quaternion n, both as structure of arrays.
+		void (*RotateStream)(const float* aR, const float* aI, const float* aJ, const float* aK, const float* aX, const float* aY, const float* aZ, float* aResultX, float* aResultY, float* aResultZ, std::size_t aCount);
+		// Euler angles in degrees, applied as in Quaternion(x, y, z), to quaternions and back.
+		void (*EulerToQuaternionStream)(const float* aX, const float* aY, const float* aZ, float* aResultR, float* aResultI, float* aResultJ, float* aResultK, std::size_t aCount);
+		void (*QuaternionToEulerStream)(const float* aR, const float* aI, const float* aJ, const float* aK, float* aResultX, float* aResultY, float* aResultZ, std::size_t aCount);
+
+		// Fixed32 raw values, FixedAdd and FixedMultiply on flat arrays and the others on structure of arrays.
+		// Integer arithmetic only, so every variant gives the same bits as the Fixed32 operators.
+		void (*FixedAdd)(const std::int32_t* aValues0, const std::int32_t* aValues1, std::int32_t* aResult, std::size_t aCount);
+		void (*FixedMultiply)(const std::int32_t* aValues0, const std::int32_t* aValues1, std::int32_t* aResult, std::size_t aCount);
+		void (*FixedDot)(const std::int32_t* aX0, const std::int32_t* aY0, const std::int32_t* aZ0, const std::int32_t* aX1, const std::int32_t* aY1, const std::int32_t* aZ1, std::int32_t* aResult, std::size_t aCount);
+		void (*FixedCross)(const std::int32_t* aX0, const std::int32_t* aY0, const std::int32_t* aZ0, const std::int32_t* aX1, const std::int32_t* aY1, const std::int32_t* aZ1, std::int32_t* aResultX, std::int32_t* aResultY, std::int32_t* aResultZ, std::size_t aCount);
+
+		// 2D boxes stored as min x, min y, max x, max y. Writes aFirstIndex plus the position of every box in
+		// aBoxes that overlaps aBox to aResult and returns how many there were. aResult must hold aCount entries.
+		std::size_t (*OverlapBoxes2D)(const float* aBox, const float* aBoxes, std::size_t aCount, std::uint32_t aFirstIndex, std::uint32_t* aResult);
+
+		// One ray, its origin followed by its direction, against spheres as centers and radii or planes as normals
+		// and Hessian distances, all structure of arrays. Indexed by Batch::HitMode. Writes the position and the
+		// distance of the hits to aIndices and aDistances and returns how many there were, All needs room for aCount.
+		std::size_t (*RaySpheres[3])(const float* aRay, const float* aX, const float* aY, const float* aZ, const float* aRadii, std::size_t aCount, float aMaxDistance, std::uint32_t* aIndices, float* aDistances);
+		std::size_t (*RayPlanes[3])(const float* aRay, const float* aX, const float* aY, const float* aZ, const float* aOffsets, std::size_t aCount, float aMaxDistance, std::uint32_t* aIndices, float* aDistances);
+
+		// Planes as structure of arrays of normals and Hessian distances, normals pointing out. Objects are aStride
+		// floats apart, boxes with their max corner and spheres with their radius aOffset floats after the min
+		// corner or center. Writes the position of every object not entirely in front of a plane to aResult and
+		// returns how many there were. aResult must hold aCount entries.
+		std::size_t (*CullBoxes)(const float* aX, const float* aY, const float* aZ, const float* aDistances, std::size_t aPlaneCount, const float* aBoxes, std::size_t aStride, std::size_t aOffset, std::size_t aCount, std::uint32_t* aResult);
+		std::size_t (*CullSpheres)(const float* aX, const float* aY, const float* aZ, const float* aDistances, std::size_t aPlaneCount, const float* aSpheres, std::size_t aStride, std::size_t aOffset, std::size_t aCount, std::uint32_t* aResult);
+
+		// Flat float arrays to IEEE halves or snorm16 and back, aCount is the number of floats.
+		void (*FloatsToHalves)(const float* aFloats, std::uint16_t* aHalves, std::size_t aCount);
+		void (*HalvesToFloats)(const std::uint16_t* aHalves, float* aFloats, std::size_t aCount);
+		void (*FloatsToSnorm16)(const float* aFloats, std::int16_t* aSnorms, std::size_t aCount);
+		void (*Snorm16ToFloats)(const std::int16_t* aSnorms, float* aFloats, std::size_t aCount);
+		// Padded Vector3f normals to OctahedralNormal snorm16 pairs and back, aCount is the number of normals.
+		void (*NormalsToOctahedral)(const float* aNormals, std::int16_t* aOctahedral, std::size_t aCount);
+		void (*OctahedralToNormals)(const std::int16_t* aOctahedral, float* aNormals, std::size_t aCount);
+	};
+
+	// Each returns nullptr when the variant was not compiled for this target.
+	const BatchKernels* GetScalarKernels();
+	const BatchKernels* GetSSE2Kernels();
+	const BatchKernels* GetAVX2Kernels();
+	const BatchKernels* GetAVX512Kernels();
+
+	// Quaternion::GimbalLockThreshold, Quaternion.hpp is full of inline code so it is mirrored here.
+	constexpr float GimbalLockThreshold = 1e-7f;
+	// Math::RadToDegree(1.0f), mirrored for the same reason.
+	constexpr float RadiansToDegrees = 180.0f / std::numbers::pi_v<float>;
+
+	// Lanes provides Register, Width (a multiple of 4) and the Load/Store/arithmetic used below.
+	// Lanes::ReciprocalSqrt is the hardware estimate, or exact where there is none.
+	// Load and Store take the number of valid floats, anything past it is neither read nor written.
+	// LoadHalves/StoreHalves and LoadInt16/StoreInt16 do the same for 16 bit elements, StoreInt16
+	// rounds to nearest and saturates.
+	// Round, Less, Select, And and Xor are the FastMath requirements, see there.
+	// MaskBits packs the sign bit of every lane into an integer, lane 0 in bit 0.
+	// FixedRegister holds Width int32 lanes with LoadFixed/StoreFixed, AddFixed, SubFixed and MultiplyFixed,
+	// the latter keeping bits 16 to 47 of the signed 64 bit product.
+	template<typename Lanes>
+	struct BatchKernelsFor
+	{
+		using Register = typename Lanes::Register;
+		using FixedRegister = typename Lanes::FixedRegister;
+		using Polynomials = FastMath<Lanes>;
+
+		static std::size_t Remaining(std::size_t aIndex, std::size_t aCount)
+		{
+			return aCount - aIndex < Lanes::Width ? aCount - aIndex : Lanes::Width;
+		}
+
+		static void Dot(const float* aX0, const float* aY0, const float* aZ0, const float* aX1, const float* aY1, const float* aZ1, float* aResult, std::size_t aCount)
+		{
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				Register result = Lanes::Mul(Lanes::Load(aZ0 + index, count), Lanes::Load(aZ1 + index, count));
+				result = Lanes::MultiplyAdd(Lanes::Load(aY0 + index, count), Lanes::Load(aY1 + index, count), result);
+				result = Lanes::MultiplyAdd(Lanes::Load(aX0 + index, count), Lanes::Load(aX1 + index, count), result);
+				Lanes::Store(aResult + index, result, count);
+			}
+		}
+
+		static void DistanceSqr(const float* aX0, const float* aY0, const float* aZ0, const float* aX1, const float* aY1, const float* aZ1, float* aResult, std::size_t aCount)
+		{
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				Register x = Lanes::Sub(Lanes::Load(aX0 + index, count), Lanes::Load(aX1 + index, count));
+				Register y = Lanes::Sub(Lanes::Load(aY0 + index, count), Lanes::Load(aY1 + index, count));
+				Register z = Lanes::Sub(Lanes::Load(aZ0 + index, count), Lanes::Load(aZ1 + index, count));
+				Lanes::Store(aResult + index, Lanes::MultiplyAdd(x, x, Lanes::MultiplyAdd(y, y, Lanes::Mul(z, z))), count);
+			}
+		}
+
+		// The estimate refined by one Newton-Raphson step for Fast, see Precision for the error bounds.
+		template<Precision P>
+		static Register ReciprocalSqrt(Register aValue)
+		{
+			Register estimate = Lanes::ReciprocalSqrt(aValue);
+			if constexpr (P == Precision::Fast)
+			{
+				Register halfValue = Lanes::Mul(Lanes::Splat(0.5f), aValue);
+				estimate = Lanes::Mul(estimate, Lanes::Sub(Lanes::Splat(1.5f), Lanes::Mul(halfValue, Lanes::Mul(estimate, estimate))));
+			}
+			return estimate;
+		}
+
+		template<Precision P>
+		static void Length(const float* aX, const float* aY, const float* aZ, float* aResult, std::size_t aCount)
+		{
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				Register x = Lanes::Load(aX + index, count);
+				Register y = Lanes::Load(aY + index, count);
+				Register z = Lanes::Load(aZ + index, count);
+				Register lengthSqr = Lanes::MultiplyAdd(x, x, Lanes::MultiplyAdd(y, y, Lanes::Mul(z, z)));
+				if constexpr (P == Precision::Exact)
+				{
+					Lanes::Store(aResult + index, Lanes::Sqrt(lengthSqr), count);
+				}
+				else
+				{
+					// Clamping keeps zero lengths at 0 instead of 0 * inf.
+					Register clamped = Lanes::Max(lengthSqr, Lanes::Splat(std::numeric_limits<float>::min()));
+					Lanes::Store(aResult + index, Lanes::Mul(lengthSqr, ReciprocalSqrt<P>(clamped)), count);
+				}
+			}
+		}
+
+		template<Precision P>
+		static void Normalize(float* aX, float* aY, float* aZ, std::size_t aCount)
+		{
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				Register x = Lanes::Load(aX + index, count);
+				Register y = Lanes::Load(aY + index, count);
+				Register z = Lanes::Load(aZ + index, count);
+				Register lengthSqr = Lanes::MultiplyAdd(x, x, Lanes::MultiplyAdd(y, y, Lanes::Mul(z, z)));
+				if constexpr (P == Precision::Exact)
+				{
+					Register length = Lanes::Sqrt(lengthSqr);
+					Lanes::Store(aX + index, Lanes::Div(x, length), count);
+					Lanes::Store(aY + index, Lanes::Div(y, length), count);
+					Lanes::Store(aZ + index, Lanes::Div(z, length), count);
+				}
+				else
+				{
+					Register scale = ReciprocalSqrt<P>(lengthSqr);
+					Lanes::Store(aX + index, Lanes::Mul(x, scale), count);
+					Lanes::Store(aY + index, Lanes::Mul(y, scale), count);
+					Lanes::Store(aZ + index, Lanes::Mul(z, scale), count);
+				}
+			}
+		}
+
+		static void Cross(const float* aX0, const float* aY0, const float* aZ0, const float* aX1, const float* aY1, const float* aZ1, float* aResultX, float* aResultY, float* aResultZ, std::size_t aCount)
+		{
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				Register ax = Lanes::Load(aX0 + index, count);
+				Register ay = Lanes::Load(aY0 + index, count);
+				Register az = Lanes::Load(aZ0 + index, count);
+				Register bx = Lanes::Load(aX1 + index, count);
+				Register by = Lanes::Load(aY1 + index, count);
+				Register bz = Lanes::Load(aZ1 + index, count);
+				Lanes::Store(aResultX + index, Lanes::Sub(Lanes::Mul(ay, bz), Lanes::Mul(az, by)), count);
+				Lanes::Store(aResultY + index, Lanes::Sub(Lanes::Mul(az, bx), Lanes::Mul(ax, bz)), count);
+				Lanes::Store(aResultZ + index, Lanes::Sub(Lanes::Mul(ax, by), Lanes::Mul(ay, bx)), count);
+			}
+		}
+
+		static void Lerp(const float* aX0, const float* aY0, const float* aZ0, const float* aX1, const float* aY1, const float* aZ1, float aDelta, float* aResultX, float* aResultY, float* aResultZ, std::size_t aCount)
+		{
+			const Register delta = Lanes::Splat(aDelta);
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				Register x = Lanes::Load(aX0 + index, count);
+				Register y = Lanes::Load(aY0 + index, count);
+				Register z = Lanes::Load(aZ0 + index, count);
+				Lanes::Store(aResultX + index, Lanes::MultiplyAdd(delta, Lanes::Sub(Lanes::Load(aX1 + index, count), x), x), count);
+				Lanes::Store(aResultY + index, Lanes::MultiplyAdd(delta, Lanes::Sub(Lanes::Load(aY1 + index, count), y), y), count);
+				Lanes::Store(aResultZ + index, Lanes::MultiplyAdd(delta, Lanes::Sub(Lanes::Load(aZ1 + index, count), z), z), count);
+			}
+		}
+
+		static void ClampFloats(const float* aValues, float aMin, float aMax, float* aResult, std::size_t aCount)
+		{
+			const Register lower = Lanes::Splat(aMin);
+			const Register upper = Lanes::Splat(aMax);
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				Lanes::Store(aResult + index, Lanes::Min(Lanes::Max(Lanes::Load(aValues + index, count), lower), upper), count);
+			}
+		}
+
+		static void LerpFloats(const float* aFrom, const float* aTo, float aDelta, float* aResult, std::size_t aCount)
+		{
+			const Register delta = Lanes::Splat(aDelta);
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				Register from = Lanes::Load(aFrom + index, count);
+				Lanes::Store(aResult + index, Lanes::MultiplyAdd(delta, Lanes::Sub(Lanes::Load(aTo + index, count), from), from), count);
+			}
+		}
+
+		static void ScaleOffsetFloats(const float* aValues, float aScale, float aOffset, float* aResult, std::size_t aCount)
+		{
+			const Register scale = Lanes::Splat(aScale);
+			const Register offset = Lanes::Splat(aOffset);
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				Lanes::Store(aResult + index, Lanes::MultiplyAdd(Lanes::Load(aValues + index, count), scale, offset), count);
+			}
+		}
+
+		// Every group of four lanes holds one matrix row, the rows of aRight are replicated per group.
+		static void MultiplyMatrices(const float* aLeft, const float* aRight, float* aResult, std::size_t aCount)
+		{
+			const Register right0 = Lanes::Replicate4(aRight);
+			const Register right1 = Lanes::Replicate4(aRight + 4);
+			const Register right2 = Lanes::Replicate4(aRight + 8);
+			const Register right3 = Lanes::Replicate4(aRight + 12);
+
+			const std::size_t floatCount = aCount * 16;
+			for (std::size_t index = 0; index < floatCount; index += Lanes::Width)
+			{
+				Register rows = Lanes::Load(aLeft + index, Lanes::Width);
+				Register result = Lanes::Mul(Lanes::template Broadcast4<0>(rows), right0);
+				result = Lanes::MultiplyAdd(Lanes::template Broadcast4<1>(rows), right1, result);
+				result = Lanes::MultiplyAdd(Lanes::template Broadcast4<2>(rows), right2, result);
+				result = Lanes::MultiplyAdd(Lanes::template Broadcast4<3>(rows), right3, result);
+				Lanes::Store(aResult + index, result, Lanes::Width);
+			}
+		}
+
+		// Width divides 16, so every register holds rows of a single matrix and its right hand side is one matrix too.
+		// All rows of the right hand side are loaded before the first row of its result is stored, and every row of
+		// aLeft is read before its own result row is stored, so aResult may alias either input.
+		static void MultiplyMatricesPairwise(const float* aLeft, const float* aRight, float* aResult, std::size_t aCount)
+		{
+			for (std::size_t matrix = 0; matrix < aCount * 16; matrix += 16)
+			{
+				const Register right0 = Lanes::Replicate4(aRight + matrix);
+				const Register right1 = Lanes::Replicate4(aRight + matrix + 4);
+				const Register right2 = Lanes::Replicate4(aRight + matrix + 8);
+				const Register right3 = Lanes::Replicate4(aRight + matrix + 12);
+				for (std::size_t index = matrix; index < matrix + 16; index += Lanes::Width)
+				{
+					Register rows = Lanes::Load(aLeft + index, Lanes::Width);
+					Register result = Lanes::Mul(Lanes::template Broadcast4<0>(rows), right0);
+					result = Lanes::MultiplyAdd(Lanes::template Broadcast4<1>(rows), right1, result);
+					result = Lanes::MultiplyAdd(Lanes::template Broadcast4<2>(rows), right2, result);
+					result = Lanes::MultiplyAdd(Lanes::template Broadcast4<3>(rows), right3, result);
+					Lanes::Store(aResult + index, result, Lanes::Width);
+				}
+			}
+		}
+
+		template<TransformKind Kind>
+		static void TransformVectors(const float* aVectors, const float* aMatrix, float* aResult, std::size_t aCount)
+		{
+			const Register row0 = Lanes::Replicate4(aMatrix);
+			const Register row1 = Lanes::Replicate4(aMatrix + 4);
+			const Register row2 = Lanes::Replicate4(aMatrix + 8);
+			const Register row3 = Lanes::Replicate4(aMatrix + 12);
+
+			const std::size_t floatCount = aCount * 4;
+			for (std::size_t index = 0; index < floatCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, floatCount);
+				Register vectors = Lanes::Load(aVectors + index, count);
+				Register result = Lanes::Mul(Lanes::template Broadcast4<0>(vectors), row0);
+				result = Lanes::MultiplyAdd(Lanes::template Broadcast4<1>(vectors), row1, result);
+				result = Lanes::MultiplyAdd(Lanes::template Broadcast4<2>(vectors), row2, result);
+				if constexpr (Kind == TransformKind::Point)
+				{
+					result = Lanes::Add(result, row3);
+				}
+				else if constexpr (Kind == TransformKind::Homogeneous)
+				{
+					result = Lanes::MultiplyAdd(Lanes::template Broadcast4<3>(vectors), row3, result);
+				}
+				Lanes::Store(aResult + index, result, count);
+			}
+		}
+
+		template<TransformKind Kind>
+		static void TransformStream(const float* aX, const float* aY, const float* aZ, const float* aMatrix, float* aResultX, float* aResultY, float* aResultZ, std::size_t aCount)
+		{
+			static_assert(Kind != TransformKind::Homogeneous, "Streams have no w component");
+
+			Register matrix[12];
+			for (int element = 0; element < 12; element++)
+			{
+				matrix[element] = Lanes::Splat(aMatrix[element]);
+			}
+			const Register translationX = Lanes::Splat(Kind == TransformKind::Point ? aMatrix[12] : 0.0f);
+			const Register translationY = Lanes::Splat(Kind == TransformKind::Point ? aMatrix[13] : 0.0f);
+			const Register translationZ = Lanes::Splat(Kind == TransformKind::Point ? aMatrix[14] : 0.0f);
+
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				Register x = Lanes::Load(aX + index, count);
+				Register y = Lanes::Load(aY + index, count);
+				Register z = Lanes::Load(aZ + index, count);
+				Register resultX = Lanes::MultiplyAdd(z, matrix[8], Lanes::MultiplyAdd(y, matrix[4], Lanes::MultiplyAdd(x, matrix[0], translationX)));
+				Register resultY = Lanes::MultiplyAdd(z, matrix[9], Lanes::MultiplyAdd(y, matrix[5], Lanes::MultiplyAdd(x, matrix[1], translationY)));
+				Register resultZ = Lanes::MultiplyAdd(z, matrix[10], Lanes::MultiplyAdd(y, matrix[6], Lanes::MultiplyAdd(x, matrix[2], translationZ)));
+				Lanes::Store(aResultX + index, resultX, count);
+				Lanes::Store(aResultY + index, resultY, count);
+				Lanes::Store(aResultZ + index, resultZ, count);
+			}
+		}
+
+		template<Precision P>
+		static void NormalizeQuaternions(float* aQuaternions, std::size_t aCount)
+		{
+			const std::size_t floatCount = aCount * 4;
+			for (std::size_t index = 0; index < floatCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, floatCount);
+				Register quaternions = Lanes::Load(aQuaternions + index, count);
+				Register lengthSqr = Lanes::Sum4(Lanes::Mul(quaternions, quaternions));
+				if constexpr (P == Precision::Exact)
+				{
+					Lanes::Store(aQuaternions + index, Lanes::Div(quaternions, Lanes::Sqrt(lengthSqr)), count);
+				}
+				else
+				{
+					Lanes::Store(aQuaternions + index, Lanes::Mul(quaternions, ReciprocalSqrt<P>(lengthSqr)), count);
+				}
+			}
+		}
+
+		// v' = v + r * t + q x t with t = 2 * (q x v), which only holds for unit quaternions.
+		static void RotateStream(const float* aR, const float* aI, const float* aJ, const float* aK, const float* aX, const float* aY, const float* aZ, float* aResultX, float* aResultY, float* aResultZ, std::size_t aCount)
+		{
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				Register r = Lanes::Load(aR + index, count);
+				Register i = Lanes::Load(aI + index, count);
+				Register j = Lanes::Load(aJ + index, count);
+				Register k = Lanes::Load(aK + index, count);
+				Register x = Lanes::Load(aX + index, count);
+				Register y = Lanes::Load(aY + index, count);
+				Register z = Lanes::Load(aZ + index, count);
+
+				Register tx = Lanes::Sub(Lanes::Mul(j, z), Lanes::Mul(k, y));
+				Register ty = Lanes::Sub(Lanes::Mul(k, x), Lanes::Mul(i, z));
+				Register tz = Lanes::Sub(Lanes::Mul(i, y), Lanes::Mul(j, x));
+				tx = Lanes::Add(tx, tx);
+				ty = Lanes::Add(ty, ty);
+				tz = Lanes::Add(tz, tz);
+
+				Lanes::Store(aResultX + index, Lanes::Add(Lanes::MultiplyAdd(r, tx, x), Lanes::Sub(Lanes::Mul(j, tz), Lanes::Mul(k, ty))), count);
+				Lanes::Store(aResultY + index, Lanes::Add(Lanes::MultiplyAdd(r, ty, y), Lanes::Sub(Lanes::Mul(k, tx), Lanes::Mul(i, tz))), count);
+				Lanes::Store(aResultZ + index, Lanes::Add(Lanes::MultiplyAdd(r, tz, z), Lanes::Sub(Lanes::Mul(i, ty), Lanes::Mul(j, tx))), count);
+			}
+		}
+
+		// Closed form of Quaternion(y axis) * Quaternion(x axis) * Quaternion(z axis) from the half angle sines and cosines.
+		static void EulerToQuaternionStream(const float* aX, const float* aY, const float* aZ, float* aResultR, float* aResultI, float* aResultJ, float* aResultK, std::size_t aCount)
+		{
+			const Register halfRadians = Lanes::Splat(0.00872664626f);
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				Register sinX, cosX, sinY, cosY, sinZ, cosZ;
+				Polynomials::template SinCos<Precision::Fast>(Lanes::Mul(Lanes::Load(aX + index, count), halfRadians), sinX, cosX);
+				Polynomials::template SinCos<Precision::Fast>(Lanes::Mul(Lanes::Load(aY + index, count), halfRadians), sinY, cosY);
+				Polynomials::template SinCos<Precision::Fast>(Lanes::Mul(Lanes::Load(aZ + index, count), halfRadians), sinZ, cosZ);
+
+				const Register cosYcosX = Lanes::Mul(cosY, cosX);
+				const Register sinYsinX = Lanes::Mul(sinY, sinX);
+				const Register cosYsinX = Lanes::Mul(cosY, sinX);
+				const Register sinYcosX = Lanes::Mul(sinY, cosX);
+				Lanes::Store(aResultR + index, Lanes::MultiplyAdd(cosYcosX, cosZ, Lanes::Mul(sinYsinX, sinZ)), count);
+				Lanes::Store(aResultI + index, Lanes::MultiplyAdd(cosYsinX, cosZ, Lanes::Mul(sinYcosX, sinZ)), count);
+				Lanes::Store(aResultJ + index, Lanes::Sub(Lanes::Mul(sinYcosX, cosZ), Lanes::Mul(cosYsinX, sinZ)), count);
+				Lanes::Store(aResultK + index, Lanes::Sub(Lanes::Mul(cosYcosX, sinZ), Lanes::Mul(sinYsinX, cosZ)), count);
+			}
+		}
+
+		// Quaternion::GetEuler from the rotated forward axis and the y components of the rotated right and up axes,
+		// with the yaw from the rotated right axis and no roll where the forward axis points straight up or down.
+		static void QuaternionToEulerStream(const float* aR, const float* aI, const float* aJ, const float* aK, float* aResultX, float* aResultY, float* aResultZ, std::size_t aCount)
+		{
+			const Register two = Lanes::Splat(2.0f);
+			const Register degrees = Lanes::Splat(RadiansToDegrees);
+			const Register gimbalLockThreshold = Lanes::Splat(GimbalLockThreshold);
+			const Register zero = Lanes::Splat(0.0f);
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				Register r = Lanes::Load(aR + index, count);
+				Register i = Lanes::Load(aI + index, count);
+				Register j = Lanes::Load(aJ + index, count);
+				Register k = Lanes::Load(aK + index, count);
+
+				const Register rr = Lanes::Mul(r, r);
+				const Register ii = Lanes::Mul(i, i);
+				const Register jj = Lanes::Mul(j, j);
+				const Register kk = Lanes::Mul(k, k);
+				const Register forwardX = Lanes::Mul(two, Lanes::MultiplyAdd(i, k, Lanes::Mul(r, j)));
+				const Register negativeForwardY = Lanes::Mul(two, Lanes::Sub(Lanes::Mul(r, i), Lanes::Mul(j, k)));
+				const Register forwardZ = Lanes::Sub(Lanes::Add(rr, kk), Lanes::Add(ii, jj));
+				const Register rightX = Lanes::Sub(Lanes::Add(rr, ii), Lanes::Add(jj, kk));
+				const Register rightY = Lanes::Mul(two, Lanes::MultiplyAdd(i, j, Lanes::Mul(r, k)));
+				const Register negativeRightZ = Lanes::Mul(two, Lanes::Sub(Lanes::Mul(r, j), Lanes::Mul(i, k)));
+				const Register upY = Lanes::Sub(Lanes::Add(rr, jj), Lanes::Add(ii, kk));
+				const Register forwardXZSqr = Lanes::MultiplyAdd(forwardX, forwardX, Lanes::Mul(forwardZ, forwardZ));
+				const Register gimbalLock = Lanes::Less(forwardXZSqr, gimbalLockThreshold);
+
+				const Register yaw = Lanes::Select(gimbalLock,
+					Polynomials::template Atan2<Precision::Fast>(negativeRightZ, rightX),
+					Polynomials::template Atan2<Precision::Fast>(forwardX, forwardZ));
+				const Register roll = Lanes::Select(gimbalLock, zero, Polynomials::template Atan2<Precision::Fast>(rightY, upY));
+				Lanes::Store(aResultX + index, Lanes::Mul(Polynomials::template Atan2<Precision::Fast>(negativeForwardY, Lanes::Sqrt(forwardXZSqr)), degrees), count);
+				Lanes::Store(aResultY + index, Lanes::Mul(yaw, degrees), count);
+				Lanes::Store(aResultZ + index, Lanes::Mul(roll, degrees), count);
+			}
+		}
+
+		static void FloatsToHalves(const float* aFloats, std::uint16_t* aHalves, std::size_t aCount)
+		{
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				Lanes::StoreHalves(aHalves + index, Lanes::Load(aFloats + index, count), count);
+			}
+		}
+
+		static void HalvesToFloats(const std::uint16_t* aHalves, float* aFloats, std::size_t aCount)
+		{
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				Lanes::Store(aFloats + index, Lanes::LoadHalves(aHalves + index, count), count);
+			}
+		}
+
+		static void FloatsToSnorm16(const float* aFloats, std::int16_t* aSnorms, std::size_t aCount)
+		{
+			const Register lower = Lanes::Splat(-1.0f);
+			const Register upper = Lanes::Splat(1.0f);
+			const Register scale = Lanes::Splat(32767.0f);
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				Register clamped = Lanes::Min(Lanes::Max(Lanes::Load(aFloats + index, count), lower), upper);
+				Lanes::StoreInt16(aSnorms + index, Lanes::Mul(clamped, scale), count);
+			}
+		}
+
+		static void Snorm16ToFloats(const std::int16_t* aSnorms, float* aFloats, std::size_t aCount)
+		{
+			const Register lower = Lanes::Splat(-1.0f);
+			const Register scale = Lanes::Splat(1.0f / 32767.0f);
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				Lanes::Store(aFloats + index, Lanes::Max(Lanes::Mul(Lanes::LoadInt16(aSnorms + index, count), scale), lower), count);
+			}
+		}
+
+		// OctahedralNormal's constructor on the groups of four floats, lane x of the fold gets (1 - |v|) * sign(u)
+		// and lane y (1 - |u|) * sign(v). Only the first two snorms of every group are kept.
+		static void NormalsToOctahedral(const float* aNormals, std::int16_t* aOctahedral, std::size_t aCount)
+		{
+			constexpr std::size_t NormalsPerRegister = Lanes::Width / 4;
+			const float laneIndices[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+			const Register lanes = Lanes::Replicate4(laneIndices);
+			const Register isX = Lanes::Less(lanes, Lanes::Splat(0.5f));
+			const Register isXYZ = Lanes::Less(lanes, Lanes::Splat(2.5f));
+			const Register zero = Lanes::Splat(0.0f);
+			const Register one = Lanes::Splat(1.0f);
+			const Register signBit = Lanes::Splat(-0.0f);
+			const Register scale = Lanes::Splat(32767.0f);
+			for (std::size_t normal = 0; normal < aCount; normal += NormalsPerRegister)
+			{
+				const std::size_t count = aCount - normal < NormalsPerRegister ? aCount - normal : NormalsPerRegister;
+				// The padding lane is left out of the L1 norm.
+				const Register normals = Lanes::Select(isXYZ, Lanes::Load(aNormals + 4 * normal, 4 * count), zero);
+				Register octahedral = Lanes::Div(normals, Lanes::Sum4(Polynomials::Abs(normals)));
+				const Register swapped = Lanes::Select(isX, Lanes::template Broadcast4<1>(octahedral), Lanes::template Broadcast4<0>(octahedral));
+				const Register folded = Lanes::Mul(Lanes::Sub(one, Polynomials::Abs(swapped)), Lanes::Xor(one, Lanes::And(octahedral, signBit)));
+				octahedral = Lanes::Select(Lanes::Less(Lanes::template Broadcast4<2>(normals), zero), folded, octahedral);
+
+				std::int16_t snorms[Lanes::Width];
+				Lanes::StoreInt16(snorms, Lanes::Mul(octahedral, scale), 4 * count);
+				for (std::size_t index = 0; index < count; index++)
+				{
+					aOctahedral[2 * (normal + index)] = snorms[4 * index];
+					aOctahedral[2 * (normal + index) + 1] = snorms[4 * index + 1];
+				}
+			}
+		}
+
+		// OctahedralNormal::Unpack, every snorm pair is spread to its group of four floats first.
+		static void OctahedralToNormals(const std::int16_t* aOctahedral, float* aNormals, std::size_t aCount)
+		{
+			constexpr std::size_t NormalsPerRegister = Lanes::Width / 4;
+			const float laneIndices[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+			const Register lanes = Lanes::Replicate4(laneIndices);
+			const Register isX = Lanes::Less(lanes, Lanes::Splat(0.5f));
+			const Register isXY = Lanes::Less(lanes, Lanes::Splat(1.5f));
+			const Register isZ = Lanes::Xor(isXY, Lanes::Less(lanes, Lanes::Splat(2.5f)));
+			const Register zero = Lanes::Splat(0.0f);
+			const Register one = Lanes::Splat(1.0f);
+			const Register lower = Lanes::Splat(-1.0f);
+			const Register signBit = Lanes::Splat(-0.0f);
+			const Register scale = Lanes::Splat(1.0f / 32767.0f);
+			for (std::size_t normal = 0; normal < aCount; normal += NormalsPerRegister)
+			{
+				const std::size_t count = aCount - normal < NormalsPerRegister ? aCount - normal : NormalsPerRegister;
+				std::int16_t snorms[Lanes::Width] = {};
+				for (std::size_t index = 0; index < count; index++)
+				{
+					snorms[4 * index] = aOctahedral[2 * (normal + index)];
+					snorms[4 * index + 1] = aOctahedral[2 * (normal + index) + 1];
+				}
+				const Register octahedral = Lanes::Max(Lanes::Mul(Lanes::LoadInt16(snorms, Lanes::Width), scale), lower);
+				const Register x = Lanes::template Broadcast4<0>(octahedral);
+				const Register y = Lanes::template Broadcast4<1>(octahedral);
+				const Register z = Lanes::Sub(Lanes::Sub(one, Polynomials::Abs(x)), Polynomials::Abs(y));
+				const Register folded = Lanes::Mul(Lanes::Sub(one, Polynomials::Abs(Lanes::Select(isX, y, x))), Lanes::Xor(one, Lanes::And(octahedral, signBit)));
+				Register normals = Lanes::Select(Lanes::Less(z, zero), folded, octahedral);
+				normals = Lanes::Select(isXY, normals, Lanes::And(z, isZ));
+				Lanes::Store(aNormals + 4 * normal, Lanes::Div(normals, Lanes::Sqrt(Lanes::Sum4(Lanes::Mul(normals, normals)))), 4 * count);
+			}
+		}
+
+		static void FixedAdd(const std::int32_t* aValues0, const std::int32_t* aValues1, std::int32_t* aResult, std::size_t aCount)
+		{
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				Lanes::StoreFixed(aResult + index, Lanes::AddFixed(Lanes::LoadFixed(aValues0 + index, count), Lanes::LoadFixed(aValues1 + index, count)), count);
+			}
+		}
+
+		static void FixedMultiply(const std::int32_t* aValues0, const std::int32_t* aValues1, std::int32_t* aResult, std::size_t aCount)
+		{
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				Lanes::StoreFixed(aResult + index, Lanes::MultiplyFixed(Lanes::LoadFixed(aValues0 + index, count), Lanes::LoadFixed(aValues1 + index, count)), count);
+			}
+		}
+
+		static void FixedDot(const std::int32_t* aX0, const std::int32_t* aY0, const std::int32_t* aZ0, const std::int32_t* aX1, const std::int32_t* aY1, const std::int32_t* aZ1, std::int32_t* aResult, std::size_t aCount)
+		{
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				const FixedRegister x = Lanes::MultiplyFixed(Lanes::LoadFixed(aX0 + index, count), Lanes::LoadFixed(aX1 + index, count));
+				const FixedRegister y = Lanes::MultiplyFixed(Lanes::LoadFixed(aY0 + index, count), Lanes::LoadFixed(aY1 + index, count));
+				const FixedRegister z = Lanes::MultiplyFixed(Lanes::LoadFixed(aZ0 + index, count), Lanes::LoadFixed(aZ1 + index, count));
+				Lanes::StoreFixed(aResult + index, Lanes::AddFixed(Lanes::AddFixed(x, y), z), count);
+			}
+		}
+
+		static void FixedCross(const std::int32_t* aX0, const std::int32_t* aY0, const std::int32_t* aZ0, const std::int32_t* aX1, const std::int32_t* aY1, const std::int32_t* aZ1, std::int32_t* aResultX, std::int32_t* aResultY, std::int32_t* aResultZ, std::size_t aCount)
+		{
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				const FixedRegister x0 = Lanes::LoadFixed(aX0 + index, count);
+				const FixedRegister y0 = Lanes::LoadFixed(aY0 + index, count);
+				const FixedRegister z0 = Lanes::LoadFixed(aZ0 + index, count);
+				const FixedRegister x1 = Lanes::LoadFixed(aX1 + index, count);
+				const FixedRegister y1 = Lanes::LoadFixed(aY1 + index, count);
+				const FixedRegister z1 = Lanes::LoadFixed(aZ1 + index, count);
+				Lanes::StoreFixed(aResultX + index, Lanes::SubFixed(Lanes::MultiplyFixed(y0, z1), Lanes::MultiplyFixed(z0, y1)), count);
+				Lanes::StoreFixed(aResultY + index, Lanes::SubFixed(Lanes::MultiplyFixed(z0, x1), Lanes::MultiplyFixed(x0, z1)), count);
+				Lanes::StoreFixed(aResultZ + index, Lanes::SubFixed(Lanes::MultiplyFixed(x0, y1), Lanes::MultiplyFixed(y0, x1)), count);
+			}
+		}
+
+		// With the max sides negated a box overlaps the query when none of its four values is above the query's
+		// (max x, max y, -min x, -min y), so one compare per lane and a zero nibble per overlapping box.
+		static std::size_t OverlapBoxes2D(const float* aBox, const float* aBoxes, std::size_t aCount, std::uint32_t aFirstIndex, std::uint32_t* aResult)
+		{
+			constexpr std::size_t BoxesPerRegister = Lanes::Width / 4;
+			const float negateMax[4] = { 0.0f, 0.0f, -0.0f, -0.0f };
+			const float query[4] = { aBox[2], aBox[3], -aBox[0], -aBox[1] };
+			const Register signs = Lanes::Replicate4(negateMax);
+			const Register bounds = Lanes::Replicate4(query);
+
+			std::size_t resultCount = 0;
+			for (std::size_t box = 0; box < aCount; box += BoxesPerRegister)
+			{
+				const std::size_t count = aCount - box < BoxesPerRegister ? aCount - box : BoxesPerRegister;
+				const Register boxes = Lanes::Xor(Lanes::Load(aBoxes + 4 * box, 4 * count), signs);
+				const std::uint32_t separated = Lanes::MaskBits(Lanes::Less(bounds, boxes));
+				for (std::size_t lane = 0; lane < count; lane++)
+				{
+					// Branch free append, a separated box is written and then overwritten by the next one.
+					aResult[resultCount] = aFirstIndex + static_cast<std::uint32_t>(box + lane);
+					resultCount += ((separated >> (4 * lane)) & 0xF) == 0;
+				}
+			}
+			return resultCount;
+		}
+
+		// The hits of one register, a bit per lane in aHits. All appends every lane branch free, Any keeps the first hit
+		// and ends the search, Closest keeps the nearest so far and lowers aLimit to it.
+		template<Batch::HitMode Mode>
+		static bool CollectHits(Register aDistances, std::uint32_t aHits, std::size_t aIndex, std::size_t aCount, std::uint32_t* aIndices, float* aResultDistances, std::size_t& aResultCount, float& aLimit)
+		{
+			float distances[Lanes::Width];
+			if constexpr (Mode == Batch::HitMode::All)
+			{
+				Lanes::Store(distances, aDistances, aCount);
+				for (std::size_t lane = 0; lane < aCount; lane++)
+				{
+					aIndices[aResultCount] = static_cast<std::uint32_t>(aIndex + lane);
+					aResultDistances[aResultCount] = distances[lane];
+					aResultCount += (aHits >> lane) & 1;
+				}
+				return false;
+			}
+			else
+			{
+				if (aHits == 0)
+				{
+					return false;
+				}
+				Lanes::Store(distances, aDistances, aCount);
+				for (; aHits != 0; aHits &= aHits - 1)
+				{
+					const int lane = std::countr_zero(aHits);
+					if (distances[lane] < aLimit)
+					{
+						aIndices[0] = static_cast<std::uint32_t>(aIndex + lane);
+						aResultDistances[0] = distances[lane];
+						aResultCount = 1;
+						aLimit = distances[lane];
+						if constexpr (Mode == Batch::HitMode::Any)
+						{
+							return true;
+						}
+					}
+				}
+				return false;
+			}
+		}
+
+		static std::uint32_t LaneBits(std::size_t aCount)
+		{
+			return static_cast<std::uint32_t>((std::uint64_t(1) << aCount) - 1);
+		}
+
+		// Solves |origin + t * direction - center| = radius, a ray that starts inside hits at 0. Hits need
+		// entry <= aMaxDistance and exit >= 0, which leaves out NaN lanes.
+		template<Batch::HitMode Mode>
+		static std::size_t RaySpheres(const float* aRay, const float* aX, const float* aY, const float* aZ, const float* aRadii, std::size_t aCount, float aMaxDistance, std::uint32_t* aIndices, float* aDistances)
+		{
+			const Register originX = Lanes::Splat(aRay[0]);
+			const Register originY = Lanes::Splat(aRay[1]);
+			const Register originZ = Lanes::Splat(aRay[2]);
+			const Register directionX = Lanes::Splat(aRay[3]);
+			const Register directionY = Lanes::Splat(aRay[4]);
+			const Register directionZ = Lanes::Splat(aRay[5]);
+			const float lengthSqr = aRay[3] * aRay[3] + aRay[4] * aRay[4] + aRay[5] * aRay[5];
+			const Register a = Lanes::Splat(lengthSqr);
+			const Register inverseA = Lanes::Splat(1.0f / lengthSqr);
+			const Register zero = Lanes::Splat(0.0f);
+
+			float limit = std::nextafter(aMaxDistance, std::numeric_limits<float>::infinity());
+			std::size_t resultCount = 0;
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				const Register x = Lanes::Sub(originX, Lanes::Load(aX + index, count));
+				const Register y = Lanes::Sub(originY, Lanes::Load(aY + index, count));
+				const Register z = Lanes::Sub(originZ, Lanes::Load(aZ + index, count));
+				const Register radius = Lanes::Load(aRadii + index, count);
+				const Register b = Lanes::MultiplyAdd(x, directionX, Lanes::MultiplyAdd(y, directionY, Lanes::Mul(z, directionZ)));
+				const Register c = Lanes::Sub(Lanes::MultiplyAdd(x, x, Lanes::MultiplyAdd(y, y, Lanes::Mul(z, z))), Lanes::Mul(radius, radius));
+				const Register discriminant = Lanes::Sub(Lanes::Mul(b, b), Lanes::Mul(a, c));
+				const Register root = Lanes::Sqrt(Lanes::Max(discriminant, zero));
+				const Register entry = Lanes::Mul(Lanes::Sub(Lanes::Sub(zero, b), root), inverseA);
+				const Register exit = Lanes::Mul(Lanes::Sub(root, b), inverseA);
+
+				const std::uint32_t hits = Lanes::MaskBits(Lanes::Less(entry, Lanes::Splat(limit))) &
+					~Lanes::MaskBits(Lanes::Less(discriminant, zero)) & ~Lanes::MaskBits(Lanes::Less(exit, zero)) & LaneBits(count);
+				if (CollectHits<Mode>(Lanes::Max(entry, zero), hits, index, count, aIndices, aDistances, resultCount, limit))
+				{
+					break;
+				}
+			}
+			return resultCount;
+		}
+
+		// Planes are hit from either side. Parallel rays divide by 0 and give an infinity or NaN, which fail the
+		// compare against the limit.
+		template<Batch::HitMode Mode>
+		static std::size_t RayPlanes(const float* aRay, const float* aX, const float* aY, const float* aZ, const float* aOffsets, std::size_t aCount, float aMaxDistance, std::uint32_t* aIndices, float* aDistances)
+		{
+			const Register originX = Lanes::Splat(aRay[0]);
+			const Register originY = Lanes::Splat(aRay[1]);
+			const Register originZ = Lanes::Splat(aRay[2]);
+			const Register directionX = Lanes::Splat(aRay[3]);
+			const Register directionY = Lanes::Splat(aRay[4]);
+			const Register directionZ = Lanes::Splat(aRay[5]);
+			const Register zero = Lanes::Splat(0.0f);
+
+			float limit = std::nextafter(aMaxDistance, std::numeric_limits<float>::infinity());
+			std::size_t resultCount = 0;
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				const Register x = Lanes::Load(aX + index, count);
+				const Register y = Lanes::Load(aY + index, count);
+				const Register z = Lanes::Load(aZ + index, count);
+				const Register side = Lanes::MultiplyAdd(x, originX, Lanes::MultiplyAdd(y, originY, Lanes::MultiplyAdd(z, originZ, Lanes::Load(aOffsets + index, count))));
+				const Register speed = Lanes::MultiplyAdd(x, directionX, Lanes::MultiplyAdd(y, directionY, Lanes::Mul(z, directionZ)));
+				const Register distance = Lanes::Div(Lanes::Sub(zero, side), speed);
+
+				const std::uint32_t hits = Lanes::MaskBits(Lanes::Less(distance, Lanes::Splat(limit))) & ~Lanes::MaskBits(Lanes::Less(distance, zero)) & LaneBits(count);
+				if (CollectHits<Mode>(Lanes::Max(distance, zero), hits, index, count, aIndices, aDistances, resultCount, limit))
+				{
+					break;
+				}
+			}
+			return resultCount;
+		}
+
+		// The float at aOffset of aCount objects aStride floats apart, gathered into one register.
+		static Register GatherObjects(const float* aObjects, std::size_t aStride, std::size_t aOffset, std::size_t aCount)
+		{
+			float values[Lanes::Width];
+			for (std::size_t lane = 0; lane < aCount; lane++)
+			{
+				values[lane] = aObjects[aStride * lane + aOffset];
+			}
+			return Lanes::Load(values, aCount);
+		}
+
+		static std::size_t AppendVisible(std::uint32_t aOutside, std::size_t aIndex, std::size_t aCount, std::uint32_t* aResult, std::size_t aResultCount)
+		{
+			// Branch free append, a culled object is written and then overwritten by the next one.
+			for (std::size_t lane = 0; lane < aCount; lane++)
+			{
+				aResult[aResultCount] = static_cast<std::uint32_t>(aIndex + lane);
+				aResultCount += ((aOutside >> lane) & 1) == 0;
+			}
+			return aResultCount;
+		}
+
+		// A box is outside a plane when even its corner furthest against the normal, the negative vertex, is in
+		// front of it. The plane's signs pick that corner once for all the boxes in the register.
+		static std::size_t CullBoxes(const float* aX, const float* aY, const float* aZ, const float* aDistances, std::size_t aPlaneCount, const float* aBoxes, std::size_t aStride, std::size_t aOffset, std::size_t aCount, std::uint32_t* aResult)
+		{
+			const Register zero = Lanes::Splat(0.0f);
+			std::size_t resultCount = 0;
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				const float* boxes = aBoxes + aStride * index;
+				const Register minX = GatherObjects(boxes, aStride, 0, count);
+				const Register minY = GatherObjects(boxes, aStride, 1, count);
+				const Register minZ = GatherObjects(boxes, aStride, 2, count);
+				const Register maxX = GatherObjects(boxes, aStride, aOffset, count);
+				const Register maxY = GatherObjects(boxes, aStride, aOffset + 1, count);
+				const Register maxZ = GatherObjects(boxes, aStride, aOffset + 2, count);
+
+				const std::uint32_t allOutside = LaneBits(count);
+				std::uint32_t outside = 0;
+				for (std::size_t plane = 0; plane < aPlaneCount && outside != allOutside; plane++)
+				{
+					const Register x = aX[plane] < 0.0f ? maxX : minX;
+					const Register y = aY[plane] < 0.0f ? maxY : minY;
+					const Register z = aZ[plane] < 0.0f ? maxZ : minZ;
+					const Register distance = Lanes::MultiplyAdd(Lanes::Splat(aX[plane]), x, Lanes::MultiplyAdd(Lanes::Splat(aY[plane]), y,
+						Lanes::MultiplyAdd(Lanes::Splat(aZ[plane]), z, Lanes::Splat(aDistances[plane]))));
+					outside |= Lanes::MaskBits(Lanes::Less(zero, distance));
+				}
+				resultCount = AppendVisible(outside, index, count, aResult, resultCount);
+			}
+			return resultCount;
+		}
+
+		static std::size_t CullSpheres(const float* aX, const float* aY, const float* aZ, const float* aDistances, std::size_t aPlaneCount, const float* aSpheres, std::size_t aStride, std::size_t aOffset, std::size_t aCount, std::uint32_t* aResult)
+		{
+			std::size_t resultCount = 0;
+			for (std::size_t index = 0; index < aCount; index += Lanes::Width)
+			{
+				const std::size_t count = Remaining(index, aCount);
+				const float* spheres = aSpheres + aStride * index;
+				const Register x = GatherObjects(spheres, aStride, 0, count);
+				const Register y = GatherObjects(spheres, aStride, 1, count);
+				const Register z = GatherObjects(spheres, aStride, 2, count);
+				const Register radius = GatherObjects(spheres, aStride, aOffset, count);
+
+				const std::uint32_t allOutside = LaneBits(count);
+				std::uint32_t outside = 0;
+				for (std::size_t plane = 0; plane < aPlaneCount && outside != allOutside; plane++)
+				{
+					const Register distance = Lanes::MultiplyAdd(Lanes::Splat(aX[plane]), x, Lanes::MultiplyAdd(Lanes::Splat(aY[plane]), y,
+						Lanes::MultiplyAdd(Lanes::Splat(aZ[plane]), z, Lanes::Splat(aDistances[plane]))));
+					outside |= Lanes::MaskBits(Lanes::Less(radius, distance));
+				}
+				resultCount = AppendVisible(outside, index, count, aResult, resultCount);
+			}
+			return resultCount;
+		}
+
+		template<Precision P>
+		static void SetPrecision(BatchKernels& aKernels)
+		{
+			const int index = static_cast<int>(P);
+			aKernels.Length[index] = &Length<P>;
+			aKernels.Normalize[index] = &Normalize<P>;
+			aKernels.NormalizeQuaternions[index] = &NormalizeQuaternions<P>;
+		}
+
+		template<Batch::HitMode Mode>
+		static void SetHitMode(BatchKernels& aKernels)
+		{
+			const int index = static_cast<int>(Mode);
+			aKernels.RaySpheres[index] = &RaySpheres<Mode>;
+			aKernels.RayPlanes[index] = &RayPlanes<Mode>;
+		}
+
+		static BatchKernels Create()
+		{
+			BatchKernels kernels;
+			kernels.Dot = &Dot;
+			kernels.DistanceSqr = &DistanceSqr;
+			SetPrecision<Precision::Exact>(kernels);
+			SetPrecision<Precision::Fast>(kernels);
+			SetPrecision<Precision::Fastest>(kernels);
+			kernels.Cross = &Cross;
+			kernels.Lerp = &Lerp;
+			kernels.ClampFloats = &ClampFloats;
+			kernels.LerpFloats = &LerpFloats;
+			kernels.ScaleOffsetFloats = &ScaleOffsetFloats;
+			kernels.MultiplyMatrices = &MultiplyMatrices;
+			kernels.MultiplyMatricesPairwise = &MultiplyMatricesPairwise;
+			kernels.TransformVectors[static_cast<int>(TransformKind::Point)] = &TransformVectors<TransformKind::Point>;
+			kernels.TransformVectors[static_cast<int>(TransformKind::Direction)] = &TransformVectors<TransformKind::Direction>;
+			kernels.TransformVectors[static_cast<int>(TransformKind::Homogeneous)] = &TransformVectors<TransformKind::Homogeneous>;
+			kernels.TransformStream[static_cast<int>(TransformKind::Point)] = &TransformStream<TransformKind::Point>;
+			kernels.TransformStream[static_cast<int>(TransformKind::Direction)] = &TransformStream<TransformKind::Direction>;
+			kernels.RotateStream = &RotateStream;
+			kernels.EulerToQuaternionStream = &EulerToQuaternionStream;
+			kernels.QuaternionToEulerStream = &QuaternionToEulerStream;
+			kernels.FixedAdd = &FixedAdd;
+			kernels.FixedMultiply = &FixedMultiply;
+			kernels.FixedDot = &FixedDot;
+			kernels.FixedCross = &FixedCross;
+			kernels.OverlapBoxes2D = &OverlapBoxes2D;
+			SetHitMode<Batch::HitMode::All>(kernels);
+			SetHitMode<Batch::HitMode::Any>(kernels);
+			SetHitMode<Batch::HitMode::Closest>(kernels);
+			kernels.CullBoxes = &CullBoxes;
+			kernels.CullSpheres = &CullSpheres;
+			kernels.FloatsToHalves = &FloatsToHalves;
+			kernels.HalvesToFloats = &HalvesToFloats;
+			kernels.FloatsToSnorm16 = &FloatsToSnorm16;
+			kernels.Snorm16ToFloats = &Snorm16ToFloats;
+			kernels.NormalsToOctahedral = &NormalsToOctahedral;
+			kernels.OctahedralToNormals = &OctahedralToNormals;
+			return kernels;
+		}
+	};
+}
@@ -0,0 +1,205 @@
+#include "BatchKernels.hpp"
+
+#if !defined(STM_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <immintrin.h>
+
+#include "PackedVector.hpp"
+
+namespace stm
+{
+	namespace
+	{
+		struct SSE2Lanes
+		{
+			using Register = __m128;
+
+			static constexpr std::size_t Width = 4;
+
+			static Register Load(const float* aData, std::size_t aCount)
+			{
+				if (aCount == Width)
+				{
+					return _mm_loadu_ps(aData);
+				}
+
+				float buffer[Width] = {};
+				for (std::size_t index = 0; index < aCount; index++)
+				{
+					buffer[index] = aData[index];
+				}
+				return _mm_loadu_ps(buffer);
+			}
+
+			static void Store(float* aData, Register aValue, std::size_t aCount)
+			{
+				if (aCount == Width)
+				{
+					_mm_storeu_ps(aData, aValue);
+					return;
+				}
+
+				float buffer[Width];
+				_mm_storeu_ps(buffer, aValue);
+				for (std::size_t index = 0; index < aCount; index++)
+				{
+					aData[index] = buffer[index];
+				}
+			}
+
+			// SSE2 has no half conversion instructions, F16C comes with the AVX2 variant.
+			static Register LoadHalves(const std::uint16_t* aData, std::size_t aCount)
+			{
+				float buffer[Width] = {};
+				for (std::size_t index = 0; index < aCount; index++)
+				{
+					buffer[index] = Packing::HalfToFloat(aData[index]);
+				}
+				return _mm_loadu_ps(buffer);
+			}
+
+			static void StoreHalves(std::uint16_t* aData, Register aValue, std::size_t aCount)
+			{
+				float buffer[Width];
+				_mm_storeu_ps(buffer, aValue);
+				for (std::size_t index = 0; index < aCount; index++)
+				{
+					aData[index] = Packing::FloatToHalf(buffer[index]);
+				}
+			}
+
+			static Register LoadInt16(const std::int16_t* aData, std::size_t aCount)
+			{
+				__m128i values;
+				if (aCount == Width)
+				{
+					values = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(aData));
+				}
+				else
+				{
+					std::int16_t buffer[Width] = {};
+					for (std::size_t index = 0; index < aCount; index++)
+					{
+						buffer[index] = aData[index];
+					}
+					values = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(buffer));
+				}
+				return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(values, values), 16));
+			}
+
+			static void StoreInt16(std::int16_t* aData, Register aValue, std::size_t aCount)
+			{
+				const __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(aValue), _mm_setzero_si128());
+				if (aCount == Width)
+				{
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(aData), packed);
+					return;
+				}
+
+				std::int16_t buffer[2 * Width];
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(buffer), packed);
+				for (std::size_t index = 0; index < aCount; index++)
+				{
+					aData[index] = buffer[index];
+				}
+			}
+
+			using FixedRegister = __m128i;
+
+			static FixedRegister LoadFixed(const std::int32_t* aData, std::size_t aCount)
+			{
+				if (aCount == Width)
+				{
+					return _mm_loadu_si128(reinterpret_cast<const __m128i*>(aData));
+				}
+
+				std::int32_t buffer[Width] = {};
+				for (std::size_t index = 0; index < aCount; index++)
+				{
+					buffer[index] = aData[index];
+				}
+				return _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer));
+			}
+
+			static void StoreFixed(std::int32_t* aData, FixedRegister aValue, std::size_t aCount)
+			{
+				if (aCount == Width)
+				{
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(aData), aValue);
+					return;
+				}
+
+				std::int32_t buffer[Width];
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(buffer), aValue);
+				for (std::size_t index = 0; index < aCount; index++)
+				{
+					aData[index] = buffer[index];
+				}
+			}
+
+			static FixedRegister AddFixed(FixedRegister aA, FixedRegister aB) { return _mm_add_epi32(aA, aB); }
+			static FixedRegister SubFixed(FixedRegister aA, FixedRegister aB) { return _mm_sub_epi32(aA, aB); }
+
+			// SSE2 only multiplies unsigned, the signed product is the unsigned one minus 2^32 times b for a negative a
+			// and a for a negative b, which is taken off after the shift.
+			static FixedRegister MultiplyFixed(FixedRegister aA, FixedRegister aB)
+			{
+				const __m128i even = _mm_srli_epi64(_mm_mul_epu32(aA, aB), 16);
+				const __m128i odd = _mm_slli_epi64(_mm_mul_epu32(_mm_srli_epi64(aA, 32), _mm_srli_epi64(aB, 32)), 16);
+				const __m128i oddMask = _mm_setr_epi32(0, -1, 0, -1);
+				const __m128i product = _mm_or_si128(_mm_andnot_si128(oddMask, even), _mm_and_si128(oddMask, odd));
+				const __m128i correction = _mm_add_epi32(_mm_and_si128(_mm_srai_epi32(aA, 31), aB), _mm_and_si128(_mm_srai_epi32(aB, 31), aA));
+				return _mm_sub_epi32(product, _mm_slli_epi32(correction, 16));
+			}
+
+			static Register Splat(float aValue) { return _mm_set1_ps(aValue); }
+			static Register Add(Register aA, Register aB) { return _mm_add_ps(aA, aB); }
+			static Register Sub(Register aA, Register aB) { return _mm_sub_ps(aA, aB); }
+			static Register Mul(Register aA, Register aB) { return _mm_mul_ps(aA, aB); }
+			static Register Div(Register aA, Register aB) { return _mm_div_ps(aA, aB); }
+			static Register Sqrt(Register aA) { return _mm_sqrt_ps(aA); }
+			static Register ReciprocalSqrt(Register aA) { return _mm_rsqrt_ps(aA); }
+			static Register Min(Register aA, Register aB) { return _mm_min_ps(aA, aB); }
+			static Register Max(Register aA, Register aB) { return _mm_max_ps(aA, aB); }
+			static Register MultiplyAdd(Register aA, Register aB, Register aC) { return _mm_add_ps(_mm_mul_ps(aA, aB), aC); }
+			// Through int32, the kernels only round values well inside its range.
+			static Register Round(Register aA) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(aA)); }
+			static Register Less(Register aA, Register aB) { return _mm_cmplt_ps(aA, aB); }
+			static Register Select(Register aMask, Register aA, Register aB) { return _mm_or_ps(_mm_and_ps(aMask, aA), _mm_andnot_ps(aMask, aB)); }
+			static Register And(Register aA, Register aB) { return _mm_and_ps(aA, aB); }
+			static Register Xor(Register aA, Register aB) { return _mm_xor_ps(aA, aB); }
+			static std::uint32_t MaskBits(Register aMask) { return static_cast<std::uint32_t>(_mm_movemask_ps(aMask)); }
+
+			static Register Sum4(Register aA)
+			{
+				Register sums = _mm_add_ps(aA, _mm_shuffle_ps(aA, aA, _MM_SHUFFLE(2, 3, 0, 1)));
+				return _mm_add_ps(sums, _mm_shuffle_ps(sums, sums, _MM_SHUFFLE(1, 0, 3, 2)));
+			}
+
+			template<int Lane>
+			static Register Broadcast4(Register aA)
+			{
+				return _mm_shuffle_ps(aA, aA, _MM_SHUFFLE(Lane, Lane, Lane, Lane));
+			}
+
+			static Register Replicate4(const float* aData)
+			{
+				return _mm_loadu_ps(aData);
+			}
+		};
+	}
+
+	const BatchKernels* GetSSE2Kernels()
+	{
+		static const BatchKernels kernels = BatchKernelsFor<SSE2Lanes>::Create();
+		return &kernels;
+	}
+}
+#else
+namespace stm
+{
+	const BatchKernels* GetSSE2Kernels()
+	{
+		return nullptr;
+	}
+}
+#endif
@@ -0,0 +1,264 @@
+#include "BatchKernels.hpp"
+#include "PackedVector.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace stm
+{
+	namespace
+	{
+		struct ScalarLanes
+		{
+			struct Register
+			{
+				float v[4];
+			};
+
+			static constexpr std::size_t Width = 4;
+
+			static Register Load(const float* aData, std::size_t aCount)
+			{
+				Register result = {};
+				for (std::size_t index = 0; index < aCount; index++)
+				{
+					result.v[index] = aData[index];
+				}
+				return result;
+			}
+
+			static void Store(float* aData, const Register& aValue, std::size_t aCount)
+			{
+				for (std::size_t index = 0; index < aCount; index++)
+				{
+					aData[index] = aValue.v[index];
+				}
+			}
+
+			static Register LoadHalves(const std::uint16_t* aData, std::size_t aCount)
+			{
+				Register result = {};
+				for (std::size_t index = 0; index < aCount; index++)
+				{
+					result.v[index] = Packing::HalfToFloat(aData[index]);
+				}
+				return result;
+			}
+
+			static void StoreHalves(std::uint16_t* aData, const Register& aValue, std::size_t aCount)
+			{
+				for (std::size_t index = 0; index < aCount; index++)
+				{
+					aData[index] = Packing::FloatToHalf(aValue.v[index]);
+				}
+			}
+
+			static Register LoadInt16(const std::int16_t* aData, std::size_t aCount)
+			{
+				Register result = {};
+				for (std::size_t index = 0; index < aCount; index++)
+				{
+					result.v[index] = static_cast<float>(aData[index]);
+				}
+				return result;
+			}
+
+			static void StoreInt16(std::int16_t* aData, const Register& aValue, std::size_t aCount)
+			{
+				for (std::size_t index = 0; index < aCount; index++)
+				{
+					aData[index] = static_cast<std::int16_t>(std::clamp(std::nearbyint(aValue.v[index]), -32768.0f, 32767.0f));
+				}
+			}
+
+			// Fixed32 raw values, products keep bits 16 to 47 of the 64 bit product like Fixed32::operator*.
+			struct FixedRegister
+			{
+				std::int32_t v[4];
+			};
+
+			static FixedRegister LoadFixed(const std::int32_t* aData, std::size_t aCount)
+			{
+				FixedRegister result = {};
+				for (std::size_t index = 0; index < aCount; index++)
+				{
+					result.v[index] = aData[index];
+				}
+				return result;
+			}
+
+			static void StoreFixed(std::int32_t* aData, const FixedRegister& aValue, std::size_t aCount)
+			{
+				for (std::size_t index = 0; index < aCount; index++)
+				{
+					aData[index] = aValue.v[index];
+				}
+			}
+
+			static FixedRegister AddFixed(const FixedRegister& aA, const FixedRegister& aB)
+			{
+				FixedRegister result;
+				for (int lane = 0; lane < 4; lane++)
+				{
+					result.v[lane] = static_cast<std::int32_t>(static_cast<std::uint32_t>(aA.v[lane]) + static_cast<std::uint32_t>(aB.v[lane]));
+				}
+				return result;
+			}
+
+			static FixedRegister SubFixed(const FixedRegister& aA, const FixedRegister& aB)
+			{
+				FixedRegister result;
+				for (int lane = 0; lane < 4; lane++)
+				{
+					result.v[lane] = static_cast<std::int32_t>(static_cast<std::uint32_t>(aA.v[lane]) - static_cast<std::uint32_t>(aB.v[lane]));
+				}
+				return result;
+			}
+
+			static FixedRegister MultiplyFixed(const FixedRegister& aA, const FixedRegister& aB)
+			{
+				FixedRegister result;
+				for (int lane = 0; lane < 4; lane++)
+				{
+					result.v[lane] = static_cast<std::int32_t>((static_cast<std::int64_t>(aA.v[lane]) * aB.v[lane]) >> 16);
+				}
+				return result;
+			}
+
+			static Register Splat(float aValue)
+			{
+				return { aValue, aValue, aValue, aValue };
+			}
+
+			static Register Add(const Register& aA, const Register& aB)
+			{
+				return { aA.v[0] + aB.v[0], aA.v[1] + aB.v[1], aA.v[2] + aB.v[2], aA.v[3] + aB.v[3] };
+			}
+
+			static Register Sub(const Register& aA, const Register& aB)
+			{
+				return { aA.v[0] - aB.v[0], aA.v[1] - aB.v[1], aA.v[2] - aB.v[2], aA.v[3] - aB.v[3] };
+			}
+
+			static Register Mul(const Register& aA, const Register& aB)
+			{
+				return { aA.v[0] * aB.v[0], aA.v[1] * aB.v[1], aA.v[2] * aB.v[2], aA.v[3] * aB.v[3] };
+			}
+
+			static Register Div(const Register& aA, const Register& aB)
+			{
+				return { aA.v[0] / aB.v[0], aA.v[1] / aB.v[1], aA.v[2] / aB.v[2], aA.v[3] / aB.v[3] };
+			}
+
+			static Register Sqrt(const Register& aA)
+			{
+				return { std::sqrt(aA.v[0]), std::sqrt(aA.v[1]), std::sqrt(aA.v[2]), std::sqrt(aA.v[3]) };
+			}
+
+			static Register ReciprocalSqrt(const Register& aA)
+			{
+				return Div(Splat(1.0f), Sqrt(aA));
+			}
+
+			// Min and Max return aB when either is NaN, like minps and maxps.
+			static Register Min(const Register& aA, const Register& aB)
+			{
+				return { std::min(aB.v[0], aA.v[0]), std::min(aB.v[1], aA.v[1]), std::min(aB.v[2], aA.v[2]), std::min(aB.v[3], aA.v[3]) };
+			}
+
+			static Register Max(const Register& aA, const Register& aB)
+			{
+				return { std::max(aB.v[0], aA.v[0]), std::max(aB.v[1], aA.v[1]), std::max(aB.v[2], aA.v[2]), std::max(aB.v[3], aA.v[3]) };
+			}
+
+			static Register MultiplyAdd(const Register& aA, const Register& aB, const Register& aC)
+			{
+				return Add(Mul(aA, aB), aC);
+			}
+
+			static Register Round(const Register& aA)
+			{
+				return { std::nearbyint(aA.v[0]), std::nearbyint(aA.v[1]), std::nearbyint(aA.v[2]), std::nearbyint(aA.v[3]) };
+			}
+
+			// Masks are all bits set or clear per lane, like cmpltps.
+			static Register Less(const Register& aA, const Register& aB)
+			{
+				Register result;
+				for (int lane = 0; lane < 4; lane++)
+				{
+					result.v[lane] = std::bit_cast<float>(aA.v[lane] < aB.v[lane] ? ~std::uint32_t(0) : std::uint32_t(0));
+				}
+				return result;
+			}
+
+			static Register Select(const Register& aMask, const Register& aA, const Register& aB)
+			{
+				return Or(And(aMask, aA), AndNot(aMask, aB));
+			}
+
+			static Register And(const Register& aA, const Register& aB)
+			{
+				return Bitwise(aA, aB, [](std::uint32_t aX, std::uint32_t aY) { return aX & aY; });
+			}
+
+			static Register AndNot(const Register& aA, const Register& aB)
+			{
+				return Bitwise(aA, aB, [](std::uint32_t aX, std::uint32_t aY) { return ~aX & aY; });
+			}
+
+			static Register Or(const Register& aA, const Register& aB)
+			{
+				return Bitwise(aA, aB, [](std::uint32_t aX, std::uint32_t aY) { return aX | aY; });
+			}
+
+			static Register Xor(const Register& aA, const Register& aB)
+			{
+				return Bitwise(aA, aB, [](std::uint32_t aX, std::uint32_t aY) { return aX ^ aY; });
+			}
+
+			static std::uint32_t MaskBits(const Register& aMask)
+			{
+				std::uint32_t bits = 0;
+				for (int lane = 0; lane < 4; lane++)
+				{
+					bits |= (std::bit_cast<std::uint32_t>(aMask.v[lane]) >> 31) << lane;
+				}
+				return bits;
+			}
+
+			template<typename Function>
+			static Register Bitwise(const Register& aA, const Register& aB, const Function& aFunction)
+			{
+				Register result;
+				for (int lane = 0; lane < 4; lane++)
+				{
+					result.v[lane] = std::bit_cast<float>(aFunction(std::bit_cast<std::uint32_t>(aA.v[lane]), std::bit_cast<std::uint32_t>(aB.v[lane])));
+				}
+				return result;
+			}
+
+			static Register Sum4(const Register& aA)
+			{
+				return Splat(aA.v[0] + aA.v[1] + aA.v[2] + aA.v[3]);
+			}
+
+			template<int Lane>
+			static Register Broadcast4(const Register& aA)
+			{
+				return Splat(aA.v[Lane]);
+			}
+
+			static Register Replicate4(const float* aData)
+			{
+				return Load(aData, 4);
+			}
+		};
+	}
+
+	const BatchKernels* GetScalarKernels()
+	{
+		static const BatchKernels kernels = BatchKernelsFor<ScalarLanes>::Create();
+		return &kernels;
+	}
+}
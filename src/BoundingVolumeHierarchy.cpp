@@ -0,0 +1,662 @@
+#include "BoundingVolumeHierarchy.hpp"
+#include "Parallel.hpp"
+#include "Simd.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <functional>
+#include <thread>
+
+namespace stm
+{
+	namespace
+	{
+		constexpr std::uint32_t BinCount = 16;
+		// Leaves at or below this size are not split when the heuristic says splitting does not pay.
+		constexpr std::uint32_t MaximumLeafSize = 8;
+		// Keeps every traversal within its fixed size stack, pushing both children each level.
+		constexpr std::uint32_t MaximumDepth = 64;
+		// A node costs about as much to test as a primitive box.
+		constexpr float TraversalCost = 1.0f;
+		// Below this many boxes a subtree is cheaper to build than to hand to a thread.
+		constexpr std::uint32_t MinimumParallelCount = 16384;
+		constexpr std::size_t MinimumParallelBoxes = 65536;
+		constexpr std::size_t ParallelAlignment = 16;
+
+		// The fourth lane only pads the arrays out to a register and is never read back.
+		struct Bounds
+		{
+			alignas(16) float min[4] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), 0.0f };
+			alignas(16) float max[4] = { -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), 0.0f };
+
+			// Reads four floats from both, so they can point into a Node.
+			void Grow(const float* aMin, const float* aMax)
+			{
+#ifdef STM_SIMD_SSE
+				// _mm_min_ps and _mm_max_ps return their second operand when either is NaN, so a NaN coordinate is
+				// skipped like std::min and std::max skip it below instead of spreading to every enclosing node.
+				_mm_store_ps(min, _mm_min_ps(_mm_loadu_ps(aMin), _mm_load_ps(min)));
+				_mm_store_ps(max, _mm_max_ps(_mm_loadu_ps(aMax), _mm_load_ps(max)));
+#else
+				for (int axis = 0; axis < 3; axis++)
+				{
+					min[axis] = std::min(min[axis], aMin[axis]);
+					max[axis] = std::max(max[axis], aMax[axis]);
+				}
+#endif
+			}
+
+			void Grow(const Bounds& aBounds)
+			{
+				Grow(aBounds.min, aBounds.max);
+			}
+
+			// Half the surface area, the heuristic only compares ratios.
+			float HalfArea() const
+			{
+				const float x = max[0] - min[0];
+				const float y = max[1] - min[1];
+				const float z = max[2] - min[2];
+				return x < 0.0f ? 0.0f : x * y + y * z + z * x;
+			}
+		};
+
+		struct Bin
+		{
+			Bounds bounds;
+			std::uint32_t count = 0;
+		};
+
+		// Slab test against the inverse direction. Axes whose product is NaN, a ray inside a slab's plane, are
+		// skipped by the comparisons, which counts them as hit.
+		struct RaySlabs
+		{
+			float origin[3];
+			float inverseDirection[3];
+
+			explicit RaySlabs(const Ray<float>& aRay)
+			{
+				const Vector3f& position = aRay.GetPosition();
+				const Vector3f& inverse = aRay.GetInverseDirection();
+				origin[0] = position.x;
+				origin[1] = position.y;
+				origin[2] = position.z;
+				inverseDirection[0] = inverse.x;
+				inverseDirection[1] = inverse.y;
+				inverseDirection[2] = inverse.z;
+			}
+
+			bool Intersect(const float* aMin, const float* aMax, float aNear, float aFar, float& aEntry) const
+			{
+				for (int axis = 0; axis < 3; axis++)
+				{
+					float entry = (aMin[axis] - origin[axis]) * inverseDirection[axis];
+					float exit = (aMax[axis] - origin[axis]) * inverseDirection[axis];
+					if (exit < entry)
+					{
+						std::swap(entry, exit);
+					}
+					aNear = entry > aNear ? entry : aNear;
+					aFar = exit < aFar ? exit : aFar;
+				}
+				aEntry = aNear;
+				return aNear <= aFar;
+			}
+		};
+
+		const float* MinOf(const AABB3D<float>& aBox)
+		{
+			return &aBox.Min().x;
+		}
+
+		const float* MaxOf(const AABB3D<float>& aBox)
+		{
+			return &aBox.Max().x;
+		}
+
+		AABB3D<float> BoxOf(const float* aMin, const float* aMax)
+		{
+			return AABB3D<float>(Vector3f(aMin[0], aMin[1], aMin[2]), Vector3f(aMax[0], aMax[1], aMax[2]));
+		}
+	}
+
+	class BoundingVolumeHierarchy::Builder
+	{
+	public:
+		// aRecords receives the boxes in leaf order, as nodes whose index is the box's index in aBoxes.
+		Builder(std::span<const AABB3D<float>> aBoxes, std::vector<Node>& aNodes, std::vector<Node>& aRecords, Batch::Execution aExecution) :
+			m_Nodes(aNodes),
+			m_Records(aRecords),
+			m_NodeCount(1),
+			m_ParallelDepth(0)
+		{
+			if (aExecution == Batch::Execution::Parallel)
+			{
+				// A couple of levels past one subtree per thread evens out unbalanced splits.
+				for (unsigned int threads = std::max(1u, std::thread::hardware_concurrency()); threads > 1; threads >>= 1)
+				{
+					m_ParallelDepth++;
+				}
+				m_ParallelDepth += m_ParallelDepth > 0 ? 2 : 0;
+			}
+
+			// Partitioning compact copies keeps every pass over a node sequential in memory, where indices
+			// into the boxes would scatter after the first few splits.
+			m_Records.resize(aBoxes.size());
+			auto prepare = [&aBoxes, this](std::size_t aBegin, std::size_t aEnd)
+			{
+				for (std::size_t index = aBegin; index < aEnd; index++)
+				{
+					Node& record = m_Records[index];
+					std::copy(MinOf(aBoxes[index]), MinOf(aBoxes[index]) + 3, record.min);
+					std::copy(MaxOf(aBoxes[index]), MaxOf(aBoxes[index]) + 3, record.max);
+					record.index = static_cast<std::uint32_t>(index);
+					record.count = 1;
+				}
+			};
+			if (aExecution == Batch::Execution::Parallel)
+			{
+				ParallelFor(aBoxes.size(), MinimumParallelBoxes, ParallelAlignment, prepare);
+			}
+			else
+			{
+				prepare(0, aBoxes.size());
+			}
+		}
+
+		std::uint32_t Build()
+		{
+			Bounds bounds;
+			Bounds centroidBounds;
+			GrowBounds(m_Records.data(), static_cast<std::uint32_t>(m_Records.size()), bounds, centroidBounds);
+			BuildNode(0, 0, static_cast<std::uint32_t>(m_Records.size()), 0, bounds, centroidBounds);
+			return m_NodeCount.load();
+		}
+
+	private:
+		// Centroids are kept doubled, min plus max, which bins the same.
+		static void GrowCentroid(const Node& aRecord, Bounds& aCentroidBounds)
+		{
+			const float centroid[4] = { aRecord.min[0] + aRecord.max[0], aRecord.min[1] + aRecord.max[1], aRecord.min[2] + aRecord.max[2], 0.0f };
+			aCentroidBounds.Grow(centroid, centroid);
+		}
+
+		static void GrowBounds(const Node* aRecords, std::uint32_t aCount, Bounds& aBounds, Bounds& aCentroidBounds)
+		{
+			for (std::uint32_t index = 0; index < aCount; index++)
+			{
+				aBounds.Grow(aRecords[index].min, aRecords[index].max);
+				GrowCentroid(aRecords[index], aCentroidBounds);
+			}
+		}
+
+		// The bounds come from the parent's split, so a node only reads its boxes to bin and partition them.
+		void BuildNode(std::uint32_t aNode, std::uint32_t aFirst, std::uint32_t aCount, std::uint32_t aDepth, const Bounds& aBounds, const Bounds& aCentroidBounds)
+		{
+			Node* const records = m_Records.data() + aFirst;
+
+			Node& node = m_Nodes[aNode];
+			std::copy(aBounds.min, aBounds.min + 3, node.min);
+			std::copy(aBounds.max, aBounds.max + 3, node.max);
+			node.index = aFirst;
+			node.count = aCount;
+			if (aCount <= 2 || aDepth + 1 >= MaximumDepth)
+			{
+				return;
+			}
+
+			// Every box binned along all three axes in one pass over the range. Small nodes get a bin per box,
+			// more would only add empty bins to sweep.
+			const std::uint32_t binCount = std::min(BinCount, aCount);
+			Bin bins[3][BinCount];
+			alignas(16) float scale[4] = {};
+			for (int axis = 0; axis < 3; axis++)
+			{
+				const float extent = aCentroidBounds.max[axis] - aCentroidBounds.min[axis];
+				scale[axis] = extent > 0.0f ? binCount / extent : 0.0f;
+			}
+			const float lastBin = static_cast<float>(binCount - 1);
+			// The partition below must put every box on the side its bin was counted on, so both use this
+			// order of operations, clamping before the conversion like the vector path. Non-finite centroids
+			// make NaN, which the compare sends to the last bin like _mm_min_ps does.
+			auto binOf = [&](const Node& aRecord, int aAxis)
+			{
+				const float bin = (aRecord.min[aAxis] + aRecord.max[aAxis] - aCentroidBounds.min[aAxis]) * scale[aAxis];
+				return static_cast<std::uint32_t>(bin < lastBin ? bin : lastBin);
+			};
+#ifdef STM_SIMD_SSE
+			const __m128 centroidMin = _mm_load_ps(aCentroidBounds.min);
+			const __m128 scales = _mm_load_ps(scale);
+			const __m128 lastBins = _mm_set1_ps(lastBin);
+#endif
+			for (std::uint32_t index = 0; index < aCount; index++)
+			{
+				const Node& record = records[index];
+				alignas(16) std::uint32_t binIndices[4];
+#ifdef STM_SIMD_SSE
+				const __m128 centroid = _mm_add_ps(_mm_loadu_ps(record.min), _mm_loadu_ps(record.max));
+				const __m128 bin = _mm_min_ps(_mm_mul_ps(_mm_sub_ps(centroid, centroidMin), scales), lastBins);
+				_mm_store_si128(reinterpret_cast<__m128i*>(binIndices), _mm_cvttps_epi32(bin));
+				// Anything the conversion cannot represent comes out as INT_MIN, kept in range here.
+				for (int axis = 0; axis < 3; axis++)
+				{
+					binIndices[axis] = std::min(binIndices[axis], binCount - 1);
+				}
+#else
+				for (int axis = 0; axis < 3; axis++)
+				{
+					binIndices[axis] = binOf(record, axis);
+				}
+#endif
+				for (int axis = 0; axis < 3; axis++)
+				{
+					Bin& bin = bins[axis][binIndices[axis]];
+					bin.bounds.Grow(record.min, record.max);
+					bin.count++;
+				}
+			}
+
+			// Sweeps from both ends give the cost of every split plane, split n keeps bins 0 to n on the left.
+			float bestCost = std::numeric_limits<float>::max();
+			int bestAxis = -1;
+			std::uint32_t bestSplit = 0;
+			Bounds bestLeft;
+			Bounds bestRight;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				if (scale[axis] == 0.0f)
+				{
+					continue;
+				}
+
+				Bounds rightBounds[BinCount];
+				std::uint32_t rightCounts[BinCount];
+				Bounds right;
+				std::uint32_t rightCount = 0;
+				for (std::uint32_t bin = binCount - 1; bin > 0; bin--)
+				{
+					right.Grow(bins[axis][bin].bounds);
+					rightCount += bins[axis][bin].count;
+					rightBounds[bin - 1] = right;
+					rightCounts[bin - 1] = rightCount;
+				}
+				Bounds left;
+				std::uint32_t leftCount = 0;
+				for (std::uint32_t bin = 0; bin + 1 < binCount; bin++)
+				{
+					left.Grow(bins[axis][bin].bounds);
+					leftCount += bins[axis][bin].count;
+					if (leftCount == 0 || rightCounts[bin] == 0)
+					{
+						continue;
+					}
+					const float cost = left.HalfArea() * leftCount + rightBounds[bin].HalfArea() * rightCounts[bin];
+					if (cost < bestCost)
+					{
+						bestCost = cost;
+						bestAxis = axis;
+						bestSplit = bin;
+						bestLeft = left;
+						bestRight = rightBounds[bin];
+					}
+				}
+			}
+
+			std::uint32_t leftCount;
+			Bounds leftCentroids;
+			Bounds rightCentroids;
+			if (bestAxis >= 0)
+			{
+				const float area = aBounds.HalfArea();
+				if (aCount <= MaximumLeafSize && TraversalCost * area + bestCost >= area * aCount)
+				{
+					return;
+				}
+
+				// Partitions and gathers the children's centroid bounds on the way.
+				Node* left = records;
+				Node* right = records + aCount;
+				while (left < right)
+				{
+					if (binOf(*left, bestAxis) <= bestSplit)
+					{
+						GrowCentroid(*left, leftCentroids);
+						left++;
+					}
+					else
+					{
+						right--;
+						std::swap(*left, *right);
+						GrowCentroid(*right, rightCentroids);
+					}
+				}
+				leftCount = static_cast<std::uint32_t>(left - records);
+			}
+			else if (aCount > MaximumLeafSize)
+			{
+				// Every centroid in one spot, any split is as good as another.
+				leftCount = aCount / 2;
+				GrowBounds(records, leftCount, bestLeft, leftCentroids);
+				GrowBounds(records + leftCount, aCount - leftCount, bestRight, rightCentroids);
+			}
+			else
+			{
+				return;
+			}
+
+			const std::uint32_t children = m_NodeCount.fetch_add(2);
+			node.index = children;
+			node.count = 0;
+
+			if (aDepth < m_ParallelDepth && aCount >= MinimumParallelCount)
+			{
+				std::jthread leftThread(&Builder::BuildNode, this, children, aFirst, leftCount, aDepth + 1, std::cref(bestLeft), std::cref(leftCentroids));
+				BuildNode(children + 1, aFirst + leftCount, aCount - leftCount, aDepth + 1, bestRight, rightCentroids);
+			}
+			else
+			{
+				BuildNode(children, aFirst, leftCount, aDepth + 1, bestLeft, leftCentroids);
+				BuildNode(children + 1, aFirst + leftCount, aCount - leftCount, aDepth + 1, bestRight, rightCentroids);
+			}
+		}
+
+		std::vector<Node>& m_Nodes;
+		std::vector<Node>& m_Records;
+		std::atomic<std::uint32_t> m_NodeCount;
+		std::uint32_t m_ParallelDepth;
+	};
+
+	void BoundingVolumeHierarchy::Build(std::span<const AABB3D<float>> aBoxes, std::span<const std::uint32_t> aPayloads, Batch::Execution aExecution)
+	{
+		assert((aPayloads.empty() || aPayloads.size() == aBoxes.size()) && "One payload per box");
+		assert(aBoxes.size() < UINT32_MAX / 2 && "Too many boxes for 32 bit node indices");
+
+		Clear();
+		if (aBoxes.empty())
+		{
+			return;
+		}
+
+		// A binary tree with at least one box per leaf never has more than 2n - 1 nodes.
+		std::vector<Node> records;
+		m_Nodes.resize(2 * aBoxes.size() - 1);
+		Builder builder(aBoxes, m_Nodes, records, aExecution);
+		m_Nodes.resize(builder.Build());
+
+		m_Boxes.resize(aBoxes.size());
+		m_Payloads.resize(aBoxes.size());
+		auto reorder = [&](std::size_t aBegin, std::size_t aEnd)
+		{
+			for (std::size_t index = aBegin; index < aEnd; index++)
+			{
+				const std::uint32_t box = records[index].index;
+				m_Boxes[index] = aBoxes[box];
+				m_Payloads[index] = aPayloads.empty() ? box : aPayloads[box];
+			}
+		};
+		if (aExecution == Batch::Execution::Parallel)
+		{
+			ParallelFor(aBoxes.size(), MinimumParallelBoxes, ParallelAlignment, reorder);
+		}
+		else
+		{
+			reorder(0, aBoxes.size());
+		}
+	}
+
+	void BoundingVolumeHierarchy::Clear()
+	{
+		m_Nodes.clear();
+		m_Boxes.clear();
+		m_Payloads.clear();
+	}
+
+	std::size_t BoundingVolumeHierarchy::Size() const
+	{
+		return m_Boxes.size();
+	}
+
+	std::size_t BoundingVolumeHierarchy::GetNodeCount() const
+	{
+		return m_Nodes.size();
+	}
+
+	AABB3D<float> BoundingVolumeHierarchy::GetBounds() const
+	{
+		assert(!m_Nodes.empty() && "Hierarchy is empty");
+
+		const Node& root = m_Nodes[0];
+		return AABB3D<float>(Vector3f(root.min[0], root.min[1], root.min[2]), Vector3f(root.max[0], root.max[1], root.max[2]));
+	}
+
+	template<typename Test>
+	void BoundingVolumeHierarchy::Query(const Test& aTest, std::vector<std::uint32_t>& aResult) const
+	{
+		aResult.clear();
+		if (m_Nodes.empty())
+		{
+			return;
+		}
+
+		std::uint32_t stack[MaximumDepth + 1];
+		std::uint32_t stackSize = 0;
+		stack[stackSize++] = 0;
+		while (stackSize > 0)
+		{
+			const Node& node = m_Nodes[stack[--stackSize]];
+			if (!aTest(node.min, node.max))
+			{
+				continue;
+			}
+			if (node.count == 0)
+			{
+				stack[stackSize++] = node.index + 1;
+				stack[stackSize++] = node.index;
+				continue;
+			}
+			for (std::uint32_t index = node.index; index < node.index + node.count; index++)
+			{
+				if (aTest(MinOf(m_Boxes[index]), MaxOf(m_Boxes[index])))
+				{
+					aResult.push_back(m_Payloads[index]);
+				}
+			}
+		}
+	}
+
+	void BoundingVolumeHierarchy::QueryPoint(const Vector3f& aPoint, std::vector<std::uint32_t>& aResult) const
+	{
+		const float point[3] = { aPoint.x, aPoint.y, aPoint.z };
+		Query([&point](const float* aMin, const float* aMax)
+		{
+			return
+				(point[0] >= aMin[0]) & (point[0] <= aMax[0]) &
+				(point[1] >= aMin[1]) & (point[1] <= aMax[1]) &
+				(point[2] >= aMin[2]) & (point[2] <= aMax[2]);
+		}, aResult);
+	}
+
+	void BoundingVolumeHierarchy::QueryOverlap(const AABB3D<float>& aBox, std::vector<std::uint32_t>& aResult) const
+	{
+		const float* min = MinOf(aBox);
+		const float* max = MaxOf(aBox);
+		Query([min, max](const float* aMin, const float* aMax)
+		{
+			return
+				(aMin[0] <= max[0]) & (aMax[0] >= min[0]) &
+				(aMin[1] <= max[1]) & (aMax[1] >= min[1]) &
+				(aMin[2] <= max[2]) & (aMax[2] >= min[2]);
+		}, aResult);
+	}
+
+	void BoundingVolumeHierarchy::QueryOverlap(const Sphere<float>& aSphere, std::vector<std::uint32_t>& aResult) const
+	{
+		const float center[3] = { aSphere.Position().x, aSphere.Position().y, aSphere.Position().z };
+		const float radiusSqr = aSphere.Radius() * aSphere.Radius();
+		Query([&center, radiusSqr](const float* aMin, const float* aMax)
+		{
+			// Squared distance from the center to the closest point of the box.
+			float distanceSqr = 0.0f;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				const float delta = center[axis] - std::clamp(center[axis], aMin[axis], aMax[axis]);
+				distanceSqr += delta * delta;
+			}
+			return distanceSqr <= radiusSqr;
+		}, aResult);
+	}
+
+	void BoundingVolumeHierarchy::QueryRay(const Ray<float>& aRay, std::vector<std::uint32_t>& aResult, float aMinDistance, float aMaxDistance) const
+	{
+		const RaySlabs slabs(aRay);
+		Query([&slabs, aMinDistance, aMaxDistance](const float* aMin, const float* aMax)
+		{
+			float entry;
+			return slabs.Intersect(aMin, aMax, aMinDistance, aMaxDistance, entry);
+		}, aResult);
+	}
+
+	bool BoundingVolumeHierarchy::Raycast(const Ray<float>& aRay, std::uint32_t& aPayload, float& aDistance, float aMaxDistance) const
+	{
+		if (m_Nodes.empty())
+		{
+			return false;
+		}
+
+		// Nearer child first, and anything entered past the closest hit so far is skipped.
+		const RaySlabs slabs(aRay);
+		float closest = aMaxDistance;
+		bool hit = false;
+		std::uint32_t stack[MaximumDepth + 1];
+		std::uint32_t stackSize = 0;
+		float entry;
+		if (slabs.Intersect(m_Nodes[0].min, m_Nodes[0].max, 0.0f, closest, entry))
+		{
+			stack[stackSize++] = 0;
+		}
+		while (stackSize > 0)
+		{
+			const Node& node = m_Nodes[stack[--stackSize]];
+			if (node.count == 0)
+			{
+				float leftEntry;
+				float rightEntry;
+				const bool left = slabs.Intersect(m_Nodes[node.index].min, m_Nodes[node.index].max, 0.0f, closest, leftEntry);
+				const bool right = slabs.Intersect(m_Nodes[node.index + 1].min, m_Nodes[node.index + 1].max, 0.0f, closest, rightEntry);
+				if (left && right)
+				{
+					const bool leftFirst = leftEntry <= rightEntry;
+					stack[stackSize++] = leftFirst ? node.index + 1 : node.index;
+					stack[stackSize++] = leftFirst ? node.index : node.index + 1;
+				}
+				else if (left || right)
+				{
+					stack[stackSize++] = left ? node.index : node.index + 1;
+				}
+				continue;
+			}
+			for (std::uint32_t index = node.index; index < node.index + node.count; index++)
+			{
+				if (slabs.Intersect(MinOf(m_Boxes[index]), MaxOf(m_Boxes[index]), 0.0f, closest, entry) && (!hit || entry < closest))
+				{
+					closest = entry;
+					aPayload = m_Payloads[index];
+					hit = true;
+				}
+			}
+		}
+		if (hit)
+		{
+			aDistance = closest;
+		}
+		return hit;
+	}
+
+	std::uint32_t BoundingVolumeHierarchy::Raycast(const RayPacket4& aPacket, std::span<std::uint32_t, 4> aPayloads, std::span<float, 4> aDistances, float aMaxDistance) const
+	{
+		return RaycastPacket(aPacket, aPayloads, aDistances, aMaxDistance);
+	}
+
+	std::uint32_t BoundingVolumeHierarchy::Raycast(const RayPacket8& aPacket, std::span<std::uint32_t, 8> aPayloads, std::span<float, 8> aDistances, float aMaxDistance) const
+	{
+		return RaycastPacket(aPacket, aPayloads, aDistances, aMaxDistance);
+	}
+
+	template<std::size_t N>
+	std::uint32_t BoundingVolumeHierarchy::RaycastPacket(const RayPacket<N>& aPacket, std::span<std::uint32_t, N> aPayloads, std::span<float, N> aDistances, float aMaxDistance) const
+	{
+		if (m_Nodes.empty())
+		{
+			return 0;
+		}
+
+		// A node is entered when any lane still reaches it. Each lane keeps its own closest hit, so the result
+		// matches N separate Raycasts apart from which of two boxes entered at the same distance is reported.
+		float closest[N];
+		float entries[N];
+		for (std::size_t lane = 0; lane < N; lane++)
+		{
+			closest[lane] = aMaxDistance;
+		}
+		std::uint32_t hits = 0;
+		std::uint32_t stack[MaximumDepth + 1];
+		std::uint32_t stackSize = 0;
+		if (aPacket.Intersect(BoxOf(m_Nodes[0].min, m_Nodes[0].max), closest, entries) != 0)
+		{
+			stack[stackSize++] = 0;
+		}
+		while (stackSize > 0)
+		{
+			const Node& node = m_Nodes[stack[--stackSize]];
+			if (node.count == 0)
+			{
+				// Without a per lane order, the child nearer to the first lane that still reaches this node goes first.
+				const Node& left = m_Nodes[node.index];
+				const Node& right = m_Nodes[node.index + 1];
+				float leftEntries[N];
+				float rightEntries[N];
+				const std::uint32_t leftMask = aPacket.Intersect(BoxOf(left.min, left.max), closest, leftEntries);
+				const std::uint32_t rightMask = aPacket.Intersect(BoxOf(right.min, right.max), closest, rightEntries);
+				const std::uint32_t both = leftMask & rightMask;
+				const bool leftFirst = both == 0 || leftEntries[std::countr_zero(both)] <= rightEntries[std::countr_zero(both)];
+				const std::uint32_t first = leftFirst ? node.index : node.index + 1;
+				const std::uint32_t second = leftFirst ? node.index + 1 : node.index;
+				const std::uint32_t firstMask = leftFirst ? leftMask : rightMask;
+				const std::uint32_t secondMask = leftFirst ? rightMask : leftMask;
+				if (secondMask != 0)
+				{
+					stack[stackSize++] = second;
+				}
+				if (firstMask != 0)
+				{
+					stack[stackSize++] = first;
+				}
+				continue;
+			}
+			for (std::uint32_t index = node.index; index < node.index + node.count; index++)
+			{
+				std::uint32_t mask = aPacket.Intersect(m_Boxes[index], closest, entries);
+				while (mask != 0)
+				{
+					const int lane = std::countr_zero(mask);
+					mask &= mask - 1;
+					if ((hits & (1u << lane)) == 0 || entries[lane] < closest[lane])
+					{
+						closest[lane] = entries[lane];
+						aPayloads[lane] = m_Payloads[index];
+						hits |= 1u << lane;
+					}
+				}
+			}
+		}
+		for (std::size_t lane = 0; lane < N; lane++)
+		{
+			if ((hits & (1u << lane)) != 0)
+			{
+				aDistances[lane] = closest[lane];
+			}
+		}
+		return hits;
+	}
+}
@@ -0,0 +1,156 @@
+#include "Broadphase2D.hpp"
+#include "Batch.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace stm
+{
+	namespace
+	{
+		// Past this many cells per box the grid is mostly empty cells, so the cell size doubles until it fits.
+		constexpr std::size_t MaximumCellsPerBox = 4;
+		constexpr std::size_t MinimumCellLimit = 1024;
+
+		struct Grid
+		{
+			Vector2<float> origin;
+			float inverseCellSize;
+			std::uint32_t width;
+			std::uint32_t height;
+
+			std::uint32_t CellX(float aX) const
+			{
+				const float cell = (aX - origin.x) * inverseCellSize;
+				return cell < static_cast<float>(width - 1) ? static_cast<std::uint32_t>(cell) : width - 1;
+			}
+
+			std::uint32_t CellY(float aY) const
+			{
+				const float cell = (aY - origin.y) * inverseCellSize;
+				return cell < static_cast<float>(height - 1) ? static_cast<std::uint32_t>(cell) : height - 1;
+			}
+		};
+
+		Grid CreateGrid(const AABB2D<float>& aBounds, float aCellSize, std::size_t aBoxCount)
+		{
+			const std::size_t cellLimit = std::max(MinimumCellLimit, aBoxCount * MaximumCellsPerBox);
+			const double extentX = static_cast<double>(aBounds.Max().x) - aBounds.Min().x;
+			const double extentY = static_cast<double>(aBounds.Max().y) - aBounds.Min().y;
+
+			double cellSize = aCellSize;
+			double width = std::floor(extentX / cellSize) + 1.0;
+			double height = std::floor(extentY / cellSize) + 1.0;
+			while (width * height > static_cast<double>(cellLimit))
+			{
+				cellSize *= 2.0;
+				width = std::floor(extentX / cellSize) + 1.0;
+				height = std::floor(extentY / cellSize) + 1.0;
+			}
+			return { aBounds.Min(), static_cast<float>(1.0 / cellSize), static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height) };
+		}
+	}
+
+	Broadphase2D::Broadphase2D(float aCellSize)
+	{
+		SetCellSize(aCellSize);
+	}
+
+	void Broadphase2D::SetCellSize(float aCellSize)
+	{
+		assert(aCellSize > 0.0f && "Cell size must be positive");
+
+		m_CellSize = aCellSize;
+	}
+
+	float Broadphase2D::GetCellSize() const
+	{
+		return m_CellSize;
+	}
+
+	void Broadphase2D::FindPairs(std::span<const AABB2D<float>> aBoxes, std::vector<Pair>& aPairs)
+	{
+		aPairs.clear();
+		if (aBoxes.size() < 2)
+		{
+			return;
+		}
+		assert(aBoxes.size() <= UINT32_MAX && "Too many boxes for 32 bit indices");
+
+		AABB2D<float> bounds = aBoxes[0];
+		for (const AABB2D<float>& box : aBoxes)
+		{
+			bounds.Merge(box);
+		}
+		const Grid grid = CreateGrid(bounds, m_CellSize, aBoxes.size());
+		const std::size_t cellCount = static_cast<std::size_t>(grid.width) * grid.height;
+
+		auto forEachCell = [&grid](const AABB2D<float>& aBox, const auto& aFunction)
+		{
+			const std::uint32_t endX = grid.CellX(aBox.Max().x);
+			const std::uint32_t endY = grid.CellY(aBox.Max().y);
+			for (std::uint32_t y = grid.CellY(aBox.Min().y); y <= endY; y++)
+			{
+				for (std::uint32_t x = grid.CellX(aBox.Min().x); x <= endX; x++)
+				{
+					aFunction(static_cast<std::size_t>(y) * grid.width + x);
+				}
+			}
+		};
+
+		// Counting sort of the boxes into cells. After the fill every start has moved to the next cell's start,
+		// shifting them back by one restores them.
+		m_CellStart.assign(cellCount + 1, 0);
+		for (const AABB2D<float>& box : aBoxes)
+		{
+			forEachCell(box, [this](std::size_t aCell) { m_CellStart[aCell + 1]++; });
+		}
+		for (std::size_t cell = 0; cell < cellCount; cell++)
+		{
+			m_CellStart[cell + 1] += m_CellStart[cell];
+		}
+		m_CellBoxes.resize(m_CellStart[cellCount]);
+		for (std::size_t index = 0; index < aBoxes.size(); index++)
+		{
+			forEachCell(aBoxes[index], [this, index](std::size_t aCell) { m_CellBoxes[m_CellStart[aCell]++] = static_cast<std::uint32_t>(index); });
+		}
+		std::copy_backward(m_CellStart.begin(), m_CellStart.end() - 1, m_CellStart.end());
+		m_CellStart[0] = 0;
+
+		for (std::size_t cell = 0; cell < cellCount; cell++)
+		{
+			const std::uint32_t begin = m_CellStart[cell];
+			const std::uint32_t count = m_CellStart[cell + 1] - begin;
+			if (count < 2)
+			{
+				continue;
+			}
+
+			m_Gathered.resize(count);
+			m_Overlaps.resize(count);
+			for (std::uint32_t slot = 0; slot < count; slot++)
+			{
+				m_Gathered[slot] = aBoxes[m_CellBoxes[begin + slot]];
+			}
+
+			const std::span<const AABB2D<float>> gathered(m_Gathered);
+			for (std::uint32_t slot = 0; slot + 1 < count; slot++)
+			{
+				const AABB2D<float>& box = gathered[slot];
+				const std::size_t found = Batch::Overlaps(box, gathered.subspan(slot + 1), m_Overlaps);
+				for (std::size_t result = 0; result < found; result++)
+				{
+					const std::uint32_t other = slot + 1 + m_Overlaps[result];
+					const AABB2D<float>& otherBox = gathered[other];
+					const float cornerX = std::max(box.Min().x, otherBox.Min().x);
+					const float cornerY = std::max(box.Min().y, otherBox.Min().y);
+					if (static_cast<std::size_t>(grid.CellY(cornerY)) * grid.width + grid.CellX(cornerX) == cell)
+					{
+						// Cells list their boxes in index order, so the first of the pair is the smaller index.
+						aPairs.emplace_back(m_CellBoxes[begin + slot], m_CellBoxes[begin + other]);
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,111 @@
+#include "CpuFeatures.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define STM_CPUID_MSVC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#define STM_CPUID_GCC 1
+#endif
+
+namespace stm
+{
+	namespace
+	{
+		void Cpuid(unsigned int aLeaf, unsigned int aSubLeaf, unsigned int aRegisters[4])
+		{
+			aRegisters[0] = aRegisters[1] = aRegisters[2] = aRegisters[3] = 0;
+#if defined(STM_CPUID_MSVC)
+			int registers[4];
+			__cpuidex(registers, static_cast<int>(aLeaf), static_cast<int>(aSubLeaf));
+			for (int index = 0; index < 4; index++)
+			{
+				aRegisters[index] = static_cast<unsigned int>(registers[index]);
+			}
+#elif defined(STM_CPUID_GCC)
+			__cpuid_count(aLeaf, aSubLeaf, aRegisters[0], aRegisters[1], aRegisters[2], aRegisters[3]);
+#else
+			(void)aLeaf;
+			(void)aSubLeaf;
+#endif
+		}
+
+		// Register state the operating system saves on context switches (XCR0).
+		unsigned long long GetEnabledStateMask()
+		{
+#if defined(STM_CPUID_MSVC)
+			return _xgetbv(0);
+#elif defined(STM_CPUID_GCC)
+			unsigned int low = 0;
+			unsigned int high = 0;
+			__asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+			return (static_cast<unsigned long long>(high) << 32) | low;
+#else
+			return 0;
+#endif
+		}
+
+		bool HasBit(unsigned int aRegister, int aBit)
+		{
+			return (aRegister >> aBit) & 1u;
+		}
+
+		CpuFeatures Detect()
+		{
+			CpuFeatures features;
+
+			unsigned int registers[4];
+			Cpuid(0, 0, registers);
+			const unsigned int maxLeaf = registers[0];
+			if (maxLeaf < 1)
+			{
+				return features;
+			}
+
+			Cpuid(1, 0, registers);
+			features.hasSSE2 = HasBit(registers[3], 26);
+			features.hasSSE41 = HasBit(registers[2], 19);
+
+			const bool hasOSXSave = HasBit(registers[2], 27);
+			const unsigned long long stateMask = hasOSXSave ? GetEnabledStateMask() : 0;
+			const bool hasYmmState = (stateMask & 0x6) == 0x6;
+			const bool hasZmmState = hasYmmState && (stateMask & 0xE0) == 0xE0;
+
+			features.hasAVX = hasYmmState && HasBit(registers[2], 28);
+			features.hasFMA = features.hasAVX && HasBit(registers[2], 12);
+			features.hasF16C = features.hasAVX && HasBit(registers[2], 29);
+
+			if (maxLeaf >= 7)
+			{
+				Cpuid(7, 0, registers);
+				features.hasAVX2 = features.hasAVX && HasBit(registers[1], 5);
+				features.hasAVX512F = hasZmmState && HasBit(registers[1], 16);
+				features.hasAVX512DQ = features.hasAVX512F && HasBit(registers[1], 17);
+				features.hasAVX512VL = features.hasAVX512F && HasBit(registers[1], 31);
+			}
+
+			return features;
+		}
+	}
+
+	const CpuFeatures& CpuFeatures::Get()
+	{
+		static const CpuFeatures features = Detect();
+		return features;
+	}
+
+	const char* CpuFeatures::GetName(InstructionSet aInstructionSet)
+	{
+		switch (aInstructionSet)
+		{
+		case InstructionSet::SSE2:
+			return "SSE2";
+		case InstructionSet::AVX2:
+			return "AVX2";
+		case InstructionSet::AVX512:
+			return "AVX-512";
+		default:
+			return "Scalar";
+		}
+	}
+}
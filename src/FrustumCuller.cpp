@@ -0,0 +1,56 @@
+#include "FrustumCuller.hpp"
+#include <cassert>
+
+namespace stm
+{
+	FrustumCuller::FrustumCuller(const PlaneVolume<float>& aVolume)
+		: m_Planes(aVolume)
+	{
+	}
+
+	FrustumCuller::FrustumCuller(const PlaneSet<float>& aPlanes)
+		: m_Planes(aPlanes)
+	{
+	}
+
+	void FrustumCuller::SetVolume(const PlaneVolume<float>& aVolume)
+	{
+		m_Planes.Assign(aVolume);
+	}
+
+	void FrustumCuller::SetVolume(const PlaneSet<float>& aPlanes)
+	{
+		m_Planes = aPlanes;
+	}
+
+	std::size_t FrustumCuller::GetPlaneCount() const
+	{
+		return m_Planes.Size();
+	}
+
+	PlaneSet<float>& FrustumCuller::GetPlanes()
+	{
+		return m_Planes;
+	}
+
+	const PlaneSet<float>& FrustumCuller::GetPlanes() const
+	{
+		return m_Planes;
+	}
+
+	void FrustumCuller::Cull(std::span<const AABB3D<float>> aBoxes, std::vector<std::uint32_t>& aVisible, Batch::Execution aExecution) const
+	{
+		assert(aBoxes.size() <= UINT32_MAX && "Too many boxes for 32 bit indices");
+
+		aVisible.resize(aBoxes.size());
+		aVisible.resize(Batch::Cull(m_Planes.GetNormals(), m_Planes.GetDistances(), aBoxes, aVisible, aExecution));
+	}
+
+	void FrustumCuller::Cull(std::span<const Sphere<float>> aSpheres, std::vector<std::uint32_t>& aVisible, Batch::Execution aExecution) const
+	{
+		assert(aSpheres.size() <= UINT32_MAX && "Too many spheres for 32 bit indices");
+
+		aVisible.resize(aSpheres.size());
+		aVisible.resize(Batch::Cull(m_Planes.GetNormals(), m_Planes.GetDistances(), aSpheres, aVisible, aExecution));
+	}
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace stm
+{
+	// Splits [0, aCount) into one contiguous range per hardware thread and calls aFunction(begin, end) for each,
+	// the calling thread takes the first range. Ranges start on multiples of aAlignment elements so no two
+	// threads write the same cache line, and fewer threads are used when a range would drop below aMinimumCount.
+	template<typename Function>
+	void ParallelFor(std::size_t aCount, std::size_t aMinimumCount, std::size_t aAlignment, const Function& aFunction)
+	{
+		const std::size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+		const std::size_t threadCount = std::min(hardwareThreads, aCount / std::max<std::size_t>(aMinimumCount, 1));
+		if (threadCount <= 1)
+		{
+			aFunction(std::size_t(0), aCount);
+			return;
+		}
+
+		std::size_t rangeSize = (aCount + threadCount - 1) / threadCount;
+		rangeSize = (rangeSize + aAlignment - 1) / aAlignment * aAlignment;
+
+		std::vector<std::jthread> threads;
+		threads.reserve(threadCount - 1);
+		for (std::size_t begin = rangeSize; begin < aCount; begin += rangeSize)
+		{
+			threads.emplace_back(aFunction, begin, std::min(begin + rangeSize, aCount));
+		}
+		aFunction(std::size_t(0), std::min(rangeSize, aCount));
+	}
+}
@@ -4,99 +4,89 @@
 
 namespace stm
 {
-	Quaternion::Quaternion() : r(1), i(0), j(0), k(0)
-	{
-
-	}
-
-	Quaternion::Quaternion(float aR, float aI, float aJ, float aK)
-	{
-		r = aR;
-		i = aI;
-		j = aJ;
-		k = aK;
-	}
-
 	Quaternion::Quaternion(float aX, float aY, float aZ)
 	{
-		*this = Quaternion(aY, { 0,1,0 }) * Quaternion(aX, { 1,0,0 }) * Quaternion(aZ, { 0,0,1 });
-	}
+		// The three axis products multiplied out, only the half angle sines and cosines are needed.
+		float sinX, cosX, sinY, cosY, sinZ, cosZ;
+		Math::SinCos(Math::DegreeToRad(aX) * 0.5f, sinX, cosX);
+		Math::SinCos(Math::DegreeToRad(aY) * 0.5f, sinY, cosY);
+		Math::SinCos(Math::DegreeToRad(aZ) * 0.5f, sinZ, cosZ);
 
-	Quaternion::Quaternion(const Quaternion& aQuaternion)
-	{
-		r = aQuaternion.r;
-		i = aQuaternion.i;
-		j = aQuaternion.j;
-		k = aQuaternion.k;
+		r = cosY * cosX * cosZ + sinY * sinX * sinZ;
+		i = cosY * sinX * cosZ + sinY * cosX * sinZ;
+		j = sinY * cosX * cosZ - cosY * sinX * sinZ;
+		k = cosY * cosX * sinZ - sinY * sinX * cosZ;
 	}
 
 	Quaternion::Quaternion(const float aDegreeAngle, const Vector3f& aRotationAxis)
 	{
 		float halfAngle = Math::DegreeToRad(aDegreeAngle) / 2.0f;
-		float sinus = sin(halfAngle);
-		r = cos(halfAngle);
+		float sinus;
+		Math::SinCos(halfAngle, sinus, r);
 		i = aRotationAxis.x * sinus;
 		j = aRotationAxis.y * sinus;
 		k = aRotationAxis.z * sinus;
 	}
 
-	const Vector3f Quaternion::GetEuler() const
+	Quaternion::Quaternion(const Matrix3x3<float>& aRotation)
 	{
-		Vector3f eulerAngle = Vector3f();
-
-		Vector3f rotatedForward = Vector3f(0, 0, 1);
-		rotatedForward = Rotate(rotatedForward);
-		eulerAngle.y = atan2f(rotatedForward.x, rotatedForward.z);
-
-		Quaternion counterYQuat = Quaternion(Math::RadToDegree(-eulerAngle.y), Vector3f(0, 1, 0));
-		rotatedForward = counterYQuat.Rotate(rotatedForward);
-		eulerAngle.x = atan2f(-rotatedForward.y, rotatedForward.z);
-
-		Quaternion counterXQuat = Quaternion(Math::RadToDegree(-eulerAngle.x), Vector3f(1, 0, 0));
-		Vector3f rotatedRight = Vector3f(1, 0, 0);
-		rotatedRight = Rotate(rotatedRight);
-		rotatedRight = counterYQuat.Rotate(rotatedRight);
-		rotatedRight = counterXQuat.Rotate(rotatedRight);
-		eulerAngle.z = atan2f(rotatedRight.y, rotatedRight.x);
-
-		return eulerAngle * 57.2957795f;
+		// Shepperd's method on the column vector form, the largest of the four candidates gives the most precision.
+		auto element = [&aRotation](int aRow, int aColumn) { return aRotation(aColumn, aRow); };
+		const float trace = element(1, 1) + element(2, 2) + element(3, 3);
+		if (trace > 0.0f)
+		{
+			const float scale = 2.0f * sqrtf(trace + 1.0f);
+			r = 0.25f * scale;
+			i = (element(3, 2) - element(2, 3)) / scale;
+			j = (element(1, 3) - element(3, 1)) / scale;
+			k = (element(2, 1) - element(1, 2)) / scale;
+		}
+		else if (element(1, 1) > element(2, 2) && element(1, 1) > element(3, 3))
+		{
+			const float scale = 2.0f * sqrtf(1.0f + element(1, 1) - element(2, 2) - element(3, 3));
+			r = (element(3, 2) - element(2, 3)) / scale;
+			i = 0.25f * scale;
+			j = (element(1, 2) + element(2, 1)) / scale;
+			k = (element(1, 3) + element(3, 1)) / scale;
+		}
+		else if (element(2, 2) > element(3, 3))
+		{
+			const float scale = 2.0f * sqrtf(1.0f + element(2, 2) - element(1, 1) - element(3, 3));
+			r = (element(1, 3) - element(3, 1)) / scale;
+			i = (element(1, 2) + element(2, 1)) / scale;
+			j = 0.25f * scale;
+			k = (element(2, 3) + element(3, 2)) / scale;
+		}
+		else
+		{
+			const float scale = 2.0f * sqrtf(1.0f + element(3, 3) - element(1, 1) - element(2, 2));
+			r = (element(2, 1) - element(1, 2)) / scale;
+			i = (element(1, 3) + element(3, 1)) / scale;
+			j = (element(2, 3) + element(3, 2)) / scale;
+			k = 0.25f * scale;
+		}
 	}
 
-	const Quaternion Quaternion::operator*(const Quaternion& aOther) const
-	{
-		return Quaternion(r * aOther.r - i * aOther.i - j * aOther.j - k * aOther.k,
-			r * aOther.i + i * aOther.r + j * aOther.k - k * aOther.j,
-			r * aOther.j - i * aOther.k + j * aOther.r + k * aOther.i,
-			r * aOther.k + i * aOther.j - j * aOther.i + k * aOther.r);
-	}
-	void Quaternion::operator*=(const Quaternion& aOther)
-	{
-		*this = *this * aOther;
-	}
-	const Vector3f Quaternion::Rotate(const Vector3f& aVector) const
+	const Vector3f Quaternion::GetEuler() const
 	{
-		Vector3f vectorPart(i, j, k);
-
-		return 2.0f * vectorPart.Dot(aVector) * vectorPart
-			+ (r * r - vectorPart.Dot(vectorPart)) * aVector
-			+ 2.0f * r * vectorPart.Cross(aVector);
-	}
+		// Yaw and pitch from the rotated forward axis, roll from the y components of the rotated right and up axes.
+		const float forwardX = 2.0f * (i * k + r * j);
+		const float forwardY = 2.0f * (j * k - r * i);
+		const float forwardZ = r * r - i * i - j * j + k * k;
+		const float forwardXZSqr = forwardX * forwardX + forwardZ * forwardZ;
+		const float pitch = Math::Atan2(-forwardY, sqrtf(forwardXZSqr));
 
-	const Vector4f Quaternion::Rotate(const Vector4f& aVector) const
-	{
-		const Vector3f* vector3 = reinterpret_cast<const Vector3f*>(&aVector);
-		return Vector4f(Rotate(*vector3), aVector.w);
-	}
-	
-	void Quaternion::Normalize()
-	{
-		float length = std::sqrt(r * r + i * i + j * j + k * k);
-		assert(length != 0 && "Division by 0");
+		// Looking straight up or down yaw and roll turn about the same axis and the forward x and z are rounding
+		// noise, so roll is 0 and the rotated right axis, which then lies in the xz plane, gives the yaw.
+		if (forwardXZSqr < GimbalLockThreshold)
+		{
+			const float rightX = r * r + i * i - j * j - k * k;
+			const float rightZ = 2.0f * (i * k - r * j);
+			return Vector3f(pitch, Math::Atan2(-rightZ, rightX), 0.0f) * Math::RadToDegree(1.0f);
+		}
 
-		float result = 1.f / length;
-		r *= result;
-		i *= result;
-		j *= result;
-		k *= result;
+		const float rightY = 2.0f * (i * j + r * k);
+		const float upY = r * r - i * i + j * j - k * k;
+		return Vector3f(pitch, Math::Atan2(forwardX, forwardZ), Math::Atan2(rightY, upY)) * Math::RadToDegree(1.0f);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "QuaternionStream.hpp"
+#include <cassert>
+
+namespace stm
+{
+	QuaternionStream::QuaternionStream(std::size_t aSize) :
+		m_R(aSize),
+		m_I(aSize),
+		m_J(aSize),
+		m_K(aSize)
+	{
+	}
+
+	QuaternionStream::QuaternionStream(std::span<const Quaternion> aQuaternions)
+	{
+		Load(aQuaternions);
+	}
+
+	void QuaternionStream::Resize(std::size_t aSize)
+	{
+		m_R.resize(aSize);
+		m_I.resize(aSize);
+		m_J.resize(aSize);
+		m_K.resize(aSize);
+	}
+
+	std::size_t QuaternionStream::Size() const
+	{
+		return m_R.size();
+	}
+
+	void QuaternionStream::Load(std::span<const Quaternion> aQuaternions)
+	{
+		Resize(aQuaternions.size());
+
+		std::size_t index = 0;
+#ifdef STM_SIMD_SSE
+		for (; index + 4 <= aQuaternions.size(); index += 4)
+		{
+			__m128 row0 = _mm_loadu_ps(&aQuaternions[index].r);
+			__m128 row1 = _mm_loadu_ps(&aQuaternions[index + 1].r);
+			__m128 row2 = _mm_loadu_ps(&aQuaternions[index + 2].r);
+			__m128 row3 = _mm_loadu_ps(&aQuaternions[index + 3].r);
+			_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+			_mm_storeu_ps(&m_R[index], row0);
+			_mm_storeu_ps(&m_I[index], row1);
+			_mm_storeu_ps(&m_J[index], row2);
+			_mm_storeu_ps(&m_K[index], row3);
+		}
+#endif
+		for (; index < aQuaternions.size(); index++)
+		{
+			Set(index, aQuaternions[index]);
+		}
+	}
+
+	void QuaternionStream::Store(std::span<Quaternion> aQuaternions) const
+	{
+		assert(aQuaternions.size() >= Size() && "Output span too small");
+
+		std::size_t index = 0;
+#ifdef STM_SIMD_SSE
+		for (; index + 4 <= Size(); index += 4)
+		{
+			__m128 row0 = _mm_loadu_ps(&m_R[index]);
+			__m128 row1 = _mm_loadu_ps(&m_I[index]);
+			__m128 row2 = _mm_loadu_ps(&m_J[index]);
+			__m128 row3 = _mm_loadu_ps(&m_K[index]);
+			_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+			_mm_storeu_ps(&aQuaternions[index].r, row0);
+			_mm_storeu_ps(&aQuaternions[index + 1].r, row1);
+			_mm_storeu_ps(&aQuaternions[index + 2].r, row2);
+			_mm_storeu_ps(&aQuaternions[index + 3].r, row3);
+		}
+#endif
+		for (; index < Size(); index++)
+		{
+			aQuaternions[index] = Get(index);
+		}
+	}
+
+	Quaternion QuaternionStream::Get(std::size_t aIndex) const
+	{
+		assert(aIndex < Size() && "Index out of bounds");
+
+		return Quaternion(m_R[aIndex], m_I[aIndex], m_J[aIndex], m_K[aIndex]);
+	}
+
+	void QuaternionStream::Set(std::size_t aIndex, const Quaternion& aQuaternion)
+	{
+		assert(aIndex < Size() && "Index out of bounds");
+
+		m_R[aIndex] = aQuaternion.r;
+		m_I[aIndex] = aQuaternion.i;
+		m_J[aIndex] = aQuaternion.j;
+		m_K[aIndex] = aQuaternion.k;
+	}
+
+	float* QuaternionStream::R()
+	{
+		return m_R.data();
+	}
+
+	float* QuaternionStream::I()
+	{
+		return m_I.data();
+	}
+
+	float* QuaternionStream::J()
+	{
+		return m_J.data();
+	}
+
+	float* QuaternionStream::K()
+	{
+		return m_K.data();
+	}
+
+	const float* QuaternionStream::R() const
+	{
+		return m_R.data();
+	}
+
+	const float* QuaternionStream::I() const
+	{
+		return m_I.data();
+	}
+
+	const float* QuaternionStream::J() const
+	{
+		return m_J.data();
+	}
+
+	const float* QuaternionStream::K() const
+	{
+		return m_K.data();
+	}
+
+	void QuaternionStream::Rotate(const Vector3Stream<float>& aVectors, Vector3Stream<float>& aResult, Batch::Execution aExecution) const
+	{
+		Batch::Rotate(*this, aVectors, aResult, aExecution);
+	}
+}
@@ -1,4 +1,5 @@
 #include "Transform.hpp"
+#include <cassert>
 
 namespace stm
 {
@@ -17,6 +18,33 @@ namespace stm
 		m_Position = aTransform.m_Position;
 	}
 
+	Transform::Transform(const Matrix3x4f& aMatrix)
+	{
+		const Vector3f right = aMatrix.GetRight();
+		const Vector3f up = aMatrix.GetUp();
+		const Vector3f forward = aMatrix.GetForward();
+
+		m_Scale = Vector3f(right.Length(), up.Length(), forward.Length());
+		// A mirrored basis can not be a rotation, the flip is moved into the x scale.
+		if (Matrix3x4f::GetDeterminant(aMatrix) < 0.0f)
+		{
+			m_Scale.x = -m_Scale.x;
+		}
+		assert(m_Scale.x != 0 && m_Scale.y != 0 && m_Scale.z != 0 && "Division by 0");
+
+		Matrix3x3f rotation;
+		const Vector3f axes[3] = { right / m_Scale.x, up / m_Scale.y, forward / m_Scale.z };
+		for (int row = 0; row < 3; row++)
+		{
+			rotation(row + 1, 1) = axes[row].x;
+			rotation(row + 1, 2) = axes[row].y;
+			rotation(row + 1, 3) = axes[row].z;
+		}
+		m_Rotation = Quaternion(rotation);
+		m_Rotation.Normalize();
+		m_Position = aMatrix.GetTranslation();
+	}
+
 	void Transform::SetScale(const Vector3f& aScale)
 	{
 		m_Scale = aScale;
@@ -61,17 +89,21 @@ namespace stm
 	{
 		return m_Position;
 	}
+	// The rotated axes are rows of the rotation matrix, only the one asked for is computed.
 	const Vector3f Transform::GetUp() const
 	{
-		return Rotate(Vector3f(0, 1, 0));
+		const Quaternion& q = m_Rotation;
+		return Vector3f(2.0f * (q.i * q.j - q.r * q.k), q.r * q.r - q.i * q.i + q.j * q.j - q.k * q.k, 2.0f * (q.j * q.k + q.r * q.i));
 	}
 	const Vector3f Transform::GetRight() const
 	{
-		return Rotate(Vector3f(1, 0, 0));
+		const Quaternion& q = m_Rotation;
+		return Vector3f(q.r * q.r + q.i * q.i - q.j * q.j - q.k * q.k, 2.0f * (q.i * q.j + q.r * q.k), 2.0f * (q.i * q.k - q.r * q.j));
 	}
 	const Vector3f Transform::GetForward() const
 	{
-		return Rotate(Vector3f(0, 0, 1));
+		const Quaternion& q = m_Rotation;
+		return Vector3f(2.0f * (q.i * q.k + q.r * q.j), 2.0f * (q.j * q.k - q.r * q.i), q.r * q.r - q.i * q.i - q.j * q.j + q.k * q.k);
 	}
 	const Vector3f Transform::Rotate(const Vector3f& aVector) const
 	{
@@ -83,29 +115,28 @@ namespace stm
 	}
 	const Matrix4x4f Transform::CreateMatrix() const
 	{
-		Vector4f right = Vector4f(m_Scale.x, 0, 0, 0);
-		Vector4f up = Vector4f(0, m_Scale.y, 0, 0);
-		Vector4f forward = Vector4f(0, 0, m_Scale.z, 0);
-
-		right = m_Rotation.Rotate(right);
-		up = m_Rotation.Rotate(up);
-		forward = m_Rotation.Rotate(forward);
-
-		Matrix4x4f returnMatrix = Matrix4x4f();
-		returnMatrix(1, 1) = right.x;
-		returnMatrix(1, 2) = right.y;
-		returnMatrix(1, 3) = right.z;
-		returnMatrix(2, 1) = up.x;
-		returnMatrix(2, 2) = up.y;
-		returnMatrix(2, 3) = up.z;
-		returnMatrix(3, 1) = forward.x;
-		returnMatrix(3, 2) = forward.y;
-		returnMatrix(3, 3) = forward.z;
-		returnMatrix(4, 1) = m_Position.x;
-		returnMatrix(4, 2) = m_Position.y;
-		returnMatrix(4, 3) = m_Position.z;
-
-		return returnMatrix;
+		const Vector3f right = GetRight() * m_Scale.x;
+		const Vector3f up = GetUp() * m_Scale.y;
+		const Vector3f forward = GetForward() * m_Scale.z;
+
+		return Matrix4x4f(
+			right.x, right.y, right.z, 0,
+			up.x, up.y, up.z, 0,
+			forward.x, forward.y, forward.z, 0,
+			m_Position.x, m_Position.y, m_Position.z, 1
+		);
+	}
+	const Matrix3x4f Transform::CreateAffineMatrix() const
+	{
+		const Vector3f right = GetRight() * m_Scale.x;
+		const Vector3f up = GetUp() * m_Scale.y;
+		const Vector3f forward = GetForward() * m_Scale.z;
+
+		return Matrix3x4f(
+			right.x, up.x, forward.x, m_Position.x,
+			right.y, up.y, forward.y, m_Position.y,
+			right.z, up.z, forward.z, m_Position.z
+		);
 	}
 	const Vector3f operator*(const Vector3f& aVector, const Transform& aTransform)
 	{
@@ -0,0 +1,187 @@
+#include "TransformHierarchy.hpp"
+#include "Parallel.hpp"
+#include <cassert>
+
+namespace stm
+{
+	namespace
+	{
+		// A node is two small matrix products, levels with fewer dirty nodes than this are not worth a thread.
+		constexpr std::size_t MinimumParallelCount = 4096;
+		// Ranges split a level's dirty list, sixteen handles keep each thread's part on whole cache lines of it.
+		constexpr std::size_t ParallelAlignment = 16;
+	}
+
+	void TransformHierarchy::Reserve(std::size_t aCapacity)
+	{
+		m_Local.reserve(aCapacity);
+		m_Parent.reserve(aCapacity);
+		m_FirstChild.reserve(aCapacity);
+		m_NextSibling.reserve(aCapacity);
+		m_Depth.reserve(aCapacity);
+		m_Flags.reserve(aCapacity);
+		m_LocalMatrix.reserve(aCapacity);
+		m_WorldMatrix.reserve(aCapacity);
+	}
+
+	void TransformHierarchy::Clear()
+	{
+		m_Local.clear();
+		m_Parent.clear();
+		m_FirstChild.clear();
+		m_NextSibling.clear();
+		m_Depth.clear();
+		m_Flags.clear();
+		m_LocalMatrix.clear();
+		m_WorldMatrix.clear();
+		m_DirtyLevels.clear();
+	}
+
+	std::size_t TransformHierarchy::Size() const
+	{
+		return m_Local.size();
+	}
+
+	TransformHierarchy::Handle TransformHierarchy::Add(const Transform& aLocal, Handle aParent)
+	{
+		assert((aParent == InvalidHandle || aParent < Size()) && "Parent must be added before its children");
+		assert(Size() < InvalidHandle && "Hierarchy is full");
+
+		const Handle handle = static_cast<Handle>(Size());
+		const std::uint32_t depth = aParent == InvalidHandle ? 0 : m_Depth[aParent] + 1;
+
+		m_Local.push_back(aLocal);
+		m_Parent.push_back(aParent);
+		m_FirstChild.push_back(InvalidHandle);
+		m_NextSibling.push_back(InvalidHandle);
+		m_Depth.push_back(depth);
+		m_Flags.push_back(LocalDirty | WorldDirty);
+		m_LocalMatrix.emplace_back();
+		m_WorldMatrix.emplace_back();
+		if (aParent != InvalidHandle)
+		{
+			m_NextSibling[handle] = m_FirstChild[aParent];
+			m_FirstChild[aParent] = handle;
+		}
+		if (depth >= m_DirtyLevels.size())
+		{
+			m_DirtyLevels.resize(depth + 1);
+		}
+		m_DirtyLevels[depth].push_back(handle);
+		return handle;
+	}
+
+	TransformHierarchy::Handle TransformHierarchy::GetParent(Handle aHandle) const
+	{
+		assert(aHandle < Size() && "Index out of bounds");
+
+		return m_Parent[aHandle];
+	}
+
+	std::uint32_t TransformHierarchy::GetDepth(Handle aHandle) const
+	{
+		assert(aHandle < Size() && "Index out of bounds");
+
+		return m_Depth[aHandle];
+	}
+
+	const Transform& TransformHierarchy::GetLocal(Handle aHandle) const
+	{
+		assert(aHandle < Size() && "Index out of bounds");
+
+		return m_Local[aHandle];
+	}
+
+	void TransformHierarchy::SetLocal(Handle aHandle, const Transform& aLocal)
+	{
+		assert(aHandle < Size() && "Index out of bounds");
+
+		m_Local[aHandle] = aLocal;
+		if (m_Flags[aHandle] == 0)
+		{
+			m_DirtyLevels[m_Depth[aHandle]].push_back(aHandle);
+		}
+		m_Flags[aHandle] |= LocalDirty | WorldDirty;
+	}
+
+	bool TransformHierarchy::IsDirty(Handle aHandle) const
+	{
+		assert(aHandle < Size() && "Index out of bounds");
+
+		return m_Flags[aHandle] != 0;
+	}
+
+	const Matrix3x4f& TransformHierarchy::GetLocalMatrix(Handle aHandle) const
+	{
+		assert(aHandle < Size() && "Index out of bounds");
+
+		return m_LocalMatrix[aHandle];
+	}
+
+	const Matrix3x4f& TransformHierarchy::GetWorldMatrix(Handle aHandle) const
+	{
+		assert(aHandle < Size() && "Index out of bounds");
+
+		return m_WorldMatrix[aHandle];
+	}
+
+	std::span<const Matrix3x4f> TransformHierarchy::GetWorldMatrices() const
+	{
+		return m_WorldMatrix;
+	}
+
+	void TransformHierarchy::Update(Batch::Execution aExecution)
+	{
+		// Nodes of one level only read the level above, which is complete by the time the level starts.
+		for (std::size_t depth = 0; depth < m_DirtyLevels.size(); depth++)
+		{
+			std::vector<Handle>& dirty = m_DirtyLevels[depth];
+			if (dirty.empty())
+			{
+				continue;
+			}
+
+			// A changed world matrix moves every child, each is queued once however many times it is flagged.
+			for (const Handle handle : dirty)
+			{
+				for (Handle child = m_FirstChild[handle]; child != InvalidHandle; child = m_NextSibling[child])
+				{
+					if (m_Flags[child] == 0)
+					{
+						m_DirtyLevels[depth + 1].push_back(child);
+					}
+					m_Flags[child] |= WorldDirty;
+				}
+			}
+
+			auto updateRange = [this, &dirty](std::size_t aBegin, std::size_t aEnd)
+			{
+				for (std::size_t index = aBegin; index < aEnd; index++)
+				{
+					UpdateNode(dirty[index]);
+				}
+			};
+			// ParallelFor gives every thread at least MinimumParallelCount nodes, smaller levels stay on this thread.
+			if (aExecution == Batch::Execution::Parallel && dirty.size() >= 2 * MinimumParallelCount)
+			{
+				ParallelFor(dirty.size(), MinimumParallelCount, ParallelAlignment, updateRange);
+			}
+			else
+			{
+				updateRange(0, dirty.size());
+			}
+			dirty.clear();
+		}
+	}
+
+	void TransformHierarchy::UpdateNode(Handle aHandle)
+	{
+		if (m_Flags[aHandle] & LocalDirty)
+		{
+			m_LocalMatrix[aHandle] = m_Local[aHandle].CreateAffineMatrix();
+		}
+		const Handle parent = m_Parent[aHandle];
+		m_WorldMatrix[aHandle] = parent == InvalidHandle ? m_LocalMatrix[aHandle] : m_LocalMatrix[aHandle] * m_WorldMatrix[parent];
+		m_Flags[aHandle] = 0;
+	}
+}
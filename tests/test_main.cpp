@@ -1,27 +1,2326 @@
 #include "AABB2D.hpp"
 #include "AABB3D.hpp"
+#include "Batch.hpp"
+#include "BoundingVolumeHierarchy.hpp"
+#include "Broadphase2D.hpp"
+#include "CpuFeatures.hpp"
 #include "EulerAngle.hpp"
+#include "FastMath.hpp"
+#include "Fixed32.hpp"
+#include "FixedQuaternion.hpp"
+#include "FrustumCuller.hpp"
 #include "Line.hpp"
 #include "LineVolume.hpp"
 #include "Math.hpp"
 #include "Matrix3x3.hpp"
+#include "Matrix3x4.hpp"
 #include "Matrix4x4.hpp"
+#include "PackedVector.hpp"
 #include "Plane.hpp"
+#include "PlaneSet.hpp"
 #include "PlaneVolume.hpp"
+#include "Precision.hpp"
 #include "Quaternion.hpp"
+#include "QuaternionStream.hpp"
 #include "Ray.hpp"
+#include "RayPacket.hpp"
+#include "Simd.hpp"
 #include "SimpleList.hpp"
 #include "Sphere.hpp"
 #include "Transform.hpp"
+#include "TransformHierarchy.hpp"
 #include "Vector2.hpp"
 #include "Vector3.hpp"
+#include "Vector3Stream.hpp"
 #include "Vector4.hpp"
+#include "VectorExpression.hpp"
+#include "ViewProjection.hpp"
 
+// Private to the library, the tests run every kernel table the CPU supports against the scalar one.
+#include "BatchKernels.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	using namespace stm;
+
+	int failureCount = 0;
+	std::mt19937 randomEngine(20240611);
+
+	void Check(bool aCondition, const std::string& aName)
+	{
+		if (!aCondition)
+		{
+			std::cout << "FAILED: " << aName << '\n';
+			failureCount++;
+		}
+	}
+
+	// Relative to the expected value, absolute below 1.
+	bool Near(float aValue, float aExpected, float aTolerance)
+	{
+		return std::abs(aValue - aExpected) <= aTolerance * std::max(1.0f, std::abs(aExpected));
+	}
+
+	bool AllNear(const std::vector<float>& aValues, const std::vector<float>& aExpected, float aTolerance)
+	{
+		for (std::size_t index = 0; index < aExpected.size(); index++)
+		{
+			if (!Near(aValues[index], aExpected[index], aTolerance))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	float RandomFloat(float aMin, float aMax)
+	{
+		return std::uniform_real_distribution<float>(aMin, aMax)(randomEngine);
+	}
+
+	std::vector<float> RandomFloats(std::size_t aCount, float aMin, float aMax)
+	{
+		std::vector<float> result(aCount);
+		for (float& value : result)
+		{
+			value = RandomFloat(aMin, aMax);
+		}
+		return result;
+	}
+
+	Vector3f RandomVector(float aMin, float aMax)
+	{
+		return Vector3f(RandomFloat(aMin, aMax), RandomFloat(aMin, aMax), RandomFloat(aMin, aMax));
+	}
+
+	Quaternion RandomRotation()
+	{
+		Quaternion rotation(RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f));
+		rotation.Normalize();
+		return rotation;
+	}
+
+	AABB3D<float> RandomBox(float aRange, float aMaxExtent)
+	{
+		const Vector3f center = RandomVector(-aRange, aRange);
+		const Vector3f extent(RandomFloat(0.1f, aMaxExtent), RandomFloat(0.1f, aMaxExtent), RandomFloat(0.1f, aMaxExtent));
+		return AABB3D<float>(center - extent, center + extent);
+	}
+
+	// Largest distance between the axes rotated by either quaternion.
+	float RotationDifference(const Quaternion& aRotation0, const Quaternion& aRotation1)
+	{
+		float difference = 0.0f;
+		for (const Vector3f& axis : { Vector3f(1, 0, 0), Vector3f(0, 1, 0), Vector3f(0, 0, 1) })
+		{
+			difference = std::max(difference, (aRotation0.Rotate(axis) - aRotation1.Rotate(axis)).Length());
+		}
+		return difference;
+	}
+
+	// The tables the dispatch could pick on this CPU, scalar first.
+	std::vector<std::pair<InstructionSet, const BatchKernels*>> GetRunnableKernels()
+	{
+		const CpuFeatures& features = CpuFeatures::Get();
+		std::vector<std::pair<InstructionSet, const BatchKernels*>> result = { { InstructionSet::Scalar, GetScalarKernels() } };
+		if (features.hasSSE2 && GetSSE2Kernels())
+		{
+			result.emplace_back(InstructionSet::SSE2, GetSSE2Kernels());
+		}
+		if (features.hasAVX2 && features.hasFMA && features.hasF16C && GetAVX2Kernels())
+		{
+			result.emplace_back(InstructionSet::AVX2, GetAVX2Kernels());
+		}
+		if (features.hasAVX512F && features.hasAVX512DQ && features.hasAVX512VL && features.hasFMA && features.hasF16C && GetAVX512Kernels())
+		{
+			result.emplace_back(InstructionSet::AVX512, GetAVX512Kernels());
+		}
+		return result;
+	}
+
+	// Every kernel of aKernels against the scalar table, on counts that leave a partial register for every width.
+	// Float results may differ by fused multiply-adds and hardware estimates, integer and index results not at all.
+	void CheckKernels(const BatchKernels& aScalar, const BatchKernels& aKernels, const std::string& aName)
+	{
+		constexpr std::size_t Count = 37;
+		constexpr std::size_t MatrixCount = 5;
+
+		auto compare = [&](const std::string& aKernel, std::size_t aSize, float aTolerance, const auto& aRun)
+		{
+			std::vector<float> expected(aSize);
+			std::vector<float> result(aSize);
+			aRun(aScalar, expected.data());
+			aRun(aKernels, result.data());
+			Check(AllNear(result, expected, aTolerance), aName + " " + aKernel);
+		};
+		auto compareExact = [&](const std::string& aKernel, const auto& aExpected, const auto& aResult)
+		{
+			Check(aExpected == aResult, aName + " " + aKernel);
+		};
+
+		const std::vector<float> x0 = RandomFloats(Count, -10.0f, 10.0f);
+		const std::vector<float> y0 = RandomFloats(Count, -10.0f, 10.0f);
+		const std::vector<float> z0 = RandomFloats(Count, -10.0f, 10.0f);
+		const std::vector<float> x1 = RandomFloats(Count, -10.0f, 10.0f);
+		const std::vector<float> y1 = RandomFloats(Count, -10.0f, 10.0f);
+		const std::vector<float> z1 = RandomFloats(Count, -10.0f, 10.0f);
+
+		compare("Dot", Count, 1e-5f, [&](const BatchKernels& aTable, float* aResult)
+		{
+			aTable.Dot(x0.data(), y0.data(), z0.data(), x1.data(), y1.data(), z1.data(), aResult, Count);
+		});
+		compare("DistanceSqr", Count, 1e-5f, [&](const BatchKernels& aTable, float* aResult)
+		{
+			aTable.DistanceSqr(x0.data(), y0.data(), z0.data(), x1.data(), y1.data(), z1.data(), aResult, Count);
+		});
+		const float precisionTolerance[3] = { 1e-5f, 1e-5f, 1e-3f };
+		for (int precision = 0; precision < 3; precision++)
+		{
+			compare("Length " + std::to_string(precision), Count, precisionTolerance[precision], [&](const BatchKernels& aTable, float* aResult)
+			{
+				aTable.Length[precision](x0.data(), y0.data(), z0.data(), aResult, Count);
+			});
+			compare("Normalize " + std::to_string(precision), 3 * Count, precisionTolerance[precision], [&](const BatchKernels& aTable, float* aResult)
+			{
+				std::copy(x0.begin(), x0.end(), aResult);
+				std::copy(y0.begin(), y0.end(), aResult + Count);
+				std::copy(z0.begin(), z0.end(), aResult + 2 * Count);
+				aTable.Normalize[precision](aResult, aResult + Count, aResult + 2 * Count, Count);
+			});
+		}
+		compare("Cross", 3 * Count, 1e-5f, [&](const BatchKernels& aTable, float* aResult)
+		{
+			aTable.Cross(x0.data(), y0.data(), z0.data(), x1.data(), y1.data(), z1.data(), aResult, aResult + Count, aResult + 2 * Count, Count);
+		});
+		compare("Lerp", 3 * Count, 1e-5f, [&](const BatchKernels& aTable, float* aResult)
+		{
+			aTable.Lerp(x0.data(), y0.data(), z0.data(), x1.data(), y1.data(), z1.data(), 0.3f, aResult, aResult + Count, aResult + 2 * Count, Count);
+		});
+		compare("ClampFloats", Count, 0.0f, [&](const BatchKernels& aTable, float* aResult)
+		{
+			aTable.ClampFloats(x0.data(), -2.0f, 3.0f, aResult, Count);
+		});
+		compare("LerpFloats", Count, 1e-5f, [&](const BatchKernels& aTable, float* aResult)
+		{
+			aTable.LerpFloats(x0.data(), x1.data(), 0.7f, aResult, Count);
+		});
+		compare("ScaleOffsetFloats", Count, 1e-5f, [&](const BatchKernels& aTable, float* aResult)
+		{
+			aTable.ScaleOffsetFloats(x0.data(), 1.5f, -4.0f, aResult, Count);
+		});
+
+		const std::vector<float> left = RandomFloats(16 * MatrixCount, -2.0f, 2.0f);
+		const std::vector<float> right = RandomFloats(16 * MatrixCount, -2.0f, 2.0f);
+		compare("MultiplyMatrices", 16 * MatrixCount, 1e-5f, [&](const BatchKernels& aTable, float* aResult)
+		{
+			aTable.MultiplyMatrices(left.data(), right.data(), aResult, MatrixCount);
+		});
+		compare("MultiplyMatricesPairwise", 16 * MatrixCount, 1e-5f, [&](const BatchKernels& aTable, float* aResult)
+		{
+			aTable.MultiplyMatricesPairwise(left.data(), right.data(), aResult, MatrixCount);
+		});
+		{
+			// aResult may alias either input, checked against the scalar table writing to a separate array.
+			std::vector<float> expected(16 * MatrixCount);
+			aScalar.MultiplyMatricesPairwise(left.data(), right.data(), expected.data(), MatrixCount);
+			std::vector<float> result(left);
+			aKernels.MultiplyMatricesPairwise(result.data(), right.data(), result.data(), MatrixCount);
+			Check(AllNear(result, expected, 1e-5f), aName + " MultiplyMatricesPairwise aliasing aLeft");
+			result = right;
+			aKernels.MultiplyMatricesPairwise(left.data(), result.data(), result.data(), MatrixCount);
+			Check(AllNear(result, expected, 1e-5f), aName + " MultiplyMatricesPairwise aliasing aRight");
+		}
+
+		const std::vector<float> vectors = RandomFloats(4 * Count, -10.0f, 10.0f);
+		for (int kind = 0; kind < 3; kind++)
+		{
+			compare("TransformVectors " + std::to_string(kind), 4 * Count, 1e-5f, [&](const BatchKernels& aTable, float* aResult)
+			{
+				aTable.TransformVectors[kind](vectors.data(), left.data(), aResult, Count);
+			});
+		}
+		for (int kind = 0; kind < 2; kind++)
+		{
+			compare("TransformStream " + std::to_string(kind), 3 * Count, 1e-5f, [&](const BatchKernels& aTable, float* aResult)
+			{
+				aTable.TransformStream[kind](x0.data(), y0.data(), z0.data(), left.data(), aResult, aResult + Count, aResult + 2 * Count, Count);
+			});
+		}
+
+		for (int precision = 0; precision < 3; precision++)
+		{
+			compare("NormalizeQuaternions " + std::to_string(precision), 4 * Count, precisionTolerance[precision], [&](const BatchKernels& aTable, float* aResult)
+			{
+				std::copy(vectors.begin(), vectors.end(), aResult);
+				aTable.NormalizeQuaternions[precision](aResult, Count);
+			});
+		}
+
+		QuaternionStream rotations(Count);
+		for (std::size_t index = 0; index < Count; index++)
+		{
+			rotations.Set(index, RandomRotation());
+		}
+		compare("RotateStream", 3 * Count, 1e-5f, [&](const BatchKernels& aTable, float* aResult)
+		{
+			aTable.RotateStream(rotations.R(), rotations.I(), rotations.J(), rotations.K(), x0.data(), y0.data(), z0.data(), aResult, aResult + Count, aResult + 2 * Count, Count);
+		});
+
+		const std::vector<float> pitches = RandomFloats(Count, -90.0f, 90.0f);
+		const std::vector<float> yaws = RandomFloats(Count, -180.0f, 180.0f);
+		const std::vector<float> rolls = RandomFloats(Count, -180.0f, 180.0f);
+		compare("EulerToQuaternionStream", 4 * Count, 1e-5f, [&](const BatchKernels& aTable, float* aResult)
+		{
+			aTable.EulerToQuaternionStream(pitches.data(), yaws.data(), rolls.data(), aResult, aResult + Count, aResult + 2 * Count, aResult + 3 * Count, Count);
+		});
+		{
+			// Compared as rotations, angles next to +-180 may come out on either side.
+			std::vector<float> expected(3 * Count);
+			std::vector<float> result(3 * Count);
+			aScalar.QuaternionToEulerStream(rotations.R(), rotations.I(), rotations.J(), rotations.K(), expected.data(), expected.data() + Count, expected.data() + 2 * Count, Count);
+			aKernels.QuaternionToEulerStream(rotations.R(), rotations.I(), rotations.J(), rotations.K(), result.data(), result.data() + Count, result.data() + 2 * Count, Count);
+			float difference = 0.0f;
+			for (std::size_t index = 0; index < Count; index++)
+			{
+				difference = std::max(difference, RotationDifference(
+					Quaternion(expected[index], expected[Count + index], expected[2 * Count + index]),
+					Quaternion(result[index], result[Count + index], result[2 * Count + index])));
+			}
+			Check(difference < 1e-4f, aName + " QuaternionToEulerStream");
+		}
+
+		std::vector<std::int32_t> fixed[6];
+		for (std::vector<std::int32_t>& values : fixed)
+		{
+			values.resize(Count);
+			for (std::int32_t& value : values)
+			{
+				value = std::uniform_int_distribution<std::int32_t>(-100 << 16, 100 << 16)(randomEngine);
+			}
+		}
+		{
+			std::vector<std::int32_t> expected(3 * Count);
+			std::vector<std::int32_t> result(3 * Count);
+			aScalar.FixedAdd(fixed[0].data(), fixed[1].data(), expected.data(), Count);
+			aKernels.FixedAdd(fixed[0].data(), fixed[1].data(), result.data(), Count);
+			compareExact("FixedAdd", expected, result);
+			aScalar.FixedMultiply(fixed[0].data(), fixed[1].data(), expected.data(), Count);
+			aKernels.FixedMultiply(fixed[0].data(), fixed[1].data(), result.data(), Count);
+			compareExact("FixedMultiply", expected, result);
+			aScalar.FixedDot(fixed[0].data(), fixed[1].data(), fixed[2].data(), fixed[3].data(), fixed[4].data(), fixed[5].data(), expected.data(), Count);
+			aKernels.FixedDot(fixed[0].data(), fixed[1].data(), fixed[2].data(), fixed[3].data(), fixed[4].data(), fixed[5].data(), result.data(), Count);
+			compareExact("FixedDot", expected, result);
+			aScalar.FixedCross(fixed[0].data(), fixed[1].data(), fixed[2].data(), fixed[3].data(), fixed[4].data(), fixed[5].data(), expected.data(), expected.data() + Count, expected.data() + 2 * Count, Count);
+			aKernels.FixedCross(fixed[0].data(), fixed[1].data(), fixed[2].data(), fixed[3].data(), fixed[4].data(), fixed[5].data(), result.data(), result.data() + Count, result.data() + 2 * Count, Count);
+			compareExact("FixedCross", expected, result);
+		}
+
+		{
+			std::vector<float> boxes(4 * Count);
+			for (std::size_t index = 0; index < Count; index++)
+			{
+				boxes[4 * index] = RandomFloat(-10.0f, 10.0f);
+				boxes[4 * index + 1] = RandomFloat(-10.0f, 10.0f);
+				boxes[4 * index + 2] = boxes[4 * index] + RandomFloat(0.0f, 6.0f);
+				boxes[4 * index + 3] = boxes[4 * index + 1] + RandomFloat(0.0f, 6.0f);
+			}
+			const float box[4] = { -2.0f, -3.0f, 4.0f, 2.0f };
+			std::vector<std::uint32_t> expected(Count);
+			std::vector<std::uint32_t> result(Count);
+			expected.resize(aScalar.OverlapBoxes2D(box, boxes.data(), Count, 5, expected.data()));
+			result.resize(aKernels.OverlapBoxes2D(box, boxes.data(), Count, 5, result.data()));
+			compareExact("OverlapBoxes2D", expected, result);
+		}
+
+		{
+			const float ray[6] = { 0.5f, -0.5f, -30.0f, 0.1f, 0.05f, 1.0f };
+			const std::vector<float> radii = RandomFloats(Count, 0.5f, 6.0f);
+			const std::vector<float> offsets = RandomFloats(Count, -20.0f, 20.0f);
+			std::vector<float> normalX(Count);
+			std::vector<float> normalY(Count);
+			std::vector<float> normalZ(Count);
+			for (std::size_t index = 0; index < Count; index++)
+			{
+				// Kept well away from parallel to the ray, grazing hits are too far out to compare.
+				const Vector3f normal = Vector3f(RandomFloat(-0.5f, 0.5f), RandomFloat(-0.5f, 0.5f), 1.0f).GetNormalized();
+				normalX[index] = normal.x;
+				normalY[index] = normal.y;
+				normalZ[index] = normal.z;
+			}
+
+			auto compareHits = [&](const std::string& aKernel, const auto& aKernelsOf, const float* aX, const float* aY, const float* aZ, const float* aValues)
+			{
+				for (int mode = 0; mode < 3; mode++)
+				{
+					std::vector<std::uint32_t> expectedIndices(Count);
+					std::vector<std::uint32_t> indices(Count);
+					std::vector<float> expectedDistances(Count);
+					std::vector<float> distances(Count);
+					const std::size_t expectedCount = aKernelsOf(aScalar)[mode](ray, aX, aY, aZ, aValues, Count, 1000.0f, expectedIndices.data(), expectedDistances.data());
+					const std::size_t count = aKernelsOf(aKernels)[mode](ray, aX, aY, aZ, aValues, Count, 1000.0f, indices.data(), distances.data());
+					expectedIndices.resize(expectedCount);
+					indices.resize(count);
+					expectedDistances.resize(expectedCount);
+					distances.resize(count);
+					const std::string name = aKernel + " " + std::to_string(mode);
+					if (mode == static_cast<int>(Batch::HitMode::Any))
+					{
+						// Any may stop at a different hit, so it only has to be a hit of the scalar All.
+						std::vector<std::uint32_t> allIndices(Count);
+						std::vector<float> allDistances(Count);
+						allIndices.resize(aKernelsOf(aScalar)[0](ray, aX, aY, aZ, aValues, Count, 1000.0f, allIndices.data(), allDistances.data()));
+						Check(count == expectedCount && (count == 0 || std::find(allIndices.begin(), allIndices.end(), indices[0]) != allIndices.end()), aName + " " + name);
+						continue;
+					}
+					Check(indices == expectedIndices && AllNear(distances, expectedDistances, 1e-4f), aName + " " + name);
+				}
+			};
+			compareHits("RaySpheres", [](const BatchKernels& aTable) { return aTable.RaySpheres; }, x0.data(), y0.data(), z0.data(), radii.data());
+			compareHits("RayPlanes", [](const BatchKernels& aTable) { return aTable.RayPlanes; }, normalX.data(), normalY.data(), normalZ.data(), offsets.data());
+		}
+
+		{
+			const Matrix4x4<float> viewProjection = Matrix4x4<float>::CreateLookAt({ 3, 2, -20 }, { 0, 0, 0 }, { 0, 1, 0 }) * Matrix4x4<float>::CreatePerspective(1.0f, 1.5f, 0.5f, 60.0f);
+			const PlaneSet<float> planes(PlaneVolume<float>::CreateFrustum(viewProjection));
+			std::vector<AABB3D<float>> boxes;
+			std::vector<Sphere<float>> spheres;
+			boxes.reserve(Count);
+			spheres.reserve(Count);
+			for (std::size_t index = 0; index < Count; index++)
+			{
+				boxes.push_back(RandomBox(30.0f, 4.0f));
+				spheres.emplace_back(RandomVector(-30.0f, 30.0f), RandomFloat(0.1f, 4.0f));
+			}
+			const std::size_t offset = sizeof(Vector3f) / sizeof(float);
+			std::vector<std::uint32_t> expected(Count);
+			std::vector<std::uint32_t> result(Count);
+			const Vector3Stream<float>& normals = planes.GetNormals();
+			expected.resize(aScalar.CullBoxes(normals.X(), normals.Y(), normals.Z(), planes.GetDistances().data(), planes.Size(), &boxes[0].Min().x, sizeof(AABB3D<float>) / sizeof(float), offset, Count, expected.data()));
+			result.resize(aKernels.CullBoxes(normals.X(), normals.Y(), normals.Z(), planes.GetDistances().data(), planes.Size(), &boxes[0].Min().x, sizeof(AABB3D<float>) / sizeof(float), offset, Count, result.data()));
+			compareExact("CullBoxes", expected, result);
+			expected.resize(Count);
+			result.resize(Count);
+			expected.resize(aScalar.CullSpheres(normals.X(), normals.Y(), normals.Z(), planes.GetDistances().data(), planes.Size(), &spheres[0].Position().x, sizeof(Sphere<float>) / sizeof(float), offset, Count, expected.data()));
+			result.resize(aKernels.CullSpheres(normals.X(), normals.Y(), normals.Z(), planes.GetDistances().data(), planes.Size(), &spheres[0].Position().x, sizeof(Sphere<float>) / sizeof(float), offset, Count, result.data()));
+			compareExact("CullSpheres", expected, result);
+		}
+
+		{
+			// Overflow, infinity, half denormals, signed zero and rounding ties besides the random values.
+			std::vector<float> floats = RandomFloats(Count, -70000.0f, 70000.0f);
+			const float special[] = { 65520.0f, 65504.0f, std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), 1e-6f, -3e-8f, -0.0f, 1.0f + 1.0f / 2048.0f };
+			floats.insert(floats.end(), std::begin(special), std::end(special));
+			std::vector<std::uint16_t> expected(floats.size());
+			std::vector<std::uint16_t> result(floats.size());
+			aScalar.FloatsToHalves(floats.data(), expected.data(), floats.size());
+			aKernels.FloatsToHalves(floats.data(), result.data(), floats.size());
+			compareExact("FloatsToHalves", expected, result);
+
+			std::vector<std::uint16_t> halves(Count);
+			for (std::uint16_t& half : halves)
+			{
+				// Every value but NaN, whose payload the hardware conversions keep.
+				do
+				{
+					half = static_cast<std::uint16_t>(std::uniform_int_distribution<int>(0, 0xFFFF)(randomEngine));
+				} while ((half & 0x7C00u) == 0x7C00u && (half & 0x03FFu) != 0);
+			}
+			std::vector<float> expectedFloats(Count);
+			std::vector<float> resultFloats(Count);
+			aScalar.HalvesToFloats(halves.data(), expectedFloats.data(), Count);
+			aKernels.HalvesToFloats(halves.data(), resultFloats.data(), Count);
+			compareExact("HalvesToFloats", expectedFloats, resultFloats);
+
+			const std::vector<float> snormFloats = RandomFloats(Count, -1.5f, 1.5f);
+			std::vector<std::int16_t> expectedSnorms(Count);
+			std::vector<std::int16_t> resultSnorms(Count);
+			aScalar.FloatsToSnorm16(snormFloats.data(), expectedSnorms.data(), Count);
+			aKernels.FloatsToSnorm16(snormFloats.data(), resultSnorms.data(), Count);
+			compareExact("FloatsToSnorm16", expectedSnorms, resultSnorms);
+			expectedSnorms.push_back(-32768);
+			resultSnorms.push_back(-32768);
+			expectedFloats.resize(expectedSnorms.size());
+			resultFloats.resize(expectedSnorms.size());
+			aScalar.Snorm16ToFloats(expectedSnorms.data(), expectedFloats.data(), expectedSnorms.size());
+			aKernels.Snorm16ToFloats(expectedSnorms.data(), resultFloats.data(), expectedSnorms.size());
+			compareExact("Snorm16ToFloats", expectedFloats, resultFloats);
+		}
+
+		{
+			// Groups of four floats with garbage in the padding lane, both hemispheres, the axes and a signed zero.
+			std::vector<float> normals;
+			for (std::size_t index = 0; index < Count; index++)
+			{
+				const Vector3f normal = RandomVector(-1.0f, 1.0f).GetNormalized();
+				normals.insert(normals.end(), { normal.x, normal.y, normal.z, RandomFloat(-5.0f, 5.0f) });
+			}
+			normals.insert(normals.end(), { 0.0f, 0.0f, -1.0f, 0.0f, -0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 7.0f, 0.6f, -0.8f, -0.0f, 0.0f });
+			const std::size_t normalCount = normals.size() / 4;
+			std::vector<std::int16_t> expected(2 * normalCount);
+			std::vector<std::int16_t> result(2 * normalCount);
+			aScalar.NormalsToOctahedral(normals.data(), expected.data(), normalCount);
+			aKernels.NormalsToOctahedral(normals.data(), result.data(), normalCount);
+			compareExact("NormalsToOctahedral", expected, result);
+			bool sameAsScalar = true;
+			for (std::size_t normal = 0; normal < normalCount; normal++)
+			{
+				const OctahedralNormal packed(Vector3f(normals[4 * normal], normals[4 * normal + 1], normals[4 * normal + 2]));
+				sameAsScalar &= packed.u == result[2 * normal] && packed.v == result[2 * normal + 1];
+			}
+			Check(sameAsScalar, aName + " NormalsToOctahedral matches OctahedralNormal");
+			compare("OctahedralToNormals", 4 * normalCount, 1e-6f, [&](const BatchKernels& aTable, float* aResult)
+			{
+				aTable.OctahedralToNormals(expected.data(), aResult, normalCount);
+			});
+		}
+	}
+
+	void CheckPackedFormats()
+	{
+		constexpr std::size_t Count = 101;
+		std::vector<Vector3f> vectors(Count);
+		std::vector<Vector3f> normals(Count);
+		std::vector<Vector4f> vectors4(Count);
+		std::vector<Quaternion> rotations(Count);
+		for (std::size_t index = 0; index < Count; index++)
+		{
+			vectors[index] = RandomVector(-1000.0f, 1000.0f);
+			normals[index] = RandomVector(-1.0f, 1.0f).GetNormalized();
+			vectors4[index] = Vector4f(RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), index % 3 == 0 ? -1.0f : 1.0f);
+			rotations[index] = RandomRotation();
+		}
+
+		// Batch::Pack gives the same bits as the scalar constructors and unpacks to what Unpack gives.
+		std::vector<Vector3h> halves(Count);
+		std::vector<Vector3f> unpacked(Count);
+		Batch::Pack(vectors, halves);
+		Batch::Unpack(halves, unpacked);
+		bool same = true;
+		bool near = true;
+		for (std::size_t index = 0; index < Count; index++)
+		{
+			const Vector3h half(vectors[index]);
+			same &= half.x == halves[index].x && half.y == halves[index].y && half.z == halves[index].z;
+			same &= half.Unpack().x == unpacked[index].x && half.Unpack().y == unpacked[index].y && half.Unpack().z == unpacked[index].z;
+			near &= Near(unpacked[index].x, vectors[index].x, 1.0f / 2048.0f) && Near(unpacked[index].y, vectors[index].y, 1.0f / 2048.0f) && Near(unpacked[index].z, vectors[index].z, 1.0f / 2048.0f);
+		}
+		Check(same, "Vector3h Batch matches scalar");
+		Check(near, "Vector3h round trip");
+
+		std::vector<OctahedralNormal> octahedral(Count);
+		Batch::Pack(normals, octahedral);
+		Batch::Unpack(octahedral, unpacked);
+		same = true;
+		near = true;
+		for (std::size_t index = 0; index < Count; index++)
+		{
+			const OctahedralNormal normal(normals[index]);
+			same &= normal.u == octahedral[index].u && normal.v == octahedral[index].v;
+			// 16 bit octahedral normals are within about 0.005 degrees.
+			near &= (unpacked[index] - normals[index]).Length() < 1e-4f;
+		}
+		Check(same, "OctahedralNormal Batch matches scalar");
+		Check(near, "OctahedralNormal round trip");
+
+		std::vector<PackedVector1010102> packed(Count);
+		std::vector<Vector4f> unpacked4(Count);
+		Batch::Pack(vectors4, packed);
+		Batch::Unpack(packed, unpacked4);
+		same = true;
+		near = true;
+		for (std::size_t index = 0; index < Count; index++)
+		{
+			same &= PackedVector1010102(vectors4[index]).bits == packed[index].bits;
+			near &= std::abs(unpacked4[index].x - vectors4[index].x) <= 0.5f / 511.0f + 1e-6f;
+			near &= std::abs(unpacked4[index].y - vectors4[index].y) <= 0.5f / 511.0f + 1e-6f;
+			near &= std::abs(unpacked4[index].z - vectors4[index].z) <= 0.5f / 511.0f + 1e-6f;
+			near &= unpacked4[index].w == vectors4[index].w;
+		}
+		Check(same, "PackedVector1010102 Batch matches scalar");
+		Check(near, "PackedVector1010102 round trip");
+
+		std::vector<PackedQuaternion> packedRotations(Count);
+		std::vector<Quaternion> unpackedRotations(Count);
+		Batch::Pack(rotations, packedRotations);
+		Batch::Unpack(packedRotations, unpackedRotations);
+		same = true;
+		near = true;
+		for (std::size_t index = 0; index < Count; index++)
+		{
+			const PackedQuaternion rotation(rotations[index]);
+			same &= rotation.r == packedRotations[index].r && rotation.i == packedRotations[index].i && rotation.j == packedRotations[index].j && rotation.k == packedRotations[index].k;
+			near &= RotationDifference(unpackedRotations[index], rotations[index]) < 1e-4f;
+		}
+		Check(same, "PackedQuaternion Batch matches scalar");
+		Check(near, "PackedQuaternion round trip");
+	}
+
+	void CheckMatrixMultiply()
+	{
+		std::vector<Matrix4x4<float>> left(7);
+		std::vector<Matrix4x4<float>> right(7);
+		std::vector<Matrix4x4<float>> expected(7);
+		for (std::size_t index = 0; index < left.size(); index++)
+		{
+			for (int element = 0; element < 16; element++)
+			{
+				left[index].GetData()[element] = RandomFloat(-2.0f, 2.0f);
+				right[index].GetData()[element] = RandomFloat(-2.0f, 2.0f);
+			}
+			expected[index] = left[index] * right[index];
+		}
+
+		auto matches = [&expected](const std::vector<Matrix4x4<float>>& aResult)
+		{
+			for (std::size_t index = 0; index < expected.size(); index++)
+			{
+				for (int element = 0; element < 16; element++)
+				{
+					if (!Near(aResult[index].GetData()[element], expected[index].GetData()[element], 1e-5f))
+					{
+						return false;
+					}
+				}
+			}
+			return true;
+		};
+
+		std::vector<Matrix4x4<float>> result(left);
+		Batch::Multiply(result, right, result);
+		Check(matches(result), "Batch::Multiply aliasing aLeft");
+		result = right;
+		Batch::Multiply(left, result, result);
+		Check(matches(result), "Batch::Multiply aliasing aRight");
+
+		// The SSE2 double product against the sums written out, both add the four products left to right.
+		Matrix4x4<double> leftDouble;
+		Matrix4x4<double> rightDouble;
+		for (int element = 0; element < 16; element++)
+		{
+			leftDouble.GetData()[element] = RandomFloat(-2.0f, 2.0f);
+			rightDouble.GetData()[element] = RandomFloat(-2.0f, 2.0f);
+		}
+		const Matrix4x4<double> product = leftDouble * rightDouble;
+		bool same = true;
+		for (int row = 1; row <= 4; row++)
+		{
+			for (int column = 1; column <= 4; column++)
+			{
+				double sum = leftDouble(row, 1) * rightDouble(1, column);
+				for (int inner = 2; inner <= 4; inner++)
+				{
+					sum += leftDouble(row, inner) * rightDouble(inner, column);
+				}
+				same &= std::abs(product(row, column) - sum) <= 1e-12;
+			}
+		}
+		Check(same, "Matrix4x4<double> multiply");
+	}
+
+	// Quaternion(x, y, z) and GetEuler, and their Batch versions, are inverses, also when looking straight up or down.
+	void CheckEulerAngles()
+	{
+		std::vector<Vector3f> angles;
+		for (int index = 0; index < 200; index++)
+		{
+			angles.emplace_back(RandomFloat(-89.0f, 89.0f), RandomFloat(-180.0f, 180.0f), RandomFloat(-180.0f, 180.0f));
+		}
+		for (float pitch : { -90.0f, 90.0f })
+		{
+			angles.emplace_back(pitch, 30.0f, 40.0f);
+			for (int index = 0; index < 20; index++)
+			{
+				angles.emplace_back(pitch, RandomFloat(-180.0f, 180.0f), RandomFloat(-180.0f, 180.0f));
+			}
+		}
+
+		float difference = 0.0f;
+		bool rollZeroAtPoles = true;
+		for (const Vector3f& angle : angles)
+		{
+			const Quaternion rotation(angle.x, angle.y, angle.z);
+			const Vector3f euler = rotation.GetEuler();
+			difference = std::max(difference, RotationDifference(Quaternion(euler.x, euler.y, euler.z), rotation));
+			if (std::abs(angle.x) == 90.0f)
+			{
+				rollZeroAtPoles &= euler.z == 0.0f && Near(euler.x, angle.x, 1e-5f);
+			}
+		}
+		Check(difference < 1e-5f, "Quaternion::GetEuler round trip");
+		Check(rollZeroAtPoles, "Quaternion::GetEuler at +-90 pitch");
+
+		// The batch versions use the Fast polynomials.
+		Vector3Stream<float> eulerAngles(std::span<const Vector3f>(angles.data(), angles.size()));
+		QuaternionStream rotations(angles.size());
+		Vector3Stream<float> result(angles.size());
+		Batch::ToQuaternions(eulerAngles, rotations);
+		Batch::ToEulerAngles(rotations, result);
+		difference = 0.0f;
+		for (std::size_t index = 0; index < angles.size(); index++)
+		{
+			const Vector3f euler = result.Get(index);
+			difference = std::max(difference, RotationDifference(Quaternion(euler.x, euler.y, euler.z), Quaternion(angles[index].x, angles[index].y, angles[index].z)));
+		}
+		Check(difference < 1e-4f, "Batch::ToEulerAngles round trip");
+	}
+
+	void CheckAABB2D()
+	{
+		// Closed boxes, touching borders count.
+		AABB2D<float> box(Vector2<float>(-1.0f, -2.0f), Vector2<float>(3.0f, 4.0f));
+		Check(box.IsInside(Vector2<float>(3.0f, 4.0f)) && box.IsInside(Vector2<float>(0.0f, 0.0f)) && !box.IsInside(Vector2<float>(3.5f, 0.0f)), "AABB2D IsInside");
+		Check(box.Contains(AABB2D<float>(Vector2<float>(-1.0f, 0.0f), Vector2<float>(3.0f, 1.0f))) && !box.Contains(AABB2D<float>(Vector2<float>(-1.0f, 0.0f), Vector2<float>(3.5f, 1.0f))), "AABB2D Contains");
+		Check(box.Overlaps(AABB2D<float>(Vector2<float>(3.0f, 4.0f), Vector2<float>(5.0f, 5.0f))) && !box.Overlaps(AABB2D<float>(Vector2<float>(3.1f, 0.0f), Vector2<float>(5.0f, 1.0f))), "AABB2D Overlaps");
+
+		box.Merge(AABB2D<float>(Vector2<float>(-4.0f, 1.0f), Vector2<float>(0.0f, 6.0f)));
+		box.Merge(Vector2<float>(5.0f, -3.0f));
+		Check(box.Min() == Vector2<float>(-4.0f, -3.0f) && box.Max() == Vector2<float>(5.0f, 6.0f), "AABB2D Merge");
+		box.Expand(-1.0f);
+		Check(box.Min() == Vector2<float>(-3.0f, -2.0f) && box.Max() == Vector2<float>(4.0f, 5.0f), "AABB2D Expand");
+
+		// Batch::Overlaps against the member, with boxes touching the query on every side.
+		const AABB2D<float> query(Vector2<float>(-5.0f, -5.0f), Vector2<float>(5.0f, 5.0f));
+		std::vector<AABB2D<float>> boxes;
+		for (int index = 0; index < 203; index++)
+		{
+			const Vector2<float> min(RandomFloat(-12.0f, 8.0f), RandomFloat(-12.0f, 8.0f));
+			boxes.emplace_back(min, min + Vector2<float>(RandomFloat(0.0f, 4.0f), RandomFloat(0.0f, 4.0f)));
+		}
+		boxes.emplace_back(Vector2<float>(5.0f, 0.0f), Vector2<float>(6.0f, 1.0f));
+		boxes.emplace_back(Vector2<float>(-6.0f, -6.0f), Vector2<float>(-5.0f, -5.0f));
+		std::vector<std::uint32_t> expected;
+		for (std::uint32_t index = 0; index < boxes.size(); index++)
+		{
+			if (query.Overlaps(boxes[index]))
+			{
+				expected.push_back(index);
+			}
+		}
+		std::vector<std::uint32_t> result(boxes.size());
+		result.resize(Batch::Overlaps(query, boxes, result));
+		Check(result == expected, "Batch::Overlaps AABB2D");
+	}
+
+	void CheckBroadphase()
+	{
+		std::vector<AABB2D<float>> boxes;
+		for (int index = 0; index < 1500; index++)
+		{
+			const Vector2<float> min(RandomFloat(-200.0f, 200.0f), RandomFloat(-200.0f, 200.0f));
+			boxes.emplace_back(min, min + Vector2<float>(RandomFloat(0.5f, 12.0f), RandomFloat(0.5f, 12.0f)));
+		}
+		std::vector<Broadphase2D::Pair> expected;
+		for (std::uint32_t first = 0; first < boxes.size(); first++)
+		{
+			for (std::uint32_t second = first + 1; second < boxes.size(); second++)
+			{
+				if (boxes[first].Overlaps(boxes[second]))
+				{
+					expected.emplace_back(first, second);
+				}
+			}
+		}
+
+		Broadphase2D broadphase(8.0f);
+		std::vector<Broadphase2D::Pair> pairs;
+		broadphase.FindPairs(boxes, pairs);
+		std::sort(pairs.begin(), pairs.end());
+		Check(pairs == expected, "Broadphase2D FindPairs");
+	}
+
+	void CheckBoundingVolumeHierarchy()
+	{
+		std::vector<AABB3D<float>> boxes;
+		for (int index = 0; index < 3000; index++)
+		{
+			boxes.push_back(RandomBox(100.0f, 5.0f));
+		}
+		BoundingVolumeHierarchy tree;
+		BoundingVolumeHierarchy parallelTree;
+		tree.Build(boxes);
+		parallelTree.Build(boxes, {}, Batch::Execution::Parallel);
+		Check(tree.Size() == boxes.size(), "BoundingVolumeHierarchy size");
+
+		std::vector<std::uint32_t> result;
+		std::vector<std::uint32_t> expected;
+		auto checkQuery = [&](const std::string& aName, const auto& aTest)
+		{
+			expected.clear();
+			for (std::uint32_t index = 0; index < boxes.size(); index++)
+			{
+				if (aTest(boxes[index]))
+				{
+					expected.push_back(index);
+				}
+			}
+			std::sort(result.begin(), result.end());
+			Check(result == expected, "BoundingVolumeHierarchy " + aName);
+		};
+
+		for (int query = 0; query < 50; query++)
+		{
+			const AABB3D<float> box = RandomBox(100.0f, 20.0f);
+			tree.QueryOverlap(box, result);
+			checkQuery("QueryOverlap box", [&box](const AABB3D<float>& aBox) { return aBox.Overlaps(box); });
+			parallelTree.QueryOverlap(box, result);
+			checkQuery("parallel build", [&box](const AABB3D<float>& aBox) { return aBox.Overlaps(box); });
+
+			const Sphere<float> sphere(RandomVector(-100.0f, 100.0f), RandomFloat(1.0f, 20.0f));
+			tree.QueryOverlap(sphere, result);
+			checkQuery("QueryOverlap sphere", [&sphere](const AABB3D<float>& aBox)
+			{
+				const Vector3f& center = sphere.Position();
+				const Vector3f closest(
+					std::clamp(center.x, aBox.Min().x, aBox.Max().x),
+					std::clamp(center.y, aBox.Min().y, aBox.Max().y),
+					std::clamp(center.z, aBox.Min().z, aBox.Max().z));
+				return (center - closest).LengthSqr() <= sphere.Radius() * sphere.Radius();
+			});
+
+			// Half of the points are inside some box, random points in this much space rarely are.
+			const Vector3f point = query % 2 == 0 ? RandomVector(-100.0f, 100.0f) : (boxes[query].Min() + boxes[query].Max()) * 0.5f;
+			tree.QueryPoint(point, result);
+			checkQuery("QueryPoint", [&point](const AABB3D<float>& aBox) { return aBox.Contains(AABB3D<float>(point, point)); });
+
+			const Ray<float> ray(RandomVector(-150.0f, 150.0f), RandomVector(-50.0f, 50.0f));
+			tree.QueryRay(ray, result);
+			checkQuery("QueryRay", [&ray](const AABB3D<float>& aBox) { return ray.Intersects(aBox); });
+
+			float closest = std::numeric_limits<float>::infinity();
+			for (const AABB3D<float>& candidate : boxes)
+			{
+				float entry;
+				if (ray.Intersects(candidate, entry) && entry < closest)
+				{
+					closest = entry;
+				}
+			}
+			std::uint32_t payload = 0;
+			float distance = 0.0f;
+			const bool hit = tree.Raycast(ray, payload, distance);
+			Check(hit == (closest != std::numeric_limits<float>::infinity()) && (!hit || distance == closest), "BoundingVolumeHierarchy Raycast");
+		}
+	}
+
+	// Boxes reaching to infinity, or holding NaN, must keep the build in bounds and leave the finite boxes findable.
+	void CheckBoundingVolumeHierarchyNonFinite()
+	{
+		const float infinity = std::numeric_limits<float>::infinity();
+		std::vector<AABB3D<float>> boxes;
+		for (int index = 0; index < 500; index++)
+		{
+			boxes.push_back(RandomBox(100.0f, 5.0f));
+		}
+		boxes[17] = AABB3D<float>(Vector3f(-infinity, -infinity, -infinity), Vector3f(infinity, infinity, infinity));
+		boxes[230] = AABB3D<float>(Vector3f(0.0f, 0.0f, 0.0f), Vector3f(infinity, 1.0f, 1.0f));
+		boxes[401] = AABB3D<float>(Vector3f(std::numeric_limits<float>::quiet_NaN(), 0.0f, 0.0f), Vector3f(1.0f, 1.0f, 1.0f));
+
+		BoundingVolumeHierarchy tree;
+		tree.Build(boxes);
+		Check(tree.Size() == boxes.size(), "BoundingVolumeHierarchy non-finite size");
+
+		std::vector<std::uint32_t> result;
+		bool found = true;
+		for (std::uint32_t index = 0; index < boxes.size(); index++)
+		{
+			// The infinite box and the NaN box have no center to look for.
+			const Vector3f center = (boxes[index].Min() + boxes[index].Max()) * 0.5f;
+			if (std::isnan(center.x))
+			{
+				continue;
+			}
+			tree.QueryPoint(center, result);
+			found &= std::find(result.begin(), result.end(), index) != result.end();
+			found &= std::find(result.begin(), result.end(), 17u) != result.end();
+		}
+		tree.QueryPoint(Vector3f(1000.0f, 0.5f, 0.5f), result);
+		found &= std::find(result.begin(), result.end(), 230u) != result.end();
+		Check(found, "BoundingVolumeHierarchy non-finite QueryPoint");
+	}
+
+	template<std::size_t N>
+	void CheckRayPacket(const BoundingVolumeHierarchy& aTree, const std::vector<AABB3D<float>>& aBoxes, const std::string& aName)
+	{
+		// Rays leaving one point, with axis parallel directions and starting inside a box mixed in.
+		RayPacket<N> packet;
+		std::vector<Ray<float>> rays(N);
+		for (std::size_t lane = 0; lane < N; lane++)
+		{
+			if (lane % 4 == 1)
+			{
+				const Vector3f directions[3] = { Vector3f(1.0f, 0.0f, 0.0f), Vector3f(0.0f, -1.0f, 0.0f), Vector3f(0.0f, 0.0f, 1.0f) };
+				rays[lane].InitWithOriginAndDirection(Vector3f(1.0f, -2.0f, 3.0f), directions[lane % 3]);
+			}
+			else if (lane % 4 == 3)
+			{
+				rays[lane].InitWith2Points((aBoxes[lane].Min() + aBoxes[lane].Max()) * 0.5f, RandomVector(-60.0f, 60.0f));
+			}
+			else
+			{
+				rays[lane].InitWith2Points(Vector3f(0.0f, 0.0f, -150.0f), RandomVector(-60.0f, 60.0f));
+			}
+			packet.Set(lane, rays[lane]);
+		}
+
+		// One box against every lane, the mask and entries as Ray::Intersects gives them.
+		bool same = true;
+		float maxDistances[N];
+		float entries[N];
+		for (std::size_t lane = 0; lane < N; lane++)
+		{
+			maxDistances[lane] = lane % 2 == 0 ? 120.0f : std::numeric_limits<float>::infinity();
+		}
+		for (const AABB3D<float>& box : aBoxes)
+		{
+			const std::uint32_t mask = packet.Intersect(box, std::span<const float, N>(maxDistances), std::span<float, N>(entries));
+			for (std::size_t lane = 0; lane < N; lane++)
+			{
+				float entry = 0.0f;
+				const bool hit = rays[lane].Intersects(box, entry, maxDistances[lane]);
+				same &= hit == (((mask >> lane) & 1) != 0) && (!hit || entry == entries[lane]);
+			}
+		}
+		Check(same, aName + " Intersect");
+
+		// The packet traversal against casting every ray on its own.
+		std::uint32_t payloads[N];
+		float distances[N];
+		const std::uint32_t mask = aTree.Raycast(packet, std::span<std::uint32_t, N>(payloads), std::span<float, N>(distances));
+		same = true;
+		for (std::size_t lane = 0; lane < N; lane++)
+		{
+			std::uint32_t payload = 0;
+			float distance = 0.0f;
+			const bool hit = aTree.Raycast(rays[lane], payload, distance);
+			same &= hit == (((mask >> lane) & 1) != 0) && (!hit || distance == distances[lane]);
+		}
+		Check(same, aName + " BoundingVolumeHierarchy Raycast");
+	}
+
+	void CheckRayPackets()
+	{
+		std::vector<AABB3D<float>> boxes;
+		for (int index = 0; index < 2000; index++)
+		{
+			boxes.push_back(RandomBox(80.0f, 5.0f));
+		}
+		BoundingVolumeHierarchy tree;
+		tree.Build(boxes);
+		for (int repeat = 0; repeat < 10; repeat++)
+		{
+			CheckRayPacket<4>(tree, boxes, "RayPacket4");
+			CheckRayPacket<8>(tree, boxes, "RayPacket8");
+		}
+	}
+
+	void CheckFrustumCuller()
+	{
+		const Matrix4x4<float> viewProjection = Matrix4x4<float>::CreateLookAt({ 3, 2, -20 }, { 0, 0, 0 }, { 0, 1, 0 }) * Matrix4x4<float>::CreatePerspective(1.0f, 1.5f, 0.5f, 60.0f);
+		const PlaneVolume<float> volume = PlaneVolume<float>::CreateFrustum(viewProjection);
+		const FrustumCuller culler(volume);
+
+		std::vector<AABB3D<float>> boxes;
+		std::vector<Sphere<float>> spheres;
+		boxes.reserve(5000);
+		spheres.reserve(5000);
+		for (int index = 0; index < 5000; index++)
+		{
+			boxes.push_back(RandomBox(80.0f, 4.0f));
+			spheres.emplace_back(RandomVector(-80.0f, 80.0f), RandomFloat(0.1f, 4.0f));
+		}
+
+		std::vector<std::uint32_t> expectedBoxes;
+		std::vector<std::uint32_t> expectedSpheres;
+		for (std::uint32_t index = 0; index < boxes.size(); index++)
+		{
+			bool boxOutside = false;
+			bool sphereOutside = false;
+			for (const Plane<float>& plane : volume.GetPlanes())
+			{
+				const Vector3f& normal = plane.Normal();
+				const AABB3D<float>& box = boxes[index];
+				const Vector3f corner(normal.x < 0.0f ? box.Max().x : box.Min().x, normal.y < 0.0f ? box.Max().y : box.Min().y, normal.z < 0.0f ? box.Max().z : box.Min().z);
+				boxOutside |= plane.SignedDistance(corner) > 0.0f;
+				sphereOutside |= plane.SignedDistance(spheres[index].Position()) > spheres[index].Radius();
+			}
+			if (!boxOutside)
+			{
+				expectedBoxes.push_back(index);
+			}
+			if (!sphereOutside)
+			{
+				expectedSpheres.push_back(index);
+			}
+		}
+
+		std::vector<std::uint32_t> visible;
+		for (Batch::Execution execution : { Batch::Execution::Sequential, Batch::Execution::Parallel })
+		{
+			culler.Cull(boxes, visible, execution);
+			Check(visible == expectedBoxes, "FrustumCuller boxes");
+			culler.Cull(spheres, visible, execution);
+			Check(visible == expectedSpheres, "FrustumCuller spheres");
+		}
+	}
+
+	// Row vector matrices, points go through aMatrix as Vector4(point, 1) * aMatrix.
+	Vector3f TransformPoint(const Vector3f& aPoint, const Matrix4x4<float>& aMatrix)
+	{
+		const Vector4f point = Vector4f(aPoint.x, aPoint.y, aPoint.z, 1.0f) * aMatrix;
+		return Vector3f(point.x, point.y, point.z) * (1.0f / point.w);
+	}
+
+	void CheckPlaneSet()
+	{
+		PlaneVolume<float> volume;
+		for (int index = 0; index < 9; index++)
+		{
+			volume.AddPlane(Plane<float>(RandomVector(-10.0f, 10.0f), RandomVector(-1.0f, 1.0f).GetNormalized()));
+		}
+		PlaneSet<float> planes(volume);
+		bool same = planes.Size() == volume.GetPlanes().Size();
+		for (int index = 0; index < 200; index++)
+		{
+			const Vector3f point = RandomVector(-20.0f, 20.0f);
+			same &= planes.Inside(point) == volume.Inside(point);
+		}
+		Check(same, "PlaneSet Inside");
+
+		// A rigid transform keeps distances, a scaled one only which side points are on.
+		Matrix4x4<float> rigid = Matrix4x4<float>::CreateRotationAroundX(0.7f) * Matrix4x4<float>::CreateRotationAroundY(-1.9f);
+		rigid(4, 1) = 3.0f;
+		rigid(4, 2) = -7.0f;
+		rigid(4, 3) = 11.0f;
+		Matrix4x4<float> scaled = rigid;
+		for (int column = 1; column <= 3; column++)
+		{
+			scaled(1, column) *= 2.0f;
+			scaled(3, column) *= 0.25f;
+		}
+		for (const Matrix4x4<float>* matrix : { &rigid, &scaled })
+		{
+			PlaneSet<float> transformed(volume);
+			Check(transformed.Transform(*matrix), "PlaneSet Transform");
+			const PlaneVolume<float> transformedVolume = volume * *matrix;
+			bool distances = true;
+			bool sides = true;
+			for (std::size_t plane = 0; plane < volume.GetPlanes().Size(); plane++)
+			{
+				for (int index = 0; index < 50; index++)
+				{
+					const Vector3f point = RandomVector(-20.0f, 20.0f);
+					const Vector3f moved = TransformPoint(point, *matrix);
+					const float distance = volume.GetPlanes()[plane].SignedDistance(point);
+					const float movedDistance = transformed.Get(plane).SignedDistance(moved);
+					distances &= matrix != &rigid || Near(movedDistance, distance, 1e-4f);
+					sides &= std::abs(distance) < 1e-3f || (distance > 0.0f) == (movedDistance > 0.0f);
+					sides &= Near(transformedVolume.GetPlanes()[plane].SignedDistance(moved), movedDistance, 1e-4f);
+				}
+			}
+			Check(distances, "PlaneSet Transform rigid distances");
+			Check(sides, "PlaneSet Transform sides");
+		}
+
+		Matrix4x4<float> singular = rigid;
+		for (int column = 1; column <= 4; column++)
+		{
+			singular(2, column) = 0.0f;
+		}
+		PlaneSet<float> untouched(volume);
+		Check(!untouched.Transform(singular) && untouched.Get(3).Normal() == planes.Get(3).Normal() && untouched.Get(3).Distance() == planes.Get(3).Distance(), "PlaneSet Transform singular");
+	}
+
+	template<typename Vector>
+	bool VectorNear(const Vector& aValue, const Vector& aExpected, float aTolerance)
+	{
+		const Vector difference = aValue - aExpected;
+		return difference.Length() <= aTolerance * std::max(1.0f, static_cast<float>(aExpected.Length()));
+	}
+
+	// The SSE specializations against the generic template computed in double.
+	void CheckVectors()
+	{
+		const auto toDouble3 = [](const Vector3f& aVector) { return Vector3<double>(aVector.x, aVector.y, aVector.z); };
+		const auto toFloat3 = [](const Vector3<double>& aVector) { return Vector3f(static_cast<float>(aVector.x), static_cast<float>(aVector.y), static_cast<float>(aVector.z)); };
+		const auto toDouble4 = [](const Vector4f& aVector) { return Vector4<double>(aVector.x, aVector.y, aVector.z, aVector.w); };
+		const auto toFloat4 = [](const Vector4<double>& aVector) { return Vector4f(static_cast<float>(aVector.x), static_cast<float>(aVector.y), static_cast<float>(aVector.z), static_cast<float>(aVector.w)); };
+
+		bool vector3 = true;
+		bool vector4 = true;
+		for (int index = 0; index < 200; index++)
+		{
+			const Vector3f a = RandomVector(-100.0f, 100.0f);
+			const Vector3f b = RandomVector(-100.0f, 100.0f);
+			const Vector3<double> da = toDouble3(a);
+			const Vector3<double> db = toDouble3(b);
+			const float scalar = RandomFloat(0.5f, 4.0f);
+			const float delta = RandomFloat(0.0f, 1.0f);
+
+			vector3 &= VectorNear(a + b, toFloat3(da + db), 1e-6f);
+			vector3 &= VectorNear(a - b, toFloat3(da - db), 1e-6f);
+			vector3 &= VectorNear(a * scalar, toFloat3(da * static_cast<double>(scalar)), 1e-6f);
+			vector3 &= VectorNear(scalar * a, toFloat3(da * static_cast<double>(scalar)), 1e-6f);
+			vector3 &= VectorNear(a / scalar, toFloat3(da / static_cast<double>(scalar)), 1e-6f);
+			vector3 &= VectorNear(Vector3f(a).operator-(), toFloat3(-Vector3<double>(da)), 0.0f);
+			vector3 &= VectorNear(a.Cross(b), toFloat3(da.Cross(db)), 1e-5f);
+			vector3 &= VectorNear(Vector3f::Lerp(a, b, delta), toFloat3(Vector3<double>::Lerp(da, db, delta)), 1e-5f);
+			vector3 &= Near(a.Dot(b), static_cast<float>(da.Dot(db)), 1e-4f);
+			vector3 &= Near(a.LengthSqr(), static_cast<float>(da.LengthSqr()), 1e-6f);
+			vector3 &= Near(a.Length(), static_cast<float>(da.Length()), 1e-6f);
+			vector3 &= Near(a.Distance(b), static_cast<float>(da.Distance(db)), 1e-6f);
+			vector3 &= Near(a.DistanceSqr(b), static_cast<float>(da.DistanceSqr(db)), 1e-6f);
+			vector3 &= VectorNear(a.GetNormalized(), toFloat3(da.GetNormalized()), 1e-6f);
+
+			Vector3f compound = a;
+			compound += b;
+			compound -= a * 0.5f;
+			compound *= scalar;
+			compound /= 2.0f;
+			Vector3<double> expected = da;
+			expected += db;
+			expected -= da * 0.5;
+			expected *= static_cast<double>(scalar);
+			expected /= 2.0;
+			vector3 &= VectorNear(compound, toFloat3(expected), 1e-5f);
+
+			Vector3f normalized = a;
+			normalized.Normalize();
+			vector3 &= Near(normalized.Length(), 1.0f, 1e-6f);
+			Vector3f truncated = a;
+			truncated.Truncate(20.0f);
+			vector3 &= Near(truncated.Length(), std::min(a.Length(), 20.0f), 1e-5f);
+			vector3 &= VectorNear(truncated.GetNormalized(), normalized, 1e-5f);
+
+			const Vector4f c(a, RandomFloat(-100.0f, 100.0f));
+			const Vector4f d(b, RandomFloat(-100.0f, 100.0f));
+			const Vector4<double> dc = toDouble4(c);
+			const Vector4<double> dd = toDouble4(d);
+
+			vector4 &= VectorNear(c + d, toFloat4(dc + dd), 1e-6f);
+			vector4 &= VectorNear(c - d, toFloat4(dc - dd), 1e-6f);
+			vector4 &= VectorNear(c * scalar, toFloat4(dc * static_cast<double>(scalar)), 1e-6f);
+			vector4 &= VectorNear(scalar * c, toFloat4(dc * static_cast<double>(scalar)), 1e-6f);
+			vector4 &= VectorNear(c / scalar, toFloat4(dc / static_cast<double>(scalar)), 1e-6f);
+			vector4 &= VectorNear(-Vector4f(c), toFloat4(-Vector4<double>(dc)), 0.0f);
+			vector4 &= VectorNear(Vector4f::Lerp(c, d, delta), toFloat4(Vector4<double>::Lerp(dc, dd, delta)), 1e-5f);
+			vector4 &= Near(c.Dot(d), static_cast<float>(dc.Dot(dd)), 1e-4f);
+			vector4 &= Near(c.LengthSqr(), static_cast<float>(dc.LengthSqr()), 1e-6f);
+			vector4 &= Near(c.Length(), static_cast<float>(dc.Length()), 1e-6f);
+			vector4 &= Near(c.Distance(d), static_cast<float>(dc.Distance(dd)), 1e-6f);
+			vector4 &= Near(c.DistanceSqr(d), static_cast<float>(dc.DistanceSqr(dd)), 1e-6f);
+			vector4 &= VectorNear(c.GetNormalized(), toFloat4(dc.GetNormalized()), 1e-6f);
+
+			Vector4f compound4 = c;
+			compound4 += d;
+			compound4 -= c * 0.5f;
+			compound4 *= scalar;
+			compound4 /= 2.0f;
+			Vector4<double> expected4 = dc;
+			expected4 += dd;
+			expected4 -= dc * 0.5;
+			expected4 *= static_cast<double>(scalar);
+			expected4 /= 2.0;
+			vector4 &= VectorNear(compound4, toFloat4(expected4), 1e-5f);
+
+			Vector4f truncated4 = c;
+			truncated4.Truncate(20.0f);
+			vector4 &= Near(truncated4.Length(), std::min(c.Length(), 20.0f), 1e-5f);
+		}
+		Check(vector3, "Vector3<float> against Vector3<double>");
+		Check(vector4, "Vector4<float> against Vector4<double>");
+
+#ifdef STM_SIMD_SSE
+		// The padding lane must not leak into the three component results.
+		Vector3f padded(1.0f, 2.0f, 2.0f);
+		padded.m_Padding = 1000.0f;
+		Check(padded.Length() == 3.0f && padded.Dot(padded) == 9.0f && padded.Distance(Vector3f()) == 3.0f, "Vector3<float> ignores padding");
+		Check(sizeof(Vector3f) == 16 && alignof(Vector3f) == 16 && sizeof(Vector4f) == 16 && alignof(Vector4f) == 16, "SIMD vector layout");
+#endif
+	}
+
+	// Small integers and halves keep every product exact, so the compile time and run time paths must agree bit for bit.
+	constexpr Vector3f constantA(1.0f, 2.0f, 3.0f);
+	constexpr Vector3f constantB(-2.0f, 0.5f, 4.0f);
+	constexpr Vector4f constantC(1.0f, -2.0f, 0.5f, 3.0f);
+	constexpr Vector4f constantD(4.0f, 1.0f, -1.0f, 2.0f);
+	constexpr Matrix4x4<float> constantM(
+		1.0f, 2.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f, 0.0f,
+		0.5f, 0.0f, 2.0f, 0.0f,
+		3.0f, -1.0f, 4.0f, 1.0f);
+	constexpr Matrix4x4<float> constantN(
+		0.0f, 1.0f, 0.0f, 0.0f,
+		-1.0f, 0.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 1.0f, 0.0f,
+		2.0f, 5.0f, -3.0f, 1.0f);
+	constexpr Quaternion constantQ(0.5f, 0.5f, -0.5f, 0.5f);
+	constexpr Quaternion constantR(0.0f, 0.0f, 0.0f, 1.0f);
+
+	static_assert(constantA + constantB == Vector3f(-1.0f, 2.5f, 7.0f));
+	static_assert(constantA.Cross(constantB) == Vector3f(6.5f, -10.0f, 4.5f));
+	static_assert(constantA.Dot(constantB) == 11.0f && constantA.LengthSqr() == 14.0f && constantA.DistanceSqr(constantB) == 12.25f);
+	static_assert(Vector3f::Lerp(constantA, constantB, 0.5f) == Vector3f(-0.5f, 1.25f, 3.5f));
+	static_assert(constantC * 2.0f - constantD == Vector4f(-2.0f, -5.0f, 2.0f, 4.0f));
+	static_assert(constantC.Dot(constantD) == 7.5f && constantC.LengthSqr() == 14.25f);
+	static_assert(Vector2f(1.0f, 2.0f).Dot(Vector2f(3.0f, -1.0f)) == 1.0f);
+	static_assert(Vector4f(constantA, 1.0f) * Matrix4x4<float>::GetIdentity() == Vector4f(1.0f, 2.0f, 3.0f, 1.0f));
+	static_assert(Matrix4x4<float>::Transpose(Matrix4x4<float>::Transpose(constantM)) == constantM);
+	static_assert(Matrix4x4<float>::GetDeterminant(constantM) == 2.0f);
+	static_assert(constantN * Matrix4x4<float>::GetFastInverse(constantN) == Matrix4x4<float>::GetIdentity());
+	static_assert([]
+	{
+		Matrix4x4<float> inverse;
+		return Matrix4x4<float>::GetInverse(constantM, inverse) && constantM * inverse == Matrix4x4<float>::GetIdentity();
+	}());
+	static_assert(constantR.Rotate(constantA) == Vector3f(-1.0f, -2.0f, 3.0f));
+	static_assert((constantQ * constantR).r == -0.5f && (constantQ * constantR).k == 0.5f);
+	static_assert(Math::Clamp(5.0f, 0.0f, 1.0f) == 1.0f && Math::Clamp01(-2.0) == 0.0 && Math::Lerp(2.0f, 4.0f, 0.25f) == 2.5f);
+	static_assert(Math::DegreeToRad(180.0f) == Math::PI && Math::Sign(-3.0f) == -1.0f && Math::Remap(5.0f, 0.0f, 10.0f, 2.0f, 4.0f) == 3.0f);
+
+	// The same operations at run time, where the SSE specializations take their SIMD path.
+	void CheckConstexpr()
+	{
+		Vector3f a = constantA;
+		Vector3f b = constantB;
+		Vector4f c = constantC;
+		Vector4f d = constantD;
+		Matrix4x4<float> m = constantM;
+		Matrix4x4<float> n = constantN;
+		Check(a + b == constantA + constantB && a.Cross(b) == constantA.Cross(constantB), "constexpr Vector3f matches run time");
+		Check(a.Dot(b) == constantA.Dot(constantB) && Vector3f::Lerp(a, b, 0.5f) == Vector3f::Lerp(constantA, constantB, 0.5f), "constexpr Vector3f Dot and Lerp match run time");
+		Check(c * 2.0f - d == constantC * 2.0f - constantD && c.Dot(d) == constantC.Dot(constantD), "constexpr Vector4f matches run time");
+
+		constexpr Matrix4x4<float> constantProduct = constantM * constantN;
+		constexpr Vector4f constantTransformed = constantC * constantM;
+		Check(m * n == constantProduct && c * m == constantTransformed, "constexpr Matrix4x4 products match run time");
+		Matrix4x4<float> inverse;
+		constexpr Matrix4x4<float> constantInverse = []
+		{
+			Matrix4x4<float> result;
+			Matrix4x4<float>::GetInverse(constantM, result);
+			return result;
+		}();
+		Check(Matrix4x4<float>::GetInverse(m, inverse) && inverse == constantInverse, "constexpr Matrix4x4 GetInverse matches run time");
+
+		Quaternion q = constantQ;
+		constexpr Vector3f constantRotated = constantQ.Rotate(constantA);
+		const Vector3f rotated = q.Rotate(a);
+		Check(rotated == constantRotated, "constexpr Quaternion Rotate matches run time");
+	}
+
+	// Relative error bound of every Precision tier, see Precision.hpp, plus a few roundings around the estimate.
+	float PrecisionTolerance(Precision aPrecision)
+	{
+		return aPrecision == Precision::Exact ? 3e-7f : aPrecision == Precision::Fast ? 6e-7f : 3.8e-4f;
+	}
+
+	template<Precision P>
+	bool CheckPrecisionTier()
+	{
+		const float tolerance = PrecisionTolerance(P);
+		bool result = true;
+		std::vector<Vector3f> vectors;
+		for (int index = 0; index < 300; index++)
+		{
+			// Spread over many binades, the estimate's error depends on the mantissa and the exponent parity.
+			const Vector3f vector = RandomVector(-1.0f, 1.0f) * std::ldexp(1.0f, index % 40 - 20);
+			vectors.push_back(vector);
+			const double length = std::sqrt(static_cast<double>(vector.x) * vector.x + static_cast<double>(vector.y) * vector.y + static_cast<double>(vector.z) * vector.z);
+			result &= std::abs(vector.Length<P>() - length) <= tolerance * length;
+
+			const Vector3f normalized = vector.GetNormalized<P>();
+			Vector3f inPlace = vector;
+			inPlace.Normalize<P>();
+			result &= normalized == inPlace;
+			result &= std::abs(normalized.x - vector.x / length) <= tolerance && std::abs(normalized.y - vector.y / length) <= tolerance && std::abs(normalized.z - vector.z / length) <= tolerance;
+
+			const Vector4f vector4(vector, RandomFloat(-1.0f, 1.0f) * std::ldexp(1.0f, index % 40 - 20));
+			const double length4 = std::sqrt(length * length + static_cast<double>(vector4.w) * vector4.w);
+			result &= std::abs(vector4.Length<P>() - length4) <= tolerance * length4;
+			const Vector4f normalized4 = vector4.GetNormalized<P>();
+			result &= std::abs(normalized4.w - vector4.w / length4) <= tolerance && std::abs(normalized4.x - vector4.x / length4) <= tolerance;
+
+			Quaternion quaternion(vector4.w, vector.x, vector.y, vector.z);
+			quaternion.Normalize<P>();
+			result &= std::abs(quaternion.r - vector4.w / length4) <= tolerance && std::abs(quaternion.k - vector4.z / length4) <= tolerance;
+		}
+
+		// The batched paths through whatever kernel table was dispatched.
+		Vector3Stream<float> stream(std::span<const Vector3f>(vectors.data(), vectors.size()));
+		std::vector<float> lengths(vectors.size());
+		stream.Length<P>(lengths);
+		stream.Normalize<P>();
+		for (std::size_t index = 0; index < vectors.size(); index++)
+		{
+			const float length = vectors[index].Length();
+			const Vector3f normalized = stream.Get(index);
+			result &= std::abs(lengths[index] - length) <= tolerance * length;
+			result &= (normalized - vectors[index] / length).Length() <= 2.0f * tolerance;
+		}
+		return result;
+	}
+
+	void CheckPrecision()
+	{
+		Check(CheckPrecisionTier<Precision::Exact>(), "Precision::Exact error bound");
+		Check(CheckPrecisionTier<Precision::Fast>(), "Precision::Fast error bound");
+		Check(CheckPrecisionTier<Precision::Fastest>(), "Precision::Fastest error bound");
+	}
+
+	// Lazy expressions against the same arithmetic written out per component.
+	void CheckVectorExpressions()
+	{
+		bool same = true;
+		for (int index = 0; index < 100; index++)
+		{
+			const Vector3f a = RandomVector(-10.0f, 10.0f);
+			const Vector3f b = RandomVector(-10.0f, 10.0f);
+			const Vector3f c = RandomVector(-10.0f, 10.0f);
+			const float length = RandomFloat(0.5f, 4.0f);
+
+			const Vector3f result = Expression::Lazy(a) * 2.0f + b - c / length;
+			const auto evaluated = (-Expression::Lazy(a) + 0.5 * Expression::Lazy(b)).Evaluate();
+			same &= Near(result.x, a.x * 2.0f + b.x - c.x / length, 1e-6f);
+			same &= Near(result.y, a.y * 2.0f + b.y - c.y / length, 1e-6f);
+			same &= Near(result.z, a.z * 2.0f + b.z - c.z / length, 1e-6f);
+			same &= std::is_same_v<std::remove_const_t<decltype(evaluated)>, Vector3f>;
+			same &= Near(evaluated.x, -a.x + 0.5f * b.x, 1e-6f) && Near(evaluated.y, -a.y + 0.5f * b.y, 1e-6f) && Near(evaluated.z, -a.z + 0.5f * b.z, 1e-6f);
+
+			// Assigning into an operand only ever reads the component being written.
+			Vector3f aliased = a;
+			Expression::Assign(aliased, Expression::Lazy(aliased) * 3.0f - aliased);
+			same &= Near(aliased.x, a.x * 3.0f - a.x, 1e-6f) && Near(aliased.y, a.y * 3.0f - a.y, 1e-6f) && Near(aliased.z, a.z * 3.0f - a.z, 1e-6f);
+
+			const Vector2f a2(a.x, a.y);
+			const Vector2f result2 = Expression::Lazy(a2) / 4.0f + Vector2f(1.0f, -1.0f);
+			same &= Near(result2.x, a.x / 4.0f + 1.0f, 1e-6f) && Near(result2.y, a.y / 4.0f - 1.0f, 1e-6f);
+			const Vector4f a4(a, length);
+			const Vector4f result4 = Expression::Lazy(a4) - Vector4f(b, 1.0f) * length;
+			same &= Near(result4.x, a.x - b.x * length, 1e-6f) && Near(result4.w, length - length, 1e-6f);
+		}
+		Check(same, "VectorExpression matches per component arithmetic");
+
+		constexpr Vector3<double> constantResult = Expression::Lazy(Vector3<double>(1.0, 2.0, 3.0)) * 2.0 - Vector3<double>(0.5, 0.5, 0.5);
+		static_assert(constantResult == Vector3<double>(1.5, 3.5, 5.5));
+
+		// Streams are assigned element by element, single vectors broadcast over them.
+		std::vector<Vector3f> positions;
+		std::vector<Vector3f> velocities;
+		for (int index = 0; index < 37; index++)
+		{
+			positions.push_back(RandomVector(-10.0f, 10.0f));
+			velocities.push_back(RandomVector(-1.0f, 1.0f));
+		}
+		Vector3Stream<float> positionStream(std::span<const Vector3f>(positions.data(), positions.size()));
+		const Vector3Stream<float> velocityStream(std::span<const Vector3f>(velocities.data(), velocities.size()));
+		const Vector3f gravity(0.0f, -9.8f, 0.0f);
+		Expression::Assign(positionStream, Expression::Lazy(positionStream) + (Expression::Lazy(velocityStream) + gravity * 0.5f) * 0.25f);
+		Vector3Stream<float> resized;
+		Expression::Assign(resized, -Expression::Lazy(velocityStream));
+		bool streams = positionStream.Size() == positions.size() && resized.Size() == velocities.size();
+		for (std::size_t index = 0; streams && index < positions.size(); index++)
+		{
+			const Vector3f expected = positions[index] + (velocities[index] + gravity * 0.5f) * 0.25f;
+			streams &= VectorNear(positionStream.Get(index), expected, 1e-6f);
+			streams &= resized.Get(index) == Vector3f(-velocities[index].x, -velocities[index].y, -velocities[index].z);
+		}
+		Check(streams, "VectorExpression Assign to Vector3Stream");
+
+		// In place += and -= update the left operand, also when both sides are the same vector.
+		Vector3f sum = Vector3f(1.0f, 2.0f, 3.0f);
+		sum += sum;
+		sum -= Vector3f(0.5f, 0.5f, 0.5f);
+		Vector3<double> sumDouble(1.0, 2.0, 3.0);
+		sumDouble += sumDouble;
+		sumDouble -= Vector3<double>(0.5, 0.5, 0.5);
+		Vector4f sum4(1.0f, 2.0f, 3.0f, 4.0f);
+		sum4 += sum4;
+		sum4 -= Vector4f(0.5f, 0.5f, 0.5f, 0.5f);
+		Vector2f sum2(1.0f, 2.0f);
+		sum2 += sum2;
+		sum2 -= Vector2f(0.5f, 0.5f);
+		Check(sum == Vector3f(1.5f, 3.5f, 5.5f) && sumDouble == Vector3<double>(1.5, 3.5, 5.5), "Vector3 in place += and -=");
+		Check(sum4 == Vector4f(1.5f, 3.5f, 5.5f, 7.5f) && sum2 == Vector2f(1.5f, 3.5f), "Vector2 and Vector4 in place += and -=");
+	}
+
+	// Determinant by cofactor expansion along the first row, in double.
+	double ReferenceDeterminant(const double* aData, int aSize)
+	{
+		if (aSize == 1)
+		{
+			return aData[0];
+		}
+		double result = 0.0;
+		double minor[9];
+		for (int skipped = 0; skipped < aSize; skipped++)
+		{
+			int written = 0;
+			for (int row = 1; row < aSize; row++)
+			{
+				for (int column = 0; column < aSize; column++)
+				{
+					if (column != skipped)
+					{
+						minor[written++] = aData[row * aSize + column];
+					}
+				}
+			}
+			result += (skipped % 2 == 0 ? 1.0 : -1.0) * aData[skipped] * ReferenceDeterminant(minor, aSize - 1);
+		}
+		return result;
+	}
+
+	// GetInverse, GetInverseAffine and GetDeterminant, single and Batch, singular matrices keep the output untouched.
+	void CheckInverse()
+	{
+		auto isIdentity = [](const Matrix4x4<float>& aMatrix, float aTolerance)
+		{
+			const Matrix4x4<float> identity = Matrix4x4<float>::GetIdentity();
+			for (int element = 0; element < 16; element++)
+			{
+				if (std::abs(aMatrix.GetData()[element] - identity.GetData()[element]) > aTolerance)
+				{
+					return false;
+				}
+			}
+			return true;
+		};
+
+		std::vector<Matrix4x4<float>> matrices(9);
+		std::vector<Matrix4x4<float>> transforms(9);
+		bool inverse = true;
+		bool determinant = true;
+		bool affine = true;
+		for (std::size_t index = 0; index < matrices.size(); index++)
+		{
+			// A dominant diagonal keeps the random matrices well conditioned.
+			double data[16];
+			for (int element = 0; element < 16; element++)
+			{
+				matrices[index].GetData()[element] = RandomFloat(-1.0f, 1.0f) + (element % 5 == 0 ? 4.0f : 0.0f);
+				data[element] = matrices[index].GetData()[element];
+			}
+			Matrix4x4<float> result;
+			inverse &= Matrix4x4<float>::GetInverse(matrices[index], result);
+			inverse &= isIdentity(matrices[index] * result, 1e-5f) && isIdentity(result * matrices[index], 1e-5f);
+			determinant &= Near(Matrix4x4<float>::GetDeterminant(matrices[index]), static_cast<float>(ReferenceDeterminant(data, 4)), 1e-5f);
+
+			// Rotation, non uniform scale and shear, then translation.
+			Matrix4x4<float> transform = Matrix4x4<float>::CreateRotationAroundY(RandomFloat(-3.0f, 3.0f)) * Matrix4x4<float>::CreateRotationAroundX(RandomFloat(-3.0f, 3.0f));
+			transform(1, 1) *= RandomFloat(0.5f, 2.0f);
+			transform(2, 2) *= RandomFloat(0.5f, 2.0f);
+			transform(2, 1) += RandomFloat(-0.5f, 0.5f);
+			transform(4, 1) = RandomFloat(-50.0f, 50.0f);
+			transform(4, 2) = RandomFloat(-50.0f, 50.0f);
+			transform(4, 3) = RandomFloat(-50.0f, 50.0f);
+			transforms[index] = transform;
+			Matrix4x4<float> affineResult;
+			affine &= Matrix4x4<float>::GetInverseAffine(transform, affineResult);
+			affine &= isIdentity(transform * affineResult, 1e-4f) && isIdentity(affineResult * transform, 1e-4f);
+		}
+		Check(inverse, "Matrix4x4 GetInverse");
+		Check(determinant, "Matrix4x4 GetDeterminant");
+		Check(affine, "Matrix4x4 GetInverseAffine");
+
+		// A zero row makes every product in the determinant exactly zero, whichever way it is expanded.
+		Matrix4x4<float> singular = matrices[0];
+		for (int column = 1; column <= 4; column++)
+		{
+			singular(3, column) = 0.0f;
+		}
+		Matrix4x4<float> untouched(2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 2, 0, 1, 2, 3, 1);
+		const Matrix4x4<float> before = untouched;
+		Check(!Matrix4x4<float>::GetInverse(singular, untouched) && untouched == before, "Matrix4x4 GetInverse leaves aResult untouched when singular");
+		Matrix4x4<float> flat = transforms[0];
+		flat(3, 1) = 0.0f;
+		flat(3, 2) = 0.0f;
+		flat(3, 3) = 0.0f;
+		Check(!Matrix4x4<float>::GetInverseAffine(flat, untouched) && untouched == before, "Matrix4x4 GetInverseAffine leaves aResult untouched when singular");
+		Check(Matrix4x4<float>::GetDeterminant(singular) == 0.0f, "Matrix4x4 GetDeterminant of a singular matrix");
+
+		// The Batch versions match the single calls and count the singular entries.
+		matrices[4] = singular;
+		transforms[6] = flat;
+		std::vector<Matrix4x4<float>> results(matrices.size(), before);
+		std::vector<Matrix4x4<float>> affineResults(transforms.size(), before);
+		std::vector<float> determinants(matrices.size());
+		const std::size_t singularCount = Batch::Inverse(matrices, results);
+		const std::size_t singularAffineCount = Batch::InverseAffine(transforms, affineResults);
+		Batch::Determinant(matrices, determinants);
+		bool same = singularCount == 1 && singularAffineCount == 1;
+		for (std::size_t index = 0; index < matrices.size(); index++)
+		{
+			Matrix4x4<float> expected = before;
+			Matrix4x4<float>::GetInverse(matrices[index], expected);
+			Matrix4x4<float> expectedAffine = before;
+			Matrix4x4<float>::GetInverseAffine(transforms[index], expectedAffine);
+			same &= results[index] == expected && affineResults[index] == expectedAffine;
+			same &= determinants[index] == Matrix4x4<float>::GetDeterminant(matrices[index]);
+		}
+		Check(same, "Batch::Inverse, InverseAffine and Determinant match Matrix4x4");
+
+		// The upper left blocks, the singular matrix at index four keeps its zero row.
+		std::vector<Matrix3x3<float>> matrices3(matrices.begin(), matrices.end());
+		std::vector<Matrix3x3<float>> results3(matrices3.size());
+		std::vector<float> determinants3(matrices3.size());
+		const std::size_t singularCount3 = Batch::Inverse(matrices3, results3);
+		Batch::Determinant(matrices3, determinants3);
+		bool inverse3 = singularCount3 == 1 && results3[4] == Matrix3x3<float>();
+		for (std::size_t index = 0; index < matrices3.size(); index++)
+		{
+			if (index == 4)
+			{
+				continue;
+			}
+			double data[9];
+			for (int row = 0; row < 3; row++)
+			{
+				for (int column = 0; column < 3; column++)
+				{
+					data[row * 3 + column] = matrices3[index](row + 1, column + 1);
+				}
+			}
+			Matrix3x3<float> product = matrices3[index];
+			product *= results3[index];
+			for (int row = 1; row <= 3; row++)
+			{
+				for (int column = 1; column <= 3; column++)
+				{
+					inverse3 &= std::abs(product(row, column) - (row == column ? 1.0f : 0.0f)) <= 1e-5f;
+				}
+			}
+			inverse3 &= Near(determinants3[index], static_cast<float>(ReferenceDeterminant(data, 3)), 1e-5f);
+			inverse3 &= determinants3[index] == Matrix3x3<float>::GetDeterminant(matrices3[index]);
+		}
+		Check(inverse3, "Matrix3x3 GetInverse and GetDeterminant, single and Batch");
+	}
+
+	// Rotation, non uniform scale and shear, then translation, the last column stays (0, 0, 0, 1).
+	Matrix4x4<float> RandomAffine(float aRange)
+	{
+		Matrix4x4<float> transform = Matrix4x4<float>::CreateRotationAroundZ(RandomFloat(-3.0f, 3.0f)) * Matrix4x4<float>::CreateRotationAroundX(RandomFloat(-3.0f, 3.0f));
+		transform(1, 1) *= RandomFloat(0.5f, 2.0f);
+		transform(3, 3) *= RandomFloat(0.5f, 2.0f);
+		transform(3, 2) += RandomFloat(-0.5f, 0.5f);
+		transform(4, 1) = RandomFloat(-aRange, aRange);
+		transform(4, 2) = RandomFloat(-aRange, aRange);
+		transform(4, 3) = RandomFloat(-aRange, aRange);
+		return transform;
+	}
+
+	// Matrix3x4 against the Matrix4x4 it was converted from.
+	void CheckMatrix3x4()
+	{
+		auto matrixNear = [](const Matrix3x4<float>& aValue, const Matrix3x4<float>& aExpected, float aTolerance)
+		{
+			for (int element = 0; element < 12; element++)
+			{
+				if (!Near(aValue.GetData()[element], aExpected.GetData()[element], aTolerance))
+				{
+					return false;
+				}
+			}
+			return true;
+		};
+
+		bool conversion = true;
+		bool product = true;
+		bool transform = true;
+		bool inverse = true;
+		for (int index = 0; index < 50; index++)
+		{
+			const Matrix4x4<float> left = RandomAffine(20.0f);
+			const Matrix4x4<float> right = RandomAffine(20.0f);
+			const Matrix3x4<float> left3x4(left);
+			const Matrix3x4<float> right3x4(right);
+
+			conversion &= left3x4.ToMatrix4x4() == left;
+			conversion &= left3x4(1, 4) == left(4, 1) && left3x4(3, 2) == left(2, 3);
+			conversion &= left3x4.GetRight() == left.GetRight() && left3x4.GetUp() == left.GetUp();
+			conversion &= left3x4.GetForward() == left.GetForward() && left3x4.GetTranslation() == left.GetTranslation();
+			conversion &= Near(Matrix3x4<float>::GetDeterminant(left3x4), Matrix4x4<float>::GetDeterminant(left), 1e-5f);
+
+			// aLeft * aRight applies aLeft first, the same order as the Matrix4x4 product.
+			product &= matrixNear(left3x4 * right3x4, Matrix3x4<float>(left * right), 1e-5f);
+			Matrix3x4<float> accumulated = left3x4;
+			accumulated *= right3x4;
+			product &= accumulated == left3x4 * right3x4;
+
+			const Vector3f point = RandomVector(-10.0f, 10.0f);
+			const Vector4f direction = Vector4f(point, 0.0f) * left;
+			transform &= VectorNear(left3x4.TransformPoint(point), TransformPoint(point, left), 1e-5f);
+			transform &= point * left3x4 == left3x4.TransformPoint(point);
+			transform &= VectorNear(left3x4.TransformDirection(point), Vector3f(direction.x, direction.y, direction.z), 1e-5f);
+			transform &= VectorNear((left3x4 * right3x4).TransformPoint(point), right3x4.TransformPoint(left3x4.TransformPoint(point)), 1e-5f);
+
+			Matrix4x4<float> expected;
+			Matrix4x4<float>::GetInverseAffine(left, expected);
+			Matrix3x4<float> result;
+			inverse &= Matrix3x4<float>::GetInverse(left3x4, result);
+			inverse &= matrixNear(result, Matrix3x4<float>(expected), 1e-5f);
+			inverse &= matrixNear(left3x4 * result, Matrix3x4<float>::GetIdentity(), 1e-5f);
+			Matrix3x4<float> aliased = left3x4;
+			inverse &= Matrix3x4<float>::GetInverse(aliased, aliased) && aliased == result;
+		}
+		Check(conversion, "Matrix3x4 conversion to and from Matrix4x4");
+		Check(product, "Matrix3x4 product matches Matrix4x4");
+		Check(transform, "Matrix3x4 TransformPoint and TransformDirection match Matrix4x4");
+		Check(inverse, "Matrix3x4 GetInverse matches Matrix4x4 GetInverseAffine");
+
+		// A zero scale axis, aResult keeps what it held.
+		Matrix4x4<float> flat = RandomAffine(20.0f);
+		flat(2, 1) = 0.0f;
+		flat(2, 2) = 0.0f;
+		flat(2, 3) = 0.0f;
+		const Matrix3x4<float> before(RandomAffine(20.0f));
+		Matrix3x4<float> untouched = before;
+		Check(!Matrix3x4<float>::GetInverse(Matrix3x4<float>(flat), untouched) && untouched == before, "Matrix3x4 GetInverse leaves aResult untouched when singular");
+
+		constexpr Matrix3x4<float> constantTransform(0, -1, 0, 4, 1, 0, 0, 5, 0, 0, 2, 6);
+		static_assert(constantTransform * Matrix3x4<float>::GetIdentity() == constantTransform);
+		static_assert(constantTransform.TransformPoint(Vector3f(1.0f, 2.0f, 3.0f)) == Vector3f(2.0f, 6.0f, 12.0f));
+		static_assert(Matrix3x4<float>(constantTransform.ToMatrix4x4()) == constantTransform);
+	}
+
+	// Depth after the divide by w, for a point on the view axis.
+	float ProjectedDepth(float aViewDepth, const Matrix4x4<float>& aProjection)
+	{
+		return TransformPoint(Vector3f(0.0f, 0.0f, aViewDepth), aProjection).z;
+	}
+
+	// The projection and look at builders map their near and far planes and the field of view edges where they say.
+	void CheckProjectionBuilders()
+	{
+		const float fieldOfView = 1.0f;
+		const float aspectRatio = 1.5f;
+		const float edge = std::tan(fieldOfView / 2.0f);
+
+		const Matrix4x4<float> perspective = Matrix4x4<float>::CreatePerspective(fieldOfView, aspectRatio, 0.5f, 300.0f);
+		const Matrix4x4<float> reversed = Matrix4x4<float>::CreatePerspectiveReversedZ(fieldOfView, aspectRatio, 0.5f, 300.0f);
+		const Matrix4x4<float> infinite = Matrix4x4<float>::CreatePerspectiveInfinite(fieldOfView, aspectRatio, 0.5f);
+		const Matrix4x4<float> infiniteReversed = Matrix4x4<float>::CreatePerspectiveInfiniteReversedZ(fieldOfView, aspectRatio, 0.5f);
+		Check(Near(ProjectedDepth(0.5f, perspective), 0.0f, 1e-6f) && Near(ProjectedDepth(300.0f, perspective), 1.0f, 1e-6f), "CreatePerspective depth range");
+		Check(Near(ProjectedDepth(0.5f, reversed), 1.0f, 1e-6f) && Near(ProjectedDepth(300.0f, reversed), 0.0f, 1e-6f), "CreatePerspectiveReversedZ depth range");
+		Check(Near(ProjectedDepth(0.5f, infinite), 0.0f, 1e-6f) && Near(ProjectedDepth(1e6f, infinite), 1.0f, 1e-6f), "CreatePerspectiveInfinite depth range");
+		Check(Near(ProjectedDepth(0.5f, infiniteReversed), 1.0f, 1e-6f) && Near(ProjectedDepth(1e6f, infiniteReversed), 0.0f, 1e-6f), "CreatePerspectiveInfiniteReversedZ depth range");
+		bool edges = true;
+		for (const Matrix4x4<float>* projection : { &perspective, &reversed, &infinite, &infiniteReversed })
+		{
+			const Vector3f corner = TransformPoint(Vector3f(edge * aspectRatio * 40.0f, -edge * 40.0f, 40.0f), *projection);
+			edges &= Near(corner.x, 1.0f, 1e-5f) && Near(corner.y, -1.0f, 1e-5f);
+		}
+		Check(edges, "CreatePerspective field of view edges");
+
+		const Matrix4x4<float> orthographic = Matrix4x4<float>::CreateOrthographic(20.0f, 10.0f, 1.0f, 101.0f);
+		const Matrix4x4<float> orthographicReversed = Matrix4x4<float>::CreateOrthographicReversedZ(20.0f, 10.0f, 1.0f, 101.0f);
+		Check(TransformPoint(Vector3f(10.0f, -5.0f, 1.0f), orthographic) == Vector3f(1.0f, -1.0f, 0.0f) && Near(ProjectedDepth(101.0f, orthographic), 1.0f, 1e-6f), "CreateOrthographic");
+		Check(TransformPoint(Vector3f(-10.0f, 5.0f, 101.0f), orthographicReversed) == Vector3f(-1.0f, 1.0f, 0.0f) && Near(ProjectedDepth(1.0f, orthographicReversed), 1.0f, 1e-6f), "CreateOrthographicReversedZ");
+
+		// The eye lands on the origin looking down +z with up on +y, lengths are kept.
+		bool lookAt = true;
+		for (int index = 0; index < 20; index++)
+		{
+			const Vector3f eye = RandomVector(-100.0f, 100.0f);
+			const Vector3f target = eye + RandomVector(-10.0f, 10.0f);
+			const Matrix4x4<float> view = Matrix4x4<float>::CreateLookAt(eye, target, Vector3f(0.0f, 1.0f, 0.0f));
+			const Vector3f viewTarget = TransformPoint(target, view);
+			const Vector3f viewAbove = TransformPoint(eye + Vector3f(0.0f, 1.0f, 0.0f), view);
+			lookAt &= VectorNear(TransformPoint(eye, view), Vector3f(0.0f, 0.0f, 0.0f), 1e-5f);
+			lookAt &= VectorNear(viewTarget, Vector3f(0.0f, 0.0f, (target - eye).Length()), 1e-4f);
+			lookAt &= std::abs(viewAbove.x) <= 1e-4f && viewAbove.y > 0.0f;
+			lookAt &= Near(Matrix4x4<float>::GetDeterminant(view), 1.0f, 1e-5f);
+		}
+		Check(lookAt, "CreateLookAt");
+
+		const Matrix4x4<float> view = Matrix4x4<float>::CreateLookAt(Vector3f(3.0f, 2.0f, -20.0f), Vector3f(0.0f, 0.0f, 0.0f), Vector3f(0.0f, 1.0f, 0.0f));
+		ViewProjection<float> viewProjection(view, perspective);
+		Check(viewProjection.GetViewProjection() == view * perspective && viewProjection.GetFrustum().Size() == 6, "ViewProjection combines view and projection");
+		viewProjection.SetProjection(infinite);
+		Check(viewProjection.GetViewProjection() == view * infinite && viewProjection.GetFrustum().Size() == 5, "ViewProjection updates on SetProjection");
+	}
+
+	// Cameras thousands of units from the origin keep all six planes, the distance only grows the w column.
+	void CheckFrustumFarFromOrigin()
+	{
+		struct Camera
+		{
+			Vector3f eye;
+			Vector3f target;
+			float farPlane;
+		};
+		const Camera cameras[] =
+		{
+			{ Vector3f(5000.0f, 0.0f, 0.0f), Vector3f(0.0f, 0.0f, 0.0f), 3000.0f },
+			{ Vector3f(20000.0f, 50.0f, -30.0f), Vector3f(0.0f, 0.0f, 0.0f), 10000.0f },
+			{ Vector3f(5000.0f, 20.0f, 20000.0f), Vector3f(5000.0f, 0.0f, 0.0f), 5000.0f },
+		};
+		const float fieldOfView = 1.0f;
+		const float aspectRatio = 1.5f;
+		const float nearPlane = 0.5f;
+		const float edge = std::tan(fieldOfView / 2.0f);
+
+		for (const Camera& camera : cameras)
+		{
+			const std::string name = "CreateFrustum far from the origin, far plane " + std::to_string(static_cast<int>(camera.farPlane));
+			const Matrix4x4<float> view = Matrix4x4<float>::CreateLookAt(camera.eye, camera.target, Vector3f(0.0f, 1.0f, 0.0f));
+			const Matrix4x4<float> toWorld = Matrix4x4<float>::GetFastInverse(view);
+			const PlaneVolume<float> frustum = PlaneVolume<float>::CreateFrustum(view * Matrix4x4<float>::CreatePerspective(fieldOfView, aspectRatio, nearPlane, camera.farPlane));
+			Check(frustum.Size() == 6, name + " keeps six planes");
+
+			bool inside = true;
+			bool outside = true;
+			for (int index = 0; index < 200; index++)
+			{
+				const float depth = RandomFloat(nearPlane * 2.0f, camera.farPlane * 0.98f);
+				const float x = RandomFloat(-0.95f, 0.95f) * edge * aspectRatio * depth;
+				const float y = RandomFloat(-0.95f, 0.95f) * edge * depth;
+				inside &= frustum.Inside(TransformPoint(Vector3f(x, y, depth), toWorld));
+				outside &= !frustum.Inside(TransformPoint(Vector3f(x, y, camera.farPlane * RandomFloat(1.02f, 3.0f)), toWorld));
+				outside &= !frustum.Inside(TransformPoint(Vector3f(x * 1.1f, y, -depth), toWorld));
+				outside &= !frustum.Inside(TransformPoint(Vector3f(edge * aspectRatio * depth * 1.1f, y, depth), toWorld));
+				outside &= !frustum.Inside(TransformPoint(Vector3f(x, -edge * depth * 1.1f, depth), toWorld));
+			}
+			Check(inside, name + " inside");
+			Check(outside && !frustum.Inside(Vector3f(0.0f, 0.0f, 1e6f)), name + " outside");
+
+			// The infinite far plane is the only one that goes.
+			const PlaneVolume<float> infinite = PlaneVolume<float>::CreateFrustum(view * Matrix4x4<float>::CreatePerspectiveInfinite(fieldOfView, aspectRatio, nearPlane));
+			const PlaneVolume<float> infiniteReversed = PlaneVolume<float>::CreateFrustum(view * Matrix4x4<float>::CreatePerspectiveInfiniteReversedZ(fieldOfView, aspectRatio, nearPlane));
+			Check(infinite.Size() == 5 && infiniteReversed.Size() == 5, name + " infinite projections keep five planes");
+			Check(infinite.Inside(TransformPoint(Vector3f(0.0f, 0.0f, 1e6f), toWorld)) && infiniteReversed.Inside(TransformPoint(Vector3f(0.0f, 0.0f, 1e6f), toWorld)), name + " infinite projections have no far plane");
+		}
+	}
+
+	// Every Batch::Rotate overload against Quaternion::Rotate, in place and split across threads.
+	void CheckBatchRotate()
+	{
+		for (std::size_t count : { std::size_t(37), std::size_t(40000) })
+		{
+			const std::string size = " of " + std::to_string(count);
+			const Quaternion rotation = RandomRotation();
+			std::vector<Vector3f> vectors(count);
+			std::vector<Vector4f> vectors4(count);
+			std::vector<Quaternion> rotations(count);
+			for (std::size_t index = 0; index < count; index++)
+			{
+				vectors[index] = RandomVector(-10.0f, 10.0f);
+				vectors4[index] = Vector4f(vectors[index], RandomFloat(-2.0f, 2.0f));
+				rotations[index] = RandomRotation();
+			}
+			const Vector3Stream<float> stream(std::span<const Vector3f>(vectors.data(), vectors.size()));
+			const QuaternionStream rotationStream(rotations);
+
+			for (Batch::Execution execution : { Batch::Execution::Sequential, Batch::Execution::Parallel })
+			{
+				const std::string name = "Batch::Rotate" + size + (execution == Batch::Execution::Parallel ? " in parallel" : "");
+				std::vector<Vector3f> result(count);
+				std::vector<Vector4f> result4(vectors4);
+				Vector3Stream<float> streamResult;
+				Vector3Stream<float> perElement;
+				Batch::Rotate(vectors, rotation, result, execution);
+				Batch::Rotate(result4, rotation, result4, execution);
+				Batch::Rotate(stream, rotation, streamResult, execution);
+				Batch::Rotate(rotationStream, stream, perElement, execution);
+
+				bool same = streamResult.Size() == count && perElement.Size() == count;
+				bool same4 = true;
+				bool sameElement = true;
+				for (std::size_t index = 0; same && index < count; index++)
+				{
+					const Vector3f expected = rotation.Rotate(vectors[index]);
+					const Vector3f expected4 = rotation.Rotate(Vector3f(vectors4[index].x, vectors4[index].y, vectors4[index].z));
+					same &= VectorNear(result[index], expected, 1e-5f) && VectorNear(streamResult.Get(index), expected, 1e-5f);
+					same4 &= VectorNear(Vector3f(result4[index].x, result4[index].y, result4[index].z), expected4, 1e-5f) && result4[index].w == vectors4[index].w;
+					sameElement &= VectorNear(perElement.Get(index), rotations[index].Rotate(vectors[index]), 1e-5f);
+				}
+				Check(same, name + " Vector3 and Vector3Stream");
+				Check(same4, name + " Vector4 in place keeps w");
+				Check(sameElement, name + " per element QuaternionStream");
+
+				std::vector<Vector3f> inPlace(vectors);
+				Batch::Rotate(inPlace, rotation, inPlace, execution);
+				Check(inPlace == result, name + " in place");
+			}
+		}
+	}
+
+	// Batch::BuildMatrices against Transform::CreateMatrix and CreateAffineMatrix.
+	void CheckBuildMatrices()
+	{
+		for (std::size_t count : { std::size_t(37), std::size_t(20000) })
+		{
+			std::vector<Transform> transforms(count);
+			for (Transform& transform : transforms)
+			{
+				transform.SetPosition(RandomVector(-100.0f, 100.0f));
+				transform.SetRotation(RandomRotation());
+				transform.SetScale(Vector3f(RandomFloat(0.1f, 4.0f), RandomFloat(0.1f, 4.0f), RandomFloat(0.1f, 4.0f)));
+			}
+			for (Batch::Execution execution : { Batch::Execution::Sequential, Batch::Execution::Parallel })
+			{
+				std::vector<Matrix4x4<float>> matrices(count);
+				std::vector<Matrix3x4<float>> affineMatrices(count);
+				Batch::BuildMatrices(transforms, matrices, execution);
+				Batch::BuildMatrices(transforms, affineMatrices, execution);
+
+				bool same = true;
+				bool sameAffine = true;
+				for (std::size_t index = 0; index < count; index++)
+				{
+					const Matrix4x4<float> expected = transforms[index].CreateMatrix();
+					const Matrix3x4<float> expectedAffine = transforms[index].CreateAffineMatrix();
+					for (int element = 0; element < 16; element++)
+					{
+						same &= Near(matrices[index].GetData()[element], expected.GetData()[element], 1e-5f);
+					}
+					for (int element = 0; element < 12; element++)
+					{
+						sameAffine &= Near(affineMatrices[index].GetData()[element], expectedAffine.GetData()[element], 1e-5f);
+					}
+				}
+				const std::string name = "Batch::BuildMatrices of " + std::to_string(count) + (execution == Batch::Execution::Parallel ? " in parallel" : "");
+				Check(same, name + " matches CreateMatrix");
+				Check(sameAffine, name + " matches CreateAffineMatrix");
+			}
+		}
+	}
+
+	Transform RandomTransform()
+	{
+		Transform transform;
+		transform.SetPosition(RandomVector(-10.0f, 10.0f));
+		transform.SetRotation(RandomRotation());
+		transform.SetScale(Vector3f(RandomFloat(0.5f, 2.0f), RandomFloat(0.5f, 2.0f), RandomFloat(0.5f, 2.0f)));
+		return transform;
+	}
+
+	// Every world matrix against the local matrices multiplied up the parent chain by hand.
+	bool WorldMatricesMatch(const TransformHierarchy& aHierarchy)
+	{
+		for (TransformHierarchy::Handle handle = 0; handle < aHierarchy.Size(); handle++)
+		{
+			Matrix3x4<float> expected = aHierarchy.GetLocal(handle).CreateAffineMatrix();
+			for (TransformHierarchy::Handle parent = aHierarchy.GetParent(handle); parent != TransformHierarchy::InvalidHandle; parent = aHierarchy.GetParent(parent))
+			{
+				expected = expected * aHierarchy.GetLocal(parent).CreateAffineMatrix();
+			}
+			const Matrix3x4<float>& world = aHierarchy.GetWorldMatrix(handle);
+			for (int element = 0; element < 12; element++)
+			{
+				if (!Near(world.GetData()[element], expected.GetData()[element], 1e-4f) || aHierarchy.IsDirty(handle))
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	void CheckTransformHierarchy()
+	{
+		for (Batch::Execution execution : { Batch::Execution::Sequential, Batch::Execution::Parallel })
+		{
+			const std::string name = std::string("TransformHierarchy") + (execution == Batch::Execution::Parallel ? " in parallel" : "");
+
+			// A few roots with random subtrees up to six levels deep.
+			TransformHierarchy hierarchy;
+			for (int index = 0; index < 300; index++)
+			{
+				TransformHierarchy::Handle parent = TransformHierarchy::InvalidHandle;
+				if (index >= 3)
+				{
+					parent = static_cast<TransformHierarchy::Handle>(RandomFloat(0.0f, static_cast<float>(index) - 0.5f));
+					while (hierarchy.GetDepth(parent) >= 5)
+					{
+						parent = hierarchy.GetParent(parent);
+					}
+				}
+				hierarchy.Add(RandomTransform(), parent);
+			}
+			hierarchy.Update(execution);
+			Check(WorldMatricesMatch(hierarchy), name + " after the first Update");
+
+			// An inner node with grandchildren, its subtree moves and the rest of the tree keeps its matrices.
+			TransformHierarchy::Handle inner = 0;
+			for (TransformHierarchy::Handle handle = 0; handle < hierarchy.Size(); handle++)
+			{
+				if (hierarchy.GetDepth(handle) == 3)
+				{
+					inner = hierarchy.GetParent(handle);
+					break;
+				}
+			}
+			const std::vector<Matrix3x4<float>> before(hierarchy.GetWorldMatrices().begin(), hierarchy.GetWorldMatrices().end());
+			hierarchy.SetLocal(inner, RandomTransform());
+			hierarchy.SetLocal(inner, RandomTransform());
+			Check(hierarchy.IsDirty(inner), name + " SetLocal flags the node");
+			hierarchy.Update(execution);
+			Check(WorldMatricesMatch(hierarchy), name + " after SetLocal on an inner node");
+			bool untouched = true;
+			for (TransformHierarchy::Handle handle = 0; handle < hierarchy.Size(); handle++)
+			{
+				bool inSubtree = false;
+				for (TransformHierarchy::Handle ancestor = handle; ancestor != TransformHierarchy::InvalidHandle; ancestor = hierarchy.GetParent(ancestor))
+				{
+					inSubtree |= ancestor == inner;
+				}
+				untouched &= inSubtree || hierarchy.GetWorldMatrix(handle) == before[handle];
+			}
+			Check(untouched, name + " keeps the matrices outside the changed subtree");
+
+			// Leaves and a root changed together, nodes added after the last Update.
+			hierarchy.SetLocal(static_cast<TransformHierarchy::Handle>(hierarchy.Size() - 1), RandomTransform());
+			hierarchy.SetLocal(1, RandomTransform());
+			hierarchy.Add(RandomTransform(), 2);
+			hierarchy.Update(execution);
+			Check(WorldMatricesMatch(hierarchy), name + " after SetLocal on a root and a leaf");
+
+			// One level wide enough to be split across threads.
+			TransformHierarchy wide;
+			const TransformHierarchy::Handle root = wide.Add(RandomTransform());
+			for (int index = 0; index < 10000; index++)
+			{
+				wide.Add(RandomTransform(), root);
+			}
+			wide.Update(execution);
+			wide.SetLocal(root, RandomTransform());
+			wide.Update(execution);
+			Check(WorldMatricesMatch(wide), name + " with a wide level");
+		}
+	}
+
+	// Distance from the double reference in units of the float result's last place.
+	double UlpError(float aValue, double aExpected)
+	{
+		const float expected = std::abs(static_cast<float>(aExpected));
+		const float ulp = std::nextafter(expected, std::numeric_limits<float>::infinity()) - expected;
+		return std::abs(aValue - aExpected) / ulp;
+	}
+
+	// The Fast and Fastest tiers of Math against double libm, within the errors FastMath.hpp documents.
+	void CheckMathTiers()
+	{
+		std::vector<float> angles;
+		for (int index = 0; index < 20000; index++)
+		{
+			angles.push_back(RandomFloat(-8191.0f, 8191.0f));
+			angles.push_back(RandomFloat(-4.0f, 4.0f));
+		}
+		// Next to the zeros of sine and cosine, where the reduction error shows in ULP.
+		for (int quadrant = -5214; quadrant <= 5214; quadrant += 7)
+		{
+			const float angle = static_cast<float>(quadrant * std::numbers::pi / 2.0);
+			angles.insert(angles.end(), { std::nextafter(angle, -10000.0f), angle, std::nextafter(angle, 10000.0f) });
+		}
+
+		double sinCosFast = 0.0;
+		double sinCosFastest = 0.0;
+		bool same = true;
+		for (float angle : angles)
+		{
+			float sine;
+			float cosine;
+			Math::SinCos<Precision::Fast>(angle, sine, cosine);
+			sinCosFast = std::max({ sinCosFast, UlpError(sine, std::sin(static_cast<double>(angle))), UlpError(cosine, std::cos(static_cast<double>(angle))) });
+			same &= Math::Sin<Precision::Fast>(angle) == sine && Math::Cos<Precision::Fast>(angle) == cosine;
+			Math::SinCos<Precision::Fastest>(angle, sine, cosine);
+			sinCosFastest = std::max({ sinCosFastest, std::abs(sine - std::sin(static_cast<double>(angle))), std::abs(cosine - std::cos(static_cast<double>(angle))) });
+			same &= Math::Sin<Precision::Fastest>(angle) == sine && Math::Cos<Precision::Fastest>(angle) == cosine;
+			Math::SinCos(angle, sine, cosine);
+			same &= sine == std::sin(angle) && cosine == std::cos(angle);
+		}
+		Check(sinCosFast <= 2.0, "Math::SinCos Fast within 2 ULP");
+		Check(sinCosFastest <= 1.5e-5, "Math::SinCos Fastest within 1.5e-5");
+		Check(same, "Math::Sin and Cos match SinCos, Exact is libm");
+
+		double atan2Fast = 0.0;
+		double atan2Fastest = 0.0;
+		double acosFast = 0.0;
+		double acosFastest = 0.0;
+		double expFast = 0.0;
+		double expFastest = 0.0;
+		for (int index = 0; index < 40000; index++)
+		{
+			// Every octant, with ratios from tiny to huge.
+			const float y = RandomFloat(-1.0f, 1.0f) * std::ldexp(1.0f, index % 20 - 10);
+			const float x = RandomFloat(-1.0f, 1.0f);
+			const double atan2 = std::atan2(static_cast<double>(y), static_cast<double>(x));
+			atan2Fast = std::max(atan2Fast, UlpError(Math::Atan2<Precision::Fast>(y, x), atan2));
+			atan2Fastest = std::max(atan2Fastest, std::abs(Math::Atan2<Precision::Fastest>(y, x) - atan2) / std::abs(atan2));
+
+			const float value = index < 2 ? (index == 0 ? -1.0f : 1.0f) : RandomFloat(-1.0f, 1.0f);
+			const double acos = std::acos(static_cast<double>(value));
+			acosFast = std::max(acosFast, UlpError(Math::Acos<Precision::Fast>(value), acos));
+			acosFastest = std::max(acosFastest, std::abs(Math::Acos<Precision::Fastest>(value) - acos));
+
+			const float exponent = RandomFloat(-104.0f, 88.72f);
+			const double exp = std::exp(static_cast<double>(exponent));
+			expFast = std::max(expFast, UlpError(Math::Exp<Precision::Fast>(exponent), exp));
+			if (exponent > -87.33f)
+			{
+				expFastest = std::max(expFastest, std::abs(Math::Exp<Precision::Fastest>(exponent) - exp) / exp);
+			}
+		}
+		Check(atan2Fast <= 3.0, "Math::Atan2 Fast within 3 ULP");
+		Check(atan2Fastest <= 2.3e-5, "Math::Atan2 Fastest within 2.3e-5 relative");
+		Check(acosFast <= 2.0, "Math::Acos Fast within 2 ULP");
+		Check(acosFastest <= 6.8e-5, "Math::Acos Fastest within 6.8e-5");
+		Check(expFast <= 2.0, "Math::Exp Fast within 2 ULP");
+		Check(expFastest <= 1.3e-4, "Math::Exp Fastest within 1.3e-4 relative");
+
+		// Outside [-104, 88.72] the inputs are clamped.
+		Check(Math::Exp<Precision::Fast>(-200.0f) == Math::Exp<Precision::Fast>(-104.0f) && Math::Exp<Precision::Fastest>(100.0f) == Math::Exp<Precision::Fastest>(88.7228394f), "Math::Exp clamps its input");
+	}
+
+	// Math's scalar helpers in float and double, and their Batch array forms.
+	void CheckMathHelpers()
+	{
+		static_assert(std::is_same_v<decltype(Math::Clamp(0.5, 0, 1)), double> && std::is_same_v<decltype(Math::Lerp(1.0, 2, 0.5)), double>);
+		Check(Math::DegreeToRad(180.0) == std::numbers::pi && Math::RadToDegree(std::numbers::pi) == 180.0, "Math angle conversions keep double precision");
+		Check(Near(Math::DegreeToRad(90.0f), std::numbers::pi_v<float> / 2.0f, 1e-7f) && Near(Math::RadToDegree(Math::DegreeToRad(37.5f)), 37.5f, 2e-7f), "Math angle conversions in float");
+		Check(Math::PI == std::numbers::pi_v<float> && Math::PI_D == std::numbers::pi, "Math::PI is not truncated");
+		Check(Math::Sign(-2.5) == -1.0 && Math::Sign(0.0f) == 1.0f && Math::Sign(3) == 1 && Math::Sign(-3) == -1, "Math::Sign");
+		Check(Math::Clamp(1e-300, 0.0, 1.0) == 1e-300 && Math::Clamp(-1.0, 0.0, 1.0) == 0.0 && Math::Clamp(7, -2, 5) == 5, "Math::Clamp");
+		Check(Math::Clamp01(1.5f) == 1.0f && Math::Clamp01(0.25) == 0.25, "Math::Clamp01");
+		Check(Math::Lerp(2.0, 4.0, 0.0) == 2.0 && Math::Lerp(2.0, 4.0, 1.0) == 4.0 && Math::Lerp(1.0, 1.0 + 1e-12, 0.5) == 1.0 + 0.5e-12, "Math::Lerp");
+		Check(Math::Remap(15.0, 10.0, 20.0, -1.0, 1.0) == 0.0 && Math::Remap(30.0f, 10.0f, 20.0f, 0.0f, 1.0f) == 2.0f, "Math::Remap does not clamp");
+		Check(Math::IsInvertible(1e-30f) && Math::IsInvertible(-2.0) && !Math::IsInvertible(0.0f) && !Math::IsInvertible(1e-40f), "Math::IsInvertible rejects zero and denormals");
+		Check(!Math::IsInvertible(std::numeric_limits<float>::quiet_NaN()) && !Math::IsInvertible(-std::numeric_limits<double>::denorm_min()), "Math::IsInvertible rejects NaN");
+
+		for (std::size_t count : { std::size_t(37), std::size_t(40000) })
+		{
+			const std::vector<float> values = RandomFloats(count, -10.0f, 10.0f);
+			const std::vector<float> targets = RandomFloats(count, -10.0f, 10.0f);
+			for (Batch::Execution execution : { Batch::Execution::Sequential, Batch::Execution::Parallel })
+			{
+				const std::string name = " of " + std::to_string(count) + (execution == Batch::Execution::Parallel ? " in parallel" : "");
+				std::vector<float> clamped(count);
+				std::vector<float> interpolated(values);
+				std::vector<float> remapped(count);
+				Batch::Clamp(values, -2.0f, 3.0f, clamped, execution);
+				Batch::Lerp(interpolated, targets, 0.3f, interpolated, execution);
+				Batch::Remap(values, -10.0f, 10.0f, 100.0f, 200.0f, remapped, execution);
+
+				bool clampSame = true;
+				bool lerpSame = true;
+				bool remapNear = true;
+				for (std::size_t index = 0; index < count; index++)
+				{
+					clampSame &= clamped[index] == Math::Clamp(values[index], -2.0f, 3.0f);
+					lerpSame &= Near(interpolated[index], Math::Lerp(values[index], targets[index], 0.3f), 1e-6f);
+					remapNear &= Near(remapped[index], Math::Remap(values[index], -10.0f, 10.0f, 100.0f, 200.0f), 1e-6f);
+				}
+				Check(clampSame, "Batch::Clamp" + name);
+				Check(lerpSame, "Batch::Lerp in place" + name);
+				Check(remapNear, "Batch::Remap" + name);
+			}
+		}
+	}
+
+	// Fixed32 arithmetic against the same integer operations written out, trig against double libm.
+	void CheckFixedPoint()
+	{
+		const double step = 1.0 / Fixed32::One;
+		std::uniform_int_distribution<std::int32_t> randomRaw(std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max());
+
+		bool arithmetic = true;
+		bool trigonometry = true;
+		for (int index = 0; index < 20000; index++)
+		{
+			const Fixed32 a = Fixed32::FromRaw(randomRaw(randomEngine) >> (index % 16));
+			const Fixed32 b = Fixed32::FromRaw(randomRaw(randomEngine) >> (index % 16));
+			const std::int64_t rawA = a.GetRaw();
+			const std::int64_t rawB = b.GetRaw();
+			arithmetic &= (a + b).GetRaw() == static_cast<std::int32_t>(static_cast<std::uint32_t>(rawA + rawB));
+			arithmetic &= (a - b).GetRaw() == static_cast<std::int32_t>(static_cast<std::uint32_t>(rawA - rawB));
+			// Both round toward negative infinity.
+			arithmetic &= (a * b).GetRaw() == static_cast<std::int32_t>((rawA * rawB - ((rawA * rawB) % Fixed32::One + Fixed32::One) % Fixed32::One) / Fixed32::One);
+			if (b.GetRaw() != 0 && std::abs(static_cast<double>(a) / static_cast<double>(b)) < 32767.0)
+			{
+				const std::int64_t numerator = rawA * Fixed32::One;
+				const std::int64_t remainder = (numerator % rawB + rawB) % rawB;
+				arithmetic &= (a / b).GetRaw() == static_cast<std::int32_t>((numerator - remainder) / rawB);
+			}
+			arithmetic &= (a < b) == (rawA < rawB) && (a == b) == (rawA == rawB);
+			arithmetic &= static_cast<int>(a) == static_cast<int>(std::floor(static_cast<double>(a)));
+			arithmetic &= Fixed32(static_cast<double>(a)) == a && std::abs(Fixed32(static_cast<float>(a)).GetRaw() - rawA) <= 128;
+			arithmetic &= std::abs(static_cast<double>(Fixed32::Sqrt(Fixed32::Abs(a))) - std::sqrt(std::abs(static_cast<double>(a)))) <= 0.5 * step;
+
+			const double angle = static_cast<double>(a);
+			Fixed32 sine;
+			Fixed32 cosine;
+			Fixed32::SinCos(a, sine, cosine);
+			trigonometry &= std::abs(static_cast<double>(sine) - std::sin(angle)) <= step && std::abs(static_cast<double>(cosine) - std::cos(angle)) <= step;
+			trigonometry &= Fixed32::Sin(a) == sine && Fixed32::Cos(a) == cosine;
+			trigonometry &= Math::Sin<Precision::Fastest>(a) == sine && Math::Atan2(a, b) == Fixed32::Atan2(a, b);
+			if (a.GetRaw() != 0 || b.GetRaw() != 0)
+			{
+				trigonometry &= std::abs(static_cast<double>(Fixed32::Atan2(a, b)) - std::atan2(angle, static_cast<double>(b))) <= step;
+			}
+		}
+		Check(arithmetic, "Fixed32 arithmetic, conversions and Sqrt");
+		Check(trigonometry, "Fixed32 SinCos and Atan2 within one step");
+		Check(Fixed32::Atan2(Fixed32(), Fixed32()) == Fixed32() && std::abs(static_cast<double>(Fixed32::Pi()) - std::numbers::pi) <= 0.5 * step, "Fixed32 Atan2(0, 0) and Pi");
+		Check(std::abs(static_cast<double>(Fixed32::DegreeToRad(Fixed32(-135))) + 0.75 * std::numbers::pi) <= step, "Fixed32 DegreeToRad");
+		Check(Fixed32(32767) + Fixed32(1) == Fixed32::FromRaw(std::numeric_limits<std::int32_t>::min()) && Fixed32(-32768).GetRaw() == std::numeric_limits<std::int32_t>::min(), "Fixed32 overflow wraps");
+		Check(Fixed32(-1.5) == -Fixed32(1.5) && static_cast<int>(Fixed32(-1.5)) == -2 && Fixed32(0.5f).GetRaw() == Fixed32::One / 2, "Fixed32 from floating point");
+
+		// The delta is a Fixed32, so the midpoint of two Vector3x is exact.
+		const Vector3x from(Fixed32(-3), Fixed32(1.25), Fixed32(100));
+		const Vector3x to(Fixed32(5), Fixed32(-0.75), Fixed32(-100));
+		Check(Vector3x::Lerp(from, to, Fixed32(0.5)) == Vector3x(Fixed32(1), Fixed32(0.25), Fixed32(0)), "Vector3x Lerp with a Fixed32 delta");
+		static_assert(std::is_same_v<decltype(Vector3x::Lerp(from, to, Fixed32(0.25))), Vector3x>);
+
+		// FixedQuaternion against the float Quaternion it rounds, a few steps of rounding per product.
+		bool rotation = true;
+		for (int index = 0; index < 500; index++)
+		{
+			const Quaternion left = RandomRotation();
+			const Quaternion right = RandomRotation();
+			const FixedQuaternion fixedLeft(left);
+			const FixedQuaternion fixedRight(right);
+			const Quaternion product = (fixedLeft * fixedRight).ToQuaternion();
+			rotation &= RotationDifference(product, left * right) <= 3e-4f;
+			FixedQuaternion accumulated = fixedLeft;
+			accumulated *= fixedRight;
+			rotation &= accumulated == fixedLeft * fixedRight;
+
+			const Vector3f vector = RandomVector(-100.0f, 100.0f);
+			const Vector3x rotated = fixedLeft.Rotate(Vector3x(Fixed32(vector.x), Fixed32(vector.y), Fixed32(vector.z)));
+			rotation &= VectorNear(Vector3f(static_cast<float>(rotated.x), static_cast<float>(rotated.y), static_cast<float>(rotated.z)), left.Rotate(vector), 1e-3f);
+
+			const float degrees = RandomFloat(-180.0f, 180.0f);
+			const Vector3f axis = RandomVector(-1.0f, 1.0f).GetNormalized();
+			const FixedQuaternion fixedAxisAngle(Fixed32(degrees), Vector3x(Fixed32(axis.x), Fixed32(axis.y), Fixed32(axis.z)));
+			rotation &= RotationDifference(fixedAxisAngle.ToQuaternion(), Quaternion(degrees, axis)) <= 3e-4f;
+
+			FixedQuaternion scaled(fixedLeft.r * Fixed32(3), fixedLeft.i * Fixed32(3), fixedLeft.j * Fixed32(3), fixedLeft.k * Fixed32(3));
+			scaled.Normalize();
+			rotation &= RotationDifference(scaled.ToQuaternion(), left) <= 3e-4f;
+		}
+		Check(rotation, "FixedQuaternion product, Rotate, axis angle and Normalize");
+
+		// Integer only, so compile time evaluation gives the same bits.
+		constexpr FixedQuaternion constantRotation(Fixed32(90), Vector3x(Fixed32(0), Fixed32(1), Fixed32(0)));
+		constexpr Vector3x constantRotated = constantRotation.Rotate(Vector3x(Fixed32(1), Fixed32(2), Fixed32(3)));
+		const FixedQuaternion runtimeRotation(Fixed32(90), Vector3x(Fixed32(0), Fixed32(1), Fixed32(0)));
+		Check(runtimeRotation.Rotate(Vector3x(Fixed32(1), Fixed32(2), Fixed32(3))) == constantRotated, "FixedQuaternion is the same at compile time");
+	}
+
+	// Every hit of aRay in index order, worked out in double. Spheres are given by center and radius, planes by
+	// normal and Hessian distance.
+	std::vector<std::pair<std::uint32_t, float>> ReferenceHits(const Ray<float>& aRay, const std::vector<Vector3f>& aPrimitives, const std::vector<float>& aValues, bool aSpheres, double aMaxDistance)
+	{
+		const Vector3f& origin = aRay.GetPosition();
+		const Vector3f& direction = aRay.GetDirection();
+		std::vector<std::pair<std::uint32_t, float>> hits;
+		for (std::size_t index = 0; index < aPrimitives.size(); index++)
+		{
+			const Vector3f& primitive = aPrimitives[index];
+			double distance = 0.0;
+			if (aSpheres)
+			{
+				const double x = double(origin.x) - primitive.x;
+				const double y = double(origin.y) - primitive.y;
+				const double z = double(origin.z) - primitive.z;
+				const double a = double(direction.x) * direction.x + double(direction.y) * direction.y + double(direction.z) * direction.z;
+				const double b = x * direction.x + y * direction.y + z * direction.z;
+				const double c = x * x + y * y + z * z - double(aValues[index]) * aValues[index];
+				const double discriminant = b * b - a * c;
+				if (discriminant < 0.0 || (std::sqrt(discriminant) - b) / a < 0.0)
+				{
+					continue;
+				}
+				distance = std::max(0.0, (-b - std::sqrt(discriminant)) / a);
+			}
+			else
+			{
+				const double side = double(primitive.x) * origin.x + double(primitive.y) * origin.y + double(primitive.z) * origin.z + aValues[index];
+				const double speed = double(primitive.x) * direction.x + double(primitive.y) * direction.y + double(primitive.z) * direction.z;
+				distance = speed != 0.0 ? -side / speed : -1.0;
+				if (distance < 0.0)
+				{
+					continue;
+				}
+			}
+			if (distance <= aMaxDistance)
+			{
+				hits.emplace_back(static_cast<std::uint32_t>(index), static_cast<float>(distance));
+			}
+		}
+		return hits;
+	}
+
+	void CheckBatchRays()
+	{
+		std::vector<Vector3f> centers;
+		std::vector<Vector3f> normals;
+		for (int index = 0; index < 300; index++)
+		{
+			centers.push_back(RandomVector(-40.0f, 40.0f));
+		}
+		for (int index = 0; index < 64; index++)
+		{
+			// Kept away from parallel to the z axis rays below, grazing hits are too far out to compare.
+			normals.push_back(Vector3f(RandomFloat(-0.5f, 0.5f), RandomFloat(-0.5f, 0.5f), 1.0f).GetNormalized());
+		}
+		const std::vector<float> radii = RandomFloats(centers.size(), 0.5f, 4.0f);
+		const std::vector<float> offsets = RandomFloats(normals.size(), -30.0f, 30.0f);
+		const Vector3Stream<float> centerStream(std::span<const Vector3f>(centers.data(), centers.size()));
+		const Vector3Stream<float> normalStream(std::span<const Vector3f>(normals.data(), normals.size()));
+
+		// Rays through the primitives from every side, their directions reaching a point around the middle at 1.
+		std::vector<Ray<float>> rays;
+		for (int index = 0; index < 200; index++)
+		{
+			const Vector3f origin = RandomVector(-50.0f, 50.0f);
+			const Vector3f target = Vector3f(RandomFloat(-10.0f, 10.0f), RandomFloat(-10.0f, 10.0f), origin.z + RandomFloat(20.0f, 60.0f) * (index % 2 == 0 ? 1.0f : -1.0f));
+			rays.emplace_back(origin, target);
+		}
+		// Pointing away from everything, and starting inside sphere 0.
+		rays.emplace_back(Vector3f(0.0f, 0.0f, 500.0f), Vector3f(0.0f, 0.0f, 600.0f));
+		rays.emplace_back(centers[0], centers[0] + Vector3f(1.0f, 0.0f, 0.0f));
+
+		auto checkPrimitives = [&](const std::string& aName, bool aSpheres, const Vector3Stream<float>& aStream, const std::vector<Vector3f>& aPrimitives, const std::vector<float>& aValues)
+		{
+			auto intersect = [&](const Ray<float>& aRay, Batch::HitMode aMode, std::span<std::uint32_t> aIndices, std::span<float> aDistances, float aMaxDistance)
+			{
+				return aSpheres ?
+					Batch::IntersectSpheres(aRay, aStream, aValues, aMode, aIndices, aDistances, aMaxDistance) :
+					Batch::IntersectPlanes(aRay, aStream, aValues, aMode, aIndices, aDistances, aMaxDistance);
+			};
+
+			const std::size_t count = aValues.size();
+			bool all = true;
+			bool closest = true;
+			bool any = true;
+			std::size_t hitCount = 0;
+			for (float maxDistance : { std::numeric_limits<float>::infinity(), 1.0f })
+			{
+				for (const Ray<float>& ray : rays)
+				{
+					const std::vector<std::pair<std::uint32_t, float>> expected = ReferenceHits(ray, aPrimitives, aValues, aSpheres, maxDistance);
+					std::vector<std::uint32_t> indices(count);
+					std::vector<float> distances(count);
+					indices.resize(intersect(ray, Batch::HitMode::All, indices, distances, maxDistance));
+					all &= indices.size() == expected.size();
+					for (std::size_t hit = 0; all && hit < indices.size(); hit++)
+					{
+						all &= indices[hit] == expected[hit].first && Near(distances[hit], expected[hit].second, 1e-4f);
+					}
+					hitCount += expected.size();
+
+					std::uint32_t index = Batch::NoHit;
+					float distance = std::numeric_limits<float>::infinity();
+					const std::size_t closestCount = intersect(ray, Batch::HitMode::Closest, std::span<std::uint32_t>(&index, 1), std::span<float>(&distance, 1), maxDistance);
+					const auto nearest = std::min_element(expected.begin(), expected.end(), [](const auto& aHit0, const auto& aHit1) { return aHit0.second < aHit1.second; });
+					closest &= expected.empty() ? closestCount == 0 : closestCount == 1 && index == nearest->first && Near(distance, nearest->second, 1e-4f);
+
+					// Any may stop at whichever hit it reaches first.
+					const std::size_t anyCount = intersect(ray, Batch::HitMode::Any, std::span<std::uint32_t>(&index, 1), std::span<float>(&distance, 1), maxDistance);
+					const auto found = std::find_if(expected.begin(), expected.end(), [index](const auto& aHit) { return aHit.first == index; });
+					any &= expected.empty() ? anyCount == 0 : anyCount == 1 && found != expected.end() && Near(distance, found->second, 1e-4f);
+				}
+			}
+			Check(all && hitCount > rays.size(), aName + " All");
+			Check(closest, aName + " Closest");
+			Check(any, aName + " Any");
+
+			// Many rays give each ray's single ray result, NoHit and infinity for misses.
+			for (Batch::HitMode mode : { Batch::HitMode::Closest, Batch::HitMode::Any })
+			{
+				for (Batch::Execution execution : { Batch::Execution::Sequential, Batch::Execution::Parallel })
+				{
+					std::vector<std::uint32_t> indices(rays.size());
+					std::vector<float> distances(rays.size());
+					if (aSpheres)
+					{
+						Batch::IntersectSpheres(rays, aStream, aValues, mode, indices, distances, 1.0f, execution);
+					}
+					else
+					{
+						Batch::IntersectPlanes(rays, aStream, aValues, mode, indices, distances, 1.0f, execution);
+					}
+					bool same = true;
+					for (std::size_t ray = 0; ray < rays.size(); ray++)
+					{
+						std::uint32_t index = Batch::NoHit;
+						float distance = std::numeric_limits<float>::infinity();
+						intersect(rays[ray], mode, std::span<std::uint32_t>(&index, 1), std::span<float>(&distance, 1), 1.0f);
+						same &= indices[ray] == index && distances[ray] == distance;
+					}
+					Check(same, aName + " rays " + std::to_string(static_cast<int>(mode)) + (execution == Batch::Execution::Parallel ? " Parallel" : " Sequential"));
+				}
+			}
+
+			std::uint32_t index = 0;
+			float distance = 0.0f;
+			Check(intersect(rays[200], Batch::HitMode::Closest, std::span<std::uint32_t>(&index, 1), std::span<float>(&distance, 1), 1.0f) == 0, aName + " miss");
+		};
+		checkPrimitives("IntersectSpheres", true, centerStream, centers, radii);
+		checkPrimitives("IntersectPlanes", false, normalStream, normals, offsets);
+
+		std::uint32_t index = Batch::NoHit;
+		float distance = -1.0f;
+		Check(Batch::IntersectSpheres(rays[201], centerStream, radii, Batch::HitMode::Closest, std::span<std::uint32_t>(&index, 1), std::span<float>(&distance, 1)) == 1 && distance == 0.0f, "IntersectSpheres inside");
+
+		// No primitives: no hits for one ray, NoHit and infinity for many.
+		const Vector3Stream<float> empty;
+		std::vector<std::uint32_t> indices(rays.size(), 0);
+		std::vector<float> distances(rays.size(), 0.0f);
+		Check(Batch::IntersectSpheres(rays[0], empty, {}, Batch::HitMode::All, indices, distances) == 0, "IntersectSpheres empty");
+		Batch::IntersectPlanes(rays, empty, {}, Batch::HitMode::Closest, indices, distances, 1.0f, Batch::Execution::Parallel);
+		Check(std::all_of(indices.begin(), indices.end(), [](std::uint32_t aIndex) { return aIndex == Batch::NoHit; }) &&
+			std::all_of(distances.begin(), distances.end(), [](float aDistance) { return aDistance == std::numeric_limits<float>::infinity(); }), "IntersectPlanes empty");
+	}
+}
 
-int main() 
-{ 
-    using namespace stm;
+int main()
+{
+	const auto kernels = GetRunnableKernels();
+	for (const auto& [instructionSet, table] : kernels)
+	{
+		CheckKernels(*kernels.front().second, *table, CpuFeatures::GetName(instructionSet));
+	}
+	CheckVectors();
+	CheckConstexpr();
+	CheckPrecision();
+	CheckMathTiers();
+	CheckMathHelpers();
+	CheckFixedPoint();
+	CheckVectorExpressions();
+	CheckPackedFormats();
+	CheckMatrixMultiply();
+	CheckInverse();
+	CheckMatrix3x4();
+	CheckBatchRotate();
+	CheckBuildMatrices();
+	CheckTransformHierarchy();
+	CheckEulerAngles();
+	CheckAABB2D();
+	CheckBroadphase();
+	CheckBoundingVolumeHierarchy();
+	CheckBoundingVolumeHierarchyNonFinite();
+	CheckRayPackets();
+	CheckBatchRays();
+	CheckFrustumCuller();
+	CheckPlaneSet();
+	CheckProjectionBuilders();
+	CheckFrustumFarFromOrigin();
 
-    return 0; 
-}
\ No newline at end of file
+	std::cout << (failureCount == 0 ? "All checks passed" : "Checks failed") << " on " << kernels.size() << " kernel tables\n";
+	return failureCount == 0 ? 0 : 1;
+}